@@ -0,0 +1,27 @@
+@echo off
+rmdir /Q /S bin
+mkdir bin
+pushd bin
+
+rem Name
+set name=App
+
+rem Include directories 
+set inc=/I ..\..\..\third_party\include\ /I ..\..\containers\source\
+
+rem Source files
+set src_main=..\source\main.c
+
+rem All source together
+set src_all=%src_main%
+
+rem OS Libraries
+set os_libs= opengl32.lib kernel32.lib user32.lib ^
+shell32.lib vcruntime.lib msvcrt.lib gdi32.lib Winmm.lib Advapi32.lib
+
+rem Compile Release (benchmarks are meaningless in debug)
+cl /MP /FS /Ox /W0 /DNDEBUG /Fe%name%.exe %src_all% %inc% ^
+/EHsc /link /SUBSYSTEM:CONSOLE /NODEFAULTLIB:msvcrt.lib /NODEFAULTLIB:LIBCMT ^
+%os_libs%
+
+popd
@@ -0,0 +1,1329 @@
+/*================================================================
+    * Copyright: 2020 John Jackson
+    * bench
+
+    Headless micro-benchmarks for the containers and allocators
+    demonstrated in ex_core_containers/containers. No window is
+    created, results are printed to stdout and can also be written
+    as CSV or JSON for tracking across builds.
+
+    Included:
+        * containers: insert, grow, lookup, iterate and erase for gs_dyn_array,
+            gs_hash_table, gs_hash_table_simd, gs_slot_array, gs_slot_map and
+            gs_byte_buffer_t, 1e3-1e7 elements, u32 to 64 byte struct keys
+        * gs_pool_t: fixed size block allocator vs. gs_malloc/gs_free,
+            single threaded and with 1-16 threads sharing a pool
+        * gs_mpmc_queue(T)/gs_spsc_ring(T): lock-free queues vs. a spinlock
+            guarded gs_dyn_array, with 1-16 producer/consumer threads
+        * gs_hash_table_concurrent(K, V): read-mostly access from 1-16 threads
+            vs. a spinlock guarded gs_hash_table
+        * gs_radix_sort: u32, u64, f32 and u64 key + payload sorts, serial and
+            parallel, vs. qsort
+
+    Usage: App [--suite containers|pool|queue|shared_table|sort] [--max N] [--csv FILE] [--json FILE]
+        --suite:    only run one suite (default all)
+        --max:      largest element count for container and sort runs (default 1000000)
+        --csv/json: also write every result to FILE, '-' for stdout (tables then go to stderr)
+================================================================*/
+
+// No window or app loop, just main()
+#define GS_NO_HIJACK_MAIN
+#define GS_IMPL
+#include <gs/gs.h>
+
+#define GS_THREAD_IMPL
+#include "gs_thread.h"
+
+#define GS_POOL_IMPL
+#include "gs_pool.h"
+
+#define GS_CONCURRENT_QUEUE_IMPL
+#include "gs_concurrent_queue.h"
+
+// Benchmarked by its own names next to the default gs_hash_table (no override)
+#define GS_HASH_TABLE_SIMD_IMPL
+#include "gs_hash_table_simd.h"
+
+#define GS_CONTAINERS_BULK_IMPL
+#include "gs_containers_bulk.h"
+
+#define GS_HASH_TABLE_CONCURRENT_IMPL
+#include "gs_hash_table_concurrent.h"
+
+#define GS_RADIX_SORT_IMPL
+#include "gs_radix_sort.h"
+
+#include <stdarg.h>
+
+#if (defined _WIN32 || defined _WIN64)
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#define BENCH_POOL_OPS          2000000
+#define BENCH_POOL_LIVE         4096
+#define BENCH_MAX_THREADS       16
+#define BENCH_QUEUE_ITEMS       (1 << 21)
+#define BENCH_QUEUE_CAPACITY    1024
+#define BENCH_QUEUE_BATCH       32
+#define BENCH_SHARED_TABLE_KEYS         (1 << 16)
+#define BENCH_SHARED_TABLE_OPS          (1 << 21)
+#define BENCH_SHARED_TABLE_WRITE_EVERY  20
+#define BENCH_MIN_TIME          0.1         // Seconds spent repeating each container run (best run is kept)
+#define BENCH_MAX_REPS          50
+#define BENCH_BUDGET            5.0         // Skip container sizes projected to take longer than this per run
+
+// Human-readable tables (stderr when machine-readable results are written to stdout)
+static FILE* bench_log = NULL;
+
+static void bench_printf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(bench_log, fmt, args);
+    va_end(args);
+}
+
+static void bench_println(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(bench_log, fmt, args);
+    va_end(args);
+    fputc('\n', bench_log);
+}
+
+// Monotonic time in seconds
+static double bench_now()
+{
+#if (defined _WIN32 || defined _WIN64)
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static uint64_t bench_rand(uint64_t* s)
+{
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+/*=== Results ===*/
+
+typedef struct bench_result_t
+{
+    const char* suite;
+    const char* name;       // Container/allocator/queue under test
+    const char* op;
+    const char* param;      // Key type, block size, ...
+    uint32_t n;
+    uint32_t threads;
+    double ns;              // Per op
+} bench_result_t;
+
+static gs_dyn_array(bench_result_t) bench_results = NULL;
+
+static void bench_record(const char* suite, const char* name, const char* op, const char* param, uint32_t n, uint32_t threads, double ns)
+{
+    bench_result_t r = {.suite = suite, .name = name, .op = op, .param = param, .n = n, .threads = threads, .ns = ns};
+    gs_dyn_array_push(bench_results, r);
+}
+
+static bool bench_write_results(const char* path, bool json)
+{
+    FILE* f = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "Error: could not open %s\n", path);
+        return false;
+    }
+
+    const uint32_t ct = gs_dyn_array_size(bench_results);
+    if (json)
+    {
+        fprintf(f, "{\n  \"hardware_threads\": %u,\n  \"results\": [\n", gs_thread_hardware_concurrency());
+        for (uint32_t i = 0; i < ct; ++i)
+        {
+            const bench_result_t* r = &bench_results[i];
+            fprintf(f, "    {\"suite\": \"%s\", \"name\": \"%s\", \"op\": \"%s\", \"param\": \"%s\", \"n\": %u, \"threads\": %u, \"ns_per_op\": %.3f}%s\n",
+                r->suite, r->name, r->op, r->param, r->n, r->threads, r->ns, i + 1 < ct ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+    }
+    else
+    {
+        fprintf(f, "suite,name,op,param,n,threads,ns_per_op\n");
+        for (uint32_t i = 0; i < ct; ++i)
+        {
+            const bench_result_t* r = &bench_results[i];
+            fprintf(f, "%s,%s,%s,%s,%u,%u,%.3f\n", r->suite, r->name, r->op, r->param, r->n, r->threads, r->ns);
+        }
+    }
+
+    if (f != stdout) fclose(f);
+    return true;
+}
+
+/*=== Containers ===*/
+
+typedef struct bench_key16_t { uint64_t v[2]; } bench_key16_t;
+typedef struct bench_key64_t { uint64_t v[8]; } bench_key64_t;
+
+typedef enum bench_container_type
+{
+    BENCH_CONTAINER_DYN_ARRAY,
+    BENCH_CONTAINER_HASH_TABLE,
+    BENCH_CONTAINER_HASH_TABLE_SIMD,
+    BENCH_CONTAINER_SLOT_ARRAY,
+    BENCH_CONTAINER_SLOT_MAP,
+    BENCH_CONTAINER_BYTE_BUFFER,
+    BENCH_CONTAINER_COUNT
+} bench_container_type;
+
+static const char* bench_container_names[BENCH_CONTAINER_COUNT] =
+{
+    "gs_dyn_array",
+    "gs_hash_table",
+    "gs_hash_table_simd",
+    "gs_slot_array",
+    "gs_slot_map",
+    "gs_byte_buffer_t"
+};
+
+typedef enum bench_op_type
+{
+    BENCH_OP_INSERT,        // Into storage reserved up front
+    BENCH_OP_GROW,          // From empty, growing as needed
+    BENCH_OP_LOOKUP,        // Every element, in random order
+    BENCH_OP_ITERATE,
+    BENCH_OP_ERASE,         // Every element, in random order
+    BENCH_OP_COUNT
+} bench_op_type;
+
+static const char* bench_op_names[BENCH_OP_COUNT] =
+{
+    "insert",
+    "grow",
+    "lookup",
+    "iterate",
+    "erase"
+};
+
+// Keeps results of timed loops alive
+static volatile uint64_t bench_sink = 0;
+
+// Reads first 4 bytes of any key, enough to make the compiler load it
+gs_force_inline
+uint32_t bench_touch_func(const void* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+#define bench_touch(__K)\
+    bench_touch_func(&(__K))
+
+static double bench_ns(double t0, uint32_t n)
+{
+    return (bench_now() - t0) * 1e9 / (double)n;
+}
+
+// Bijective mix, so keys made from distinct indices stay distinct
+static uint64_t bench_mix64(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static void bench_make_keys(void* keys, size_t key_size, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if (key_size == sizeof(uint32_t)) {
+            ((uint32_t*)keys)[i] = i * 0x9E3779B1u;
+            continue;
+        }
+        uint64_t* k = (uint64_t*)((uint8_t*)keys + (size_t)i * key_size);
+        k[0] = bench_mix64(i);
+        for (size_t w = 1; w < key_size / sizeof(uint64_t); ++w) k[w] = (uint64_t)i * (w + 1);
+    }
+}
+
+// Random permutation of [0, n)
+static void bench_make_order(uint32_t* order, uint32_t n, uint64_t seed)
+{
+    for (uint32_t i = 0; i < n; ++i) order[i] = i;
+    for (uint32_t i = n; i > 1; --i)
+    {
+        uint32_t j = (uint32_t)(bench_rand(&seed) % i);
+        uint32_t t = order[i - 1]; order[i - 1] = order[j]; order[j] = t;
+    }
+}
+
+// One run of every op, writes ns/op to ns[BENCH_OP_COUNT] (negative if op doesn't apply)
+typedef void (*bench_container_func)(uint32_t n, const void* keys, const uint32_t* order, double* ns);
+
+#define BENCH_DEFINE_DYN_ARRAY(__NAME, __K)\
+    static void bench_dyn_array_##__NAME(uint32_t n, const void* kp, const uint32_t* order, double* ns)\
+    {\
+        const __K* keys = (const __K*)kp;\
+        uint64_t sum = 0;\
+        gs_dyn_array(__K) arr = NULL;\
+\
+        double t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_dyn_array_push(arr, keys[i]);\
+        ns[BENCH_OP_GROW] = bench_ns(t0, n);\
+        gs_dyn_array_free(arr);\
+\
+        gs_dyn_array_reserve(arr, n + 1);\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_dyn_array_push(arr, keys[i]);\
+        ns[BENCH_OP_INSERT] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) sum += bench_touch(arr[order[i]]);\
+        ns[BENCH_OP_LOOKUP] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < gs_dyn_array_size(arr); ++i) sum += bench_touch(arr[i]);\
+        ns[BENCH_OP_ITERATE] = bench_ns(t0, n);\
+\
+        /* Unordered erase, back element is moved into the hole */\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) {\
+            uint32_t j = order[i] % gs_dyn_array_size(arr);\
+            arr[j] = gs_dyn_array_back(arr);\
+            gs_dyn_array_pop(arr);\
+        }\
+        ns[BENCH_OP_ERASE] = bench_ns(t0, n);\
+\
+        gs_dyn_array_free(arr);\
+        bench_sink += sum;\
+    }
+
+// __PRE is the macro prefix, so the default table and simd table share a body
+#define BENCH_DEFINE_HASH_TABLE(__NAME, __PRE, __K)\
+    static void bench_##__PRE##_##__NAME(uint32_t n, const void* kp, const uint32_t* order, double* ns)\
+    {\
+        const __K* keys = (const __K*)kp;\
+        uint64_t sum = 0;\
+        __PRE(__K, uint32_t) ht = NULL;\
+\
+        double t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) __PRE##_insert(ht, keys[i], i);\
+        ns[BENCH_OP_GROW] = bench_ns(t0, n);\
+        __PRE##_free(ht);\
+\
+        BENCH_RESERVE_##__PRE(ht, __K, n);\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) __PRE##_insert(ht, keys[i], i);\
+        ns[BENCH_OP_INSERT] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) sum += __PRE##_get(ht, keys[order[i]]);\
+        ns[BENCH_OP_LOOKUP] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t it = __PRE##_iter_new(ht); __PRE##_iter_valid(ht, it); __PRE##_iter_advance(ht, it)) {\
+            sum += __PRE##_iter_get(ht, it);\
+        }\
+        ns[BENCH_OP_ITERATE] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) __PRE##_erase(ht, keys[order[i]]);\
+        ns[BENCH_OP_ERASE] = bench_ns(t0, n);\
+\
+        __PRE##_free(ht);\
+        bench_sink += sum;\
+    }
+
+#define BENCH_RESERVE_gs_hash_table(__HT, __K, __CT)          gs_hash_table_reserve(__HT, __K, uint32_t, __CT)
+#define BENCH_RESERVE_gs_hash_table_simd(__HT, __K, __CT)     gs_hash_table_simd_reserve(__HT, __CT)
+
+#define BENCH_DEFINE_SLOT_ARRAY(__NAME, __K)\
+    static void bench_slot_array_##__NAME(uint32_t n, const void* kp, const uint32_t* order, double* ns)\
+    {\
+        const __K* keys = (const __K*)kp;\
+        uint64_t sum = 0;\
+        uint32_t* hndls = (uint32_t*)gs_malloc(sizeof(uint32_t) * n);\
+        gs_slot_array(__K) sa = NULL;\
+\
+        double t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) hndls[i] = gs_slot_array_insert(sa, keys[i]);\
+        ns[BENCH_OP_GROW] = bench_ns(t0, n);\
+        gs_slot_array_free(sa);\
+\
+        gs_slot_array_reserve(sa, n + 1);\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) hndls[i] = gs_slot_array_insert(sa, keys[i]);\
+        ns[BENCH_OP_INSERT] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) sum += bench_touch(gs_slot_array_get(sa, hndls[order[i]]));\
+        ns[BENCH_OP_LOOKUP] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (gs_slot_array_iter it = gs_slot_array_iter_new(sa); gs_slot_array_iter_valid(sa, it); gs_slot_array_iter_advance(sa, it)) {\
+            sum += bench_touch(gs_slot_array_iter_get(sa, it));\
+        }\
+        ns[BENCH_OP_ITERATE] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_slot_array_erase(sa, hndls[order[i]]);\
+        ns[BENCH_OP_ERASE] = bench_ns(t0, n);\
+\
+        gs_slot_array_free(sa);\
+        gs_free(hndls);\
+        bench_sink += sum;\
+    }
+
+#define BENCH_DEFINE_SLOT_MAP(__NAME, __K)\
+    static void bench_slot_map_##__NAME(uint32_t n, const void* kp, const uint32_t* order, double* ns)\
+    {\
+        const __K* keys = (const __K*)kp;\
+        uint64_t sum = 0;\
+        gs_slot_map(__K, uint32_t) sm = NULL;\
+\
+        double t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_slot_map_insert(sm, keys[i], i);\
+        ns[BENCH_OP_GROW] = bench_ns(t0, n);\
+        gs_slot_map_free(sm);\
+\
+        gs_slot_map_reserve(sm, n);\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_slot_map_insert(sm, keys[i], i);\
+        ns[BENCH_OP_INSERT] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) sum += gs_slot_map_get(sm, keys[order[i]]);\
+        ns[BENCH_OP_LOOKUP] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (gs_slot_map_iter it = gs_slot_map_iter_new(sm); gs_slot_map_iter_valid(sm, it); gs_slot_map_iter_advance(sm, it)) {\
+            sum += gs_slot_map_iter_get(sm, it);\
+        }\
+        ns[BENCH_OP_ITERATE] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_slot_map_erase(sm, keys[order[i]]);\
+        ns[BENCH_OP_ERASE] = bench_ns(t0, n);\
+\
+        gs_slot_map_free(sm);\
+        bench_sink += sum;\
+    }
+
+// Lookup seeks to an element's offset and reads it back, erase doesn't apply
+#define BENCH_DEFINE_BYTE_BUFFER(__NAME, __K)\
+    static void bench_byte_buffer_##__NAME(uint32_t n, const void* kp, const uint32_t* order, double* ns)\
+    {\
+        const __K* keys = (const __K*)kp;\
+        uint64_t sum = 0;\
+        __K v;\
+        gs_byte_buffer_t bb = gs_byte_buffer_new();\
+\
+        double t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_byte_buffer_write(&bb, __K, keys[i]);\
+        ns[BENCH_OP_GROW] = bench_ns(t0, n);\
+        gs_byte_buffer_free(&bb);\
+\
+        bb = gs_byte_buffer_new();\
+        gs_byte_buffer_resize(&bb, sizeof(__K) * n + 1);\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) gs_byte_buffer_write(&bb, __K, keys[i]);\
+        ns[BENCH_OP_INSERT] = bench_ns(t0, n);\
+\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) {\
+            bb.position = order[i] * (uint32_t)sizeof(__K);\
+            gs_byte_buffer_read(&bb, __K, &v);\
+            sum += bench_touch(v);\
+        }\
+        ns[BENCH_OP_LOOKUP] = bench_ns(t0, n);\
+\
+        gs_byte_buffer_seek_to_beg(&bb);\
+        t0 = bench_now();\
+        for (uint32_t i = 0; i < n; ++i) {\
+            gs_byte_buffer_read(&bb, __K, &v);\
+            sum += bench_touch(v);\
+        }\
+        ns[BENCH_OP_ITERATE] = bench_ns(t0, n);\
+        ns[BENCH_OP_ERASE] = -1.0;\
+\
+        gs_byte_buffer_free(&bb);\
+        bench_sink += sum;\
+    }
+
+#define BENCH_DEFINE_CONTAINERS(__NAME, __K)\
+    BENCH_DEFINE_DYN_ARRAY(__NAME, __K)\
+    BENCH_DEFINE_HASH_TABLE(__NAME, gs_hash_table, __K)\
+    BENCH_DEFINE_HASH_TABLE(__NAME, gs_hash_table_simd, __K)\
+    BENCH_DEFINE_SLOT_ARRAY(__NAME, __K)\
+    BENCH_DEFINE_SLOT_MAP(__NAME, __K)\
+    BENCH_DEFINE_BYTE_BUFFER(__NAME, __K)\
+    static bench_container_func bench_containers_##__NAME[BENCH_CONTAINER_COUNT] =\
+    {\
+        bench_dyn_array_##__NAME,\
+        bench_gs_hash_table_##__NAME,\
+        bench_gs_hash_table_simd_##__NAME,\
+        bench_slot_array_##__NAME,\
+        bench_slot_map_##__NAME,\
+        bench_byte_buffer_##__NAME\
+    };
+
+BENCH_DEFINE_CONTAINERS(u32, uint32_t)
+BENCH_DEFINE_CONTAINERS(u64, uint64_t)
+BENCH_DEFINE_CONTAINERS(key16, bench_key16_t)
+BENCH_DEFINE_CONTAINERS(key64, bench_key64_t)
+
+typedef struct bench_key_desc_t
+{
+    const char* name;
+    size_t size;
+    bench_container_func* funcs;
+} bench_key_desc_t;
+
+static const bench_key_desc_t bench_key_descs[] =
+{
+    {"u32", sizeof(uint32_t), bench_containers_u32},
+    {"u64", sizeof(uint64_t), bench_containers_u64},
+    {"key16", sizeof(bench_key16_t), bench_containers_key16},
+    {"key64", sizeof(bench_key64_t), bench_containers_key64}
+};
+
+#define BENCH_SIZE_COUNT    5
+
+static void bench_containers(uint32_t max_n)
+{
+    const uint32_t sizes[BENCH_SIZE_COUNT] = {1000, 10000, 100000, 1000000, 10000000};
+    uint32_t size_ct = 0;
+    while (size_ct < BENCH_SIZE_COUNT && sizes[size_ct] <= max_n) ++size_ct;
+    if (!size_ct) return;
+
+    const uint32_t max_size = sizes[size_ct - 1];
+    uint32_t* order = (uint32_t*)gs_malloc(sizeof(uint32_t) * max_size);
+
+    for (uint32_t k = 0; k < gs_array_size(bench_key_descs); ++k)
+    {
+        const bench_key_desc_t* kd = &bench_key_descs[k];
+        void* keys = gs_malloc(kd->size * max_size);
+        bench_make_keys(keys, kd->size, max_size);
+
+        double ns[BENCH_CONTAINER_COUNT][BENCH_SIZE_COUNT][BENCH_OP_COUNT];
+        double run_time[BENCH_CONTAINER_COUNT][BENCH_SIZE_COUNT] = {0};
+        for (uint32_t c = 0; c < BENCH_CONTAINER_COUNT; ++c)
+            for (uint32_t s = 0; s < BENCH_SIZE_COUNT; ++s)
+                for (uint32_t o = 0; o < BENCH_OP_COUNT; ++o) ns[c][s][o] = -1.0;
+
+        for (uint32_t s = 0; s < size_ct; ++s)
+        {
+            const uint32_t n = sizes[s];
+            bench_make_order(order, n, 0x9E3779B97F4A7C15ull + n);
+
+            for (uint32_t c = 0; c < BENCH_CONTAINER_COUNT; ++c)
+            {
+                // Project this size from the last two (catches ops that scale worse than linearly)
+                if (s && run_time[c][s - 1] == 0.0) continue;
+                if (s)
+                {
+                    double per = run_time[c][s - 1] / sizes[s - 1];
+                    double growth = s > 1 ? per / (run_time[c][s - 2] / sizes[s - 2]) : 1.0;
+                    if (per * gs_max(growth, 1.0) * n > BENCH_BUDGET) continue;
+                }
+
+                double rep_ns[BENCH_OP_COUNT];
+                double total = 0.0;
+                for (uint32_t r = 0; r < BENCH_MAX_REPS && (r == 0 || total < BENCH_MIN_TIME); ++r)
+                {
+                    double t0 = bench_now();
+                    kd->funcs[c](n, keys, order, rep_ns);
+                    double t = bench_now() - t0;
+                    total += t;
+                    if (r == 0 || t < run_time[c][s]) run_time[c][s] = t;
+                    for (uint32_t o = 0; o < BENCH_OP_COUNT; ++o) {
+                        if (r == 0 || rep_ns[o] < ns[c][s][o]) ns[c][s][o] = rep_ns[o];
+                    }
+                }
+
+                for (uint32_t o = 0; o < BENCH_OP_COUNT; ++o) {
+                    if (ns[c][s][o] >= 0.0) bench_record("containers", bench_container_names[c], bench_op_names[o], kd->name, n, 1, ns[c][s][o]);
+                }
+            }
+        }
+
+        bench_println("containers: %s keys (%zu bytes), best ns/op (- skipped or not applicable)", kd->name, kd->size);
+        for (uint32_t c = 0; c < BENCH_CONTAINER_COUNT; ++c)
+        {
+            bench_printf("  %-26s", bench_container_names[c]);
+            for (uint32_t s = 0; s < size_ct; ++s) bench_printf(" %10zu", (size_t)sizes[s]);
+            bench_println("");
+            for (uint32_t o = 0; o < BENCH_OP_COUNT; ++o)
+            {
+                bench_printf("    %-24s", bench_op_names[o]);
+                for (uint32_t s = 0; s < size_ct; ++s)
+                {
+                    if (ns[c][s][o] < 0.0) bench_printf(" %10s", "-");
+                    else bench_printf(" %10.2f", ns[c][s][o]);
+                }
+                bench_println("");
+            }
+        }
+
+        gs_free(keys);
+    }
+
+    gs_free(order);
+}
+
+/*=== Pool ===*/
+
+typedef enum bench_alloc_type
+{
+    BENCH_ALLOC_MALLOC,
+    BENCH_ALLOC_POOL,
+    BENCH_ALLOC_POOL_CACHED,
+    BENCH_ALLOC_COUNT
+} bench_alloc_type;
+
+static const char* bench_alloc_names[BENCH_ALLOC_COUNT] =
+{
+    "gs_malloc",
+    "gs_pool_t",
+    "gs_pool_t (thread cache)"
+};
+
+typedef struct bench_pool_job_t
+{
+    bench_alloc_type type;
+    gs_pool_t* pool;
+    size_t block_size;
+    uint32_t ops;
+    uint64_t seed;
+    gs_thread_t thread;
+} bench_pool_job_t;
+
+gs_force_inline
+void* bench_alloc(bench_pool_job_t* job)
+{
+    return job->type == BENCH_ALLOC_MALLOC ? gs_malloc(job->block_size) : gs_pool_alloc(job->pool);
+}
+
+gs_force_inline
+void bench_release(bench_pool_job_t* job, void* p)
+{
+    if (job->type == BENCH_ALLOC_MALLOC) gs_free(p);
+    else gs_pool_release(job->pool, p);
+}
+
+// Random alloc/free churn over a fixed size working set (touches every block so it can't be optimized away)
+static void bench_pool_churn(void* user_data)
+{
+    bench_pool_job_t* job = (bench_pool_job_t*)user_data;
+    void* live[BENCH_POOL_LIVE] = {0};
+    uint64_t s = job->seed;
+
+    for (uint32_t i = 0; i < job->ops; ++i)
+    {
+        uint32_t slot = (uint32_t)(bench_rand(&s) % BENCH_POOL_LIVE);
+        if (live[slot]) {
+            bench_release(job, live[slot]);
+            live[slot] = NULL;
+        } else {
+            live[slot] = bench_alloc(job);
+            *(uint32_t*)live[slot] = i;
+        }
+    }
+
+    for (uint32_t i = 0; i < BENCH_POOL_LIVE; ++i) {
+        if (live[i]) bench_release(job, live[i]);
+    }
+    if (job->pool) gs_pool_thread_flush(job->pool);
+}
+
+// Allocates everything, then frees everything (LIFO), as when loading then unloading a level
+static double bench_pool_burst(bench_alloc_type type, size_t block_size)
+{
+    const uint32_t n = BENCH_POOL_OPS / 2;
+    void** ptrs = (void**)gs_malloc(sizeof(void*) * n);
+    bench_pool_job_t job = {.type = type, .block_size = block_size};
+    if (type != BENCH_ALLOC_MALLOC) {
+        job.pool = gs_pool_new((gs_pool_desc_t){
+            .block_size = block_size,
+            .blocks_per_chunk = 4096,
+            .thread_cache_size = type == BENCH_ALLOC_POOL_CACHED ? 64 : 0
+        });
+    }
+
+    double t0 = bench_now();
+    for (uint32_t i = 0; i < n; ++i) {
+        ptrs[i] = bench_alloc(&job);
+        *(uint32_t*)ptrs[i] = i;
+    }
+    for (uint32_t i = n; i-- > 0;) {
+        bench_release(&job, ptrs[i]);
+    }
+    double t = bench_now() - t0;
+
+    if (job.pool) gs_pool_free(job.pool);
+    gs_free(ptrs);
+    return t * 1e9 / (double)(n * 2);
+}
+
+static double bench_pool_threaded(bench_alloc_type type, size_t block_size, uint32_t thread_ct)
+{
+    bench_pool_job_t jobs[BENCH_MAX_THREADS] = {0};
+    gs_pool_t* pool = NULL;
+    if (type != BENCH_ALLOC_MALLOC) {
+        pool = gs_pool_new((gs_pool_desc_t){
+            .block_size = block_size,
+            .blocks_per_chunk = 4096,
+            .thread_cache_size = type == BENCH_ALLOC_POOL_CACHED ? 64 : 0
+        });
+    }
+
+    const uint32_t ops = BENCH_POOL_OPS / thread_ct;
+    double t0 = bench_now();
+    for (uint32_t i = 0; i < thread_ct; ++i)
+    {
+        jobs[i] = (bench_pool_job_t){.type = type, .pool = pool, .block_size = block_size, .ops = ops, .seed = 0x9E3779B97F4A7C15ull * (i + 1)};
+        jobs[i].thread = gs_thread_create(bench_pool_churn, &jobs[i]);
+    }
+    for (uint32_t i = 0; i < thread_ct; ++i) {
+        gs_thread_join(jobs[i].thread);
+    }
+    double t = bench_now() - t0;
+
+    if (pool) gs_pool_free(pool);
+
+    // Wall time per op across all threads
+    return t * 1e9 / (double)(ops * thread_ct);
+}
+
+static void bench_pool()
+{
+    const size_t sizes[] = {16, 64, 256};
+    const char* size_names[] = {"16B", "64B", "256B"};
+
+    bench_println("gs_pool_t: burst (alloc %zu, then free all), ns/op", (size_t)BENCH_POOL_OPS / 2);
+    bench_println("  %-26s %10s %10s %10s", "", "16B", "64B", "256B");
+    for (uint32_t a = 0; a < BENCH_ALLOC_COUNT; ++a)
+    {
+        bench_printf("  %-26s", bench_alloc_names[a]);
+        for (uint32_t s = 0; s < gs_array_size(sizes); ++s) {
+            double ns = bench_pool_burst((bench_alloc_type)a, sizes[s]);
+            bench_record("pool", bench_alloc_names[a], "burst", size_names[s], BENCH_POOL_OPS / 2, 1, ns);
+            bench_printf(" %10.2f", ns);
+        }
+        bench_println("");
+    }
+
+    bench_println("gs_pool_t: random churn over %zu live blocks (64B), wall ns/op", (size_t)BENCH_POOL_LIVE);
+    bench_printf("  %-26s", "threads");
+    for (uint32_t t = 1; t <= BENCH_MAX_THREADS; t *= 2) bench_printf(" %10zu", (size_t)t);
+    bench_println("");
+    for (uint32_t a = 0; a < BENCH_ALLOC_COUNT; ++a)
+    {
+        bench_printf("  %-26s", bench_alloc_names[a]);
+        for (uint32_t t = 1; t <= BENCH_MAX_THREADS; t *= 2) {
+            double ns = bench_pool_threaded((bench_alloc_type)a, 64, t);
+            bench_record("pool", bench_alloc_names[a], "churn", "64B", BENCH_POOL_OPS, t, ns);
+            bench_printf(" %10.2f", ns);
+        }
+        bench_println("");
+    }
+}
+
+/*=== Queues ===*/
+
+typedef enum bench_queue_type
+{
+    BENCH_QUEUE_LOCKED,
+    BENCH_QUEUE_MPMC,
+    BENCH_QUEUE_MPMC_BATCH,
+    BENCH_QUEUE_SPSC,
+    BENCH_QUEUE_SPSC_BATCH,
+    BENCH_QUEUE_COUNT
+} bench_queue_type;
+
+static const char* bench_queue_names[BENCH_QUEUE_COUNT] =
+{
+    "locked gs_dyn_array",
+    "gs_mpmc_queue",
+    "gs_mpmc_queue (batch)",
+    "gs_spsc_ring",
+    "gs_spsc_ring (batch)"
+};
+
+// What our threads used to do: a lock around a dyn array, consumers read from a moving front index
+typedef struct bench_locked_queue_t
+{
+    gs_spinlock_t lock;
+    gs_dyn_array(uint64_t) items;
+    uint32_t front;
+} bench_locked_queue_t;
+
+typedef struct bench_queue_t
+{
+    bench_queue_type type;
+    bench_locked_queue_t locked;
+    gs_mpmc_queue(uint64_t) mpmc;
+    gs_spsc_ring(uint64_t) spsc;
+} bench_queue_t;
+
+typedef struct bench_queue_job_t
+{
+    bench_queue_t* q;
+    uint32_t ct;            // Items to push or pop
+    bool producer;
+    uint64_t sum;           // Sum of items popped, to validate
+    gs_thread_t thread;
+} bench_queue_job_t;
+
+static uint32_t bench_queue_push(bench_queue_t* q, const uint64_t* v, uint32_t ct)
+{
+    switch (q->type)
+    {
+        case BENCH_QUEUE_LOCKED:
+        {
+            gs_spinlock_lock(&q->locked.lock);
+            uint32_t sz = gs_dyn_array_size(q->locked.items) - q->locked.front;
+            uint32_t n = gs_min(ct, BENCH_QUEUE_CAPACITY - sz);
+            for (uint32_t i = 0; i < n; ++i) gs_dyn_array_push(q->locked.items, v[i]);
+            gs_spinlock_unlock(&q->locked.lock);
+            return n;
+        }
+        case BENCH_QUEUE_MPMC:          return gs_mpmc_queue_push(q->mpmc, v) ? 1 : 0;
+        case BENCH_QUEUE_MPMC_BATCH:    return gs_mpmc_queue_push_n(q->mpmc, v, ct);
+        case BENCH_QUEUE_SPSC:          return gs_spsc_ring_push(q->spsc, *v) ? 1 : 0;
+        case BENCH_QUEUE_SPSC_BATCH:    return gs_spsc_ring_push_n(q->spsc, v, ct);
+        default:                        return 0;
+    }
+}
+
+static uint32_t bench_queue_pop(bench_queue_t* q, uint64_t* v, uint32_t ct)
+{
+    switch (q->type)
+    {
+        case BENCH_QUEUE_LOCKED:
+        {
+            gs_spinlock_lock(&q->locked.lock);
+            uint32_t sz = gs_dyn_array_size(q->locked.items) - q->locked.front;
+            uint32_t n = gs_min(ct, sz);
+            memcpy(v, q->locked.items + q->locked.front, n * sizeof(uint64_t));
+            q->locked.front += n;
+            if (q->locked.front == gs_dyn_array_size(q->locked.items)) {
+                gs_dyn_array_clear(q->locked.items);
+                q->locked.front = 0;
+            }
+            gs_spinlock_unlock(&q->locked.lock);
+            return n;
+        }
+        case BENCH_QUEUE_MPMC:          return gs_mpmc_queue_pop(q->mpmc, v) ? 1 : 0;
+        case BENCH_QUEUE_MPMC_BATCH:    return gs_mpmc_queue_pop_n(q->mpmc, v, ct);
+        case BENCH_QUEUE_SPSC:          return gs_spsc_ring_pop(q->spsc, v) ? 1 : 0;
+        case BENCH_QUEUE_SPSC_BATCH:    return gs_spsc_ring_pop_n(q->spsc, v, ct);
+        default:                        return 0;
+    }
+}
+
+// Items moved per push/pop call
+gs_force_inline
+uint32_t bench_queue_batch(bench_queue_type type)
+{
+    return (type == BENCH_QUEUE_MPMC_BATCH || type == BENCH_QUEUE_SPSC_BATCH) ? BENCH_QUEUE_BATCH : 1;
+}
+
+// Spin briefly, then give up the time slice (matters when threads outnumber cores)
+gs_force_inline
+void bench_backoff(uint32_t* fails)
+{
+    if (++(*fails) & 15) gs_cpu_relax();
+    else gs_thread_yield();
+}
+
+static void bench_queue_worker(void* user_data)
+{
+    bench_queue_job_t* job = (bench_queue_job_t*)user_data;
+    const uint32_t batch = bench_queue_batch(job->q->type);
+    uint64_t buf[BENCH_QUEUE_BATCH];
+    uint32_t done = 0, fails = 0;
+
+    while (done < job->ct)
+    {
+        uint32_t want = gs_min(batch, job->ct - done);
+        uint32_t n = 0;
+        if (job->producer) {
+            for (uint32_t i = 0; i < want; ++i) buf[i] = done + i + 1;
+            n = bench_queue_push(job->q, buf, want);
+        } else {
+            n = bench_queue_pop(job->q, buf, want);
+            for (uint32_t i = 0; i < n; ++i) job->sum += buf[i];
+        }
+        if (!n) bench_backoff(&fails);
+        done += n;
+    }
+}
+
+// Returns wall ns per item, or a negative value if the run is not applicable/invalid
+static double bench_queue_run(bench_queue_type type, uint32_t thread_ct)
+{
+    const bool spsc = type == BENCH_QUEUE_SPSC || type == BENCH_QUEUE_SPSC_BATCH;
+    if (spsc && thread_ct != 2) return -1.0;
+
+    bench_queue_t q = {.type = type};
+    gs_mpmc_queue_init(q.mpmc, BENCH_QUEUE_CAPACITY);
+    gs_spsc_ring_init(q.spsc, BENCH_QUEUE_CAPACITY);
+    gs_dyn_array_reserve(q.locked.items, BENCH_QUEUE_CAPACITY);
+
+    bench_queue_job_t jobs[BENCH_MAX_THREADS] = {0};
+    uint64_t expected = 0;
+    double t0 = bench_now();
+
+    if (thread_ct == 1)
+    {
+        // Single thread alternates between filling and draining
+        bench_queue_job_t* job = &jobs[0];
+        job->q = &q;
+        const uint32_t batch = bench_queue_batch(type);
+        uint64_t buf[BENCH_QUEUE_BATCH];
+        for (uint32_t done = 0; done < BENCH_QUEUE_ITEMS; done += batch)
+        {
+            for (uint32_t i = 0; i < batch; ++i) buf[i] = done + i + 1;
+            bench_queue_push(&q, buf, batch);
+            uint32_t n = bench_queue_pop(&q, buf, batch);
+            for (uint32_t i = 0; i < n; ++i) job->sum += buf[i];
+        }
+        expected = (uint64_t)BENCH_QUEUE_ITEMS * (BENCH_QUEUE_ITEMS + 1) / 2;
+    }
+    else
+    {
+        const uint32_t pairs = thread_ct / 2;
+        const uint32_t per = BENCH_QUEUE_ITEMS / pairs;
+        for (uint32_t i = 0; i < thread_ct; ++i)
+        {
+            jobs[i] = (bench_queue_job_t){.q = &q, .ct = per, .producer = (i & 1) == 0};
+            jobs[i].thread = gs_thread_create(bench_queue_worker, &jobs[i]);
+        }
+        for (uint32_t i = 0; i < thread_ct; ++i) {
+            gs_thread_join(jobs[i].thread);
+        }
+        expected = (uint64_t)pairs * ((uint64_t)per * (per + 1) / 2);
+    }
+
+    double t = bench_now() - t0;
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < thread_ct; ++i) sum += jobs[i].sum;
+
+    gs_mpmc_queue_free(q.mpmc);
+    gs_spsc_ring_free(q.spsc);
+    gs_dyn_array_free(q.locked.items);
+
+    if (sum != expected) {
+        bench_println("Error: %s lost or duplicated items with %zu threads", bench_queue_names[type], (size_t)thread_ct);
+        return -1.0;
+    }
+    return t * 1e9 / (double)BENCH_QUEUE_ITEMS;
+}
+
+// Zero sized batches move nothing, on a queue that's neither empty nor full too (where a wait can't end)
+static bool bench_queue_check_empty_batch()
+{
+    gs_mpmc_queue(uint64_t) mpmc = NULL;
+    gs_spsc_ring(uint64_t) spsc = NULL;
+    gs_mpmc_queue_init(mpmc, BENCH_QUEUE_CAPACITY);
+    gs_spsc_ring_init(spsc, BENCH_QUEUE_CAPACITY);
+
+    uint64_t v = 1, out = 0;
+    bool ok = gs_mpmc_queue_push(mpmc, &v) && gs_spsc_ring_push(spsc, v);
+    ok &= gs_mpmc_queue_push_n(mpmc, &v, 0) == 0 && gs_mpmc_queue_pop_n(mpmc, &out, 0) == 0;
+    ok &= gs_spsc_ring_push_n(spsc, &v, 0) == 0 && gs_spsc_ring_pop_n(spsc, &out, 0) == 0;
+    ok &= gs_mpmc_queue_pop(mpmc, &out) && out == 1;
+    ok &= gs_spsc_ring_pop(spsc, &out) && out == 1;
+
+    gs_mpmc_queue_free(mpmc);
+    gs_spsc_ring_free(spsc);
+    if (!ok) bench_println("Error: zero sized queue batches moved items");
+    return ok;
+}
+
+// Returns false if the queues misbehave, their timings are skipped then
+static bool bench_queue()
+{
+    if (!bench_queue_check_empty_batch()) return false;
+    bench_println("queues: %zu u64 items, capacity %zu, half producers/half consumers, wall ns/item",
+        (size_t)BENCH_QUEUE_ITEMS, (size_t)BENCH_QUEUE_CAPACITY);
+    bench_printf("  %-26s", "threads");
+    for (uint32_t t = 1; t <= BENCH_MAX_THREADS; t *= 2) bench_printf(" %10zu", (size_t)t);
+    bench_println("");
+    for (uint32_t q = 0; q < BENCH_QUEUE_COUNT; ++q)
+    {
+        bench_printf("  %-26s", bench_queue_names[q]);
+        for (uint32_t t = 1; t <= BENCH_MAX_THREADS; t *= 2)
+        {
+            double ns = bench_queue_run((bench_queue_type)q, t);
+            if (ns < 0.0) {
+                bench_printf(" %10s", "-");
+            } else {
+                bench_record("queue", bench_queue_names[q], "push_pop", "u64", BENCH_QUEUE_ITEMS, t, ns);
+                bench_printf(" %10.2f", ns);
+            }
+        }
+        bench_println("");
+    }
+    return true;
+}
+
+/*=== Concurrent Hash Table ===*/
+
+typedef enum bench_shared_table_type
+{
+    BENCH_SHARED_TABLE_LOCKED,
+    BENCH_SHARED_TABLE_CONCURRENT,
+    BENCH_SHARED_TABLE_COUNT
+} bench_shared_table_type;
+
+static const char* bench_shared_table_names[BENCH_SHARED_TABLE_COUNT] =
+{
+    "locked gs_hash_table",
+    "gs_hash_table_concurrent"
+};
+
+// What our name/asset tables used to do: one lock around a gs_hash_table
+typedef struct bench_shared_table_t
+{
+    bench_shared_table_type type;
+    gs_spinlock_t lock;
+    gs_hash_table(uint64_t, uint64_t) locked;
+    gs_hash_table_concurrent(uint64_t, uint64_t) concurrent;
+} bench_shared_table_t;
+
+typedef struct bench_shared_table_job_t
+{
+    bench_shared_table_t* table;
+    uint32_t ops;
+    uint64_t seed;
+    uint64_t sum;
+    gs_thread_t thread;
+} bench_shared_table_job_t;
+
+// Mostly reads, 1 in BENCH_SHARED_TABLE_WRITE_EVERY ops overwrites a value
+static void bench_shared_table_worker(void* user_data)
+{
+    bench_shared_table_job_t* job = (bench_shared_table_job_t*)user_data;
+    bench_shared_table_t* st = job->table;
+    uint64_t s = job->seed;
+
+    for (uint32_t i = 0; i < job->ops; ++i)
+    {
+        const uint64_t r = bench_rand(&s);
+        uint64_t k = bench_mix64(r % BENCH_SHARED_TABLE_KEYS);
+        uint64_t v = 0;
+        const bool write = (r >> 32) % BENCH_SHARED_TABLE_WRITE_EVERY == 0;
+
+        if (st->type == BENCH_SHARED_TABLE_LOCKED)
+        {
+            gs_spinlock_lock(&st->lock);
+            // Overwrite through getp, inserting an existing key would bump the size and grow the table
+            if (write) *gs_hash_table_getp(st->locked, k) = i;
+            else v = gs_hash_table_get(st->locked, k);
+            gs_spinlock_unlock(&st->lock);
+        }
+        else
+        {
+            if (write) {
+                v = i;
+                gs_hash_table_concurrent_insert(st->concurrent, &k, &v);
+            }
+            else gs_hash_table_concurrent_get(st->concurrent, &k, &v);
+        }
+        job->sum += v;
+    }
+}
+
+static double bench_shared_table_run(bench_shared_table_type type, uint32_t thread_ct)
+{
+    bench_shared_table_t st = {.type = type};
+    gs_hash_table_reserve(st.locked, uint64_t, uint64_t, BENCH_SHARED_TABLE_KEYS);
+    gs_hash_table_concurrent_init(st.concurrent, BENCH_SHARED_TABLE_KEYS);
+    for (uint64_t i = 0; i < BENCH_SHARED_TABLE_KEYS; ++i)
+    {
+        uint64_t k = bench_mix64(i);
+        gs_hash_table_insert(st.locked, k, i);
+        gs_hash_table_concurrent_insert(st.concurrent, &k, &i);
+    }
+
+    bench_shared_table_job_t jobs[BENCH_MAX_THREADS] = {0};
+    const uint32_t ops = BENCH_SHARED_TABLE_OPS / thread_ct;
+    double t0 = bench_now();
+    for (uint32_t i = 0; i < thread_ct; ++i)
+    {
+        jobs[i] = (bench_shared_table_job_t){.table = &st, .ops = ops, .seed = 0x9E3779B97F4A7C15ull * (i + 1)};
+        jobs[i].thread = gs_thread_create(bench_shared_table_worker, &jobs[i]);
+    }
+    for (uint32_t i = 0; i < thread_ct; ++i) {
+        gs_thread_join(jobs[i].thread);
+        bench_sink += jobs[i].sum;
+    }
+    double t = bench_now() - t0;
+
+    gs_hash_table_free(st.locked);
+    gs_hash_table_concurrent_free(st.concurrent);
+    return t * 1e9 / (double)(ops * thread_ct);
+}
+
+static void bench_shared_table()
+{
+    bench_println("shared tables: %zu u64 keys, 1 write per %zu ops, wall ns/op",
+        (size_t)BENCH_SHARED_TABLE_KEYS, (size_t)BENCH_SHARED_TABLE_WRITE_EVERY);
+    bench_printf("  %-26s", "threads");
+    for (uint32_t t = 1; t <= BENCH_MAX_THREADS; t *= 2) bench_printf(" %10zu", (size_t)t);
+    bench_println("");
+    for (uint32_t a = 0; a < BENCH_SHARED_TABLE_COUNT; ++a)
+    {
+        bench_printf("  %-26s", bench_shared_table_names[a]);
+        for (uint32_t t = 1; t <= BENCH_MAX_THREADS; t *= 2)
+        {
+            double ns = bench_shared_table_run((bench_shared_table_type)a, t);
+            bench_record("shared_table", bench_shared_table_names[a], "read_mostly", "u64", BENCH_SHARED_TABLE_OPS, t, ns);
+            bench_printf(" %10.2f", ns);
+        }
+        bench_println("");
+    }
+}
+
+/*=== Sort ===*/
+
+typedef enum bench_sort_type
+{
+    BENCH_SORT_QSORT,
+    BENCH_SORT_RADIX,
+    BENCH_SORT_RADIX_PARALLEL,
+    BENCH_SORT_COUNT
+} bench_sort_type;
+
+static const char* bench_sort_names[BENCH_SORT_COUNT] =
+{
+    "qsort",
+    "gs_radix_sort",
+    "gs_radix_sort parallel"
+};
+
+typedef enum bench_sort_key_type
+{
+    BENCH_SORT_KEY_U32,
+    BENCH_SORT_KEY_U64,
+    BENCH_SORT_KEY_F32,
+    BENCH_SORT_KEY_U64_KV,
+    BENCH_SORT_KEY_COUNT
+} bench_sort_key_type;
+
+static const char* bench_sort_key_names[BENCH_SORT_KEY_COUNT] =
+{
+    "u32",
+    "u64",
+    "f32",
+    "u64_kv"
+};
+
+// Draw call sized payload for key + payload sorts
+typedef struct bench_draw_t
+{
+    uint32_t mesh;
+    uint32_t material;
+    uint32_t first;
+    uint32_t count;
+} bench_draw_t;
+
+// qsort sorts keys and payloads together
+typedef struct bench_draw_kv_t
+{
+    uint64_t key;
+    bench_draw_t draw;
+} bench_draw_kv_t;
+
+static int32_t bench_sort_cmp_u32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int32_t bench_sort_cmp_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int32_t bench_sort_cmp_f32(const void* a, const void* b)
+{
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct bench_sort_data_t
+{
+    const uint64_t* src;
+    void* keys;             // u32/u64/f32 keys, or bench_draw_kv_t for qsort kv
+    bench_draw_t* vals;
+    void* scratch;
+    size_t scratch_size;
+} bench_sort_data_t;
+
+static double bench_sort_run(bench_sort_type type, bench_sort_key_type kt, uint32_t n, bench_sort_data_t* d)
+{
+    double best = 0.0, total = 0.0;
+    for (uint32_t r = 0; r < BENCH_MAX_REPS && (r == 0 || total < BENCH_MIN_TIME); ++r)
+    {
+        // Fresh unsorted input every rep
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const uint64_t s = d->src[i];
+            const bench_draw_t draw = {(uint32_t)s, (uint32_t)(s >> 32), i, 6};
+            switch (kt)
+            {
+                case BENCH_SORT_KEY_U32: ((uint32_t*)d->keys)[i] = (uint32_t)s; break;
+                case BENCH_SORT_KEY_U64: ((uint64_t*)d->keys)[i] = s; break;
+                case BENCH_SORT_KEY_F32: ((float*)d->keys)[i] = (float)((int64_t)(s >> 40) - (1 << 23)) * 0.01f; break;
+                default:
+                {
+                    if (type == BENCH_SORT_QSORT) {
+                        ((bench_draw_kv_t*)d->keys)[i] = (bench_draw_kv_t){.key = s, .draw = draw};
+                    } else {
+                        ((uint64_t*)d->keys)[i] = s;
+                        d->vals[i] = draw;
+                    }
+                } break;
+            }
+        }
+
+        const uint32_t thread_ct = type == BENCH_SORT_RADIX_PARALLEL ? 0 : 1;
+        double t0 = bench_now();
+        switch (kt)
+        {
+            case BENCH_SORT_KEY_U32:
+            {
+                if (type == BENCH_SORT_QSORT) qsort(d->keys, n, sizeof(uint32_t), bench_sort_cmp_u32);
+                else gs_radix_sort_func(GS_RADIX_SORT_U32, d->keys, NULL, 0, n, d->scratch, d->scratch_size, thread_ct);
+            } break;
+
+            case BENCH_SORT_KEY_U64:
+            {
+                if (type == BENCH_SORT_QSORT) qsort(d->keys, n, sizeof(uint64_t), bench_sort_cmp_u64);
+                else gs_radix_sort_func(GS_RADIX_SORT_U64, d->keys, NULL, 0, n, d->scratch, d->scratch_size, thread_ct);
+            } break;
+
+            case BENCH_SORT_KEY_F32:
+            {
+                if (type == BENCH_SORT_QSORT) qsort(d->keys, n, sizeof(float), bench_sort_cmp_f32);
+                else gs_radix_sort_func(GS_RADIX_SORT_F32, d->keys, NULL, 0, n, d->scratch, d->scratch_size, thread_ct);
+            } break;
+
+            default:
+            {
+                if (type == BENCH_SORT_QSORT) qsort(d->keys, n, sizeof(bench_draw_kv_t), bench_sort_cmp_u64);
+                else gs_radix_sort_func(GS_RADIX_SORT_U64, d->keys, d->vals, sizeof(bench_draw_t), n, d->scratch, d->scratch_size, thread_ct);
+            } break;
+        }
+        double t = bench_now() - t0;
+        total += t;
+        if (r == 0 || t < best) best = t;
+    }
+    bench_sink += ((uint8_t*)d->keys)[0];
+    return best * 1e9 / (double)n;
+}
+
+static void bench_sort(uint32_t max_n)
+{
+    const uint32_t sizes[BENCH_SIZE_COUNT] = {1000, 10000, 100000, 1000000, 10000000};
+    uint32_t size_ct = 0;
+    while (size_ct < BENCH_SIZE_COUNT && sizes[size_ct] <= max_n) ++size_ct;
+    if (!size_ct) return;
+
+    const uint32_t max_size = sizes[size_ct - 1];
+    bench_sort_data_t d = {0};
+    uint64_t* src = (uint64_t*)gs_malloc(sizeof(uint64_t) * max_size);
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (uint32_t i = 0; i < max_size; ++i) src[i] = bench_rand(&seed);
+    d.src = src;
+    d.keys = gs_malloc(sizeof(bench_draw_kv_t) * max_size);
+    d.vals = (bench_draw_t*)gs_malloc(sizeof(bench_draw_t) * max_size);
+    d.scratch_size = gs_radix_sort_scratch_size(GS_RADIX_SORT_U64, max_size, sizeof(bench_draw_t));
+    d.scratch = gs_malloc(d.scratch_size);
+
+    for (uint32_t k = 0; k < BENCH_SORT_KEY_COUNT; ++k)
+    {
+        bench_println("sort: %s keys, best ns/element", bench_sort_key_names[k]);
+        bench_printf("  %-26s", "elements");
+        for (uint32_t s = 0; s < size_ct; ++s) bench_printf(" %10zu", (size_t)sizes[s]);
+        bench_println("");
+        for (uint32_t a = 0; a < BENCH_SORT_COUNT; ++a)
+        {
+            bench_printf("  %-26s", bench_sort_names[a]);
+            for (uint32_t s = 0; s < size_ct; ++s)
+            {
+                double ns = bench_sort_run((bench_sort_type)a, (bench_sort_key_type)k, sizes[s], &d);
+                const uint32_t threads = a == BENCH_SORT_RADIX_PARALLEL ? gs_thread_hardware_concurrency() : 1;
+                bench_record("sort", bench_sort_names[a], "sort", bench_sort_key_names[k], sizes[s], threads, ns);
+                bench_printf(" %10.2f", ns);
+            }
+            bench_println("");
+        }
+    }
+
+    gs_free(src);
+    gs_free(d.keys);
+    gs_free(d.vals);
+    gs_free(d.scratch);
+}
+
+static void bench_usage()
+{
+    fprintf(stderr, "Usage: App [--suite containers|pool|queue|shared_table|sort] [--max N] [--csv FILE] [--json FILE]\n");
+}
+
+int32_t main(int32_t argc, char** argv)
+{
+    const char* suite = NULL;
+    const char* csv = NULL;
+    const char* json = NULL;
+    uint32_t max_n = 1000000;
+
+    for (int32_t i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!val) { bench_usage(); return 1; }
+        if (strcmp(arg, "--suite") == 0) suite = val;
+        else if (strcmp(arg, "--max") == 0) max_n = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--csv") == 0) csv = val;
+        else if (strcmp(arg, "--json") == 0) json = val;
+        else { bench_usage(); return 1; }
+        ++i;
+    }
+
+    // Keep stdout clean for results written there
+    const bool results_to_stdout = (csv && strcmp(csv, "-") == 0) || (json && strcmp(json, "-") == 0);
+    bench_log = results_to_stdout ? stderr : stdout;
+
+    bool ok = true;
+    bench_println("hardware threads: %zu", (size_t)gs_thread_hardware_concurrency());
+    if (!suite || strcmp(suite, "containers") == 0) bench_containers(max_n);
+    if (!suite || strcmp(suite, "pool") == 0) bench_pool();
+    if (!suite || strcmp(suite, "queue") == 0) ok &= bench_queue();
+    if (!suite || strcmp(suite, "shared_table") == 0) bench_shared_table();
+    if (!suite || strcmp(suite, "sort") == 0) bench_sort(max_n);
+
+    if (csv) ok &= bench_write_results(csv, false);
+    if (json) ok &= bench_write_results(json, true);
+    gs_dyn_array_free(bench_results);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,447 @@
+#ifndef GS_ALLOCATOR_H
+#define GS_ALLOCATOR_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger allocator implementation like this:
+
+        #define GS_ALLOCATOR_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ALLOCATOR_IMPL
+        #include "gs_allocator.h"
+
+    All other files should just #include "gs_allocator.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_ALLOCATOR_IMPL
+        #include "gs_allocator.h"
+
+    Include this BEFORE gs_hash_table_simd.h to be able to bind simd hash tables to an allocator.
+
+    ================================================================================================================
+*/
+
+/*
+    Allocators that containers can be bound to instead of going through gs_malloc/gs_realloc/gs_free:
+
+        * gs_allocator_t:        common interface (alloc/realloc/free function pointers) plus usage stats
+        * gs_arena_t:            linear allocator, freed all at once with gs_arena_reset()
+        * gs_frame_allocator_t:  two arenas flipped by gs_frame_allocator_begin(), so memory allocated during
+                                 one frame stays valid through the next one
+
+    Containers bound to an allocator do all their growing and freeing through it:
+
+        gs_dyn_array_bound(uint32_t) arr = {0};
+        gs_dyn_array_init_with_allocator(arr, gs_frame_allocator_current(&fa), 64);
+        gs_dyn_array_push_bound(arr, 1);
+        for (uint32_t i = 0; i < gs_dyn_array_size_bound(arr); ++i) {
+            uint32_t v = arr.data[i];
+        }
+        gs_dyn_array_free_bound(arr);       // Optional for arenas, memory is reclaimed on reset anyway
+
+    Bound arrays are their own (struct) type, so only the *_bound calls take them. Passing one to a plain
+    gs_dyn_array call doesn't compile, rather than handing allocator memory to gs_realloc/gs_free. Growing an
+    array that was never bound with gs_dyn_array_init_with_allocator() is an error.
+
+    Moving an existing gs_dyn_array (say, per-frame scratch built in update()) onto an allocator means changing
+    its declaration and every use:
+
+        gs_dyn_array(T) arr = NULL;         ->  gs_dyn_array_bound(T) arr = {0};
+                                                gs_dyn_array_init_with_allocator(arr, allocator, capacity);
+        arr[i]                              ->  arr.data[i]
+        gs_dyn_array_size(arr)              ->  gs_dyn_array_size_bound(arr)
+        gs_dyn_array_capacity(arr)          ->  gs_dyn_array_capacity_bound(arr)
+        gs_dyn_array_reserve(arr, n)        ->  gs_dyn_array_reserve_bound(arr, n)
+        gs_dyn_array_push(arr, v)           ->  gs_dyn_array_push_bound(arr, v)
+        gs_dyn_array_pop(arr)               ->  gs_dyn_array_pop_bound(arr)
+        gs_dyn_array_clear(arr)             ->  gs_dyn_array_clear_bound(arr)
+        gs_dyn_array_free(arr)              ->  gs_dyn_array_free_bound(arr)
+
+    There's no bound gs_dyn_array_back(), use arr.data[gs_dyn_array_size_bound(arr) - 1]. Functions taking a T*
+    and a count get arr.data and gs_dyn_array_size_bound(arr).
+
+    Only simd hash tables can be bound, with gs_hash_table_simd_init_with_allocator() (see gs_hash_table_simd.h).
+    The stock gs_hash_table always goes through gs_malloc/gs_realloc/gs_free; switch a table to gs_hash_table_simd
+    to put it on an allocator.
+
+    Each allocator tracks its bytes in use and their high water mark, which is what arenas should be sized to.
+    A NULL allocator everywhere means the default heap (gs_malloc and friends), which isn't tracked.
+*/
+
+/*==== Interface ====*/
+
+#ifndef GS_ARENA_ALIGNMENT
+    #define GS_ARENA_ALIGNMENT              16
+#endif
+
+#define GS_ARENA_DEFAULT_BLOCK_SIZE         (64 * 1024)
+
+typedef struct gs_allocator_stats_t
+{
+    size_t in_use;          // Bytes currently handed out (including alignment padding)
+    size_t high_water;      // Largest in_use seen
+    size_t reserved;        // Bytes currently reserved from the heap
+    uint32_t alloc_ct;      // Total allocations (a realloc that moves counts as one)
+    uint32_t free_ct;       // Total frees
+    uint32_t reset_ct;      // Total resets (arenas only)
+} gs_allocator_stats_t;
+
+typedef struct gs_allocator_t
+{
+    void* (* alloc_func)(struct gs_allocator_t* allocator, size_t sz);
+    void* (* realloc_func)(struct gs_allocator_t* allocator, void* ptr, size_t old_sz, size_t new_sz);
+    void  (* free_func)(struct gs_allocator_t* allocator, void* ptr, size_t sz);
+    gs_allocator_stats_t stats;
+} gs_allocator_t;
+
+gs_force_inline
+void* gs_allocator_malloc(gs_allocator_t* allocator, size_t sz)
+{
+    return allocator ? allocator->alloc_func(allocator, sz) : gs_malloc(sz);
+}
+
+gs_force_inline
+void* gs_allocator_realloc(gs_allocator_t* allocator, void* ptr, size_t old_sz, size_t new_sz)
+{
+    return allocator ? allocator->realloc_func(allocator, ptr, old_sz, new_sz) : gs_realloc(ptr, new_sz);
+}
+
+gs_force_inline
+void gs_allocator_free(gs_allocator_t* allocator, void* ptr, size_t sz)
+{
+    if (!ptr) return;
+    if (allocator) allocator->free_func(allocator, ptr, sz);
+    else gs_free(ptr);
+}
+
+#define gs_allocator_stats(__A)\
+    ((__A)->stats)
+
+// Restart high water tracking from current usage (ie. to measure a single level/scene)
+#define gs_allocator_stats_reset_high_water(__A)\
+    do {\
+        (__A)->stats.high_water = (__A)->stats.in_use;\
+    } while (0)
+
+/*=== Arena ===*/
+
+typedef struct gs_arena_block_t
+{
+    struct gs_arena_block_t* prev;
+    size_t capacity;                // Usable bytes following the (aligned) block header
+} gs_arena_block_t;
+
+typedef struct gs_arena_t
+{
+    gs_allocator_t allocator;       // Must be first, bind containers to &arena->allocator
+    gs_arena_block_t* block;        // Current block, older blocks are chained through prev
+    size_t offset;                  // Write offset into current block
+    size_t block_size;              // Minimum size of new blocks
+    void* last;                     // Most recent allocation, which can grow or be freed in place
+} gs_arena_t;
+
+GS_API_DECL gs_arena_t
+gs_arena_new(size_t block_size);
+
+// Releases everything allocated from the arena. If it had to chain blocks, they are merged into one big enough for the high water mark.
+GS_API_DECL void
+gs_arena_reset(gs_arena_t* arena);
+
+GS_API_DECL void
+gs_arena_free(gs_arena_t* arena);
+
+#define gs_arena_alloc(__ARENA, __SZ)\
+    gs_allocator_malloc(&(__ARENA)->allocator, (__SZ))
+
+/*=== Frame Allocator ===*/
+
+typedef struct gs_frame_allocator_t
+{
+    gs_arena_t arenas[2];
+    uint32_t frame;
+} gs_frame_allocator_t;
+
+GS_API_DECL gs_frame_allocator_t
+gs_frame_allocator_new(size_t block_size);
+
+// Call once at the start of every frame. Resets the arena that was used two frames ago and makes it current.
+GS_API_DECL void
+gs_frame_allocator_begin(gs_frame_allocator_t* fa);
+
+GS_API_DECL void
+gs_frame_allocator_free(gs_frame_allocator_t* fa);
+
+// Combined stats of both arenas (high water is per frame, ie. the largest of the two)
+GS_API_DECL gs_allocator_stats_t
+gs_frame_allocator_stats(const gs_frame_allocator_t* fa);
+
+#define gs_frame_allocator_current(__FA)\
+    (&(__FA)->arenas[(__FA)->frame & 1].allocator)
+
+/*=== Allocator Bound Dynamic Array ===*/
+
+#define gs_dyn_array_bound(__T)\
+    struct {\
+        __T* data;\
+        uint32_t size;\
+        uint32_t capacity;\
+        gs_allocator_t* allocator;  /* NULL for the default heap */\
+        bool bound;                 /* Set by gs_dyn_array_init_with_allocator() */\
+    }
+
+GS_API_DECL void
+gs_dyn_array_bound_grow_func(void** data, gs_allocator_t* allocator, bool bound, uint32_t* capacity, uint32_t new_capacity, size_t val_len);
+
+#define gs_dyn_array_init_with_allocator(__A, __ALLOC, __CAP)\
+    do {\
+        gs_assert(!(__A).bound);\
+        (__A).data = NULL;\
+        (__A).size = 0;\
+        (__A).capacity = 0;\
+        (__A).allocator = (__ALLOC);\
+        (__A).bound = true;\
+        gs_dyn_array_reserve_bound((__A), (__CAP));\
+    } while (0)
+
+#define gs_dyn_array_allocator(__A)\
+    ((__A).allocator)
+
+#define gs_dyn_array_size_bound(__A)\
+    ((__A).size)
+
+#define gs_dyn_array_capacity_bound(__A)\
+    ((__A).capacity)
+
+#define gs_dyn_array_reserve_bound(__A, __CT)\
+    do {\
+        if ((uint32_t)(__CT) > (__A).capacity) {\
+            gs_dyn_array_bound_grow_func((void**)&(__A).data, (__A).allocator, (__A).bound, &(__A).capacity, (uint32_t)(__CT), sizeof(*(__A).data));\
+        }\
+    } while (0)
+
+#define gs_dyn_array_push_bound(__A, __V)\
+    do {\
+        if ((__A).size == (__A).capacity) {\
+            gs_dyn_array_bound_grow_func((void**)&(__A).data, (__A).allocator, (__A).bound, &(__A).capacity,\
+                (__A).capacity ? (__A).capacity * 2 : 4, sizeof(*(__A).data));\
+        }\
+        (__A).data[(__A).size++] = (__V);\
+    } while (0)
+
+#define gs_dyn_array_pop_bound(__A)\
+    do {\
+        if ((__A).size) (__A).size--;\
+    } while (0)
+
+#define gs_dyn_array_clear_bound(__A)\
+    do {\
+        (__A).size = 0;\
+    } while (0)
+
+// Leaves the array unbound, init it again to reuse it
+#define gs_dyn_array_free_bound(__A)\
+    do {\
+        gs_allocator_free((__A).allocator, (__A).data, (size_t)(__A).capacity * sizeof(*(__A).data));\
+        (__A).data = NULL;\
+        (__A).size = 0;\
+        (__A).capacity = 0;\
+        (__A).bound = false;\
+    } while (0)
+
+/*==== Implementation ====*/
+
+#ifdef GS_ALLOCATOR_IMPL
+
+#define __gs_arena_align(__SZ)\
+    (((size_t)(__SZ) + (GS_ARENA_ALIGNMENT - 1)) & ~((size_t)GS_ARENA_ALIGNMENT - 1))
+
+#define __gs_arena_block_data(__B)\
+    ((uint8_t*)(__B) + __gs_arena_align(sizeof(gs_arena_block_t)))
+
+static void
+__gs_arena_push_block(gs_arena_t* arena, size_t capacity)
+{
+    gs_arena_block_t* b = (gs_arena_block_t*)gs_malloc(__gs_arena_align(sizeof(gs_arena_block_t)) + capacity);
+    b->prev = arena->block;
+    b->capacity = capacity;
+    arena->block = b;
+    arena->offset = 0;
+    arena->last = NULL;
+    arena->allocator.stats.reserved += capacity;
+}
+
+static void*
+__gs_arena_alloc_func(gs_allocator_t* allocator, size_t sz)
+{
+    gs_arena_t* arena = (gs_arena_t*)allocator;
+    sz = __gs_arena_align(sz ? sz : 1);
+
+    // Spill into a new block (the rest of the current one is wasted until reset)
+    if (!arena->block || arena->offset + sz > arena->block->capacity) {
+        __gs_arena_push_block(arena, gs_max(arena->block_size, sz));
+    }
+
+    void* ptr = __gs_arena_block_data(arena->block) + arena->offset;
+    arena->offset += sz;
+    arena->last = ptr;
+
+    gs_allocator_stats_t* st = &allocator->stats;
+    st->in_use += sz;
+    st->high_water = gs_max(st->high_water, st->in_use);
+    st->alloc_ct++;
+    return ptr;
+}
+
+static void
+__gs_arena_free_func(gs_allocator_t* allocator, void* ptr, size_t sz)
+{
+    gs_arena_t* arena = (gs_arena_t*)allocator;
+    allocator->stats.free_ct++;
+
+    // Only the most recent allocation can be given back, everything else waits for reset
+    if (ptr && ptr == arena->last)
+    {
+        size_t off = (size_t)((uint8_t*)ptr - __gs_arena_block_data(arena->block));
+        allocator->stats.in_use -= arena->offset - off;
+        arena->offset = off;
+        arena->last = NULL;
+    }
+}
+
+static void*
+__gs_arena_realloc_func(gs_allocator_t* allocator, void* ptr, size_t old_sz, size_t new_sz)
+{
+    gs_arena_t* arena = (gs_arena_t*)allocator;
+    if (!ptr) return __gs_arena_alloc_func(allocator, new_sz);
+
+    // Most recent allocation grows/shrinks in place if the block has room
+    if (ptr == arena->last)
+    {
+        size_t off = (size_t)((uint8_t*)ptr - __gs_arena_block_data(arena->block));
+        size_t end = off + __gs_arena_align(new_sz ? new_sz : 1);
+        if (end <= arena->block->capacity)
+        {
+            gs_allocator_stats_t* st = &allocator->stats;
+            st->in_use = st->in_use - arena->offset + end;
+            st->high_water = gs_max(st->high_water, st->in_use);
+            arena->offset = end;
+            return ptr;
+        }
+    }
+
+    void* np = __gs_arena_alloc_func(allocator, new_sz);
+    memcpy(np, ptr, gs_min(old_sz, new_sz));
+    return np;
+}
+
+GS_API_DECL gs_arena_t
+gs_arena_new(size_t block_size)
+{
+    gs_arena_t arena = gs_default_val();
+    arena.allocator.alloc_func = __gs_arena_alloc_func;
+    arena.allocator.realloc_func = __gs_arena_realloc_func;
+    arena.allocator.free_func = __gs_arena_free_func;
+    arena.block_size = block_size ? __gs_arena_align(block_size) : GS_ARENA_DEFAULT_BLOCK_SIZE;
+    return arena;
+}
+
+GS_API_DECL void
+gs_arena_reset(gs_arena_t* arena)
+{
+    gs_allocator_stats_t* st = &arena->allocator.stats;
+
+    // Merge chained blocks into a single one that fits the high water mark
+    if (arena->block && arena->block->prev)
+    {
+        while (arena->block) {
+            gs_arena_block_t* prev = arena->block->prev;
+            gs_free(arena->block);
+            arena->block = prev;
+        }
+        st->reserved = 0;
+        arena->block_size = gs_max(arena->block_size, __gs_arena_align(st->high_water));
+        __gs_arena_push_block(arena, arena->block_size);
+    }
+
+    arena->offset = 0;
+    arena->last = NULL;
+    st->in_use = 0;
+    st->reset_ct++;
+}
+
+GS_API_DECL void
+gs_arena_free(gs_arena_t* arena)
+{
+    while (arena->block) {
+        gs_arena_block_t* prev = arena->block->prev;
+        gs_free(arena->block);
+        arena->block = prev;
+    }
+    arena->offset = 0;
+    arena->last = NULL;
+    arena->allocator.stats.in_use = 0;
+    arena->allocator.stats.reserved = 0;
+}
+
+GS_API_DECL gs_frame_allocator_t
+gs_frame_allocator_new(size_t block_size)
+{
+    gs_frame_allocator_t fa = gs_default_val();
+    fa.arenas[0] = gs_arena_new(block_size);
+    fa.arenas[1] = gs_arena_new(block_size);
+    return fa;
+}
+
+GS_API_DECL void
+gs_frame_allocator_begin(gs_frame_allocator_t* fa)
+{
+    fa->frame++;
+    gs_arena_reset(&fa->arenas[fa->frame & 1]);
+}
+
+GS_API_DECL void
+gs_frame_allocator_free(gs_frame_allocator_t* fa)
+{
+    gs_arena_free(&fa->arenas[0]);
+    gs_arena_free(&fa->arenas[1]);
+}
+
+GS_API_DECL gs_allocator_stats_t
+gs_frame_allocator_stats(const gs_frame_allocator_t* fa)
+{
+    const gs_allocator_stats_t* a = &fa->arenas[0].allocator.stats;
+    const gs_allocator_stats_t* b = &fa->arenas[1].allocator.stats;
+    gs_allocator_stats_t st = gs_default_val();
+    st.in_use = a->in_use + b->in_use;
+    st.high_water = gs_max(a->high_water, b->high_water);
+    st.reserved = a->reserved + b->reserved;
+    st.alloc_ct = a->alloc_ct + b->alloc_ct;
+    st.free_ct = a->free_ct + b->free_ct;
+    st.reset_ct = a->reset_ct + b->reset_ct;
+    return st;
+}
+
+GS_API_DECL void
+gs_dyn_array_bound_grow_func(void** data, gs_allocator_t* allocator, bool bound, uint32_t* capacity, uint32_t new_capacity, size_t val_len)
+{
+    if (!bound) {
+        gs_println("Error: gs_dyn_array_push_bound/reserve_bound: array was never bound, call gs_dyn_array_init_with_allocator() first");
+        gs_assert(false);
+        return;
+    }
+    *data = gs_allocator_realloc(allocator, *data, (size_t)*capacity * val_len, (size_t)new_capacity * val_len);
+    *capacity = new_capacity;
+}
+
+#endif // GS_ALLOCATOR_IMPL
+#endif // GS_ALLOCATOR_H
@@ -0,0 +1,397 @@
+#ifndef GS_BYTE_BUFFER_CODEC_H
+#define GS_BYTE_BUFFER_CODEC_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger byte buffer codec implementation like this:
+
+        #define GS_BYTE_BUFFER_CODEC_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_BYTE_BUFFER_CODEC_IMPL
+        #include "gs_byte_buffer_codec.h"
+
+    All other files should just #include "gs_byte_buffer_codec.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_BYTE_BUFFER_CODEC_IMPL
+        #include "gs_byte_buffer_codec.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Compact integer encodings for gs_byte_buffer_t:
+
+        * varint:     LEB128, 7 bits per byte, high bit set on every byte but the last
+        * zigzag:     maps signed to unsigned (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...) so small magnitudes stay small as varints
+        * delta:      sorted u32 streams stored as varint gaps between consecutive values
+        * bitpacked:  n values of a fixed bit width (1-32), packed little endian into ceil(n * bits / 8) bytes
+
+    Bulk readers decode whole arrays at once. Runs of single byte varints are decoded 16 at a time with SSE2/NEON,
+    delta streams are prefix summed 4 lanes at a time, and bitpacked values are extracted from 64 bit windows.
+    Readers never read past the buffer's size.
+*/
+
+/*==== Interface ====*/
+
+#if (defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define GS_BYTE_BUFFER_CODEC_SSE2
+#elif (defined __ARM_NEON && defined __aarch64__)
+    #include <arm_neon.h>
+    #define GS_BYTE_BUFFER_CODEC_NEON
+#endif
+
+#define GS_BYTE_BUFFER_VARINT_MAX_BYTES_32   5
+#define GS_BYTE_BUFFER_VARINT_MAX_BYTES_64   10
+
+gs_force_inline
+uint32_t gs_zigzag_encode32(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+gs_force_inline
+int32_t gs_zigzag_decode32(uint32_t v)
+{
+    return (int32_t)((v >> 1) ^ (~(v & 1) + 1));
+}
+
+gs_force_inline
+uint64_t gs_zigzag_encode64(int64_t v)
+{
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+gs_force_inline
+int64_t gs_zigzag_decode64(uint64_t v)
+{
+    return (int64_t)((v >> 1) ^ (~(v & 1) + 1));
+}
+
+// Single values
+GS_API_DECL void     gs_byte_buffer_write_varint_u64(gs_byte_buffer_t* buffer, uint64_t v);
+GS_API_DECL uint64_t gs_byte_buffer_read_varint_u64(gs_byte_buffer_t* buffer);
+
+#define gs_byte_buffer_write_varint_u32(__BB, __V)  gs_byte_buffer_write_varint_u64((__BB), (uint64_t)(uint32_t)(__V))
+#define gs_byte_buffer_read_varint_u32(__BB)        ((uint32_t)gs_byte_buffer_read_varint_u64((__BB)))
+#define gs_byte_buffer_write_varint_i32(__BB, __V)  gs_byte_buffer_write_varint_u64((__BB), (uint64_t)gs_zigzag_encode32((int32_t)(__V)))
+#define gs_byte_buffer_read_varint_i32(__BB)        (gs_zigzag_decode32((uint32_t)gs_byte_buffer_read_varint_u64((__BB))))
+#define gs_byte_buffer_write_varint_i64(__BB, __V)  gs_byte_buffer_write_varint_u64((__BB), gs_zigzag_encode64((int64_t)(__V)))
+#define gs_byte_buffer_read_varint_i64(__BB)        (gs_zigzag_decode64(gs_byte_buffer_read_varint_u64((__BB))))
+
+// Arrays (readers return number of values decoded, which is less than ct only if buffer runs out)
+GS_API_DECL void     gs_byte_buffer_write_varint_u32_array(gs_byte_buffer_t* buffer, const uint32_t* v, uint32_t ct);
+GS_API_DECL uint32_t gs_byte_buffer_read_varint_u32_array(gs_byte_buffer_t* buffer, uint32_t* out, uint32_t ct);
+GS_API_DECL void     gs_byte_buffer_write_varint_i32_array(gs_byte_buffer_t* buffer, const int32_t* v, uint32_t ct);
+GS_API_DECL uint32_t gs_byte_buffer_read_varint_i32_array(gs_byte_buffer_t* buffer, int32_t* out, uint32_t ct);
+GS_API_DECL void     gs_byte_buffer_write_delta_u32(gs_byte_buffer_t* buffer, const uint32_t* sorted, uint32_t ct);
+GS_API_DECL uint32_t gs_byte_buffer_read_delta_u32(gs_byte_buffer_t* buffer, uint32_t* out, uint32_t ct);
+GS_API_DECL void     gs_byte_buffer_write_bitpacked_u32(gs_byte_buffer_t* buffer, const uint32_t* v, uint32_t ct, uint32_t bits);
+GS_API_DECL uint32_t gs_byte_buffer_read_bitpacked_u32(gs_byte_buffer_t* buffer, uint32_t* out, uint32_t ct, uint32_t bits);
+
+// Smallest bit width that can hold every value in v (for bitpacking)
+GS_API_DECL uint32_t gs_bitpack_width_u32(const uint32_t* v, uint32_t ct);
+
+/*==== Implementation ====*/
+
+#ifdef GS_BYTE_BUFFER_CODEC_IMPL
+
+// Make room for sz more bytes at the write position
+gs_force_inline
+void __gs_byte_buffer_codec_reserve(gs_byte_buffer_t* buffer, size_t sz)
+{
+    size_t tws = (size_t)buffer->position + sz;
+    if (tws >= (size_t)buffer->capacity)
+    {
+        size_t cap = buffer->capacity ? (size_t)buffer->capacity * 2 : 64;
+        while (cap <= tws) cap *= 2;
+        gs_byte_buffer_resize(buffer, cap);
+    }
+}
+
+gs_force_inline
+void __gs_byte_buffer_codec_commit(gs_byte_buffer_t* buffer, size_t sz)
+{
+    buffer->position += (uint32_t)sz;
+    buffer->size += (uint32_t)sz;
+}
+
+gs_force_inline
+uint32_t __gs_varint_encode(uint8_t* dst, uint64_t v)
+{
+    uint32_t n = 0;
+    while (v >= 0x80) {
+        dst[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    dst[n++] = (uint8_t)v;
+    return n;
+}
+
+// Decodes one varint from [*p, end). Returns 0 and leaves *p at end if truncated.
+gs_force_inline
+uint64_t __gs_varint_decode(const uint8_t** p, const uint8_t* end)
+{
+    const uint8_t* s = *p;
+    uint64_t v = 0;
+    for (uint32_t shift = 0; s < end && shift < 64; shift += 7)
+    {
+        uint8_t b = *s++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *p = s;
+            return v;
+        }
+    }
+    *p = end;
+    return 0;
+}
+
+// Mask of bytes in [p, p + 16) that have continuation bit set (requires 16 readable bytes)
+gs_force_inline
+uint32_t __gs_varint_cont_mask16(const uint8_t* p)
+{
+#if (defined GS_BYTE_BUFFER_CODEC_SSE2)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p));
+#elif (defined GS_BYTE_BUFFER_CODEC_NEON)
+    return vmaxvq_u8(vld1q_u8(p)) >= 0x80 ? 1u : 0u;
+#else
+    uint64_t a, b;
+    memcpy(&a, p, 8);
+    memcpy(&b, p + 8, 8);
+    return ((a | b) & 0x8080808080808080ull) ? 1u : 0u;
+#endif
+}
+
+// Zero extends 16 single byte varints into 16 u32's
+gs_force_inline
+void __gs_varint_widen16(const uint8_t* p, uint32_t* out)
+{
+#if (defined GS_BYTE_BUFFER_CODEC_SSE2)
+    const __m128i z = _mm_setzero_si128();
+    __m128i b = _mm_loadu_si128((const __m128i*)p);
+    __m128i lo = _mm_unpacklo_epi8(b, z);
+    __m128i hi = _mm_unpackhi_epi8(b, z);
+    _mm_storeu_si128((__m128i*)(out + 0), _mm_unpacklo_epi16(lo, z));
+    _mm_storeu_si128((__m128i*)(out + 4), _mm_unpackhi_epi16(lo, z));
+    _mm_storeu_si128((__m128i*)(out + 8), _mm_unpacklo_epi16(hi, z));
+    _mm_storeu_si128((__m128i*)(out + 12), _mm_unpackhi_epi16(hi, z));
+#elif (defined GS_BYTE_BUFFER_CODEC_NEON)
+    uint8x16_t b = vld1q_u8(p);
+    uint16x8_t lo = vmovl_u8(vget_low_u8(b));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(b));
+    vst1q_u32(out + 0, vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32(out + 4, vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32(out + 8, vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32(out + 12, vmovl_u16(vget_high_u16(hi)));
+#else
+    for (uint32_t i = 0; i < 16; ++i) out[i] = p[i];
+#endif
+}
+
+GS_API_DECL void
+gs_byte_buffer_write_varint_u64(gs_byte_buffer_t* buffer, uint64_t v)
+{
+    __gs_byte_buffer_codec_reserve(buffer, GS_BYTE_BUFFER_VARINT_MAX_BYTES_64);
+    __gs_byte_buffer_codec_commit(buffer, __gs_varint_encode(buffer->data + buffer->position, v));
+}
+
+GS_API_DECL uint64_t
+gs_byte_buffer_read_varint_u64(gs_byte_buffer_t* buffer)
+{
+    const uint8_t* p = buffer->data + buffer->position;
+    uint64_t v = __gs_varint_decode(&p, buffer->data + buffer->size);
+    buffer->position = (uint32_t)(p - buffer->data);
+    return v;
+}
+
+GS_API_DECL void
+gs_byte_buffer_write_varint_u32_array(gs_byte_buffer_t* buffer, const uint32_t* v, uint32_t ct)
+{
+    __gs_byte_buffer_codec_reserve(buffer, (size_t)ct * GS_BYTE_BUFFER_VARINT_MAX_BYTES_32);
+    uint8_t* dst = buffer->data + buffer->position;
+    size_t n = 0;
+    for (uint32_t i = 0; i < ct; ++i) {
+        n += __gs_varint_encode(dst + n, v[i]);
+    }
+    __gs_byte_buffer_codec_commit(buffer, n);
+}
+
+GS_API_DECL uint32_t
+gs_byte_buffer_read_varint_u32_array(gs_byte_buffer_t* buffer, uint32_t* out, uint32_t ct)
+{
+    const uint8_t* p = buffer->data + buffer->position;
+    const uint8_t* end = buffer->data + buffer->size;
+    uint32_t i = 0;
+    while (i < ct && p < end)
+    {
+        // Fast path: next 16 bytes are all single byte varints
+        if (ct - i >= 16 && end - p >= 16 && !__gs_varint_cont_mask16(p)) {
+            __gs_varint_widen16(p, out + i);
+            p += 16;
+            i += 16;
+            continue;
+        }
+        out[i++] = (uint32_t)__gs_varint_decode(&p, end);
+    }
+    buffer->position = (uint32_t)(p - buffer->data);
+    return i;
+}
+
+GS_API_DECL void
+gs_byte_buffer_write_varint_i32_array(gs_byte_buffer_t* buffer, const int32_t* v, uint32_t ct)
+{
+    __gs_byte_buffer_codec_reserve(buffer, (size_t)ct * GS_BYTE_BUFFER_VARINT_MAX_BYTES_32);
+    uint8_t* dst = buffer->data + buffer->position;
+    size_t n = 0;
+    for (uint32_t i = 0; i < ct; ++i) {
+        n += __gs_varint_encode(dst + n, gs_zigzag_encode32(v[i]));
+    }
+    __gs_byte_buffer_codec_commit(buffer, n);
+}
+
+GS_API_DECL uint32_t
+gs_byte_buffer_read_varint_i32_array(gs_byte_buffer_t* buffer, int32_t* out, uint32_t ct)
+{
+    uint32_t n = gs_byte_buffer_read_varint_u32_array(buffer, (uint32_t*)out, ct);
+    for (uint32_t i = 0; i < n; ++i) {
+        out[i] = gs_zigzag_decode32((uint32_t)out[i]);
+    }
+    return n;
+}
+
+GS_API_DECL void
+gs_byte_buffer_write_delta_u32(gs_byte_buffer_t* buffer, const uint32_t* sorted, uint32_t ct)
+{
+    __gs_byte_buffer_codec_reserve(buffer, (size_t)ct * GS_BYTE_BUFFER_VARINT_MAX_BYTES_32);
+    uint8_t* dst = buffer->data + buffer->position;
+    size_t n = 0;
+    uint32_t prev = 0;
+    for (uint32_t i = 0; i < ct; ++i) {
+        gs_assert(sorted[i] >= prev);
+        n += __gs_varint_encode(dst + n, sorted[i] - prev);
+        prev = sorted[i];
+    }
+    __gs_byte_buffer_codec_commit(buffer, n);
+}
+
+GS_API_DECL uint32_t
+gs_byte_buffer_read_delta_u32(gs_byte_buffer_t* buffer, uint32_t* out, uint32_t ct)
+{
+    uint32_t n = gs_byte_buffer_read_varint_u32_array(buffer, out, ct);
+
+    // Inclusive prefix sum over gaps
+    uint32_t i = 0;
+#if (defined GS_BYTE_BUFFER_CODEC_SSE2)
+    __m128i carry = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(out + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128((__m128i*)(out + i), x);
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#elif (defined GS_BYTE_BUFFER_CODEC_NEON)
+    const uint32x4_t z = vdupq_n_u32(0);
+    uint32x4_t carry = z;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t x = vld1q_u32(out + i);
+        x = vaddq_u32(x, vextq_u32(z, x, 3));
+        x = vaddq_u32(x, vextq_u32(z, x, 2));
+        x = vaddq_u32(x, carry);
+        vst1q_u32(out + i, x);
+        carry = vdupq_n_u32(vgetq_lane_u32(x, 3));
+    }
+#endif
+    uint32_t acc = i ? out[i - 1] : 0;
+    for (; i < n; ++i) {
+        acc += out[i];
+        out[i] = acc;
+    }
+    return n;
+}
+
+GS_API_DECL uint32_t
+gs_bitpack_width_u32(const uint32_t* v, uint32_t ct)
+{
+    uint32_t m = 0;
+    for (uint32_t i = 0; i < ct; ++i) m |= v[i];
+    uint32_t bits = 1;
+    while (bits < 32 && (m >> bits)) ++bits;
+    return bits;
+}
+
+GS_API_DECL void
+gs_byte_buffer_write_bitpacked_u32(gs_byte_buffer_t* buffer, const uint32_t* v, uint32_t ct, uint32_t bits)
+{
+    gs_assert(bits >= 1 && bits <= 32);
+    const size_t nbytes = ((size_t)ct * bits + 7) / 8;
+    __gs_byte_buffer_codec_reserve(buffer, nbytes);
+    uint8_t* dst = buffer->data + buffer->position;
+    const uint64_t mask = bits == 32 ? 0xFFFFFFFFull : ((1ull << bits) - 1);
+
+    // Accumulate into 64 bit window, flush whole bytes
+    uint64_t acc = 0;
+    uint32_t acc_bits = 0;
+    size_t n = 0;
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        acc |= ((uint64_t)v[i] & mask) << acc_bits;
+        acc_bits += bits;
+        while (acc_bits >= 8) {
+            dst[n++] = (uint8_t)acc;
+            acc >>= 8;
+            acc_bits -= 8;
+        }
+    }
+    if (acc_bits) dst[n++] = (uint8_t)acc;
+    __gs_byte_buffer_codec_commit(buffer, n);
+}
+
+GS_API_DECL uint32_t
+gs_byte_buffer_read_bitpacked_u32(gs_byte_buffer_t* buffer, uint32_t* out, uint32_t ct, uint32_t bits)
+{
+    gs_assert(bits >= 1 && bits <= 32);
+    const uint8_t* src = buffer->data + buffer->position;
+    const size_t avail = buffer->size > buffer->position ? buffer->size - buffer->position : 0;
+    const uint32_t n = (uint32_t)gs_min((size_t)ct, (avail * 8) / bits);
+    const uint64_t mask = bits == 32 ? 0xFFFFFFFFull : ((1ull << bits) - 1);
+
+    // Each value lies within the 8 bytes at its starting byte (bit offset <= 7, bits <= 32)
+    uint32_t i = 0;
+    size_t bitpos = 0;
+    for (; i < n && (bitpos >> 3) + 8 <= avail; ++i, bitpos += bits)
+    {
+        uint64_t w;
+        memcpy(&w, src + (bitpos >> 3), 8);
+        out[i] = (uint32_t)((w >> (bitpos & 7)) & mask);
+    }
+
+    // Tail, near end of buffer
+    for (; i < n; ++i, bitpos += bits)
+    {
+        uint64_t w = 0;
+        memcpy(&w, src + (bitpos >> 3), gs_min((size_t)8, avail - (bitpos >> 3)));
+        out[i] = (uint32_t)((w >> (bitpos & 7)) & mask);
+    }
+
+    buffer->position += (uint32_t)(((size_t)n * bits + 7) / 8);
+    return n;
+}
+
+#endif // GS_BYTE_BUFFER_CODEC_IMPL
+#endif // GS_BYTE_BUFFER_CODEC_H
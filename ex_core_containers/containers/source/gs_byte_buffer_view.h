@@ -0,0 +1,181 @@
+#ifndef GS_BYTE_BUFFER_VIEW_H
+#define GS_BYTE_BUFFER_VIEW_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger byte buffer view implementation like this:
+
+        #define GS_BYTE_BUFFER_VIEW_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_BYTE_BUFFER_VIEW_IMPL
+        #include "gs_byte_buffer_view.h"
+
+    All other files should just #include "gs_byte_buffer_view.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_BYTE_BUFFER_VIEW_IMPL
+        #include "gs_byte_buffer_view.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Read-only, zero-copy gs_byte_buffer_t modes:
+
+        * gs_byte_buffer_view(data, sz):    wraps external memory, nothing is copied or owned
+        * gs_byte_buffer_map_file(bb, path): memory maps a file (mmap/MapViewOfFile), pages are read on demand
+        * gs_byte_buffer_read_ptr(bb, T, n): returns pointer to n T's at the read position and advances past them
+
+    All gs_byte_buffer_read* macros work on these buffers as usual. They must NOT be written to, resized or passed
+    to gs_byte_buffer_free(): release a view by just dropping it, and a mapping with gs_byte_buffer_unmap().
+    Buffer size is a uint32_t, so mapped files are limited to 4GB.
+*/
+
+/*==== Interface ====*/
+
+GS_API_DECL gs_byte_buffer_t
+gs_byte_buffer_view(const void* data, size_t sz);
+
+GS_API_DECL gs_result
+gs_byte_buffer_map_file(gs_byte_buffer_t* buffer, const char* file_path);
+
+GS_API_DECL void
+gs_byte_buffer_unmap(gs_byte_buffer_t* buffer);
+
+#define gs_byte_buffer_remaining(__BB)\
+    ((__BB)->position < (__BB)->size ? (__BB)->size - (__BB)->position : 0)
+
+// Pointer to __CT contiguous __T's at current read position (no copy), advances read position past them
+#define gs_byte_buffer_read_ptr(__BB, __T, __CT)\
+    ((__BB)->position += (uint32_t)(sizeof(__T) * (__CT)),\
+        (const __T*)((__BB)->data + (__BB)->position - (uint32_t)(sizeof(__T) * (__CT))))
+
+/*==== Implementation ====*/
+
+#ifdef GS_BYTE_BUFFER_VIEW_IMPL
+
+#if (defined _WIN32 || defined _WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#elif !(defined __EMSCRIPTEN__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+GS_API_DECL gs_byte_buffer_t
+gs_byte_buffer_view(const void* data, size_t sz)
+{
+    gs_byte_buffer_t bb = gs_default_val();
+    bb.data = (uint8_t*)data;
+    bb.size = (uint32_t)sz;
+    bb.capacity = (uint32_t)sz;
+    bb.position = 0;
+    return bb;
+}
+
+GS_API_DECL gs_result
+gs_byte_buffer_map_file(gs_byte_buffer_t* buffer, const char* file_path)
+{
+    *buffer = gs_byte_buffer_view(NULL, 0);
+
+#if (defined _WIN32 || defined _WIN64)
+
+    HANDLE file = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return GS_RESULT_FAILURE;
+    }
+
+    LARGE_INTEGER fsz = {0};
+    if (!GetFileSizeEx(file, &fsz) || (uint64_t)fsz.QuadPart > UINT32_MAX) {
+        CloseHandle(file);
+        return GS_RESULT_FAILURE;
+    }
+    if (fsz.QuadPart == 0) {
+        CloseHandle(file);
+        return GS_RESULT_SUCCESS;
+    }
+
+    // View keeps mapping alive, so both handles can be closed immediately
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    if (!data) {
+        return GS_RESULT_FAILURE;
+    }
+
+    *buffer = gs_byte_buffer_view(data, (size_t)fsz.QuadPart);
+    return GS_RESULT_SUCCESS;
+
+#elif (defined __EMSCRIPTEN__)
+
+    // No real file mapping on the web, fall back to an owned heap copy
+    return gs_byte_buffer_read_from_file(buffer, file_path);
+
+#else
+
+    int fd = open(file_path, O_RDONLY);
+    if (fd < 0) {
+        return GS_RESULT_FAILURE;
+    }
+
+    struct stat st = {0};
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size > UINT32_MAX) {
+        close(fd);
+        return GS_RESULT_FAILURE;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return GS_RESULT_SUCCESS;
+    }
+
+    // Mapping stays valid after the descriptor is closed
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return GS_RESULT_FAILURE;
+    }
+
+    #ifdef MADV_SEQUENTIAL
+        madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+    #endif
+
+    *buffer = gs_byte_buffer_view(data, (size_t)st.st_size);
+    return GS_RESULT_SUCCESS;
+
+#endif
+}
+
+GS_API_DECL void
+gs_byte_buffer_unmap(gs_byte_buffer_t* buffer)
+{
+    if (!buffer || !buffer->data) return;
+
+#if (defined _WIN32 || defined _WIN64)
+    UnmapViewOfFile(buffer->data);
+#elif (defined __EMSCRIPTEN__)
+    gs_byte_buffer_free(buffer);
+#else
+    munmap(buffer->data, buffer->capacity);
+#endif
+
+    *buffer = gs_byte_buffer_view(NULL, 0);
+}
+
+#endif // GS_BYTE_BUFFER_VIEW_IMPL
+#endif // GS_BYTE_BUFFER_VIEW_H
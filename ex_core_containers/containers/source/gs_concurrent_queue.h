@@ -0,0 +1,392 @@
+#ifndef GS_CONCURRENT_QUEUE_H
+#define GS_CONCURRENT_QUEUE_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger concurrent queue implementation like this:
+
+        #define GS_CONCURRENT_QUEUE_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_CONCURRENT_QUEUE_IMPL
+        #include "gs_concurrent_queue.h"
+
+    All other files should just #include "gs_concurrent_queue.h" without the #define.
+
+    MUST include "gs.h" and "gs_thread.h" BEFORE this file, since this file relies on them:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+        #define GS_CONCURRENT_QUEUE_IMPL
+        #include "gs_concurrent_queue.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Bounded containers for handing data between threads. Capacity is fixed at init (rounded up to a power of 2)
+    and neither container ever allocates afterwards. Push fails when full and pop fails when empty, nothing blocks.
+
+        * gs_spsc_ring(T):  single producer/single consumer ring buffer, wait-free. Exactly one thread may push
+                            and exactly one (other) thread may pop.
+
+            gs_spsc_ring(float) r = NULL;
+            gs_spsc_ring_init(r, 1024);
+            gs_spsc_ring_push(r, 1.f);              // producer, returns false if full
+            float v; gs_spsc_ring_pop(r, &v);       // consumer, returns false if empty
+
+        * gs_mpmc_queue(T): multi producer/multi consumer queue, lock-free. Any number of threads may push and pop.
+                            Values are passed by pointer, since a by-value temporary can't be shared between producers.
+
+            gs_mpmc_queue(job_t) q = NULL;
+            gs_mpmc_queue_init(q, 1024);
+            gs_mpmc_queue_push(q, &job);
+            gs_mpmc_queue_pop(q, &job);
+
+    Both have batch variants (*_push_n / *_pop_n) that move up to CT values with a single synchronization and
+    return how many were moved. Free either container only once no other thread is using it.
+*/
+
+/*==== Interface ====*/
+
+/*=== SPSC Ring ===*/
+
+typedef struct gs_spsc_ring_header_t
+{
+    // Read only after init
+    uint8_t* data;
+    uint32_t capacity;
+    uint32_t mask;
+    uint32_t elem_size;
+    uint8_t __pad0[GS_CACHE_LINE_SIZE - sizeof(uint8_t*) - 3 * sizeof(uint32_t)];
+
+    // Consumer owned
+    uint32_t head;
+    uint32_t tail_cache;        // Consumer's last seen tail, only reloaded when the ring looks empty
+    uint8_t __pad1[GS_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
+
+    // Producer owned
+    uint32_t tail;
+    uint32_t head_cache;        // Producer's last seen head, only reloaded when the ring looks full
+    uint8_t __pad2[GS_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
+} gs_spsc_ring_header_t;
+
+#define gs_spsc_ring(__T)\
+    struct {\
+        gs_spsc_ring_header_t hdr;\
+        __T tmp;\
+    }*
+
+GS_API_DECL void
+__gs_spsc_ring_init_impl(void** ring, size_t sz, size_t elem_size, uint32_t capacity);
+
+GS_API_DECL uint32_t
+__gs_spsc_ring_push_func(gs_spsc_ring_header_t* hdr, const void* vals, uint32_t ct);
+
+GS_API_DECL uint32_t
+__gs_spsc_ring_pop_func(gs_spsc_ring_header_t* hdr, void* out, uint32_t ct);
+
+#define gs_spsc_ring_init(__R, __CAP)\
+    __gs_spsc_ring_init_impl((void**)&(__R), sizeof(*(__R)), sizeof((__R)->tmp), (uint32_t)(__CAP))
+
+#define gs_spsc_ring_free(__R)\
+    do {\
+        if ((__R)) {\
+            gs_free((__R)->hdr.data);\
+            gs_free((__R));\
+            (__R) = NULL;\
+        }\
+    } while (0)
+
+#define gs_spsc_ring_capacity(__R)\
+    ((__R) ? (__R)->hdr.capacity : 0)
+
+// Approximate when called while the other side is active
+#define gs_spsc_ring_size(__R)\
+    ((__R) ? gs_atomic_load_acq_u32(&(__R)->hdr.tail) - gs_atomic_load_acq_u32(&(__R)->hdr.head) : 0)
+
+// Producer only
+#define gs_spsc_ring_push(__R, __VAL)\
+    ((__R)->tmp = (__VAL), __gs_spsc_ring_push_func(&(__R)->hdr, &(__R)->tmp, 1) == 1)
+
+#define gs_spsc_ring_push_n(__R, __VALS, __CT)\
+    __gs_spsc_ring_push_func(&(__R)->hdr, (1 ? (__VALS) : &(__R)->tmp), (uint32_t)(__CT))
+
+// Consumer only
+#define gs_spsc_ring_pop(__R, __OUTP)\
+    (__gs_spsc_ring_pop_func(&(__R)->hdr, (1 ? (__OUTP) : &(__R)->tmp), 1) == 1)
+
+#define gs_spsc_ring_pop_n(__R, __OUT, __CT)\
+    __gs_spsc_ring_pop_func(&(__R)->hdr, (1 ? (__OUT) : &(__R)->tmp), (uint32_t)(__CT))
+
+/*=== MPMC Queue ===*/
+
+typedef struct gs_mpmc_queue_header_t
+{
+    // Read only after init
+    uint8_t* cells;             // Each cell is a uint32_t sequence number followed by the value (at val_offset)
+    uint32_t capacity;
+    uint32_t mask;
+    uint32_t elem_size;
+    uint32_t val_offset;
+    uint32_t stride;
+    uint8_t __pad0[GS_CACHE_LINE_SIZE - sizeof(uint8_t*) - 5 * sizeof(uint32_t)];
+
+    uint32_t enqueue_pos;
+    uint8_t __pad1[GS_CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+    uint32_t dequeue_pos;
+    uint8_t __pad2[GS_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} gs_mpmc_queue_header_t;
+
+#define gs_mpmc_queue(__T)\
+    struct {\
+        gs_mpmc_queue_header_t hdr;\
+        __T* type;\
+    }*
+
+GS_API_DECL void
+__gs_mpmc_queue_init_impl(void** queue, size_t sz, size_t elem_size, uint32_t capacity);
+
+GS_API_DECL uint32_t
+__gs_mpmc_queue_push_func(gs_mpmc_queue_header_t* hdr, const void* vals, uint32_t ct);
+
+GS_API_DECL uint32_t
+__gs_mpmc_queue_pop_func(gs_mpmc_queue_header_t* hdr, void* out, uint32_t ct);
+
+#define gs_mpmc_queue_init(__Q, __CAP)\
+    __gs_mpmc_queue_init_impl((void**)&(__Q), sizeof(*(__Q)), sizeof(*(__Q)->type), (uint32_t)(__CAP))
+
+#define gs_mpmc_queue_free(__Q)\
+    do {\
+        if ((__Q)) {\
+            gs_free((__Q)->hdr.cells);\
+            gs_free((__Q));\
+            (__Q) = NULL;\
+        }\
+    } while (0)
+
+#define gs_mpmc_queue_capacity(__Q)\
+    ((__Q) ? (__Q)->hdr.capacity : 0)
+
+// Approximate when called while other threads are active
+#define gs_mpmc_queue_size(__Q)\
+    ((__Q) ? gs_atomic_load_u32(&(__Q)->hdr.enqueue_pos) - gs_atomic_load_u32(&(__Q)->hdr.dequeue_pos) : 0)
+
+#define gs_mpmc_queue_push(__Q, __VALP)\
+    (__gs_mpmc_queue_push_func(&(__Q)->hdr, (1 ? (__VALP) : (__Q)->type), 1) == 1)
+
+#define gs_mpmc_queue_push_n(__Q, __VALS, __CT)\
+    __gs_mpmc_queue_push_func(&(__Q)->hdr, (1 ? (__VALS) : (__Q)->type), (uint32_t)(__CT))
+
+#define gs_mpmc_queue_pop(__Q, __OUTP)\
+    (__gs_mpmc_queue_pop_func(&(__Q)->hdr, (1 ? (__OUTP) : (__Q)->type), 1) == 1)
+
+#define gs_mpmc_queue_pop_n(__Q, __OUT, __CT)\
+    __gs_mpmc_queue_pop_func(&(__Q)->hdr, (1 ? (__OUT) : (__Q)->type), (uint32_t)(__CT))
+
+/*==== Implementation ====*/
+
+#ifdef GS_CONCURRENT_QUEUE_IMPL
+
+static uint32_t
+__gs_concurrent_queue_pow2(uint32_t v)
+{
+    uint32_t c = 2;
+    while (c < v) c <<= 1;
+    return c;
+}
+
+/*=== SPSC Ring ===*/
+
+GS_API_DECL void
+__gs_spsc_ring_init_impl(void** ring, size_t sz, size_t elem_size, uint32_t capacity)
+{
+    gs_assert(*ring == NULL);
+    *ring = gs_malloc(sz);
+    memset(*ring, 0, sz);
+    gs_spsc_ring_header_t* hdr = (gs_spsc_ring_header_t*)*ring;
+    hdr->capacity = __gs_concurrent_queue_pow2(capacity);
+    hdr->mask = hdr->capacity - 1;
+    hdr->elem_size = (uint32_t)elem_size;
+    hdr->data = (uint8_t*)gs_malloc((size_t)hdr->capacity * elem_size);
+}
+
+GS_API_DECL uint32_t
+__gs_spsc_ring_push_func(gs_spsc_ring_header_t* hdr, const void* vals, uint32_t ct)
+{
+    const uint32_t tail = hdr->tail;
+    uint32_t room = hdr->capacity - (tail - hdr->head_cache);
+    if (room < ct) {
+        hdr->head_cache = gs_atomic_load_acq_u32(&hdr->head);
+        room = hdr->capacity - (tail - hdr->head_cache);
+    }
+
+    const uint32_t n = gs_min(ct, room);
+    if (!n) return 0;
+
+    // At most two copies, split where the ring wraps
+    const uint32_t i = tail & hdr->mask;
+    const uint32_t first = gs_min(n, hdr->capacity - i);
+    const size_t es = hdr->elem_size;
+    memcpy(hdr->data + (size_t)i * es, vals, (size_t)first * es);
+    memcpy(hdr->data, (const uint8_t*)vals + (size_t)first * es, (size_t)(n - first) * es);
+
+    gs_atomic_store_rel_u32(&hdr->tail, tail + n);
+    return n;
+}
+
+GS_API_DECL uint32_t
+__gs_spsc_ring_pop_func(gs_spsc_ring_header_t* hdr, void* out, uint32_t ct)
+{
+    const uint32_t head = hdr->head;
+    uint32_t avail = hdr->tail_cache - head;
+    if (avail < ct) {
+        hdr->tail_cache = gs_atomic_load_acq_u32(&hdr->tail);
+        avail = hdr->tail_cache - head;
+    }
+
+    const uint32_t n = gs_min(ct, avail);
+    if (!n) return 0;
+
+    const uint32_t i = head & hdr->mask;
+    const uint32_t first = gs_min(n, hdr->capacity - i);
+    const size_t es = hdr->elem_size;
+    memcpy(out, hdr->data + (size_t)i * es, (size_t)first * es);
+    memcpy((uint8_t*)out + (size_t)first * es, hdr->data, (size_t)(n - first) * es);
+
+    gs_atomic_store_rel_u32(&hdr->head, head + n);
+    return n;
+}
+
+/*=== MPMC Queue ===*/
+
+/*
+    Bounded queue after D. Vyukov. Cell i's sequence number tells whose turn it is:
+
+        seq == pos          empty, waiting for the producer that claims position pos
+        seq == pos + 1      full, waiting for the consumer that claims position pos
+
+    Producers and consumers claim positions by CAS on enqueue_pos/dequeue_pos. Batches claim a run of consecutive
+    positions whose cells are all ready in one CAS, which is safe because nobody but the claimer touches a cell
+    once it is in that state.
+*/
+
+#define __gs_mpmc_queue_seq(__HDR, __POS)\
+    ((uint32_t*)((__HDR)->cells + (size_t)((__POS) & (__HDR)->mask) * (__HDR)->stride))
+
+#define __gs_mpmc_queue_val(__HDR, __POS)\
+    ((__HDR)->cells + (size_t)((__POS) & (__HDR)->mask) * (__HDR)->stride + (__HDR)->val_offset)
+
+GS_API_DECL void
+__gs_mpmc_queue_init_impl(void** queue, size_t sz, size_t elem_size, uint32_t capacity)
+{
+    gs_assert(*queue == NULL);
+    *queue = gs_malloc(sz);
+    memset(*queue, 0, sz);
+    gs_mpmc_queue_header_t* hdr = (gs_mpmc_queue_header_t*)*queue;
+    hdr->capacity = __gs_concurrent_queue_pow2(capacity);
+    hdr->mask = hdr->capacity - 1;
+    hdr->elem_size = (uint32_t)elem_size;
+
+    // Value follows the sequence number at its natural alignment (assumed to be at most 16)
+    hdr->val_offset = elem_size >= 16 ? 16 : (elem_size >= 8 ? 8 : 4);
+    hdr->stride = (uint32_t)((hdr->val_offset + elem_size + hdr->val_offset - 1) / hdr->val_offset * hdr->val_offset);
+    hdr->cells = (uint8_t*)gs_malloc((size_t)hdr->capacity * hdr->stride);
+    for (uint32_t i = 0; i < hdr->capacity; ++i) {
+        *__gs_mpmc_queue_seq(hdr, i) = i;
+    }
+}
+
+GS_API_DECL uint32_t
+__gs_mpmc_queue_push_func(gs_mpmc_queue_header_t* hdr, const void* vals, uint32_t ct)
+{
+    // Nothing to do, and the run below would never find a ready or blocked cell to stop on
+    if (!ct) return 0;
+
+    uint32_t pos = gs_atomic_load_u32(&hdr->enqueue_pos);
+    uint32_t n = 0;
+
+    for (;;)
+    {
+        // Count run of empty cells ready for us, starting at pos
+        n = 0;
+        while (n < ct && n < hdr->capacity)
+        {
+            int32_t diff = (int32_t)(gs_atomic_load_acq_u32(__gs_mpmc_queue_seq(hdr, pos + n)) - (pos + n));
+            if (diff) break;
+            ++n;
+        }
+
+        if (n) {
+            if (gs_atomic_cas_u32(&hdr->enqueue_pos, pos, pos + n)) break;
+        } else {
+            // First cell still holds an unconsumed value from a lap ago, so queue is full
+            int32_t diff = (int32_t)(gs_atomic_load_acq_u32(__gs_mpmc_queue_seq(hdr, pos)) - pos);
+            if (diff < 0) return 0;
+        }
+
+        // Lost the race, another producer moved enqueue_pos
+        pos = gs_atomic_load_u32(&hdr->enqueue_pos);
+    }
+
+    const size_t es = hdr->elem_size;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        memcpy(__gs_mpmc_queue_val(hdr, pos + i), (const uint8_t*)vals + (size_t)i * es, es);
+        gs_atomic_store_rel_u32(__gs_mpmc_queue_seq(hdr, pos + i), pos + i + 1);
+    }
+    return n;
+}
+
+GS_API_DECL uint32_t
+__gs_mpmc_queue_pop_func(gs_mpmc_queue_header_t* hdr, void* out, uint32_t ct)
+{
+    // Nothing to do, and the run below would never find a ready or blocked cell to stop on
+    if (!ct) return 0;
+
+    uint32_t pos = gs_atomic_load_u32(&hdr->dequeue_pos);
+    uint32_t n = 0;
+
+    for (;;)
+    {
+        // Count run of full cells ready for us, starting at pos
+        n = 0;
+        while (n < ct && n < hdr->capacity)
+        {
+            int32_t diff = (int32_t)(gs_atomic_load_acq_u32(__gs_mpmc_queue_seq(hdr, pos + n)) - (pos + n + 1));
+            if (diff) break;
+            ++n;
+        }
+
+        if (n) {
+            if (gs_atomic_cas_u32(&hdr->dequeue_pos, pos, pos + n)) break;
+        } else {
+            // First cell hasn't been written yet, so queue is empty
+            int32_t diff = (int32_t)(gs_atomic_load_acq_u32(__gs_mpmc_queue_seq(hdr, pos)) - (pos + 1));
+            if (diff < 0) return 0;
+        }
+
+        pos = gs_atomic_load_u32(&hdr->dequeue_pos);
+    }
+
+    const size_t es = hdr->elem_size;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        memcpy((uint8_t*)out + (size_t)i * es, __gs_mpmc_queue_val(hdr, pos + i), es);
+        gs_atomic_store_rel_u32(__gs_mpmc_queue_seq(hdr, pos + i), pos + i + hdr->capacity);
+    }
+    return n;
+}
+
+#endif // GS_CONCURRENT_QUEUE_IMPL
+#endif // GS_CONCURRENT_QUEUE_H
@@ -0,0 +1,173 @@
+#ifndef GS_CONTAINERS_BULK_H
+#define GS_CONTAINERS_BULK_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger bulk container implementation like this:
+
+        #define GS_CONTAINERS_BULK_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_CONTAINERS_BULK_IMPL
+        #include "gs_containers_bulk.h"
+
+    All other files should just #include "gs_containers_bulk.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_CONTAINERS_BULK_IMPL
+        #include "gs_containers_bulk.h"
+
+    If gs_hash_table_simd.h or gs_slot_array_gen.h are used with their overrides, include them BEFORE this
+    file so that the reservations and range inserts below go through those containers.
+
+    ================================================================================================================
+*/
+
+/*
+    Bulk insertion for gs_hash_table, gs_slot_array and gs_slot_map. Each call sizes its containers once
+    for the whole range, then inserts without any intermediate grow/rehash cycles.
+
+        * gs_hash_table_reserve(HT, K, V, CT):              size table to hold CT entries
+        * gs_hash_table_insert_range(HT, KEYS, VALS, CT):   insert CT k/v pairs from parallel arrays
+        * gs_slot_array_insert_range(SA, VALS, CT, HNDLS):  insert CT values, writing handles to HNDLS (optional)
+        * gs_slot_map_reserve(SM, CT):                      size slot map to hold CT entries
+        * gs_slot_map_insert_range(SM, KEYS, VALS, CT):     insert CT k/v pairs from parallel arrays
+*/
+
+/*==== Interface ====*/
+
+/*=== Hash Table ===*/
+
+#ifdef GS_HASH_TABLE_SIMD_OVERRIDE
+
+    #define __gs_hash_table_reserve_n(__HT, __CT)\
+        gs_hash_table_simd_reserve((__HT), (__CT))
+
+#else
+
+    // Default table grows at a load factor of 0.5, so keep capacity above twice the entry count
+    #define __gs_hash_table_reserve_n(__HT, __CT)\
+        do {\
+            if ((__HT) == NULL) {\
+                gs_hash_table_init((__HT), 0, 0);\
+            }\
+            uint32_t __OCAP = gs_hash_table_capacity((__HT));\
+            uint32_t __NCAP = (uint32_t)(__CT) * 2 + 1;\
+            if (__NCAP > __OCAP) {\
+                gs_dyn_array_reserve((__HT)->data, __NCAP);\
+                for (uint32_t __I = __OCAP; __I < __NCAP; ++__I) {\
+                    (__HT)->data[__I].state = GS_HASH_TABLE_ENTRY_INACTIVE;\
+                }\
+            }\
+        } while (0)
+
+#endif
+
+#ifndef gs_hash_table_reserve
+    #define gs_hash_table_reserve(__HT, __K, __V, __CT)\
+        __gs_hash_table_reserve_n((__HT), (__CT))
+#endif
+
+#ifndef gs_hash_table_insert_range
+    #define gs_hash_table_insert_range(__HT, __KEYS, __VALS, __CT)\
+        do {\
+            const uint32_t __N = (uint32_t)(__CT);\
+            __gs_hash_table_reserve_n((__HT), gs_hash_table_size((__HT)) + __N);\
+            for (uint32_t __I = 0; __I < __N; ++__I) {\
+                gs_hash_table_insert((__HT), (__KEYS)[__I], (__VALS)[__I]);\
+            }\
+        } while (0)
+#endif
+
+/*=== Slot Array ===*/
+
+GS_API_DECL void
+gs_slot_array_insert_range_func(void** indices, void** data, const void* vals, size_t val_len, uint32_t ct, uint32_t* hndls);
+
+#ifndef gs_slot_array_insert_range
+    #define gs_slot_array_insert_range(__SA, __VALS, __CT, __HNDLS)\
+        do {\
+            gs_slot_array_init_all(__SA);\
+            gs_slot_array_insert_range_func((void**)&((__SA)->indices), (void**)&((__SA)->data), (const void*)(__VALS),\
+                sizeof((__SA)->tmp), (uint32_t)(__CT), (__HNDLS));\
+        } while (0)
+#endif
+
+/*=== Slot Map ===*/
+
+#define gs_slot_map_reserve(__SM, __CT)\
+    do {\
+        gs_slot_map_init((void**)&(__SM));\
+        gs_slot_array_reserve((__SM)->sa, (__CT) + 1);\
+        __gs_hash_table_reserve_n((__SM)->ht, (__CT));\
+    } while (0)
+
+#define gs_slot_map_insert_range(__SM, __KEYS, __VALS, __CT)\
+    do {\
+        const uint32_t __SMN = (uint32_t)(__CT);\
+        gs_slot_map_reserve((__SM), gs_slot_map_size((__SM)) + __SMN);\
+        uint32_t* __SMH = (uint32_t*)gs_malloc(sizeof(uint32_t) * (__SMN ? __SMN : 1));\
+        gs_slot_array_insert_range((__SM)->sa, (__VALS), __SMN, __SMH);\
+        for (uint32_t __SMI = 0; __SMI < __SMN; ++__SMI) {\
+            gs_hash_table_insert((__SM)->ht, (__KEYS)[__SMI], __SMH[__SMI]);\
+        }\
+        gs_free(__SMH);\
+    } while (0)
+
+/*==== Implementation ====*/
+
+#ifdef GS_CONTAINERS_BULK_IMPL
+
+GS_API_DECL void
+gs_slot_array_insert_range_func(void** indices, void** data, const void* vals, size_t val_len, uint32_t ct, uint32_t* hndls)
+{
+    if (!ct) return;
+
+    // Copy all values to the back of the data array in one go
+    const uint32_t dsz = (uint32_t)gs_dyn_array_size(*data);
+    if ((uint32_t)gs_dyn_array_capacity(*data) <= dsz + ct) {
+        *data = gs_dyn_array_resize_impl(*data, val_len, dsz + ct + 1);
+    }
+    memcpy((uint8_t*)*data + (size_t)dsz * val_len, vals, (size_t)ct * val_len);
+    gs_dyn_array_head(*data)->size += ct;
+
+    // Single pass over handles, filling free slots first
+    uint32_t* idx = (uint32_t*)*indices;
+    const uint32_t isz = (uint32_t)gs_dyn_array_size(idx);
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < isz && n < ct; ++i)
+    {
+        if (idx[i] != GS_SLOT_ARRAY_INVALID_HANDLE) continue;
+        idx[i] = dsz + n;
+        if (hndls) hndls[n] = i;
+        ++n;
+    }
+
+    // Then append new handles for the remainder
+    const uint32_t rem = ct - n;
+    if (rem)
+    {
+        if ((uint32_t)gs_dyn_array_capacity(idx) <= isz + rem) {
+            idx = (uint32_t*)gs_dyn_array_resize_impl(idx, sizeof(uint32_t), isz + rem + 1);
+            *indices = idx;
+        }
+        for (uint32_t i = 0; i < rem; ++i)
+        {
+            idx[isz + i] = dsz + n + i;
+            if (hndls) hndls[n + i] = isz + i;
+        }
+        gs_dyn_array_head(idx)->size += rem;
+    }
+}
+
+#endif // GS_CONTAINERS_BULK_IMPL
+#endif // GS_CONTAINERS_BULK_H
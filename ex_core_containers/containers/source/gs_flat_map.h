@@ -0,0 +1,319 @@
+#ifndef GS_FLAT_MAP_H
+#define GS_FLAT_MAP_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger flat map implementation like this:
+
+        #define GS_FLAT_MAP_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_FLAT_MAP_IMPL
+        #include "gs_flat_map.h"
+
+    All other files should just #include "gs_flat_map.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_FLAT_MAP_IMPL
+        #include "gs_flat_map.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Sorted flat map, for small tables that are read much more often than written:
+
+        * Keys and values live in two parallel sorted arrays sharing a single allocation, so a lookup touches
+          only the keys and never chases pointers. Insert/erase shift the arrays (O(n)).
+        * Up to GS_FLAT_MAP_LINEAR_MAX entries, lookups count smaller keys in a linear scan (SSE2/NEON for 4 byte
+          keys), which beats any search at these sizes. Larger maps use a branchless binary search.
+        * 1, 2, 4 and 8 byte keys are ordered as unsigned integers, any other key size bytewise (memcmp).
+        * Unlike gs_hash_table, a map is a plain struct (zero initialized) rather than a pointer, so it can be
+          embedded in other structs with no allocation until the first insert. Copying the struct shares its storage.
+
+    Iterate it like a gs_dyn_array, in ascending key order:
+
+        gs_flat_map(uint32_t, float) m = {0};
+        gs_flat_map_insert(m, 42, 1.f);
+        for (uint32_t i = 0; i < gs_flat_map_size(m); ++i) {
+            uint32_t k = m.keys[i];
+            float v = m.vals[i];
+        }
+        gs_flat_map_free(m);
+*/
+
+/*==== Interface ====*/
+
+#if (defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define GS_FLAT_MAP_SSE2
+#elif (defined __ARM_NEON && defined __aarch64__)
+    #include <arm_neon.h>
+    #define GS_FLAT_MAP_NEON
+#endif
+
+#ifndef GS_FLAT_MAP_LINEAR_MAX
+    #define GS_FLAT_MAP_LINEAR_MAX      32
+#endif
+
+#define GS_FLAT_MAP_INVALID_INDEX       UINT32_MAX
+
+// Layout shared by every gs_flat_map(K, V)
+typedef struct gs_flat_map_header_t
+{
+    void* keys;
+    void* vals;
+    uint32_t size;
+    uint32_t capacity;
+} gs_flat_map_header_t;
+
+#define gs_flat_map(__K, __V)\
+    struct {\
+        __K* keys;\
+        __V* vals;\
+        uint32_t size;\
+        uint32_t capacity;\
+        uint32_t tmp_idx;\
+        __K tmp_key;\
+        __V tmp_val;\
+    }
+
+#define __gs_flat_map_hdr(__M)\
+    ((gs_flat_map_header_t*)&(__M))
+
+// Index of first key not less than key (size if none)
+GS_API_DECL uint32_t
+gs_flat_map_lower_bound_func(const void* keys, uint32_t size, const void* key, size_t key_len);
+
+GS_API_DECL uint32_t
+gs_flat_map_find_func(const void* keys, uint32_t size, const void* key, size_t key_len);
+
+// Returns index of key, inserting it (value uninitialized) if missing
+GS_API_DECL uint32_t
+gs_flat_map_insert_func(gs_flat_map_header_t* hdr, const void* key, size_t key_len, size_t val_len);
+
+GS_API_DECL void
+gs_flat_map_erase_func(gs_flat_map_header_t* hdr, uint32_t idx, size_t key_len, size_t val_len);
+
+GS_API_DECL void
+gs_flat_map_reserve_func(gs_flat_map_header_t* hdr, uint32_t capacity, size_t key_len, size_t val_len);
+
+#define gs_flat_map_size(__M)\
+    ((__M).size)
+
+#define gs_flat_map_capacity(__M)\
+    ((__M).capacity)
+
+#define gs_flat_map_empty(__M)\
+    ((__M).size == 0)
+
+#define gs_flat_map_reserve(__M, __CT)\
+    gs_flat_map_reserve_func(__gs_flat_map_hdr(__M), (uint32_t)(__CT), sizeof((__M).tmp_key), sizeof((__M).tmp_val))
+
+#define gs_flat_map_find(__M, __MK)\
+    ((__M).tmp_key = (__MK), gs_flat_map_find_func((__M).keys, (__M).size, &(__M).tmp_key, sizeof((__M).tmp_key)))
+
+#define gs_flat_map_exists(__M, __MK)\
+    (gs_flat_map_find((__M), (__MK)) != GS_FLAT_MAP_INVALID_INDEX)
+
+// Key must exist
+#define gs_flat_map_get(__M, __MK)\
+    ((__M).vals[gs_flat_map_find((__M), (__MK))])
+
+// NULL if key doesn't exist
+#define gs_flat_map_getp(__M, __MK)\
+    (((__M).tmp_idx = gs_flat_map_find((__M), (__MK))) != GS_FLAT_MAP_INVALID_INDEX ? &(__M).vals[(__M).tmp_idx] : NULL)
+
+// Overwrites value if key already exists
+#define gs_flat_map_insert(__M, __MK, __MV)\
+    do {\
+        (__M).tmp_key = (__MK);\
+        (__M).tmp_val = (__MV);\
+        uint32_t __FMI = gs_flat_map_insert_func(__gs_flat_map_hdr(__M), &(__M).tmp_key, sizeof((__M).tmp_key), sizeof((__M).tmp_val));\
+        (__M).vals[__FMI] = (__M).tmp_val;\
+    } while (0)
+
+#define gs_flat_map_erase(__M, __MK)\
+    do {\
+        uint32_t __FMI = gs_flat_map_find((__M), (__MK));\
+        if (__FMI != GS_FLAT_MAP_INVALID_INDEX) {\
+            gs_flat_map_erase_func(__gs_flat_map_hdr(__M), __FMI, sizeof((__M).tmp_key), sizeof((__M).tmp_val));\
+        }\
+    } while (0)
+
+#define gs_flat_map_clear(__M)\
+    do {\
+        (__M).size = 0;\
+    } while (0)
+
+#define gs_flat_map_free(__M)\
+    do {\
+        if ((__M).keys) gs_free((__M).keys);\
+        (__M).keys = NULL;\
+        (__M).vals = NULL;\
+        (__M).size = 0;\
+        (__M).capacity = 0;\
+    } while (0)
+
+/*==== Implementation ====*/
+
+#ifdef GS_FLAT_MAP_IMPL
+
+// Number of keys less than key, over a short run
+#define __gs_flat_map_count_less(__T, __KEYS, __N, __KEY)\
+    do {\
+        const __T* __K = (const __T*)(__KEYS);\
+        const __T __V = *(const __T*)(__KEY);\
+        for (uint32_t __I = 0; __I < (__N); ++__I) {\
+            c += (uint32_t)(__K[__I] < __V);\
+        }\
+    } while (0)
+
+static uint32_t
+__gs_flat_map_linear_u32(const uint32_t* keys, uint32_t n, uint32_t key)
+{
+    uint32_t c = 0, i = 0;
+#if (defined GS_FLAT_MAP_SSE2)
+    // Unsigned compare through signed compare with sign bits flipped
+    const __m128i bias = _mm_set1_epi32((int32_t)0x80000000);
+    const __m128i k = _mm_xor_si128(_mm_set1_epi32((int32_t)key), bias);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(keys + i)), bias);
+        uint32_t m = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, k)));
+        c += (m & 1) + ((m >> 1) & 1) + ((m >> 2) & 1) + (m >> 3);
+    }
+#elif (defined GS_FLAT_MAP_NEON)
+    const uint32x4_t k = vdupq_n_u32(key);
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (; i + 4 <= n; i += 4) {
+        acc = vsubq_u32(acc, vcltq_u32(vld1q_u32(keys + i), k));
+    }
+    c = vaddvq_u32(acc);
+#endif
+    for (; i < n; ++i) c += (uint32_t)(keys[i] < key);
+    return c;
+}
+
+#define __gs_flat_map_less(__T, __A, __B)\
+    (*(const __T*)(__A) < *(const __T*)(__B))
+
+gs_force_inline
+bool __gs_flat_map_key_less(const void* a, const void* b, size_t key_len)
+{
+    switch (key_len)
+    {
+        case 1: return __gs_flat_map_less(uint8_t, a, b);
+        case 2: return __gs_flat_map_less(uint16_t, a, b);
+        case 4: return __gs_flat_map_less(uint32_t, a, b);
+        case 8: return __gs_flat_map_less(uint64_t, a, b);
+        default: return memcmp(a, b, key_len) < 0;
+    }
+}
+
+GS_API_DECL uint32_t
+gs_flat_map_lower_bound_func(const void* keys, uint32_t size, const void* key, size_t key_len)
+{
+    if (!size) return 0;
+
+    if (size <= GS_FLAT_MAP_LINEAR_MAX)
+    {
+        uint32_t c = 0;
+        switch (key_len)
+        {
+            case 1: __gs_flat_map_count_less(uint8_t, keys, size, key); return c;
+            case 2: __gs_flat_map_count_less(uint16_t, keys, size, key); return c;
+            case 4: return __gs_flat_map_linear_u32((const uint32_t*)keys, size, *(const uint32_t*)key);
+            case 8: __gs_flat_map_count_less(uint64_t, keys, size, key); return c;
+            default: break;
+        }
+    }
+
+    // Branchless binary search: halve the range each step with a conditional move instead of a branch
+    const uint8_t* base = (const uint8_t*)keys;
+    uint32_t n = size;
+    while (n > 1)
+    {
+        uint32_t half = n / 2;
+        base = __gs_flat_map_key_less(base + (size_t)half * key_len, key, key_len) ? base + (size_t)half * key_len : base;
+        n -= half;
+    }
+    return (uint32_t)((base - (const uint8_t*)keys) / key_len) + (uint32_t)__gs_flat_map_key_less(base, key, key_len);
+}
+
+GS_API_DECL uint32_t
+gs_flat_map_find_func(const void* keys, uint32_t size, const void* key, size_t key_len)
+{
+    uint32_t i = gs_flat_map_lower_bound_func(keys, size, key, key_len);
+    if (i < size && memcmp((const uint8_t*)keys + (size_t)i * key_len, key, key_len) == 0) {
+        return i;
+    }
+    return GS_FLAT_MAP_INVALID_INDEX;
+}
+
+// Values start at next 16 byte boundary after keys
+#define __gs_flat_map_vals_offset(__CAP, __KL)\
+    (((size_t)(__CAP) * (__KL) + 15) & ~(size_t)15)
+
+GS_API_DECL void
+gs_flat_map_reserve_func(gs_flat_map_header_t* hdr, uint32_t capacity, size_t key_len, size_t val_len)
+{
+    if (capacity <= hdr->capacity) return;
+
+    const size_t voff = __gs_flat_map_vals_offset(capacity, key_len);
+    uint8_t* mem = (uint8_t*)gs_malloc(voff + (size_t)capacity * val_len);
+    if (hdr->size) {
+        memcpy(mem, hdr->keys, (size_t)hdr->size * key_len);
+        memcpy(mem + voff, hdr->vals, (size_t)hdr->size * val_len);
+    }
+    if (hdr->keys) gs_free(hdr->keys);
+    hdr->keys = mem;
+    hdr->vals = mem + voff;
+    hdr->capacity = capacity;
+}
+
+GS_API_DECL uint32_t
+gs_flat_map_insert_func(gs_flat_map_header_t* hdr, const void* key, size_t key_len, size_t val_len)
+{
+    uint32_t i = gs_flat_map_lower_bound_func(hdr->keys, hdr->size, key, key_len);
+    uint8_t* keys = (uint8_t*)hdr->keys;
+    if (i < hdr->size && memcmp(keys + (size_t)i * key_len, key, key_len) == 0) {
+        return i;
+    }
+
+    if (hdr->size == hdr->capacity) {
+        gs_flat_map_reserve_func(hdr, hdr->capacity ? hdr->capacity * 2 : 8, key_len, val_len);
+        keys = (uint8_t*)hdr->keys;
+    }
+
+    uint8_t* vals = (uint8_t*)hdr->vals;
+    const uint32_t tail = hdr->size - i;
+    memmove(keys + (size_t)(i + 1) * key_len, keys + (size_t)i * key_len, (size_t)tail * key_len);
+    memmove(vals + (size_t)(i + 1) * val_len, vals + (size_t)i * val_len, (size_t)tail * val_len);
+    memcpy(keys + (size_t)i * key_len, key, key_len);
+    hdr->size++;
+    return i;
+}
+
+GS_API_DECL void
+gs_flat_map_erase_func(gs_flat_map_header_t* hdr, uint32_t idx, size_t key_len, size_t val_len)
+{
+    uint8_t* keys = (uint8_t*)hdr->keys;
+    uint8_t* vals = (uint8_t*)hdr->vals;
+    const uint32_t tail = hdr->size - idx - 1;
+    memmove(keys + (size_t)idx * key_len, keys + (size_t)(idx + 1) * key_len, (size_t)tail * key_len);
+    memmove(vals + (size_t)idx * val_len, vals + (size_t)(idx + 1) * val_len, (size_t)tail * val_len);
+    hdr->size--;
+}
+
+#endif // GS_FLAT_MAP_IMPL
+#endif // GS_FLAT_MAP_H
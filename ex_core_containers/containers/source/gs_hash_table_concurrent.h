@@ -0,0 +1,574 @@
+#ifndef GS_HASH_TABLE_CONCURRENT_H
+#define GS_HASH_TABLE_CONCURRENT_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger concurrent hash table implementation like this:
+
+        #define GS_HASH_TABLE_CONCURRENT_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_HASH_TABLE_CONCURRENT_IMPL
+        #include "gs_hash_table_concurrent.h"
+
+    All other files should just #include "gs_hash_table_concurrent.h" without the #define.
+
+    MUST include "gs.h" and "gs_thread.h" BEFORE this file, since this file relies on both:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+        #define GS_HASH_TABLE_CONCURRENT_IMPL
+        #include "gs_hash_table_concurrent.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Hash table that any number of threads can read while a few threads write, without a global lock:
+
+        * Reads are lock-free: open addressing with linear probing over a control word per slot. Values are copied
+          out under a per-slot sequence counter, so a concurrent overwrite is never seen half written.
+        * Writes take one of GS_HASH_TABLE_CONCURRENT_STRIPES spinlocks picked by key hash, so writers of different
+          keys rarely contend. Empty slots are claimed with a CAS.
+        * Growth takes every stripe, rehashes into a new table (dropping tombstones) and publishes it atomically.
+          The old table is retired and only freed once every reader that could still hold it has finished. Readers
+          announce themselves on one of GS_HASH_TABLE_CONCURRENT_READER_SLOTS padded counters, picked per thread.
+        * Since entries can move under a reader, keys/values go in and out by pointer and are copied:
+
+            gs_hash_table_concurrent(uint64_t, asset_handle_t) ht = NULL;
+            gs_hash_table_concurrent_init(ht, 1024);
+
+            uint64_t k = gs_hash_str64("player.png");
+            gs_hash_table_concurrent_insert(ht, &k, &hndl);     // Any thread
+
+            asset_handle_t out;
+            if (gs_hash_table_concurrent_get(ht, &k, &out)) {}  // Any thread
+
+        * The iterator macros match gs_hash_table's, but are only valid once writers have quiesced.
+*/
+
+/*==== Interface ====*/
+
+#ifndef GS_HASH_TABLE_CONCURRENT_STRIPES
+    #define GS_HASH_TABLE_CONCURRENT_STRIPES        32      // Power of 2
+#endif
+
+#define GS_HASH_TABLE_CONCURRENT_READER_SLOTS       32      // One bit each in a retired table's pending mask
+#define GS_HASH_TABLE_CONCURRENT_MIN_CAPACITY       128     // Headroom (1/4) must cover one racing insert per stripe
+
+#define GS_HASH_TABLE_CONCURRENT_EMPTY              0x00000000
+#define GS_HASH_TABLE_CONCURRENT_BUSY               0x00000001  // Claimed, key/value being written
+#define GS_HASH_TABLE_CONCURRENT_DELETED            0x00000002
+#define GS_HASH_TABLE_CONCURRENT_FULL               0x80000000  // Set in every live slot, with 31 bits of hash
+
+typedef struct gs_hash_table_concurrent_slot_t
+{
+    uint32_t state;
+    uint32_t seq;       // Odd while value is being overwritten
+} gs_hash_table_concurrent_slot_t;
+
+typedef struct gs_hash_table_concurrent_table_t
+{
+    uint32_t capacity;
+    gs_hash_table_concurrent_slot_t* slots;
+    uint8_t* entries;
+} gs_hash_table_concurrent_table_t;
+
+typedef struct gs_hash_table_concurrent_retired_t
+{
+    gs_hash_table_concurrent_table_t* table;
+    uint32_t pending;   // Reader slots not yet seen idle since table was retired
+} gs_hash_table_concurrent_retired_t;
+
+typedef struct gs_hash_table_concurrent_stripe_t
+{
+    gs_spinlock_t lock;
+    uint8_t pad[GS_CACHE_LINE_SIZE - sizeof(gs_spinlock_t)];
+} gs_hash_table_concurrent_stripe_t;
+
+typedef struct gs_hash_table_concurrent_reader_t
+{
+    uint32_t count;
+    uint8_t pad[GS_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} gs_hash_table_concurrent_reader_t;
+
+typedef struct gs_hash_table_concurrent_header_t
+{
+    gs_hash_table_concurrent_table_t* table;
+    uint32_t key_size;
+    uint32_t val_size;
+    uint32_t stride;
+    uint32_t val_offset;
+    uint32_t size;          // Live entries
+    uint32_t used;          // Live entries + tombstones
+    uint32_t retired_ct;
+    gs_spinlock_t retire_lock;
+    gs_dyn_array(gs_hash_table_concurrent_retired_t) retired;
+    gs_hash_table_concurrent_stripe_t stripes[GS_HASH_TABLE_CONCURRENT_STRIPES];
+    gs_hash_table_concurrent_reader_t readers[GS_HASH_TABLE_CONCURRENT_READER_SLOTS];
+} gs_hash_table_concurrent_header_t;
+
+// Header must stay the first member and data the second (updated on growth for iteration)
+#define gs_hash_table_concurrent(__HMK, __HMV)\
+    struct {\
+        gs_hash_table_concurrent_header_t hdr;\
+        struct {\
+            __HMK key;\
+            __HMV val;\
+        }* data;\
+        __HMK* key_type;\
+        __HMV* val_type;\
+    }*
+
+GS_API_DECL void
+__gs_hash_table_concurrent_init_impl(void** ht, size_t sz, uint32_t key_size, uint32_t val_size, uint32_t stride, uint32_t val_offset, uint32_t capacity);
+
+GS_API_DECL void
+__gs_hash_table_concurrent_free_func(void* ht);
+
+GS_API_DECL bool
+gs_hash_table_concurrent_get_func(gs_hash_table_concurrent_header_t* hdr, const void* key, void* out_val);
+
+GS_API_DECL bool
+gs_hash_table_concurrent_insert_func(gs_hash_table_concurrent_header_t* hdr, const void* key, const void* val, bool overwrite);
+
+GS_API_DECL bool
+gs_hash_table_concurrent_erase_func(gs_hash_table_concurrent_header_t* hdr, const void* key);
+
+GS_API_DECL void
+gs_hash_table_concurrent_clear_func(gs_hash_table_concurrent_header_t* hdr);
+
+GS_API_DECL uint32_t
+__gs_hash_table_concurrent_find_first_valid_iterator(const gs_hash_table_concurrent_header_t* hdr, uint32_t idx);
+
+// Must be called before the table is shared with other threads
+#define gs_hash_table_concurrent_init(__HT, __CAP)\
+    __gs_hash_table_concurrent_init_impl((void**)&(__HT), sizeof(*(__HT)),\
+        (uint32_t)sizeof(*(__HT)->key_type), (uint32_t)sizeof(*(__HT)->val_type),\
+        (uint32_t)sizeof(*(__HT)->data), (uint32_t)((size_t)&(__HT)->data->val - (size_t)(__HT)->data), (uint32_t)(__CAP))
+
+// No other thread may access the table during or after this
+#define gs_hash_table_concurrent_free(__HT)\
+    do {\
+        if ((__HT) != NULL) {\
+            __gs_hash_table_concurrent_free_func((__HT));\
+            (__HT) = NULL;\
+        }\
+    } while (0)
+
+#define gs_hash_table_concurrent_size(__HT)\
+    ((__HT) != NULL ? gs_atomic_load_u32(&(__HT)->hdr.size) : 0)
+
+#define gs_hash_table_concurrent_capacity(__HT)\
+    ((__HT) != NULL ? ((gs_hash_table_concurrent_table_t*)gs_atomic_load_ptr(&(__HT)->hdr.table))->capacity : 0)
+
+// Compile time check that a pointer matches the table's key/value type
+#define __gs_hash_table_concurrent_kp(__HT, __KP)\
+    ((const void*)(1 ? (__KP) : (__HT)->key_type))
+
+#define __gs_hash_table_concurrent_vp(__HT, __VP)\
+    ((void*)(1 ? (__VP) : (__HT)->val_type))
+
+// Copies value of *__KP into *__VP, returns false if missing. Safe from any thread.
+#define gs_hash_table_concurrent_get(__HT, __KP, __VP)\
+    gs_hash_table_concurrent_get_func(&(__HT)->hdr, __gs_hash_table_concurrent_kp((__HT), (__KP)), __gs_hash_table_concurrent_vp((__HT), (__VP)))
+
+#define gs_hash_table_concurrent_exists(__HT, __KP)\
+    gs_hash_table_concurrent_get_func(&(__HT)->hdr, __gs_hash_table_concurrent_kp((__HT), (__KP)), NULL)
+
+// Inserts or overwrites, returns true if key was new
+#define gs_hash_table_concurrent_insert(__HT, __KP, __VP)\
+    gs_hash_table_concurrent_insert_func(&(__HT)->hdr, __gs_hash_table_concurrent_kp((__HT), (__KP)),\
+        (const void*)__gs_hash_table_concurrent_vp((__HT), (__VP)), true)
+
+// Only inserts if key is missing (returns false and leaves existing value otherwise)
+#define gs_hash_table_concurrent_try_insert(__HT, __KP, __VP)\
+    gs_hash_table_concurrent_insert_func(&(__HT)->hdr, __gs_hash_table_concurrent_kp((__HT), (__KP)),\
+        (const void*)__gs_hash_table_concurrent_vp((__HT), (__VP)), false)
+
+#define gs_hash_table_concurrent_erase(__HT, __KP)\
+    gs_hash_table_concurrent_erase_func(&(__HT)->hdr, __gs_hash_table_concurrent_kp((__HT), (__KP)))
+
+#define gs_hash_table_concurrent_clear(__HT)\
+    gs_hash_table_concurrent_clear_func(&(__HT)->hdr)
+
+/*===== Hash Table Iterator (writers must be quiesced) ====*/
+
+#define gs_hash_table_concurrent_iter_new(__HT)\
+    ((__HT) ? __gs_hash_table_concurrent_find_first_valid_iterator(&(__HT)->hdr, 0) : 0)
+
+#define gs_hash_table_concurrent_iter_valid(__HT, __IT)\
+    ((__IT) < gs_hash_table_concurrent_capacity((__HT)))
+
+#define gs_hash_table_concurrent_iter_advance(__HT, __IT)\
+    ((__IT) = __gs_hash_table_concurrent_find_first_valid_iterator(&(__HT)->hdr, (__IT) + 1))
+
+#define gs_hash_table_concurrent_iter_get(__HT, __IT)\
+    ((__HT)->data[(__IT)].val)
+
+#define gs_hash_table_concurrent_iter_getp(__HT, __IT)\
+    (&((__HT)->data[(__IT)].val))
+
+#define gs_hash_table_concurrent_iter_getk(__HT, __IT)\
+    ((__HT)->data[(__IT)].key)
+
+#define gs_hash_table_concurrent_iter_getkp(__HT, __IT)\
+    (&((__HT)->data[(__IT)].key))
+
+/*==== Implementation ====*/
+
+#ifdef GS_HASH_TABLE_CONCURRENT_IMPL
+
+static uint32_t __gs_hash_table_concurrent_thread_ct = 0;
+static GS_THREAD_LOCAL uint32_t __gs_hash_table_concurrent_thread_slot = UINT32_MAX;
+
+gs_force_inline
+uint32_t __gs_hash_table_concurrent_reader_slot()
+{
+    if (__gs_hash_table_concurrent_thread_slot == UINT32_MAX) {
+        __gs_hash_table_concurrent_thread_slot = gs_atomic_add_u32(&__gs_hash_table_concurrent_thread_ct, 1) & (GS_HASH_TABLE_CONCURRENT_READER_SLOTS - 1);
+    }
+    return __gs_hash_table_concurrent_thread_slot;
+}
+
+// Tag and stripe come from the top 32 bits. gs_hash_bytes() is only as wide as size_t, so on 32 bit builds
+// (html5/wasm) its result is spread over all 64 first, or every key would share one stripe and one tag.
+gs_force_inline
+uint64_t __gs_hash_table_concurrent_hash_func(const void* key, uint32_t key_size)
+{
+    uint64_t h = (uint64_t)gs_hash_bytes((void*)key, key_size, GS_HASH_TABLE_HASH_SEED);
+    if (sizeof(size_t) < sizeof(uint64_t)) {
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+#define __gs_hash_table_concurrent_hash(__HDR, __KEY)\
+    __gs_hash_table_concurrent_hash_func((__KEY), (__HDR)->key_size)
+
+#define __gs_hash_table_concurrent_tag(__HSH)\
+    ((uint32_t)((__HSH) >> 33) | GS_HASH_TABLE_CONCURRENT_FULL)
+
+#define __gs_hash_table_concurrent_stripe(__HSH)\
+    ((uint32_t)((__HSH) >> 40) & (GS_HASH_TABLE_CONCURRENT_STRIPES - 1))
+
+#define __gs_hash_table_concurrent_entry(__HDR, __T, __I)\
+    ((__T)->entries + (size_t)(__I) * (__HDR)->stride)
+
+#define __gs_hash_table_concurrent_data(__HDR)\
+    ((void**)((uint8_t*)(__HDR) + sizeof(gs_hash_table_concurrent_header_t)))
+
+static gs_hash_table_concurrent_table_t*
+__gs_hash_table_concurrent_table_new(const gs_hash_table_concurrent_header_t* hdr, uint32_t capacity)
+{
+    const size_t slots_off = (sizeof(gs_hash_table_concurrent_table_t) + 15) & ~(size_t)15;
+    const size_t entries_off = (slots_off + sizeof(gs_hash_table_concurrent_slot_t) * capacity + 15) & ~(size_t)15;
+    uint8_t* mem = (uint8_t*)gs_malloc(entries_off + (size_t)hdr->stride * capacity);
+    gs_hash_table_concurrent_table_t* t = (gs_hash_table_concurrent_table_t*)mem;
+    t->capacity = capacity;
+    t->slots = (gs_hash_table_concurrent_slot_t*)(mem + slots_off);
+    t->entries = mem + entries_off;
+    memset(t->slots, 0, sizeof(gs_hash_table_concurrent_slot_t) * capacity);
+    return t;
+}
+
+GS_API_DECL void
+__gs_hash_table_concurrent_init_impl(void** ht, size_t sz, uint32_t key_size, uint32_t val_size, uint32_t stride, uint32_t val_offset, uint32_t capacity)
+{
+    *ht = gs_malloc(sz);
+    memset(*ht, 0, sz);
+
+    gs_hash_table_concurrent_header_t* hdr = (gs_hash_table_concurrent_header_t*)*ht;
+    hdr->key_size = key_size;
+    hdr->val_size = val_size;
+    hdr->stride = stride;
+    hdr->val_offset = val_offset;
+
+    // Room for capacity entries at the growth threshold (3/4)
+    uint32_t cap = GS_HASH_TABLE_CONCURRENT_MIN_CAPACITY;
+    while (cap / 4 * 3 < capacity) cap *= 2;
+    hdr->table = __gs_hash_table_concurrent_table_new(hdr, cap);
+    *__gs_hash_table_concurrent_data(hdr) = hdr->table->entries;
+}
+
+GS_API_DECL void
+__gs_hash_table_concurrent_free_func(void* ht)
+{
+    gs_hash_table_concurrent_header_t* hdr = (gs_hash_table_concurrent_header_t*)ht;
+    for (uint32_t i = 0; i < gs_dyn_array_size(hdr->retired); ++i) {
+        gs_free(hdr->retired[i].table);
+    }
+    gs_dyn_array_free(hdr->retired);
+    gs_free(hdr->table);
+    gs_free(ht);
+}
+
+// Frees retired tables once every reader slot has been seen idle since retirement
+static void
+__gs_hash_table_concurrent_reclaim(gs_hash_table_concurrent_header_t* hdr)
+{
+    if (!gs_atomic_load_u32(&hdr->retired_ct) || !gs_spinlock_try_lock(&hdr->retire_lock)) return;
+
+    for (uint32_t i = gs_dyn_array_size(hdr->retired); i-- > 0;)
+    {
+        gs_hash_table_concurrent_retired_t* r = &hdr->retired[i];
+        for (uint32_t b = 0; b < GS_HASH_TABLE_CONCURRENT_READER_SLOTS; ++b)
+        {
+            if ((r->pending & (1u << b)) && !gs_atomic_load_u32(&hdr->readers[b].count)) {
+                r->pending &= ~(1u << b);
+            }
+        }
+        if (!r->pending)
+        {
+            gs_free(r->table);
+            *r = gs_dyn_array_back(hdr->retired);
+            gs_dyn_array_pop(hdr->retired);
+        }
+    }
+
+    gs_atomic_store_u32(&hdr->retired_ct, gs_dyn_array_size(hdr->retired));
+    gs_spinlock_unlock(&hdr->retire_lock);
+}
+
+static void
+__gs_hash_table_concurrent_lock_all(gs_hash_table_concurrent_header_t* hdr)
+{
+    for (uint32_t i = 0; i < GS_HASH_TABLE_CONCURRENT_STRIPES; ++i) gs_spinlock_lock(&hdr->stripes[i].lock);
+}
+
+static void
+__gs_hash_table_concurrent_unlock_all(gs_hash_table_concurrent_header_t* hdr)
+{
+    for (uint32_t i = GS_HASH_TABLE_CONCURRENT_STRIPES; i-- > 0;) gs_spinlock_unlock(&hdr->stripes[i].lock);
+}
+
+// Swaps in nt as the current table (all stripes held), old table is freed once readers are done with it
+static void
+__gs_hash_table_concurrent_publish(gs_hash_table_concurrent_header_t* hdr, gs_hash_table_concurrent_table_t* nt)
+{
+    gs_hash_table_concurrent_table_t* old = hdr->table;
+    gs_atomic_store_ptr(&hdr->table, nt);
+    *__gs_hash_table_concurrent_data(hdr) = nt->entries;
+
+    gs_hash_table_concurrent_retired_t r = {.table = old, .pending = 0xFFFFFFFF};
+    gs_spinlock_lock(&hdr->retire_lock);
+    gs_dyn_array_push(hdr->retired, r);
+    gs_atomic_store_u32(&hdr->retired_ct, gs_dyn_array_size(hdr->retired));
+    gs_spinlock_unlock(&hdr->retire_lock);
+}
+
+static void
+__gs_hash_table_concurrent_grow(gs_hash_table_concurrent_header_t* hdr)
+{
+    __gs_hash_table_concurrent_lock_all(hdr);
+
+    gs_hash_table_concurrent_table_t* t = hdr->table;
+    if (gs_atomic_load_u32(&hdr->used) + 1 > t->capacity / 4 * 3)
+    {
+        // Sized from live entries only, so a table full of tombstones is just rebuilt
+        const uint32_t live = gs_atomic_load_u32(&hdr->size);
+        uint32_t cap = GS_HASH_TABLE_CONCURRENT_MIN_CAPACITY;
+        while (cap / 2 < live + 1) cap *= 2;
+
+        gs_hash_table_concurrent_table_t* nt = __gs_hash_table_concurrent_table_new(hdr, cap);
+        const uint32_t mask = cap - 1;
+        for (uint32_t i = 0; i < t->capacity; ++i)
+        {
+            const uint32_t st = t->slots[i].state;
+            if (!(st & GS_HASH_TABLE_CONCURRENT_FULL)) continue;
+
+            const uint8_t* e = __gs_hash_table_concurrent_entry(hdr, t, i);
+            uint32_t j = (uint32_t)__gs_hash_table_concurrent_hash(hdr, e) & mask;
+            while (nt->slots[j].state) j = (j + 1) & mask;
+            memcpy(__gs_hash_table_concurrent_entry(hdr, nt, j), e, hdr->stride);
+            nt->slots[j].state = st;
+        }
+
+        gs_atomic_store_u32(&hdr->used, live);
+        __gs_hash_table_concurrent_publish(hdr, nt);
+    }
+
+    __gs_hash_table_concurrent_unlock_all(hdr);
+    __gs_hash_table_concurrent_reclaim(hdr);
+}
+
+GS_API_DECL bool
+gs_hash_table_concurrent_get_func(gs_hash_table_concurrent_header_t* hdr, const void* key, void* out_val)
+{
+    const uint64_t hash = __gs_hash_table_concurrent_hash(hdr, key);
+    const uint32_t tag = __gs_hash_table_concurrent_tag(hash);
+    bool found = false;
+
+    // Announce before loading the table, so growth can't free it from under us
+    gs_hash_table_concurrent_reader_t* reader = &hdr->readers[__gs_hash_table_concurrent_reader_slot()];
+    gs_atomic_add_u32(&reader->count, 1);
+
+    const gs_hash_table_concurrent_table_t* t = (const gs_hash_table_concurrent_table_t*)gs_atomic_load_ptr(&hdr->table);
+    const uint32_t mask = t->capacity - 1;
+    uint32_t i = (uint32_t)hash & mask;
+
+    for (uint32_t c = 0; c < t->capacity; ++c, i = (i + 1) & mask)
+    {
+        gs_hash_table_concurrent_slot_t* slot = &t->slots[i];
+        const uint32_t st = gs_atomic_load_acq_u32(&slot->state);
+        if (st == GS_HASH_TABLE_CONCURRENT_EMPTY) break;
+        if (st != tag) continue;
+
+        // Keys never change once published
+        const uint8_t* e = __gs_hash_table_concurrent_entry(hdr, t, i);
+        if (memcmp(e, key, hdr->key_size) != 0) continue;
+
+        found = true;
+        if (out_val)
+        {
+            for (;;)
+            {
+                const uint32_t s0 = gs_atomic_load_acq_u32(&slot->seq);
+                if (s0 & 1) {
+                    gs_cpu_relax();
+                    continue;
+                }
+                // May race with an overwrite, copy is only kept if seq didn't move
+                memcpy(out_val, e + hdr->val_offset, hdr->val_size);
+                gs_atomic_fence_acq();
+                if (gs_atomic_load_u32(&slot->seq) == s0) break;
+            }
+        }
+        break;
+    }
+
+    gs_atomic_add_u32(&reader->count, (uint32_t)-1);
+    return found;
+}
+
+GS_API_DECL bool
+gs_hash_table_concurrent_insert_func(gs_hash_table_concurrent_header_t* hdr, const void* key, const void* val, bool overwrite)
+{
+    const uint64_t hash = __gs_hash_table_concurrent_hash(hdr, key);
+    const uint32_t tag = __gs_hash_table_concurrent_tag(hash);
+    gs_spinlock_t* lock = &hdr->stripes[__gs_hash_table_concurrent_stripe(hash)].lock;
+    bool inserted = false;
+
+    gs_spinlock_lock(lock);
+
+    // Table can't be swapped while we hold a stripe
+    gs_hash_table_concurrent_table_t* t = hdr->table;
+    while (gs_atomic_load_u32(&hdr->used) + 1 > t->capacity / 4 * 3)
+    {
+        gs_spinlock_unlock(lock);
+        __gs_hash_table_concurrent_grow(hdr);
+        gs_spinlock_lock(lock);
+        t = hdr->table;
+    }
+
+    // Same key always hashes to the same stripe, so it can only be found before the first empty slot
+    const uint32_t mask = t->capacity - 1;
+    for (uint32_t i = (uint32_t)hash & mask;; i = (i + 1) & mask)
+    {
+        gs_hash_table_concurrent_slot_t* slot = &t->slots[i];
+        const uint32_t st = gs_atomic_load_acq_u32(&slot->state);
+        uint8_t* e = __gs_hash_table_concurrent_entry(hdr, t, i);
+
+        if (st == GS_HASH_TABLE_CONCURRENT_EMPTY)
+        {
+            // Lost to a writer on another stripe, look again at the same slot
+            if (!gs_atomic_cas_u32(&slot->state, GS_HASH_TABLE_CONCURRENT_EMPTY, GS_HASH_TABLE_CONCURRENT_BUSY)) {
+                i = (i - 1) & mask;
+                continue;
+            }
+            memcpy(e, key, hdr->key_size);
+            memcpy(e + hdr->val_offset, val, hdr->val_size);
+            gs_atomic_store_rel_u32(&slot->state, tag);
+            gs_atomic_add_u32(&hdr->used, 1);
+            gs_atomic_add_u32(&hdr->size, 1);
+            inserted = true;
+            break;
+        }
+
+        if (st == tag && memcmp(e, key, hdr->key_size) == 0)
+        {
+            if (overwrite)
+            {
+                const uint32_t s = slot->seq;
+                gs_atomic_store_u32(&slot->seq, s + 1);
+                gs_atomic_fence_rel();
+                memcpy(e + hdr->val_offset, val, hdr->val_size);
+                gs_atomic_store_rel_u32(&slot->seq, s + 2);
+            }
+            break;
+        }
+    }
+
+    gs_spinlock_unlock(lock);
+    __gs_hash_table_concurrent_reclaim(hdr);
+    return inserted;
+}
+
+GS_API_DECL bool
+gs_hash_table_concurrent_erase_func(gs_hash_table_concurrent_header_t* hdr, const void* key)
+{
+    const uint64_t hash = __gs_hash_table_concurrent_hash(hdr, key);
+    const uint32_t tag = __gs_hash_table_concurrent_tag(hash);
+    gs_spinlock_t* lock = &hdr->stripes[__gs_hash_table_concurrent_stripe(hash)].lock;
+    bool erased = false;
+
+    gs_spinlock_lock(lock);
+
+    gs_hash_table_concurrent_table_t* t = hdr->table;
+    const uint32_t mask = t->capacity - 1;
+    uint32_t i = (uint32_t)hash & mask;
+    for (uint32_t c = 0; c < t->capacity; ++c, i = (i + 1) & mask)
+    {
+        gs_hash_table_concurrent_slot_t* slot = &t->slots[i];
+        const uint32_t st = gs_atomic_load_acq_u32(&slot->state);
+        if (st == GS_HASH_TABLE_CONCURRENT_EMPTY) break;
+        if (st == tag && memcmp(__gs_hash_table_concurrent_entry(hdr, t, i), key, hdr->key_size) == 0)
+        {
+            // Tombstone keeps probe chains intact, slot is only reused after the next rebuild
+            gs_atomic_store_rel_u32(&slot->state, GS_HASH_TABLE_CONCURRENT_DELETED);
+            gs_atomic_add_u32(&hdr->size, (uint32_t)-1);
+            erased = true;
+            break;
+        }
+    }
+
+    gs_spinlock_unlock(lock);
+    __gs_hash_table_concurrent_reclaim(hdr);
+    return erased;
+}
+
+GS_API_DECL void
+gs_hash_table_concurrent_clear_func(gs_hash_table_concurrent_header_t* hdr)
+{
+    // Fresh table rather than wiping slots in place, readers may still be probing the old one
+    __gs_hash_table_concurrent_lock_all(hdr);
+    __gs_hash_table_concurrent_publish(hdr, __gs_hash_table_concurrent_table_new(hdr, hdr->table->capacity));
+    gs_atomic_store_u32(&hdr->size, 0);
+    gs_atomic_store_u32(&hdr->used, 0);
+    __gs_hash_table_concurrent_unlock_all(hdr);
+    __gs_hash_table_concurrent_reclaim(hdr);
+}
+
+GS_API_DECL uint32_t
+__gs_hash_table_concurrent_find_first_valid_iterator(const gs_hash_table_concurrent_header_t* hdr, uint32_t idx)
+{
+    const gs_hash_table_concurrent_table_t* t = hdr->table;
+    for (; idx < t->capacity; ++idx) {
+        if (t->slots[idx].state & GS_HASH_TABLE_CONCURRENT_FULL) return idx;
+    }
+    return t->capacity;
+}
+
+#endif // GS_HASH_TABLE_CONCURRENT_IMPL
+#endif // GS_HASH_TABLE_CONCURRENT_H
@@ -0,0 +1,677 @@
+#ifndef GS_HASH_TABLE_SIMD_H
+#define GS_HASH_TABLE_SIMD_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger simd hash table implementation like this:
+
+        #define GS_HASH_TABLE_SIMD_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_HASH_TABLE_SIMD_IMPL
+        #include "gs_hash_table_simd.h"
+
+    All other files should just #include "gs_hash_table_simd.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_HASH_TABLE_SIMD_IMPL
+        #include "gs_hash_table_simd.h"
+
+    To move existing gs_hash_table(K, V) / gs_slot_map(K, V) call sites over to this backend, also define
+    GS_HASH_TABLE_SIMD_OVERRIDE before the include. This remaps the gs_hash_table_* macros for the rest
+    of that translation unit, so only do this in files that do not touch hash tables owned by gunslinger
+    itself (asset manager, graphics internals, etc.).
+
+    To bind tables to a gs_allocator_t (arena, frame allocator, ...) with gs_hash_table_simd_init_with_allocator(),
+    include gs_allocator.h BEFORE this file.
+
+    ================================================================================================================
+*/
+
+/*
+    Open addressing hash table with a separate control byte array:
+
+        * Each slot has one control byte: 0x80 when empty, or the low 7 bits of the key's hash when full.
+        * Each entry caches its key's full hash, so probes compare hashes before keys and growing/erasing
+          never rehashes a key.
+        * The *_h variants take a hash precomputed with gs_hash_table_simd_key_hash(), so a key looked
+          up across several tables is only hashed once.
+        * Probing is linear, scanning 16 control bytes at a time (SSE2 / NEON, scalar fallback).
+        * Deletion uses backward shifting, so there are never any tombstones to skip over.
+        * Iteration scans control bytes 16 at a time rather than touching every entry.
+*/
+
+/*==== Interface ====*/
+
+#if (defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define GS_HASH_TABLE_SIMD_SSE2
+#elif (defined __ARM_NEON && defined __aarch64__)
+    #include <arm_neon.h>
+    #define GS_HASH_TABLE_SIMD_NEON
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+#define GS_HASH_TABLE_SIMD_GROUP_SIZE       16
+#define GS_HASH_TABLE_SIMD_MIN_CAPACITY     16
+#define GS_HASH_TABLE_SIMD_CTRL_EMPTY       0x80
+
+typedef struct gs_hash_table_simd_header_t
+{
+    uint8_t* ctrl;          // Control bytes (capacity + GROUP_SIZE - 1, tail mirrors head for wrapping loads)
+    uint32_t capacity;      // Number of slots (power of 2, or 0 if not allocated)
+    uint32_t size;          // Number of active entries
+    uint32_t key_size;      // Size of key type in bytes
+    uint32_t key_offset;    // Byte offset of key within an entry
+    uint32_t stride;        // Size of a single entry in bytes
+    uint32_t tmp_idx;
+    struct gs_allocator_t* allocator;   // Table and slots are allocated through this (NULL for gs_malloc)
+} gs_hash_table_simd_header_t;
+
+#define __gs_hash_table_simd_entry(__HMK, __HMV)\
+    struct\
+    {\
+        size_t hash;\
+        __HMK key;\
+        __HMV val;\
+    }
+
+#define gs_hash_table_simd(__HMK, __HMV)\
+    struct {\
+        gs_hash_table_simd_header_t hdr;\
+        __gs_hash_table_simd_entry(__HMK, __HMV)* data;\
+        __HMK tmp_key;\
+        __HMV tmp_val;\
+    }*
+
+#define gs_hash_table_simd_new(__K, __V)\
+    NULL
+
+/*=== Group Scanning ===*/
+
+gs_force_inline
+uint32_t __gs_hash_table_simd_ctz(uint32_t v)
+{
+#ifdef _MSC_VER
+    unsigned long idx = 0;
+    _BitScanForward(&idx, v);
+    return (uint32_t)idx;
+#else
+    return (uint32_t)__builtin_ctz(v);
+#endif
+}
+
+#ifdef GS_HASH_TABLE_SIMD_NEON
+gs_force_inline
+uint32_t __gs_hash_table_simd_neon_movemask(uint8x16_t v)
+{
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t m = vandq_u8(v, vld1q_u8(bits));
+    return (uint32_t)vaddv_u8(vget_low_u8(m)) | ((uint32_t)vaddv_u8(vget_high_u8(m)) << 8);
+}
+#endif
+
+// Bitmask of the slots in group starting at ctrl whose control byte equals b
+gs_force_inline
+uint32_t __gs_hash_table_simd_match(const uint8_t* ctrl, uint8_t b)
+{
+#if (defined GS_HASH_TABLE_SIMD_SSE2)
+    __m128i g = _mm_loadu_si128((const __m128i*)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)b)));
+#elif (defined GS_HASH_TABLE_SIMD_NEON)
+    return __gs_hash_table_simd_neon_movemask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(b)));
+#else
+    uint32_t m = 0;
+    for (uint32_t i = 0; i < GS_HASH_TABLE_SIMD_GROUP_SIZE; ++i) {
+        m |= (uint32_t)(ctrl[i] == b) << i;
+    }
+    return m;
+#endif
+}
+
+// Bitmask of the slots in group starting at ctrl that are full (high bit clear)
+gs_force_inline
+uint32_t __gs_hash_table_simd_match_full(const uint8_t* ctrl)
+{
+#if (defined GS_HASH_TABLE_SIMD_SSE2)
+    return ~(uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl)) & 0xFFFF;
+#elif (defined GS_HASH_TABLE_SIMD_NEON)
+    return __gs_hash_table_simd_neon_movemask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl)), vdupq_n_s8(0))) ^ 0xFFFF;
+#else
+    uint32_t m = 0;
+    for (uint32_t i = 0; i < GS_HASH_TABLE_SIMD_GROUP_SIZE; ++i) {
+        m |= (uint32_t)(!(ctrl[i] & 0x80)) << i;
+    }
+    return m;
+#endif
+}
+
+#define __gs_hash_table_simd_match_empty(__CTRL)\
+    __gs_hash_table_simd_match((__CTRL), GS_HASH_TABLE_SIMD_CTRL_EMPTY)
+
+#define __gs_hash_table_simd_hash(__KEY, __KSZ)\
+    ((size_t)gs_hash_bytes((void*)(__KEY), (__KSZ), GS_HASH_TABLE_HASH_SEED))
+
+#define __gs_hash_table_simd_entry_hash(__E)\
+    (*(size_t*)(__E))
+
+#define __gs_hash_table_simd_h1(__HSH)\
+    ((size_t)(__HSH) >> 7)
+
+#define __gs_hash_table_simd_h2(__HSH)\
+    ((uint8_t)((__HSH) & 0x7F))
+
+/*=== Lookup ===*/
+
+gs_force_inline
+uint32_t __gs_hash_table_simd_find_func(gs_hash_table_simd_header_t* hdr, void* data, void* key, size_t hash)
+{
+    if (!hdr->size) return GS_HASH_TABLE_INVALID_INDEX;
+
+    const uint32_t mask = hdr->capacity - 1;
+    const uint8_t h2 = __gs_hash_table_simd_h2(hash);
+    uint32_t pos = (uint32_t)__gs_hash_table_simd_h1(hash) & mask;
+
+    for (uint32_t probed = 0; probed < hdr->capacity; probed += GS_HASH_TABLE_SIMD_GROUP_SIZE)
+    {
+        const uint8_t* g = hdr->ctrl + pos;
+        uint32_t m = __gs_hash_table_simd_match(g, h2);
+        while (m)
+        {
+            uint32_t idx = (pos + __gs_hash_table_simd_ctz(m)) & mask;
+            uint8_t* e = (uint8_t*)data + (size_t)idx * hdr->stride;
+            if (__gs_hash_table_simd_entry_hash(e) == hash && gs_compare_bytes(e + hdr->key_offset, key, hdr->key_size)) {
+                return idx;
+            }
+            m &= m - 1;
+        }
+
+        // Linear probing keeps every key before the first empty slot after its home, so we can stop here
+        if (__gs_hash_table_simd_match_empty(g)) break;
+        pos = (pos + GS_HASH_TABLE_SIMD_GROUP_SIZE) & mask;
+    }
+
+    return GS_HASH_TABLE_INVALID_INDEX;
+}
+
+GS_API_DECL void
+__gs_hash_table_simd_init_impl(void** ht, size_t sz, struct gs_allocator_t* allocator);
+
+GS_API_DECL void
+__gs_hash_table_simd_free_func(void* ht, size_t sz);
+
+GS_API_DECL uint32_t
+__gs_hash_table_simd_insert_func(gs_hash_table_simd_header_t* hdr, void** data, void* key, size_t hash);
+
+GS_API_DECL void
+__gs_hash_table_simd_erase_func(gs_hash_table_simd_header_t* hdr, void* data, uint32_t idx);
+
+GS_API_DECL void
+__gs_hash_table_simd_reserve_func(gs_hash_table_simd_header_t* hdr, void** data, uint32_t ct);
+
+GS_API_DECL void
+__gs_hash_table_simd_clear_func(gs_hash_table_simd_header_t* hdr);
+
+#define __gs_hash_table_simd_init_with(__HT, __ALLOC)\
+    do {\
+        __gs_hash_table_simd_init_impl((void**)&(__HT), sizeof(*(__HT)), (__ALLOC));\
+        (__HT)->hdr.key_size = (uint32_t)sizeof((__HT)->tmp_key);\
+        (__HT)->hdr.stride = (uint32_t)sizeof(*((__HT)->data));\
+        (__HT)->hdr.key_offset = (uint32_t)((size_t)&((__HT)->data->key) - (size_t)((__HT)->data));\
+    } while (0)
+
+#define gs_hash_table_simd_init(__HT)\
+    __gs_hash_table_simd_init_with((__HT), NULL)
+
+#ifdef GS_ALLOCATOR_H
+    // All growth and freeing of the table goes through __ALLOC (table must not exist yet)
+    #define gs_hash_table_simd_init_with_allocator(__HT, __ALLOC)\
+        do {\
+            gs_assert((__HT) == NULL);\
+            __gs_hash_table_simd_init_with((__HT), (__ALLOC));\
+        } while (0)
+#endif
+
+#define gs_hash_table_simd_size(__HT)\
+    ((__HT) != NULL ? (__HT)->hdr.size : 0)
+
+#define gs_hash_table_simd_capacity(__HT)\
+    ((__HT) != NULL ? (__HT)->hdr.capacity : 0)
+
+#define gs_hash_table_simd_load_factor(__HT)\
+    (gs_hash_table_simd_capacity(__HT) ? (float)(gs_hash_table_simd_size(__HT)) / (float)(gs_hash_table_simd_capacity(__HT)) : 0.f)
+
+#define gs_hash_table_simd_empty(__HT)\
+    (gs_hash_table_simd_size(__HT) == 0)
+
+// Size table to hold __CT entries without growing (single rehash at most)
+#define gs_hash_table_simd_reserve(__HT, __CT)\
+    do {\
+        if ((__HT) == NULL) {\
+            gs_hash_table_simd_init((__HT));\
+        }\
+        __gs_hash_table_simd_reserve_func(&(__HT)->hdr, (void**)&(__HT)->data, (uint32_t)(__CT));\
+    } while (0)
+
+#define gs_hash_table_simd_clear(__HT)\
+    do {\
+        if ((__HT) != NULL) {\
+            __gs_hash_table_simd_clear_func(&(__HT)->hdr);\
+        }\
+    } while (0)
+
+#define gs_hash_table_simd_free(__HT)\
+    do {\
+        if ((__HT) != NULL) {\
+            __gs_hash_table_simd_free_func((__HT), sizeof(*(__HT)));\
+            (__HT) = NULL;\
+        }\
+    } while (0)
+
+// Hash of key as stored by the table. Key type determines the hash, so it can be reused across tables sharing a key type.
+#define gs_hash_table_simd_key_hashp(__KP)\
+    (__gs_hash_table_simd_hash((__KP), sizeof(*(__KP))))
+
+// Same as above, through a table's temporary key (table must already exist)
+#define gs_hash_table_simd_key_hash(__HT, __HTK)\
+    ((__HT)->tmp_key = (__HTK), __gs_hash_table_simd_hash(&(__HT)->tmp_key, sizeof((__HT)->tmp_key)))
+
+// Inserts k/v pair with precomputed hash (overwrites value if key already exists)
+#define gs_hash_table_simd_insert_h(__HT, __HMK, __HMV, __HSH)\
+    do {\
+        if ((__HT) == NULL) {\
+            gs_hash_table_simd_init((__HT));\
+        }\
+        (__HT)->tmp_key = (__HMK);\
+        (__HT)->hdr.tmp_idx = __gs_hash_table_simd_insert_func(&(__HT)->hdr, (void**)&(__HT)->data, (void*)&(__HT)->tmp_key, (__HSH));\
+        (__HT)->data[(__HT)->hdr.tmp_idx].val = (__HMV);\
+    } while (0)
+
+// Inserts k/v pair (overwrites value if key already exists)
+#define gs_hash_table_simd_insert(__HT, __HMK, __HMV)\
+    do {\
+        if ((__HT) == NULL) {\
+            gs_hash_table_simd_init((__HT));\
+        }\
+        (__HT)->tmp_key = (__HMK);\
+        (__HT)->hdr.tmp_idx = __gs_hash_table_simd_insert_func(&(__HT)->hdr, (void**)&(__HT)->data, (void*)&(__HT)->tmp_key,\
+            __gs_hash_table_simd_hash(&(__HT)->tmp_key, sizeof((__HT)->tmp_key)));\
+        (__HT)->data[(__HT)->hdr.tmp_idx].val = (__HMV);\
+    } while (0)
+
+// Inserts __CT k/v pairs from parallel key/value arrays, growing the table at most once up front
+#define gs_hash_table_simd_insert_range(__HT, __KEYS, __VALS, __CT)\
+    do {\
+        const uint32_t __N = (uint32_t)(__CT);\
+        gs_hash_table_simd_reserve((__HT), (__HT) ? (__HT)->hdr.size + __N : __N);\
+        for (uint32_t __I = 0; __I < __N; ++__I) {\
+            gs_hash_table_simd_insert((__HT), (__KEYS)[__I], (__VALS)[__I]);\
+        }\
+    } while (0)
+
+#define __gs_hash_table_simd_find_h(__HT, __HTK, __HSH)\
+    ((__HT)->tmp_key = (__HTK),\
+        __gs_hash_table_simd_find_func(&(__HT)->hdr, (void*)(__HT)->data, (void*)&(__HT)->tmp_key, (__HSH)))
+
+#define __gs_hash_table_simd_find(__HT, __HTK)\
+    ((__HT)->tmp_key = (__HTK),\
+        __gs_hash_table_simd_find_func(&(__HT)->hdr, (void*)(__HT)->data, (void*)&(__HT)->tmp_key,\
+            __gs_hash_table_simd_hash(&(__HT)->tmp_key, sizeof((__HT)->tmp_key))))
+
+// Get key at index
+#define gs_hash_table_simd_getk(__HT, __I)\
+    ((__HT)->data[(__I)].key)
+
+// Get val at index
+#define gs_hash_table_simd_geti(__HT, __I)\
+    ((__HT)->data[(__I)].val)
+
+#define gs_hash_table_simd_get(__HT, __HTK)\
+    (gs_hash_table_simd_geti((__HT), __gs_hash_table_simd_find((__HT), (__HTK))))
+
+#define gs_hash_table_simd_getp(__HT, __HTK)\
+    (\
+        (__HT)->hdr.tmp_idx = __gs_hash_table_simd_find((__HT), (__HTK)),\
+        ((__HT)->hdr.tmp_idx != GS_HASH_TABLE_INVALID_INDEX ? &gs_hash_table_simd_geti((__HT), (__HT)->hdr.tmp_idx) : NULL)\
+    )
+
+#define gs_hash_table_simd_exists(__HT, __HTK)\
+    ((__HT) && __gs_hash_table_simd_find((__HT), (__HTK)) != GS_HASH_TABLE_INVALID_INDEX)
+
+#define gs_hash_table_simd_key_exists(__HT, __HTK)\
+    (gs_hash_table_simd_exists((__HT), (__HTK)))
+
+#define gs_hash_table_simd_erase(__HT, __HTK)\
+    do {\
+        if ((__HT)) {\
+            uint32_t __IDX = __gs_hash_table_simd_find((__HT), (__HTK));\
+            if (__IDX != GS_HASH_TABLE_INVALID_INDEX) {\
+                __gs_hash_table_simd_erase_func(&(__HT)->hdr, (void*)(__HT)->data, __IDX);\
+            }\
+        }\
+    } while (0)
+
+/*=== Precomputed Hash Variants ===*/
+
+#define gs_hash_table_simd_get_h(__HT, __HTK, __HSH)\
+    (gs_hash_table_simd_geti((__HT), __gs_hash_table_simd_find_h((__HT), (__HTK), (__HSH))))
+
+#define gs_hash_table_simd_getp_h(__HT, __HTK, __HSH)\
+    (\
+        (__HT)->hdr.tmp_idx = __gs_hash_table_simd_find_h((__HT), (__HTK), (__HSH)),\
+        ((__HT)->hdr.tmp_idx != GS_HASH_TABLE_INVALID_INDEX ? &gs_hash_table_simd_geti((__HT), (__HT)->hdr.tmp_idx) : NULL)\
+    )
+
+#define gs_hash_table_simd_exists_h(__HT, __HTK, __HSH)\
+    ((__HT) && __gs_hash_table_simd_find_h((__HT), (__HTK), (__HSH)) != GS_HASH_TABLE_INVALID_INDEX)
+
+#define gs_hash_table_simd_erase_h(__HT, __HTK, __HSH)\
+    do {\
+        if ((__HT)) {\
+            uint32_t __IDX = __gs_hash_table_simd_find_h((__HT), (__HTK), (__HSH));\
+            if (__IDX != GS_HASH_TABLE_INVALID_INDEX) {\
+                __gs_hash_table_simd_erase_func(&(__HT)->hdr, (void*)(__HT)->data, __IDX);\
+            }\
+        }\
+    } while (0)
+
+/*===== Hash Table Iterator ====*/
+
+gs_force_inline
+uint32_t __gs_hash_table_simd_find_first_valid_iterator(const gs_hash_table_simd_header_t* hdr, uint32_t idx)
+{
+    for (; idx < hdr->capacity; idx += GS_HASH_TABLE_SIMD_GROUP_SIZE)
+    {
+        uint32_t m = __gs_hash_table_simd_match_full(hdr->ctrl + idx);
+
+        // Mirrored tail bytes belong to the head of the table, so mask them off
+        const uint32_t rem = hdr->capacity - idx;
+        if (rem < GS_HASH_TABLE_SIMD_GROUP_SIZE) m &= (1u << rem) - 1;
+        if (m) return idx + __gs_hash_table_simd_ctz(m);
+    }
+    return hdr->capacity;
+}
+
+#define gs_hash_table_simd_iter_new(__HT)\
+    ((__HT) ? __gs_hash_table_simd_find_first_valid_iterator(&(__HT)->hdr, 0) : 0)
+
+#define gs_hash_table_simd_iter_valid(__HT, __IT)\
+    ((__IT) < gs_hash_table_simd_capacity((__HT)))
+
+#define gs_hash_table_simd_find_valid_iter(__HT, __IT)\
+    ((__IT) = __gs_hash_table_simd_find_first_valid_iterator(&(__HT)->hdr, (__IT)))
+
+#define gs_hash_table_simd_iter_advance(__HT, __IT)\
+    ((__IT) = __gs_hash_table_simd_find_first_valid_iterator(&(__HT)->hdr, (__IT) + 1))
+
+#define gs_hash_table_simd_iter_get(__HT, __IT)\
+    gs_hash_table_simd_geti(__HT, __IT)
+
+#define gs_hash_table_simd_iter_getp(__HT, __IT)\
+    (&(gs_hash_table_simd_geti(__HT, __IT)))
+
+#define gs_hash_table_simd_iter_getk(__HT, __IT)\
+    (gs_hash_table_simd_getk(__HT, __IT))
+
+#define gs_hash_table_simd_iter_getkp(__HT, __IT)\
+    (&(gs_hash_table_simd_getk(__HT, __IT)))
+
+/*==== Override ====*/
+
+#ifdef GS_HASH_TABLE_SIMD_OVERRIDE
+
+    #undef gs_hash_table
+    #undef gs_hash_table_new
+    #undef gs_hash_table_init
+    #undef gs_hash_table_size
+    #undef gs_hash_table_capacity
+    #undef gs_hash_table_load_factor
+    #undef gs_hash_table_empty
+    #undef gs_hash_table_clear
+    #undef gs_hash_table_reserve
+    #undef gs_hash_table_insert_range
+    #undef gs_hash_table_free
+    #undef gs_hash_table_insert
+    #undef gs_hash_table_getk
+    #undef gs_hash_table_geti
+    #undef gs_hash_table_get
+    #undef gs_hash_table_getp
+    #undef gs_hash_table_exists
+    #undef gs_hash_table_key_exists
+    #undef gs_hash_table_erase
+    #undef gs_hash_table_iter_new
+    #undef gs_hash_table_iter_valid
+    #undef gs_hash_table_find_valid_iter
+    #undef gs_hash_table_iter_advance
+    #undef gs_hash_table_iter_get
+    #undef gs_hash_table_iter_getp
+    #undef gs_hash_table_iter_getk
+    #undef gs_hash_table_iter_getkp
+    #undef gs_hash_table_key_hash
+    #undef gs_hash_table_key_hashp
+    #undef gs_hash_table_insert_h
+    #undef gs_hash_table_get_h
+    #undef gs_hash_table_getp_h
+    #undef gs_hash_table_exists_h
+    #undef gs_hash_table_erase_h
+
+    #define gs_hash_table(__HMK, __HMV)             gs_hash_table_simd(__HMK, __HMV)
+    #define gs_hash_table_new(__K, __V)             gs_hash_table_simd_new(__K, __V)
+    #define gs_hash_table_init(__HT, __K, __V)      gs_hash_table_simd_init(__HT)
+    #ifdef GS_ALLOCATOR_H
+        #define gs_hash_table_init_with_allocator(__HT, __K, __V, __ALLOC)\
+            gs_hash_table_simd_init_with_allocator(__HT, __ALLOC)
+    #endif
+    #define gs_hash_table_size(__HT)                gs_hash_table_simd_size(__HT)
+    #define gs_hash_table_capacity(__HT)            gs_hash_table_simd_capacity(__HT)
+    #define gs_hash_table_load_factor(__HT)         gs_hash_table_simd_load_factor(__HT)
+    #define gs_hash_table_empty(__HT)               gs_hash_table_simd_empty(__HT)
+    #define gs_hash_table_clear(__HT)               gs_hash_table_simd_clear(__HT)
+    #define gs_hash_table_reserve(__HT, __K, __V, __CT) gs_hash_table_simd_reserve(__HT, __CT)
+    #define gs_hash_table_insert_range(__HT, __KS, __VS, __CT) gs_hash_table_simd_insert_range(__HT, __KS, __VS, __CT)
+    #define gs_hash_table_free(__HT)                gs_hash_table_simd_free(__HT)
+    #define gs_hash_table_insert(__HT, __K, __V)    gs_hash_table_simd_insert(__HT, __K, __V)
+    #define gs_hash_table_getk(__HT, __I)           gs_hash_table_simd_getk(__HT, __I)
+    #define gs_hash_table_geti(__HT, __I)           gs_hash_table_simd_geti(__HT, __I)
+    #define gs_hash_table_get(__HT, __K)            gs_hash_table_simd_get(__HT, __K)
+    #define gs_hash_table_getp(__HT, __K)           gs_hash_table_simd_getp(__HT, __K)
+    #define gs_hash_table_exists(__HT, __K)         gs_hash_table_simd_exists(__HT, __K)
+    #define gs_hash_table_key_exists(__HT, __K)     gs_hash_table_simd_key_exists(__HT, __K)
+    #define gs_hash_table_erase(__HT, __K)          gs_hash_table_simd_erase(__HT, __K)
+    #define gs_hash_table_iter_new(__HT)            gs_hash_table_simd_iter_new(__HT)
+    #define gs_hash_table_iter_valid(__HT, __IT)    gs_hash_table_simd_iter_valid(__HT, __IT)
+    #define gs_hash_table_find_valid_iter(__HT, __IT) gs_hash_table_simd_find_valid_iter(__HT, __IT)
+    #define gs_hash_table_iter_advance(__HT, __IT)  gs_hash_table_simd_iter_advance(__HT, __IT)
+    #define gs_hash_table_iter_get(__HT, __IT)      gs_hash_table_simd_iter_get(__HT, __IT)
+    #define gs_hash_table_iter_getp(__HT, __IT)     gs_hash_table_simd_iter_getp(__HT, __IT)
+    #define gs_hash_table_iter_getk(__HT, __IT)     gs_hash_table_simd_iter_getk(__HT, __IT)
+    #define gs_hash_table_iter_getkp(__HT, __IT)    gs_hash_table_simd_iter_getkp(__HT, __IT)
+    #define gs_hash_table_key_hash(__HT, __K)       gs_hash_table_simd_key_hash(__HT, __K)
+    #define gs_hash_table_key_hashp(__KP)           gs_hash_table_simd_key_hashp(__KP)
+    #define gs_hash_table_insert_h(__HT, __K, __V, __H) gs_hash_table_simd_insert_h(__HT, __K, __V, __H)
+    #define gs_hash_table_get_h(__HT, __K, __H)     gs_hash_table_simd_get_h(__HT, __K, __H)
+    #define gs_hash_table_getp_h(__HT, __K, __H)    gs_hash_table_simd_getp_h(__HT, __K, __H)
+    #define gs_hash_table_exists_h(__HT, __K, __H)  gs_hash_table_simd_exists_h(__HT, __K, __H)
+    #define gs_hash_table_erase_h(__HT, __K, __H)   gs_hash_table_simd_erase_h(__HT, __K, __H)
+
+    // Slot map iterators reach into hash table internals directly
+    #undef gs_slot_map_iter_advance
+    #undef gs_slot_map_iter_getkp
+
+    #define gs_slot_map_iter_advance(__SM, __IT)\
+        gs_hash_table_simd_iter_advance((__SM)->ht, (__IT))
+
+    #define gs_slot_map_iter_getkp(__SM, __IT)\
+        gs_hash_table_simd_iter_getkp((__SM)->ht, (__IT))
+
+#endif // GS_HASH_TABLE_SIMD_OVERRIDE
+
+/*==== Implementation ====*/
+
+#ifdef GS_HASH_TABLE_SIMD_IMPL
+
+#ifdef GS_ALLOCATOR_H
+    #define __gs_hash_table_simd_malloc(__A, __SZ)      gs_allocator_malloc((__A), (__SZ))
+    #define __gs_hash_table_simd_mfree(__A, __P, __SZ)  gs_allocator_free((__A), (__P), (__SZ))
+#else
+    #define __gs_hash_table_simd_malloc(__A, __SZ)      ((void)(__A), gs_malloc((__SZ)))
+    #define __gs_hash_table_simd_mfree(__A, __P, __SZ)  ((void)(__A), (void)(__SZ), gs_free((__P)))
+#endif
+
+// Size of the combined slot/control byte allocation for a given capacity
+#define __gs_hash_table_simd_alloc_size(__HDR, __CAP)\
+    ((size_t)(__CAP) * (__HDR)->stride + (size_t)(__CAP) + GS_HASH_TABLE_SIMD_GROUP_SIZE - 1)
+
+GS_API_DECL void
+__gs_hash_table_simd_init_impl(void** ht, size_t sz, struct gs_allocator_t* allocator)
+{
+    *ht = __gs_hash_table_simd_malloc(allocator, sz);
+    memset(*ht, 0, sz);
+    ((gs_hash_table_simd_header_t*)*ht)->allocator = allocator;
+}
+
+GS_API_DECL void
+__gs_hash_table_simd_free_func(void* ht, size_t sz)
+{
+    // Header is the first member of every table
+    gs_hash_table_simd_header_t* hdr = (gs_hash_table_simd_header_t*)ht;
+    void** data = (void**)((uint8_t*)ht + sizeof(gs_hash_table_simd_header_t));
+    if (*data) {
+        __gs_hash_table_simd_mfree(hdr->allocator, *data, __gs_hash_table_simd_alloc_size(hdr, hdr->capacity));
+    }
+    __gs_hash_table_simd_mfree(hdr->allocator, ht, sz);
+}
+
+gs_force_inline
+void __gs_hash_table_simd_set_ctrl(gs_hash_table_simd_header_t* hdr, uint32_t idx, uint8_t c)
+{
+    hdr->ctrl[idx] = c;
+    if (idx < GS_HASH_TABLE_SIMD_GROUP_SIZE - 1) {
+        hdr->ctrl[hdr->capacity + idx] = c;
+    }
+}
+
+// Returns index of first empty slot along the probe sequence starting at hash's home slot
+gs_force_inline
+uint32_t __gs_hash_table_simd_find_empty(gs_hash_table_simd_header_t* hdr, size_t hash)
+{
+    const uint32_t mask = hdr->capacity - 1;
+    uint32_t pos = (uint32_t)__gs_hash_table_simd_h1(hash) & mask;
+    for (;;)
+    {
+        uint32_t m = __gs_hash_table_simd_match_empty(hdr->ctrl + pos);
+        if (m) return (pos + __gs_hash_table_simd_ctz(m)) & mask;
+        pos = (pos + GS_HASH_TABLE_SIMD_GROUP_SIZE) & mask;
+    }
+}
+
+static void
+__gs_hash_table_simd_rehash(gs_hash_table_simd_header_t* hdr, void** data, uint32_t new_cap)
+{
+    gs_hash_table_simd_header_t old = *hdr;
+    uint8_t* old_data = (uint8_t*)*data;
+
+    // Slots and control bytes share a single allocation
+    const size_t slot_bytes = (size_t)new_cap * hdr->stride;
+    const size_t ctrl_bytes = (size_t)new_cap + GS_HASH_TABLE_SIMD_GROUP_SIZE - 1;
+    uint8_t* mem = (uint8_t*)__gs_hash_table_simd_malloc(hdr->allocator, slot_bytes + ctrl_bytes);
+    hdr->ctrl = mem + slot_bytes;
+    hdr->capacity = new_cap;
+    memset(hdr->ctrl, GS_HASH_TABLE_SIMD_CTRL_EMPTY, ctrl_bytes);
+
+    for (uint32_t i = 0; i < old.capacity; ++i)
+    {
+        if (old.ctrl[i] & 0x80) continue;
+        uint8_t* src = old_data + (size_t)i * old.stride;
+        uint32_t idx = __gs_hash_table_simd_find_empty(hdr, __gs_hash_table_simd_entry_hash(src));
+        __gs_hash_table_simd_set_ctrl(hdr, idx, old.ctrl[i]);
+        memcpy(mem + (size_t)idx * hdr->stride, src, hdr->stride);
+    }
+
+    if (old_data) __gs_hash_table_simd_mfree(hdr->allocator, old_data, __gs_hash_table_simd_alloc_size(&old, old.capacity));
+    *data = mem;
+}
+
+GS_API_DECL void
+__gs_hash_table_simd_reserve_func(gs_hash_table_simd_header_t* hdr, void** data, uint32_t ct)
+{
+    // Max load factor of 7/8
+    uint32_t cap = hdr->capacity ? hdr->capacity : GS_HASH_TABLE_SIMD_MIN_CAPACITY;
+    while ((uint64_t)ct * 8 > (uint64_t)cap * 7) cap *= 2;
+    if (cap != hdr->capacity) {
+        __gs_hash_table_simd_rehash(hdr, data, cap);
+    }
+}
+
+GS_API_DECL uint32_t
+__gs_hash_table_simd_insert_func(gs_hash_table_simd_header_t* hdr, void** data, void* key, size_t hash)
+{
+    if (hdr->capacity) {
+        uint32_t idx = __gs_hash_table_simd_find_func(hdr, *data, key, hash);
+        if (idx != GS_HASH_TABLE_INVALID_INDEX) return idx;
+    }
+
+    __gs_hash_table_simd_reserve_func(hdr, data, hdr->size + 1);
+
+    uint32_t idx = __gs_hash_table_simd_find_empty(hdr, hash);
+    uint8_t* e = (uint8_t*)*data + (size_t)idx * hdr->stride;
+    __gs_hash_table_simd_set_ctrl(hdr, idx, __gs_hash_table_simd_h2(hash));
+    __gs_hash_table_simd_entry_hash(e) = hash;
+    memcpy(e + hdr->key_offset, key, hdr->key_size);
+    hdr->size++;
+    return idx;
+}
+
+GS_API_DECL void
+__gs_hash_table_simd_erase_func(gs_hash_table_simd_header_t* hdr, void* data, uint32_t idx)
+{
+    const uint32_t mask = hdr->capacity - 1;
+    uint8_t* slots = (uint8_t*)data;
+    uint32_t i = idx;
+    uint32_t j = idx;
+
+    // Backward shift: pull following entries of the run back into the hole if their home allows it
+    for (;;)
+    {
+        j = (j + 1) & mask;
+        if (hdr->ctrl[j] & 0x80) break;
+
+        uint8_t* e = slots + (size_t)j * hdr->stride;
+        uint32_t home = (uint32_t)__gs_hash_table_simd_h1(__gs_hash_table_simd_entry_hash(e)) & mask;
+
+        // Entry stays put if its home lies cyclically within (i, j]
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (stays) continue;
+
+        memcpy(slots + (size_t)i * hdr->stride, e, hdr->stride);
+        __gs_hash_table_simd_set_ctrl(hdr, i, hdr->ctrl[j]);
+        i = j;
+    }
+
+    __gs_hash_table_simd_set_ctrl(hdr, i, GS_HASH_TABLE_SIMD_CTRL_EMPTY);
+    hdr->size--;
+}
+
+GS_API_DECL void
+__gs_hash_table_simd_clear_func(gs_hash_table_simd_header_t* hdr)
+{
+    if (hdr->ctrl) {
+        memset(hdr->ctrl, GS_HASH_TABLE_SIMD_CTRL_EMPTY, (size_t)hdr->capacity + GS_HASH_TABLE_SIMD_GROUP_SIZE - 1);
+    }
+    hdr->size = 0;
+}
+
+#endif // GS_HASH_TABLE_SIMD_IMPL
+#endif // GS_HASH_TABLE_SIMD_H
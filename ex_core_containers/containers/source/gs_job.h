@@ -0,0 +1,269 @@
+#ifndef GS_JOB_H
+#define GS_JOB_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger job pool implementation like this:
+
+        #define GS_JOB_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_JOB_IMPL
+        #include "gs_job.h"
+
+    All other files should just #include "gs_job.h" without the #define.
+
+    MUST include "gs.h", "gs_thread.h" and "gs_concurrent_queue.h" BEFORE this file, since this file relies on them:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+        #define GS_CONCURRENT_QUEUE_IMPL
+        #include "gs_concurrent_queue.h"
+
+        #define GS_JOB_IMPL
+        #include "gs_job.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Fixed pool of worker threads running fire-and-forget jobs:
+
+        * Jobs go through a gs_mpmc_queue. Idle workers sleep on a gs_semaphore_t, so an idle pool costs nothing.
+        * When the queue is full, gs_job_pool_submit() runs the job on the calling thread instead of blocking.
+        * Completion is tracked with an optional gs_job_counter_t per batch of jobs. gs_job_pool_wait() runs queued
+          jobs on the waiting thread until its counter drains, so waiting never idles a core.
+        * gs_job_pool_parallel_for() splits [0, count) into batches that the caller and the workers pull from.
+        * A pool with 0 threads (or where threads can't be created, like html5 without pthreads) runs every job
+          inline on submit.
+
+            gs_job_pool_t* pool = gs_job_pool_new((gs_job_pool_desc_t){0});     // Hardware threads - 1 workers
+
+            gs_job_counter_t ctr = {0};
+            for (uint32_t i = 0; i < ct; ++i) {
+                gs_job_pool_submit(pool, decode_job, &items[i], &ctr);
+            }
+            gs_job_pool_wait(pool, &ctr);
+
+            gs_job_pool_free(pool);
+*/
+
+/*==== Interface ====*/
+
+#define GS_JOB_POOL_QUEUE_CAPACITY_DEFAULT      4096
+
+typedef void (* gs_job_func_t)(void* user_data);
+typedef void (* gs_job_range_func_t)(uint32_t start, uint32_t end, void* user_data);
+
+typedef struct gs_job_counter_t
+{
+    uint32_t pending;
+} gs_job_counter_t;
+
+typedef struct gs_job_t
+{
+    gs_job_func_t func;
+    void* user_data;
+    gs_job_counter_t* counter;
+} gs_job_t;
+
+typedef struct gs_job_pool_desc_t
+{
+    uint32_t thread_ct;         // Worker threads (0 for hardware threads - 1), GS_JOB_POOL_INLINE for none
+    uint32_t queue_capacity;    // Queued jobs before submit runs them inline (0 for default)
+} gs_job_pool_desc_t;
+
+#define GS_JOB_POOL_INLINE      0xffffffff
+
+typedef struct gs_job_pool_t
+{
+    gs_mpmc_queue(gs_job_t) queue;
+    gs_semaphore_t wake;
+    gs_thread_t* threads;
+    uint32_t thread_ct;
+    uint32_t running;
+} gs_job_pool_t;
+
+GS_API_DECL gs_job_pool_t*
+gs_job_pool_new(gs_job_pool_desc_t desc);
+
+// Runs whatever is still queued, then joins all workers
+GS_API_DECL void
+gs_job_pool_free(gs_job_pool_t* pool);
+
+// Counter is optional, it is incremented here and decremented once the job has run
+GS_API_DECL void
+gs_job_pool_submit(gs_job_pool_t* pool, gs_job_func_t func, void* user_data, gs_job_counter_t* counter);
+
+// Runs one queued job on the calling thread, returns false if there was none
+GS_API_DECL bool
+gs_job_pool_run_one(gs_job_pool_t* pool);
+
+GS_API_DECL void
+gs_job_pool_wait(gs_job_pool_t* pool, gs_job_counter_t* counter);
+
+// Calls func over [0, count) in ranges of at most batch (0 picks one), returns once all ranges have run
+GS_API_DECL void
+gs_job_pool_parallel_for(gs_job_pool_t* pool, uint32_t count, uint32_t batch, gs_job_range_func_t func, void* user_data);
+
+#define gs_job_pool_thread_count(__POOL)\
+    ((__POOL) ? (__POOL)->thread_ct : 0)
+
+#define gs_job_counter_done(__CTR)\
+    (gs_atomic_load_acq_u32(&(__CTR)->pending) == 0)
+
+/*==== Implementation ====*/
+
+#ifdef GS_JOB_IMPL
+
+gs_force_inline void
+__gs_job_run(gs_job_t* job)
+{
+    job->func(job->user_data);
+    if (job->counter) gs_atomic_add_u32(&job->counter->pending, (uint32_t)-1);
+}
+
+static void
+__gs_job_worker(void* user_data)
+{
+    gs_job_pool_t* pool = (gs_job_pool_t*)user_data;
+    while (gs_atomic_load_acq_u32(&pool->running))
+    {
+        if (!gs_job_pool_run_one(pool)) gs_semaphore_wait(pool->wake);
+    }
+}
+
+GS_API_DECL gs_job_pool_t*
+gs_job_pool_new(gs_job_pool_desc_t desc)
+{
+    gs_job_pool_t* pool = gs_malloc(sizeof(gs_job_pool_t));
+    memset(pool, 0, sizeof(gs_job_pool_t));
+
+    uint32_t thread_ct = desc.thread_ct;
+    if (thread_ct == GS_JOB_POOL_INLINE) thread_ct = 0;
+    else if (!thread_ct) thread_ct = gs_max(gs_thread_hardware_concurrency(), 2) - 1;
+
+    gs_mpmc_queue_init(pool->queue, desc.queue_capacity ? desc.queue_capacity : GS_JOB_POOL_QUEUE_CAPACITY_DEFAULT);
+    pool->wake = gs_semaphore_new(0);
+    pool->running = 1;
+
+    if (thread_ct)
+    {
+        pool->threads = gs_malloc(sizeof(gs_thread_t) * thread_ct);
+        for (uint32_t i = 0; i < thread_ct; ++i)
+        {
+            gs_thread_t t = gs_thread_create(__gs_job_worker, pool);
+            if (!t.handle) break;
+            pool->threads[pool->thread_ct++] = t;
+        }
+    }
+
+    return pool;
+}
+
+GS_API_DECL void
+gs_job_pool_free(gs_job_pool_t* pool)
+{
+    if (!pool) return;
+    while (gs_job_pool_run_one(pool));
+    gs_atomic_store_rel_u32(&pool->running, 0);
+    gs_semaphore_post(pool->wake, pool->thread_ct);
+    for (uint32_t i = 0; i < pool->thread_ct; ++i) {
+        gs_thread_join(pool->threads[i]);
+    }
+    if (pool->threads) gs_free(pool->threads);
+    gs_semaphore_free(&pool->wake);
+    gs_mpmc_queue_free(pool->queue);
+    gs_free(pool);
+}
+
+GS_API_DECL void
+gs_job_pool_submit(gs_job_pool_t* pool, gs_job_func_t func, void* user_data, gs_job_counter_t* counter)
+{
+    gs_job_t job = {.func = func, .user_data = user_data, .counter = counter};
+    if (counter) gs_atomic_add_u32(&counter->pending, 1);
+
+    if (!pool->thread_ct || !gs_mpmc_queue_push(pool->queue, &job)) {
+        __gs_job_run(&job);
+        return;
+    }
+    gs_semaphore_post(pool->wake, 1);
+}
+
+GS_API_DECL bool
+gs_job_pool_run_one(gs_job_pool_t* pool)
+{
+    gs_job_t job;
+    if (!gs_mpmc_queue_pop(pool->queue, &job)) return false;
+    __gs_job_run(&job);
+    return true;
+}
+
+GS_API_DECL void
+gs_job_pool_wait(gs_job_pool_t* pool, gs_job_counter_t* counter)
+{
+    while (!gs_job_counter_done(counter))
+    {
+        // Remaining jobs are running on workers
+        if (!gs_job_pool_run_one(pool)) gs_thread_yield();
+    }
+}
+
+typedef struct __gs_job_range_t
+{
+    gs_job_range_func_t func;
+    void* user_data;
+    uint32_t count;
+    uint32_t batch;
+    uint32_t next;
+} __gs_job_range_t;
+
+static void
+__gs_job_range_run(void* user_data)
+{
+    __gs_job_range_t* r = (__gs_job_range_t*)user_data;
+    for (;;)
+    {
+        uint32_t start = gs_atomic_add_u32(&r->next, r->batch);
+        if (start >= r->count) return;
+        r->func(start, gs_min(start + r->batch, r->count), r->user_data);
+    }
+}
+
+GS_API_DECL void
+gs_job_pool_parallel_for(gs_job_pool_t* pool, uint32_t count, uint32_t batch, gs_job_range_func_t func, void* user_data)
+{
+    if (!count) return;
+
+    // Default to a few batches per thread, so uneven ranges still balance
+    const uint32_t thread_ct = pool->thread_ct + 1;
+    if (!batch) batch = gs_max(count / (thread_ct * 4), 1);
+
+    const uint32_t batch_ct = (count + batch - 1) / batch;
+    if (batch_ct == 1 || !pool->thread_ct) {
+        func(0, count, user_data);
+        return;
+    }
+
+    // Batches are pulled from a shared cursor, so a helper per spare worker is enough
+    __gs_job_range_t range = {.func = func, .user_data = user_data, .count = count, .batch = batch, .next = 0};
+    gs_job_counter_t ctr = {0};
+    const uint32_t helper_ct = gs_min(batch_ct - 1, pool->thread_ct);
+    for (uint32_t i = 0; i < helper_ct; ++i) {
+        gs_job_pool_submit(pool, __gs_job_range_run, &range, &ctr);
+    }
+    __gs_job_range_run(&range);
+    gs_job_pool_wait(pool, &ctr);
+}
+
+#endif // GS_JOB_IMPL
+#endif // GS_JOB_H
@@ -0,0 +1,474 @@
+#ifndef GS_POOL_H
+#define GS_POOL_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger pool implementation like this:
+
+        #define GS_POOL_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_POOL_IMPL
+        #include "gs_pool.h"
+
+    All other files should just #include "gs_pool.h" without the #define.
+
+    MUST include "gs.h" and "gs_thread.h" BEFORE this file, since this file relies on them:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+        #define GS_POOL_IMPL
+        #include "gs_pool.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Fixed size block allocator:
+
+        * Blocks are carved out of large chunks, and free blocks are linked through their first word, so alloc
+          and free are both O(1) with no per block overhead.
+        * Pools are thread safe. With thread_cache_size set, each thread keeps a private "magazine" of free
+          blocks per pool and only takes the pool's lock to move half a magazine at a time.
+        * Blocks freed on one thread can be allocated on another. A thread that is about to exit should call
+          gs_pool_thread_flush() so its cached blocks go back to the pool.
+        * A thread caches for up to GS_POOL_MAX_THREAD_CACHES pools. Entries for pools freed on any thread are
+          reclaimed, so only pools alive at the same time count towards the limit.
+        * With GS_POOL_DEBUG (on by default unless NDEBUG), every free is checked for double frees and pointers
+          that don't belong to the pool, freed blocks are filled with 0xDD, and gs_pool_free() reports leaks.
+*/
+
+/*==== Interface ====*/
+
+#if !(defined GS_POOL_DEBUG) && !(defined NDEBUG)
+    #define GS_POOL_DEBUG
+#endif
+
+#ifndef GS_POOL_MAX_THREAD_CACHES
+    #define GS_POOL_MAX_THREAD_CACHES       8     // Live pools a single thread can cache blocks for at once
+#endif
+
+#define GS_POOL_DEFAULT_BLOCKS_PER_CHUNK    256
+
+typedef struct gs_pool_desc_t
+{
+    size_t block_size;              // Size of each block (rounded up to pointer size)
+    uint32_t blocks_per_chunk;      // Blocks allocated from the heap at once (default GS_POOL_DEFAULT_BLOCKS_PER_CHUNK)
+    // Blocks cached per thread (0 disables thread caches, all calls take the lock). A thread caches for at most
+    // GS_POOL_MAX_THREAD_CACHES live pools at once, further pools take the lock on that thread until one is freed.
+    uint32_t thread_cache_size;
+} gs_pool_desc_t;
+
+typedef struct gs_pool_chunk_t
+{
+    struct gs_pool_chunk_t* next;
+    uint8_t* data;
+#ifdef GS_POOL_DEBUG
+    uint32_t* state;                // 1 when block is allocated
+#endif
+} gs_pool_chunk_t;
+
+typedef struct gs_pool_stats_t
+{
+    size_t block_size;
+    uint32_t chunk_ct;
+    uint32_t capacity;              // Blocks carved or ready to carve across all chunks
+    uint32_t live;                  // Blocks currently allocated (GS_POOL_DEBUG only, 0 otherwise)
+} gs_pool_stats_t;
+
+typedef struct gs_pool_t
+{
+    gs_spinlock_t lock;
+    void* free_list;                // Shared free list (blocks linked through first word)
+    uint8_t* carve;                 // Next never-used block in newest chunk
+    uint8_t* carve_end;
+    gs_pool_chunk_t* chunks;
+    size_t block_size;
+    uint32_t blocks_per_chunk;
+    uint32_t thread_cache_size;
+    uint32_t chunk_ct;
+    uint32_t id;                    // Unique per pool, detects stale thread cache entries
+    uint32_t live;
+} gs_pool_t;
+
+GS_API_DECL gs_pool_t*
+gs_pool_new(gs_pool_desc_t desc);
+
+GS_API_DECL void
+gs_pool_free(gs_pool_t* pool);
+
+GS_API_DECL void*
+gs_pool_alloc(gs_pool_t* pool);
+
+GS_API_DECL void
+gs_pool_release(gs_pool_t* pool, void* ptr);
+
+// Returns the calling thread's cached blocks for this pool back to the pool
+GS_API_DECL void
+gs_pool_thread_flush(gs_pool_t* pool);
+
+GS_API_DECL gs_pool_stats_t
+gs_pool_stats(gs_pool_t* pool);
+
+// Pool of blocks sized for type __T
+#define gs_pool_new_t(__T, __THREAD_CACHE_SIZE)\
+    gs_pool_new((gs_pool_desc_t){.block_size = sizeof(__T), .thread_cache_size = (__THREAD_CACHE_SIZE)})
+
+// Zero initialized block, counterpart of gs_malloc_init()
+#define gs_pool_alloc_init(__POOL, __T)\
+    ((__T*)memset(gs_pool_alloc((__POOL)), 0, sizeof(__T)))
+
+/*==== Implementation ====*/
+
+#ifdef GS_POOL_IMPL
+
+typedef struct __gs_pool_magazine_t
+{
+    gs_pool_t* pool;
+    uint32_t id;
+    uint32_t count;
+    void* head;
+} __gs_pool_magazine_t;
+
+static GS_THREAD_LOCAL __gs_pool_magazine_t __gs_pool_magazines[GS_POOL_MAX_THREAD_CACHES];
+static uint32_t __gs_pool_next_id = 0;
+
+// Ids of pools not freed yet, so a thread can tell which of its cache entries belong to pools freed elsewhere
+static gs_spinlock_t __gs_pool_live_lock = {0};
+static gs_hash_table(uint32_t, uint32_t) __gs_pool_live_ids = NULL;
+static uint32_t __gs_pool_free_ct = 0;                      // Bumped by every gs_pool_free()
+static GS_THREAD_LOCAL uint32_t __gs_pool_swept_free_ct = 0;    // __gs_pool_free_ct at this thread's last sweep
+
+#define __gs_pool_next(__P)\
+    (*(void**)(__P))
+
+GS_API_DECL gs_pool_t*
+gs_pool_new(gs_pool_desc_t desc)
+{
+    gs_pool_t* pool = gs_malloc_init(gs_pool_t);
+    pool->block_size = gs_max(desc.block_size, sizeof(void*));
+    pool->block_size = (pool->block_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    pool->blocks_per_chunk = desc.blocks_per_chunk ? desc.blocks_per_chunk : GS_POOL_DEFAULT_BLOCKS_PER_CHUNK;
+    pool->thread_cache_size = desc.thread_cache_size;
+    pool->id = gs_atomic_add_u32(&__gs_pool_next_id, 1) + 1;
+
+    gs_spinlock_lock(&__gs_pool_live_lock);
+    gs_hash_table_insert(__gs_pool_live_ids, pool->id, pool->id);
+    gs_spinlock_unlock(&__gs_pool_live_lock);
+    return pool;
+}
+
+GS_API_DECL void
+gs_pool_free(gs_pool_t* pool)
+{
+    if (!pool) return;
+
+#ifdef GS_POOL_DEBUG
+    if (pool->live)
+    {
+        gs_println("Warning: gs_pool_t (block size %zu) freed with %zu blocks still allocated:", pool->block_size, (size_t)pool->live);
+        uint32_t shown = 0;
+        for (gs_pool_chunk_t* c = pool->chunks; c && shown < 8; c = c->next) {
+            for (uint32_t i = 0; i < pool->blocks_per_chunk && shown < 8; ++i) {
+                if (c->state[i]) {
+                    gs_println("    %p", (void*)(c->data + (size_t)i * pool->block_size));
+                    ++shown;
+                }
+            }
+        }
+    }
+#endif
+
+    // Drop this thread's cache entry. Other threads' entries go stale through the id check, and are reclaimed
+    // once they run out of entries and sweep against the live ids.
+    for (uint32_t i = 0; i < GS_POOL_MAX_THREAD_CACHES; ++i) {
+        if (__gs_pool_magazines[i].pool == pool) {
+            memset(&__gs_pool_magazines[i], 0, sizeof(__gs_pool_magazine_t));
+        }
+    }
+
+    gs_spinlock_lock(&__gs_pool_live_lock);
+    gs_hash_table_erase(__gs_pool_live_ids, pool->id);
+    if (!gs_hash_table_size(__gs_pool_live_ids)) gs_hash_table_free(__gs_pool_live_ids);
+    gs_spinlock_unlock(&__gs_pool_live_lock);
+    gs_atomic_add_u32(&__gs_pool_free_ct, 1);
+
+    gs_pool_chunk_t* c = pool->chunks;
+    while (c) {
+        gs_pool_chunk_t* next = c->next;
+#ifdef GS_POOL_DEBUG
+        gs_free(c->state);
+#endif
+        gs_free(c->data);
+        gs_free(c);
+        c = next;
+    }
+    gs_free(pool);
+}
+
+#ifdef GS_POOL_DEBUG
+
+// Finds block's state word, asserting that ptr is the start of a block owned by pool
+static uint32_t*
+__gs_pool_debug_state(gs_pool_t* pool, void* ptr)
+{
+    const size_t chunk_bytes = (size_t)pool->blocks_per_chunk * pool->block_size;
+    gs_spinlock_lock(&pool->lock);
+    gs_pool_chunk_t* c = pool->chunks;
+    for (; c; c = c->next) {
+        if ((uint8_t*)ptr >= c->data && (uint8_t*)ptr < c->data + chunk_bytes) break;
+    }
+    gs_spinlock_unlock(&pool->lock);
+
+    if (!c) {
+        gs_println("Error: gs_pool_release: %p was not allocated from this pool", ptr);
+        gs_assert(false);
+        return NULL;
+    }
+
+    size_t off = (size_t)((uint8_t*)ptr - c->data);
+    if (off % pool->block_size) {
+        gs_println("Error: gs_pool_release: %p points into the middle of a block", ptr);
+        gs_assert(false);
+        return NULL;
+    }
+    return &c->state[off / pool->block_size];
+}
+
+static void
+__gs_pool_debug_on_alloc(gs_pool_t* pool, void* ptr)
+{
+    uint32_t* st = __gs_pool_debug_state(pool, ptr);
+    if (st && gs_atomic_xchg_u32(st, 1)) {
+        gs_println("Error: gs_pool_alloc: %p handed out twice (free list corrupted, use after free?)", ptr);
+        gs_assert(false);
+    }
+    gs_atomic_add_u32(&pool->live, 1);
+}
+
+static void
+__gs_pool_debug_on_release(gs_pool_t* pool, void* ptr)
+{
+    uint32_t* st = __gs_pool_debug_state(pool, ptr);
+    if (st && !gs_atomic_xchg_u32(st, 0)) {
+        gs_println("Error: gs_pool_release: double free of %p", ptr);
+        gs_assert(false);
+        return;
+    }
+    gs_atomic_add_u32(&pool->live, (uint32_t)-1);
+    memset(ptr, 0xDD, pool->block_size);
+}
+
+#endif
+
+static void
+__gs_pool_new_chunk(gs_pool_t* pool)
+{
+    gs_pool_chunk_t* c = gs_malloc_init(gs_pool_chunk_t);
+    c->data = (uint8_t*)gs_malloc((size_t)pool->blocks_per_chunk * pool->block_size);
+#ifdef GS_POOL_DEBUG
+    c->state = (uint32_t*)gs_malloc(sizeof(uint32_t) * pool->blocks_per_chunk);
+    memset(c->state, 0, sizeof(uint32_t) * pool->blocks_per_chunk);
+#endif
+    c->next = pool->chunks;
+    pool->chunks = c;
+    pool->carve = c->data;
+    pool->carve_end = c->data + (size_t)pool->blocks_per_chunk * pool->block_size;
+    pool->chunk_ct++;
+}
+
+// Pops up to ct blocks as a linked list into *head, pool must be locked. Returns number of blocks.
+static uint32_t
+__gs_pool_take_locked(gs_pool_t* pool, void** head, uint32_t ct)
+{
+    uint32_t n = 0;
+    void* list = NULL;
+    while (n < ct)
+    {
+        void* b = pool->free_list;
+        if (b) {
+            pool->free_list = __gs_pool_next(b);
+        } else {
+            if (pool->carve == pool->carve_end) {
+                // Only grab a fresh chunk if we have nothing at all to hand back
+                if (n) break;
+                __gs_pool_new_chunk(pool);
+            }
+            b = pool->carve;
+            pool->carve += pool->block_size;
+        }
+        __gs_pool_next(b) = list;
+        list = b;
+        ++n;
+    }
+    *head = list;
+    return n;
+}
+
+// Drops this thread's entries for pools freed since its last sweep, returns whether any were dropped. Their
+// blocks went with the pool, there's nothing to hand back.
+static bool
+__gs_pool_magazine_sweep()
+{
+    const uint32_t free_ct = gs_atomic_load_u32(&__gs_pool_free_ct);
+    if (free_ct == __gs_pool_swept_free_ct) return false;
+    __gs_pool_swept_free_ct = free_ct;
+
+    bool dropped = false;
+    gs_spinlock_lock(&__gs_pool_live_lock);
+    for (uint32_t i = 0; i < GS_POOL_MAX_THREAD_CACHES; ++i)
+    {
+        __gs_pool_magazine_t* m = &__gs_pool_magazines[i];
+        if (m->pool && !gs_hash_table_exists(__gs_pool_live_ids, m->id)) {
+            memset(m, 0, sizeof(__gs_pool_magazine_t));
+            dropped = true;
+        }
+    }
+    gs_spinlock_unlock(&__gs_pool_live_lock);
+    return dropped;
+}
+
+static __gs_pool_magazine_t*
+__gs_pool_magazine(gs_pool_t* pool)
+{
+    __gs_pool_magazine_t* free_slot = NULL;
+    for (uint32_t i = 0; i < GS_POOL_MAX_THREAD_CACHES; ++i)
+    {
+        __gs_pool_magazine_t* m = &__gs_pool_magazines[i];
+        if (m->pool == pool && m->id == pool->id) return m;
+
+        // A new pool allocated at a freed pool's address takes over its stale entry
+        if (!free_slot && (!m->pool || m->pool == pool)) free_slot = m;
+    }
+
+    // Every entry taken, some may belong to pools freed on other threads since
+    if (!free_slot && __gs_pool_magazine_sweep()) {
+        for (uint32_t i = 0; i < GS_POOL_MAX_THREAD_CACHES && !free_slot; ++i) {
+            if (!__gs_pool_magazines[i].pool) free_slot = &__gs_pool_magazines[i];
+        }
+    }
+
+    if (free_slot) {
+        free_slot->pool = pool;
+        free_slot->id = pool->id;
+        free_slot->count = 0;
+        free_slot->head = NULL;
+    }
+    return free_slot;
+}
+
+GS_API_DECL void*
+gs_pool_alloc(gs_pool_t* pool)
+{
+    void* b = NULL;
+    __gs_pool_magazine_t* m = pool->thread_cache_size ? __gs_pool_magazine(pool) : NULL;
+
+    if (m)
+    {
+        // Refill half a magazine at a time
+        if (!m->count) {
+            gs_spinlock_lock(&pool->lock);
+            m->count = __gs_pool_take_locked(pool, &m->head, gs_max(pool->thread_cache_size / 2, 1));
+            gs_spinlock_unlock(&pool->lock);
+        }
+        b = m->head;
+        m->head = __gs_pool_next(b);
+        m->count--;
+    }
+    else
+    {
+        gs_spinlock_lock(&pool->lock);
+        __gs_pool_take_locked(pool, &b, 1);
+        gs_spinlock_unlock(&pool->lock);
+    }
+
+#ifdef GS_POOL_DEBUG
+    __gs_pool_debug_on_alloc(pool, b);
+#endif
+    return b;
+}
+
+GS_API_DECL void
+gs_pool_release(gs_pool_t* pool, void* ptr)
+{
+    if (!ptr) return;
+
+#ifdef GS_POOL_DEBUG
+    __gs_pool_debug_on_release(pool, ptr);
+#endif
+
+    __gs_pool_magazine_t* m = pool->thread_cache_size ? __gs_pool_magazine(pool) : NULL;
+    if (m)
+    {
+        __gs_pool_next(ptr) = m->head;
+        m->head = ptr;
+        if (++m->count < pool->thread_cache_size) return;
+
+        // Magazine full, hand back the older half
+        uint32_t keep = pool->thread_cache_size / 2;
+        void* tail = m->head;
+        for (uint32_t i = 1; i < keep; ++i) tail = __gs_pool_next(tail);
+        void* give = keep ? __gs_pool_next(tail) : m->head;
+        if (keep) __gs_pool_next(tail) = NULL;
+        else m->head = NULL;
+
+        void* last = give;
+        while (__gs_pool_next(last)) last = __gs_pool_next(last);
+
+        gs_spinlock_lock(&pool->lock);
+        __gs_pool_next(last) = pool->free_list;
+        pool->free_list = give;
+        gs_spinlock_unlock(&pool->lock);
+        m->count = keep;
+        return;
+    }
+
+    gs_spinlock_lock(&pool->lock);
+    __gs_pool_next(ptr) = pool->free_list;
+    pool->free_list = ptr;
+    gs_spinlock_unlock(&pool->lock);
+}
+
+GS_API_DECL void
+gs_pool_thread_flush(gs_pool_t* pool)
+{
+    for (uint32_t i = 0; i < GS_POOL_MAX_THREAD_CACHES; ++i)
+    {
+        __gs_pool_magazine_t* m = &__gs_pool_magazines[i];
+        if (m->pool != pool || m->id != pool->id) continue;
+
+        if (m->head)
+        {
+            void* last = m->head;
+            while (__gs_pool_next(last)) last = __gs_pool_next(last);
+            gs_spinlock_lock(&pool->lock);
+            __gs_pool_next(last) = pool->free_list;
+            pool->free_list = m->head;
+            gs_spinlock_unlock(&pool->lock);
+        }
+        memset(m, 0, sizeof(__gs_pool_magazine_t));
+    }
+}
+
+GS_API_DECL gs_pool_stats_t
+gs_pool_stats(gs_pool_t* pool)
+{
+    gs_pool_stats_t st = gs_default_val();
+    st.block_size = pool->block_size;
+    st.chunk_ct = pool->chunk_ct;
+    st.capacity = pool->chunk_ct * pool->blocks_per_chunk;
+    st.live = gs_atomic_load_u32(&pool->live);
+    return st;
+}
+
+#endif // GS_POOL_IMPL
+#endif // GS_POOL_H
@@ -0,0 +1,363 @@
+#ifndef GS_RADIX_SORT_H
+#define GS_RADIX_SORT_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger radix sort implementation like this:
+
+        #define GS_RADIX_SORT_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_RADIX_SORT_IMPL
+        #include "gs_radix_sort.h"
+
+    All other files should just #include "gs_radix_sort.h" without the #define.
+
+    MUST include "gs.h" and "gs_thread.h" BEFORE this file, since this file relies on both:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+        #define GS_RADIX_SORT_IMPL
+        #include "gs_radix_sort.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Stable LSD radix sort for uint32_t, uint64_t and float keys, in place over gs_dyn_arrays (or plain arrays):
+
+        * 8 bits per pass. Passes where every key shares the same digit are skipped, so small ids in 64 bit keys
+          cost about as much as 32 bit keys.
+        * Floats sort in IEEE order (-inf < ... < -0 < +0 < ... < +inf), NaNs at either end by sign.
+        * The _kv variants carry a payload array of any element type along with the keys. Keys move with an index
+          and the payload is permuted once at the end, so large payloads only move once.
+        * Scratch comes from a caller provided buffer of at least gs_radix_sort_scratch_size() bytes. When it is
+          NULL or too small, scratch is allocated with gs_malloc for the call.
+        * The _parallel variants split every pass across up to __THREAD_CT threads (0 for all hardware threads).
+          Threads are created per call, so a thread is only added per GS_RADIX_SORT_PARALLEL_MIN elements; smaller
+          arrays sort on the calling thread.
+
+            gs_dyn_array(uint64_t) draw_keys = NULL;
+            gs_dyn_array(draw_call_t) draws = NULL;
+
+            size_t sz = gs_radix_sort_scratch_size(GS_RADIX_SORT_U64, gs_dyn_array_size(draw_keys), sizeof(draw_call_t));
+            gs_dyn_array_radix_sort_u64_kv(draw_keys, draws, frame_scratch, sz);
+*/
+
+/*==== Interface ====*/
+
+#ifndef GS_RADIX_SORT_MAX_THREADS
+    #define GS_RADIX_SORT_MAX_THREADS       16
+#endif
+
+#ifndef GS_RADIX_SORT_PARALLEL_MIN
+    #define GS_RADIX_SORT_PARALLEL_MIN      (1 << 17)   // Elements per thread
+#endif
+
+typedef enum gs_radix_sort_key_type
+{
+    GS_RADIX_SORT_U32 = 0x00,
+    GS_RADIX_SORT_U64,
+    GS_RADIX_SORT_F32
+} gs_radix_sort_key_type;
+
+// Scratch bytes needed to sort count keys, with val_size byte payloads (0 for none)
+GS_API_DECL size_t
+gs_radix_sort_scratch_size(gs_radix_sort_key_type type, uint32_t count, size_t val_size);
+
+// Sorts count keys in place, permuting vals (val_size bytes each) along with them if not NULL
+GS_API_DECL void
+gs_radix_sort_func(gs_radix_sort_key_type type, void* keys, void* vals, size_t val_size, uint32_t count,
+    void* scratch, size_t scratch_size, uint32_t thread_ct);
+
+#define __gs_radix_sort_arr(__ARR, __TYPE, __VALS, __VAL_SIZE, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)\
+    gs_radix_sort_func((__TYPE), (void*)(__ARR), (void*)(__VALS), (__VAL_SIZE), (uint32_t)gs_dyn_array_size(__ARR),\
+        (__SCRATCH), (__SCRATCH_SZ), (__THREAD_CT))
+
+#define gs_dyn_array_radix_sort_u32(__ARR, __SCRATCH, __SCRATCH_SZ)\
+    __gs_radix_sort_arr((1 ? (__ARR) : (uint32_t*)NULL), GS_RADIX_SORT_U32, NULL, 0, __SCRATCH, __SCRATCH_SZ, 1)
+
+#define gs_dyn_array_radix_sort_u64(__ARR, __SCRATCH, __SCRATCH_SZ)\
+    __gs_radix_sort_arr((1 ? (__ARR) : (uint64_t*)NULL), GS_RADIX_SORT_U64, NULL, 0, __SCRATCH, __SCRATCH_SZ, 1)
+
+#define gs_dyn_array_radix_sort_f32(__ARR, __SCRATCH, __SCRATCH_SZ)\
+    __gs_radix_sort_arr((1 ? (__ARR) : (float*)NULL), GS_RADIX_SORT_F32, NULL, 0, __SCRATCH, __SCRATCH_SZ, 1)
+
+// __VALS must hold at least as many elements as __KEYS
+#define gs_dyn_array_radix_sort_u32_kv(__KEYS, __VALS, __SCRATCH, __SCRATCH_SZ)\
+    __gs_radix_sort_arr((1 ? (__KEYS) : (uint32_t*)NULL), GS_RADIX_SORT_U32, __VALS, sizeof(*(__VALS)), __SCRATCH, __SCRATCH_SZ, 1)
+
+#define gs_dyn_array_radix_sort_u64_kv(__KEYS, __VALS, __SCRATCH, __SCRATCH_SZ)\
+    __gs_radix_sort_arr((1 ? (__KEYS) : (uint64_t*)NULL), GS_RADIX_SORT_U64, __VALS, sizeof(*(__VALS)), __SCRATCH, __SCRATCH_SZ, 1)
+
+#define gs_dyn_array_radix_sort_f32_kv(__KEYS, __VALS, __SCRATCH, __SCRATCH_SZ)\
+    __gs_radix_sort_arr((1 ? (__KEYS) : (float*)NULL), GS_RADIX_SORT_F32, __VALS, sizeof(*(__VALS)), __SCRATCH, __SCRATCH_SZ, 1)
+
+#define gs_dyn_array_radix_sort_u32_parallel(__ARR, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)\
+    __gs_radix_sort_arr((1 ? (__ARR) : (uint32_t*)NULL), GS_RADIX_SORT_U32, NULL, 0, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)
+
+#define gs_dyn_array_radix_sort_u64_parallel(__ARR, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)\
+    __gs_radix_sort_arr((1 ? (__ARR) : (uint64_t*)NULL), GS_RADIX_SORT_U64, NULL, 0, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)
+
+#define gs_dyn_array_radix_sort_f32_parallel(__ARR, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)\
+    __gs_radix_sort_arr((1 ? (__ARR) : (float*)NULL), GS_RADIX_SORT_F32, NULL, 0, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)
+
+#define gs_dyn_array_radix_sort_u32_kv_parallel(__KEYS, __VALS, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)\
+    __gs_radix_sort_arr((1 ? (__KEYS) : (uint32_t*)NULL), GS_RADIX_SORT_U32, __VALS, sizeof(*(__VALS)), __SCRATCH, __SCRATCH_SZ, __THREAD_CT)
+
+#define gs_dyn_array_radix_sort_u64_kv_parallel(__KEYS, __VALS, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)\
+    __gs_radix_sort_arr((1 ? (__KEYS) : (uint64_t*)NULL), GS_RADIX_SORT_U64, __VALS, sizeof(*(__VALS)), __SCRATCH, __SCRATCH_SZ, __THREAD_CT)
+
+#define gs_dyn_array_radix_sort_f32_kv_parallel(__KEYS, __VALS, __SCRATCH, __SCRATCH_SZ, __THREAD_CT)\
+    __gs_radix_sort_arr((1 ? (__KEYS) : (float*)NULL), GS_RADIX_SORT_F32, __VALS, sizeof(*(__VALS)), __SCRATCH, __SCRATCH_SZ, __THREAD_CT)
+
+/*==== Implementation ====*/
+
+#ifdef GS_RADIX_SORT_IMPL
+
+#define __gs_radix_sort_align(__SZ) (((__SZ) + 15) & ~(size_t)15)
+
+typedef struct __gs_radix_sort_barrier_t
+{
+    uint32_t count;
+    uint32_t gen;
+    uint32_t thread_ct;
+} __gs_radix_sort_barrier_t;
+
+typedef struct __gs_radix_sort_ctx_t
+{
+    gs_radix_sort_key_type type;
+    void* keys;
+    void* tmp;
+    uint32_t* idx;          // Key origins, only used with a payload
+    uint32_t* idx_tmp;
+    uint8_t* vals;
+    uint8_t* gather;
+    size_t val_size;
+    uint32_t count;
+    uint32_t thread_ct;
+    __gs_radix_sort_barrier_t barrier;
+    uint32_t hist[GS_RADIX_SORT_MAX_THREADS][256];
+} __gs_radix_sort_ctx_t;
+
+typedef struct __gs_radix_sort_worker_t
+{
+    __gs_radix_sort_ctx_t* ctx;
+    uint32_t tid;
+} __gs_radix_sort_worker_t;
+
+static void
+__gs_radix_sort_barrier_wait(__gs_radix_sort_barrier_t* b)
+{
+    uint32_t gen = gs_atomic_load_u32(&b->gen);
+    if (gs_atomic_add_u32(&b->count, 1) + 1 == b->thread_ct) {
+        gs_atomic_store_u32(&b->count, 0);
+        gs_atomic_add_u32(&b->gen, 1);
+    } else {
+        while (gs_atomic_load_u32(&b->gen) == gen) gs_thread_yield();
+    }
+}
+
+// Float bits to unsigned ints that sort in the same order: flip everything for negatives, just the sign otherwise
+gs_force_inline uint32_t
+__gs_radix_sort_f32_to_key(uint32_t u)
+{
+    return u ^ ((uint32_t)-(int32_t)(u >> 31) | 0x80000000);
+}
+
+gs_force_inline uint32_t
+__gs_radix_sort_key_to_f32(uint32_t u)
+{
+    return u ^ (((u >> 31) - 1) | 0x80000000);
+}
+
+// Totals digits over every thread's histogram, returns false if all keys share one digit (pass can be skipped).
+// Otherwise fills off with where this thread's keys of each digit start.
+static bool
+__gs_radix_sort_offsets(__gs_radix_sort_ctx_t* ctx, uint32_t tid, uint32_t* off)
+{
+    uint32_t sum = 0;
+    for (uint32_t d = 0; d < 256; ++d)
+    {
+        uint32_t total = 0, before = 0;
+        for (uint32_t t = 0; t < ctx->thread_ct; ++t) {
+            if (t == tid) before = total;
+            total += ctx->hist[t][d];
+        }
+        if (total == ctx->count) return false;
+        off[d] = sum + before;
+        sum += total;
+    }
+    return true;
+}
+
+// Each thread owns a contiguous chunk of the input in every pass. Chunks scatter in thread order, keeping the sort stable.
+#define __GS_RADIX_SORT_DEFINE_WORKER(__SFX, __KT, __PASSES)\
+    static void\
+    __gs_radix_sort_worker_##__SFX(__gs_radix_sort_ctx_t* ctx, uint32_t tid)\
+    {\
+        const uint32_t lo = (uint32_t)((uint64_t)ctx->count * tid / ctx->thread_ct);\
+        const uint32_t hi = (uint32_t)((uint64_t)ctx->count * (tid + 1) / ctx->thread_ct);\
+        __KT* src = (__KT*)ctx->keys;\
+        __KT* dst = (__KT*)ctx->tmp;\
+        uint32_t* isrc = NULL;\
+        uint32_t* idst = ctx->idx;\
+        uint32_t* hist = ctx->hist[tid];\
+        uint32_t off[256];\
+\
+        if (ctx->type == GS_RADIX_SORT_F32) {\
+            for (uint32_t i = lo; i < hi; ++i) src[i] = (__KT)__gs_radix_sort_f32_to_key((uint32_t)src[i]);\
+        }\
+\
+        for (uint32_t p = 0; p < (__PASSES); ++p)\
+        {\
+            const uint32_t shift = p * 8;\
+            memset(hist, 0, 256 * sizeof(uint32_t));\
+            for (uint32_t i = lo; i < hi; ++i) hist[(src[i] >> shift) & 0xff]++;\
+            __gs_radix_sort_barrier_wait(&ctx->barrier);\
+\
+            bool active = __gs_radix_sort_offsets(ctx, tid, off);\
+            if (active)\
+            {\
+                if (!idst) {\
+                    for (uint32_t i = lo; i < hi; ++i) {\
+                        __KT k = src[i];\
+                        dst[off[(k >> shift) & 0xff]++] = k;\
+                    }\
+                } else {\
+                    for (uint32_t i = lo; i < hi; ++i) {\
+                        __KT k = src[i];\
+                        uint32_t o = off[(k >> shift) & 0xff]++;\
+                        dst[o] = k;\
+                        idst[o] = isrc ? isrc[i] : i;\
+                    }\
+                }\
+            }\
+            /* Nobody may rewrite their histogram until everyone is done reading it */\
+            __gs_radix_sort_barrier_wait(&ctx->barrier);\
+\
+            if (active) {\
+                __KT* t = src; src = dst; dst = t;\
+                if (idst) {\
+                    uint32_t* it = isrc ? isrc : ctx->idx_tmp;\
+                    isrc = idst; idst = it;\
+                }\
+            }\
+        }\
+\
+        if (src != (__KT*)ctx->keys) {\
+            memcpy((__KT*)ctx->keys + lo, src + lo, (size_t)(hi - lo) * sizeof(__KT));\
+        }\
+        if (ctx->type == GS_RADIX_SORT_F32) {\
+            __KT* keys = (__KT*)ctx->keys;\
+            for (uint32_t i = lo; i < hi; ++i) keys[i] = (__KT)__gs_radix_sort_key_to_f32((uint32_t)keys[i]);\
+        }\
+\
+        /* No index means no pass moved anything, payload is already in order */\
+        if (isrc) {\
+            __gs_radix_sort_gather(ctx, isrc, lo, hi);\
+            __gs_radix_sort_barrier_wait(&ctx->barrier);\
+            memcpy(ctx->vals + (size_t)lo * ctx->val_size, ctx->gather + (size_t)lo * ctx->val_size, (size_t)(hi - lo) * ctx->val_size);\
+        }\
+    }
+
+static void
+__gs_radix_sort_gather(__gs_radix_sort_ctx_t* ctx, const uint32_t* idx, uint32_t lo, uint32_t hi)
+{
+    const size_t vs = ctx->val_size;
+    switch (vs)
+    {
+        case 4: for (uint32_t i = lo; i < hi; ++i) memcpy(ctx->gather + i * 4, ctx->vals + (size_t)idx[i] * 4, 4); break;
+        case 8: for (uint32_t i = lo; i < hi; ++i) memcpy(ctx->gather + i * 8, ctx->vals + (size_t)idx[i] * 8, 8); break;
+        default: for (uint32_t i = lo; i < hi; ++i) memcpy(ctx->gather + i * vs, ctx->vals + idx[i] * vs, vs); break;
+    }
+}
+
+__GS_RADIX_SORT_DEFINE_WORKER(u32, uint32_t, 4)
+__GS_RADIX_SORT_DEFINE_WORKER(u64, uint64_t, 8)
+
+static void
+__gs_radix_sort_thread(void* user_data)
+{
+    __gs_radix_sort_worker_t* w = (__gs_radix_sort_worker_t*)user_data;
+    if (w->ctx->type == GS_RADIX_SORT_U64) __gs_radix_sort_worker_u64(w->ctx, w->tid);
+    else                                   __gs_radix_sort_worker_u32(w->ctx, w->tid);
+}
+
+GS_API_DECL size_t
+gs_radix_sort_scratch_size(gs_radix_sort_key_type type, uint32_t count, size_t val_size)
+{
+    size_t key_size = type == GS_RADIX_SORT_U64 ? sizeof(uint64_t) : sizeof(uint32_t);
+    size_t sz = __gs_radix_sort_align(count * key_size);
+    if (val_size) {
+        sz += 2 * __gs_radix_sort_align(count * sizeof(uint32_t));
+        sz += __gs_radix_sort_align(count * val_size);
+    }
+    return sz;
+}
+
+GS_API_DECL void
+gs_radix_sort_func(gs_radix_sort_key_type type, void* keys, void* vals, size_t val_size, uint32_t count,
+    void* scratch, size_t scratch_size, uint32_t thread_ct)
+{
+    if (count < 2) return;
+    if (!vals) val_size = 0;
+
+    uint32_t max_threads = count / GS_RADIX_SORT_PARALLEL_MIN;
+    if (!thread_ct) thread_ct = gs_thread_hardware_concurrency();
+    if (thread_ct > GS_RADIX_SORT_MAX_THREADS) thread_ct = GS_RADIX_SORT_MAX_THREADS;
+    if (thread_ct > max_threads) thread_ct = max_threads;
+    if (!thread_ct) thread_ct = 1;
+
+    size_t need = gs_radix_sort_scratch_size(type, count, val_size);
+    uint8_t* mem = (uint8_t*)scratch;
+    if (!mem || scratch_size < need) mem = (uint8_t*)gs_malloc(need);
+
+    // Too big for most stacks with a lot of threads
+    __gs_radix_sort_ctx_t* ctx = (__gs_radix_sort_ctx_t*)gs_malloc(sizeof(__gs_radix_sort_ctx_t));
+    memset(ctx, 0, offsetof(__gs_radix_sort_ctx_t, hist));
+    ctx->type = type;
+    ctx->keys = keys;
+    ctx->count = count;
+    ctx->thread_ct = thread_ct;
+    ctx->barrier.thread_ct = thread_ct;
+    ctx->tmp = mem;
+    if (val_size)
+    {
+        size_t key_size = type == GS_RADIX_SORT_U64 ? sizeof(uint64_t) : sizeof(uint32_t);
+        uint8_t* p = mem + __gs_radix_sort_align(count * key_size);
+        ctx->idx = (uint32_t*)p;        p += __gs_radix_sort_align(count * sizeof(uint32_t));
+        ctx->idx_tmp = (uint32_t*)p;    p += __gs_radix_sort_align(count * sizeof(uint32_t));
+        ctx->gather = p;
+        ctx->vals = (uint8_t*)vals;
+        ctx->val_size = val_size;
+    }
+
+    __gs_radix_sort_worker_t workers[GS_RADIX_SORT_MAX_THREADS];
+    gs_thread_t threads[GS_RADIX_SORT_MAX_THREADS];
+    for (uint32_t t = 0; t < thread_ct; ++t) {
+        workers[t] = (__gs_radix_sort_worker_t){.ctx = ctx, .tid = t};
+    }
+    for (uint32_t t = 1; t < thread_ct; ++t) {
+        threads[t] = gs_thread_create(__gs_radix_sort_thread, &workers[t]);
+    }
+    __gs_radix_sort_thread(&workers[0]);
+    for (uint32_t t = 1; t < thread_ct; ++t) {
+        gs_thread_join(threads[t]);
+    }
+
+    gs_free(ctx);
+    if (mem != (uint8_t*)scratch) gs_free(mem);
+}
+
+#endif // GS_RADIX_SORT_IMPL
+#endif // GS_RADIX_SORT_H
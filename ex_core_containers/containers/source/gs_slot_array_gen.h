@@ -0,0 +1,451 @@
+#ifndef GS_SLOT_ARRAY_GEN_H
+#define GS_SLOT_ARRAY_GEN_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger generational slot array implementation like this:
+
+        #define GS_SLOT_ARRAY_GEN_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_SLOT_ARRAY_GEN_IMPL
+        #include "gs_slot_array_gen.h"
+
+    All other files should just #include "gs_slot_array_gen.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_SLOT_ARRAY_GEN_IMPL
+        #include "gs_slot_array_gen.h"
+
+    To move existing gs_slot_array(T) / gs_slot_map(K, V) call sites over to this container, also define
+    GS_SLOT_ARRAY_GEN_OVERRIDE before the include. This remaps the gs_slot_array_* macros for the rest of
+    that translation unit. Include it BEFORE gs_containers_bulk.h.
+
+    ================================================================================================================
+*/
+
+/*
+    Slot array with generation tagged handles:
+
+        * Handles pack a slot index (low GS_SLOT_ARRAY_GEN_INDEX_BITS bits) and a generation (remaining high bits).
+          Erasing bumps the slot's generation, so stale handles fail gs_slot_array_gen_handle_valid().
+        * Generations wrap, so slots are reused forever and the slot table never outgrows the most elements live
+          at once. The price is an ABA window: a stale handle matches again once its slot has been reused exactly
+          a multiple of 2^(32 - GS_SLOT_ARRAY_GEN_INDEX_BITS) times. The default 20 index bits give 4096
+          generations for up to ~1M live elements; define GS_SLOT_ARRAY_GEN_INDEX_BITS lower for more generations.
+        * Data is always densely packed. Each element keeps a back-pointer to its handle, so erase is
+          O(1) swap-and-pop and iteration walks only live elements, contiguously.
+        * Free slots form an intrusive FIFO list through the slot table, so insert is O(1) and every free slot is
+          reused before any one of them comes around again. With F slots free, a slot's generation only advances
+          once every F erases, which stretches the ABA window above by the same factor.
+        * gs_slot_array_gen_compact() reorders data into slot order, trims trailing free slots, rebuilds
+          the free list in ascending order and releases excess capacity.
+
+    Iterators are dense data indices (not handles); use gs_slot_array_gen_iter_handle() to get an element's handle.
+*/
+
+/*==== Interface ====*/
+
+#ifndef GS_SLOT_ARRAY_GEN_INDEX_BITS
+    #define GS_SLOT_ARRAY_GEN_INDEX_BITS    20
+#endif
+
+#define GS_SLOT_ARRAY_GEN_INDEX_MASK        ((uint32_t)((1u << GS_SLOT_ARRAY_GEN_INDEX_BITS) - 1))
+#define GS_SLOT_ARRAY_GEN_GEN_MASK          ((uint32_t)(0xFFFFFFFFu >> GS_SLOT_ARRAY_GEN_INDEX_BITS))
+
+#define gs_slot_array_gen_handle_index(__H)\
+    ((uint32_t)(__H) & GS_SLOT_ARRAY_GEN_INDEX_MASK)
+
+#define gs_slot_array_gen_handle_gen(__H)\
+    ((uint32_t)(__H) >> GS_SLOT_ARRAY_GEN_INDEX_BITS)
+
+#define gs_slot_array_gen_handle_new(__IDX, __GEN)\
+    ((uint32_t)(__IDX) | (((uint32_t)(__GEN) & GS_SLOT_ARRAY_GEN_GEN_MASK) << GS_SLOT_ARRAY_GEN_INDEX_BITS))
+
+typedef struct gs_slot_array_gen_slot_t
+{
+    uint32_t idx;   // Data index when live, next free slot (towards the tail) when free
+    uint32_t gen;   // Current generation of slot
+} gs_slot_array_gen_slot_t;
+
+// Shared leading layout of every gs_slot_array_gen(T), used by non-typed implementation functions
+typedef struct __gs_slot_array_gen_dummy_header {
+    gs_dyn_array(gs_slot_array_gen_slot_t) slots;
+    gs_dyn_array(uint32_t) handles;
+    void* data;
+    uint32_t free_head;
+    uint32_t free_tail;
+    uint32_t gen_base;
+} __gs_slot_array_gen_dummy_header;
+
+#define gs_slot_array_gen(__T)\
+    struct\
+    {\
+        gs_dyn_array(gs_slot_array_gen_slot_t) slots;\
+        gs_dyn_array(uint32_t) handles;\
+        gs_dyn_array(__T) data;\
+        uint32_t free_head;\
+        uint32_t free_tail;\
+        uint32_t gen_base;\
+        __T tmp;\
+    }*
+
+#define gs_slot_array_gen_new(__T)\
+    NULL
+
+GS_API_DECL void**
+gs_slot_array_gen_init(void** sa, size_t sz);
+
+GS_API_DECL uint32_t
+gs_slot_array_gen_insert_func(void* sa, void* val, size_t val_len);
+
+GS_API_DECL void
+gs_slot_array_gen_erase_func(void* sa, uint32_t hndl, size_t val_len);
+
+GS_API_DECL void
+gs_slot_array_gen_clear_func(void* sa);
+
+GS_API_DECL void
+gs_slot_array_gen_reserve_func(void* sa, uint32_t ct, size_t val_len);
+
+GS_API_DECL void
+gs_slot_array_gen_compact_func(void* sa, size_t val_len);
+
+#define gs_slot_array_gen_init_all(__SA)\
+    gs_slot_array_gen_init((void**)&(__SA), sizeof(*(__SA)))
+
+#define gs_slot_array_gen_size(__SA)\
+    ((__SA) == NULL ? 0 : gs_dyn_array_size((__SA)->data))
+
+#define gs_slot_array_gen_empty(__SA)\
+    (gs_slot_array_gen_size(__SA) == 0)
+
+#define gs_slot_array_gen_handle_valid(__SA, __H)\
+    ((__SA) && gs_slot_array_gen_handle_index(__H) < (uint32_t)gs_dyn_array_size((__SA)->slots) &&\
+        (__SA)->slots[gs_slot_array_gen_handle_index(__H)].gen == gs_slot_array_gen_handle_gen(__H))
+
+#define gs_slot_array_gen_exists(__SA, __H)\
+    gs_slot_array_gen_handle_valid(__SA, __H)
+
+#define gs_slot_array_gen_insert(__SA, __VAL)\
+    (gs_slot_array_gen_init_all(__SA), (__SA)->tmp = (__VAL),\
+        gs_slot_array_gen_insert_func((void*)(__SA), (void*)&((__SA)->tmp), sizeof((__SA)->tmp)))
+
+#define gs_slot_array_gen_insert_range(__SA, __VALS, __CT, __HNDLS)\
+    do {\
+        const uint32_t __N = (uint32_t)(__CT);\
+        uint32_t* __HP = (__HNDLS);\
+        gs_slot_array_gen_reserve((__SA), gs_slot_array_gen_size((__SA)) + __N);\
+        for (uint32_t __I = 0; __I < __N; ++__I) {\
+            uint32_t __H = gs_slot_array_gen_insert_func((void*)(__SA), (void*)&((__VALS)[__I]), sizeof((__SA)->tmp));\
+            if (__HP) __HP[__I] = __H;\
+        }\
+    } while (0)
+
+#define gs_slot_array_gen_reserve(__SA, __CT)\
+    do {\
+        gs_slot_array_gen_init_all(__SA);\
+        gs_slot_array_gen_reserve_func((void*)(__SA), (uint32_t)(__CT), sizeof((__SA)->tmp));\
+    } while (0)
+
+#define gs_slot_array_gen_get(__SA, __H)\
+    ((__SA)->data[(__SA)->slots[gs_slot_array_gen_handle_index(__H)].idx])
+
+#define gs_slot_array_gen_getp(__SA, __H)\
+    (&(gs_slot_array_gen_get(__SA, (__H))))
+
+#define gs_slot_array_gen_erase(__SA, __H)\
+    do {\
+        if ((__SA)) {\
+            gs_slot_array_gen_erase_func((void*)(__SA), (__H), sizeof((__SA)->tmp));\
+        }\
+    } while (0)
+
+#define gs_slot_array_gen_compact(__SA)\
+    do {\
+        if ((__SA)) {\
+            gs_slot_array_gen_compact_func((void*)(__SA), sizeof((__SA)->tmp));\
+        }\
+    } while (0)
+
+#define gs_slot_array_gen_clear(__SA)\
+    do {\
+        if ((__SA) != NULL) {\
+            gs_slot_array_gen_clear_func((void*)(__SA));\
+        }\
+    } while (0)
+
+#define gs_slot_array_gen_free(__SA)\
+    do {\
+        if ((__SA) != NULL) {\
+            gs_dyn_array_free((__SA)->slots);\
+            gs_dyn_array_free((__SA)->handles);\
+            gs_dyn_array_free((__SA)->data);\
+            gs_free((__SA));\
+            (__SA) = NULL;\
+        }\
+    } while (0)
+
+/*=== Slot Array Gen Iterator ===*/
+
+#define gs_slot_array_gen_iter_new(__SA)\
+    (0)
+
+#define gs_slot_array_gen_iter_valid(__SA, __IT)\
+    ((__IT) < (uint32_t)gs_slot_array_gen_size(__SA))
+
+#define gs_slot_array_gen_iter_advance(__SA, __IT)\
+    (++(__IT))
+
+#define gs_slot_array_gen_iter_get(__SA, __IT)\
+    ((__SA)->data[(__IT)])
+
+#define gs_slot_array_gen_iter_getp(__SA, __IT)\
+    (&((__SA)->data[(__IT)]))
+
+#define gs_slot_array_gen_iter_handle(__SA, __IT)\
+    ((__SA)->handles[(__IT)])
+
+/*==== Override ====*/
+
+#ifdef GS_SLOT_ARRAY_GEN_OVERRIDE
+
+    #undef gs_slot_array
+    #undef gs_slot_array_new
+    #undef gs_slot_array_init_all
+    #undef gs_slot_array_size
+    #undef gs_slot_array_empty
+    #undef gs_slot_array_handle_valid
+    #undef gs_slot_array_exists
+    #undef gs_slot_array_insert
+    #undef gs_slot_array_insert_range
+    #undef gs_slot_array_reserve
+    #undef gs_slot_array_get
+    #undef gs_slot_array_getp
+    #undef gs_slot_array_erase
+    #undef gs_slot_array_compact
+    #undef gs_slot_array_clear
+    #undef gs_slot_array_free
+    #undef gs_slot_array_iter_new
+    #undef gs_slot_array_iter_valid
+    #undef gs_slot_array_iter_advance
+    #undef gs_slot_array_iter_get
+    #undef gs_slot_array_iter_getp
+    #undef gs_slot_array_iter_handle
+
+    #define gs_slot_array(__T)                          gs_slot_array_gen(__T)
+    #define gs_slot_array_new(__T)                      gs_slot_array_gen_new(__T)
+    #define gs_slot_array_init_all(__SA)                gs_slot_array_gen_init_all(__SA)
+    #define gs_slot_array_size(__SA)                    gs_slot_array_gen_size(__SA)
+    #define gs_slot_array_empty(__SA)                   gs_slot_array_gen_empty(__SA)
+    #define gs_slot_array_handle_valid(__SA, __H)       gs_slot_array_gen_handle_valid(__SA, __H)
+    #define gs_slot_array_exists(__SA, __H)             gs_slot_array_gen_exists(__SA, __H)
+    #define gs_slot_array_insert(__SA, __VAL)           gs_slot_array_gen_insert(__SA, __VAL)
+    #define gs_slot_array_insert_range(__SA, __VALS, __CT, __HNDLS) gs_slot_array_gen_insert_range(__SA, __VALS, __CT, __HNDLS)
+    #define gs_slot_array_reserve(__SA, __CT)           gs_slot_array_gen_reserve(__SA, __CT)
+    #define gs_slot_array_get(__SA, __H)                gs_slot_array_gen_get(__SA, __H)
+    #define gs_slot_array_getp(__SA, __H)               gs_slot_array_gen_getp(__SA, __H)
+    #define gs_slot_array_erase(__SA, __H)              gs_slot_array_gen_erase(__SA, __H)
+    #define gs_slot_array_compact(__SA)                 gs_slot_array_gen_compact(__SA)
+    #define gs_slot_array_clear(__SA)                   gs_slot_array_gen_clear(__SA)
+    #define gs_slot_array_free(__SA)                    gs_slot_array_gen_free(__SA)
+    #define gs_slot_array_iter_new(__SA)                gs_slot_array_gen_iter_new(__SA)
+    #define gs_slot_array_iter_valid(__SA, __IT)        gs_slot_array_gen_iter_valid(__SA, __IT)
+    #define gs_slot_array_iter_advance(__SA, __IT)      gs_slot_array_gen_iter_advance(__SA, __IT)
+    #define gs_slot_array_iter_get(__SA, __IT)          gs_slot_array_gen_iter_get(__SA, __IT)
+    #define gs_slot_array_iter_getp(__SA, __IT)         gs_slot_array_gen_iter_getp(__SA, __IT)
+    #define gs_slot_array_iter_handle(__SA, __IT)       gs_slot_array_gen_iter_handle(__SA, __IT)
+
+    // Slot map iterators index slot array data directly by handle
+    #undef gs_slot_map_iter_get
+    #undef gs_slot_map_iter_getp
+
+    #define gs_slot_map_iter_get(__SM, __IT)\
+        gs_slot_array_gen_get((__SM)->sa, gs_hash_table_iter_get((__SM)->ht, (__IT)))
+
+    #define gs_slot_map_iter_getp(__SM, __IT)\
+        gs_slot_array_gen_getp((__SM)->sa, gs_hash_table_iter_get((__SM)->ht, (__IT)))
+
+#endif // GS_SLOT_ARRAY_GEN_OVERRIDE
+
+/*==== Implementation ====*/
+
+#ifdef GS_SLOT_ARRAY_GEN_IMPL
+
+#define __gs_slot_array_gen_is_live(__SA, __I)\
+    ((__SA)->slots[(__I)].idx < (uint32_t)gs_dyn_array_size((__SA)->handles) &&\
+        gs_slot_array_gen_handle_index((__SA)->handles[(__SA)->slots[(__I)].idx]) == (__I))
+
+// Appends a slot to the tail of the free list, so it's reused after every slot freed before it
+static void
+__gs_slot_array_gen_free_push(__gs_slot_array_gen_dummy_header* h, uint32_t si)
+{
+    h->slots[si].idx = GS_SLOT_ARRAY_INVALID_HANDLE;
+    if (h->free_head == GS_SLOT_ARRAY_INVALID_HANDLE) h->free_head = si;
+    else h->slots[h->free_tail].idx = si;
+    h->free_tail = si;
+}
+
+GS_API_DECL void**
+gs_slot_array_gen_init(void** sa, size_t sz)
+{
+    if (*sa == NULL) {
+        *sa = gs_malloc(sz);
+        memset(*sa, 0, sz);
+        ((__gs_slot_array_gen_dummy_header*)(*sa))->free_head = GS_SLOT_ARRAY_INVALID_HANDLE;
+        ((__gs_slot_array_gen_dummy_header*)(*sa))->free_tail = GS_SLOT_ARRAY_INVALID_HANDLE;
+    }
+    return sa;
+}
+
+GS_API_DECL uint32_t
+gs_slot_array_gen_insert_func(void* sa, void* val, size_t val_len)
+{
+    __gs_slot_array_gen_dummy_header* h = (__gs_slot_array_gen_dummy_header*)sa;
+
+    // Pop free slot, or push a fresh one
+    uint32_t si = h->free_head;
+    if (si != GS_SLOT_ARRAY_INVALID_HANDLE) {
+        h->free_head = h->slots[si].idx;
+    }
+    else {
+        si = (uint32_t)gs_dyn_array_size(h->slots);
+        gs_assert(si < GS_SLOT_ARRAY_GEN_INDEX_MASK);
+        gs_slot_array_gen_slot_t slot = {.idx = 0, .gen = h->gen_base & GS_SLOT_ARRAY_GEN_GEN_MASK};
+        gs_dyn_array_push_data((void**)&h->slots, &slot, sizeof(slot));
+    }
+
+    uint32_t hndl = gs_slot_array_gen_handle_new(si, h->slots[si].gen);
+    h->slots[si].idx = (uint32_t)gs_dyn_array_size(h->data);
+    gs_dyn_array_push_data(&h->data, val, val_len);
+    gs_dyn_array_push_data((void**)&h->handles, &hndl, sizeof(uint32_t));
+    return hndl;
+}
+
+GS_API_DECL void
+gs_slot_array_gen_erase_func(void* sa, uint32_t hndl, size_t val_len)
+{
+    __gs_slot_array_gen_dummy_header* h = (__gs_slot_array_gen_dummy_header*)sa;
+    if (!gs_slot_array_gen_handle_valid(h, hndl)) {
+        gs_println("Warning: Attempting to erase invalid slot array handle (%zu)", hndl);
+        return;
+    }
+
+    const uint32_t si = gs_slot_array_gen_handle_index(hndl);
+    const uint32_t di = h->slots[si].idx;
+    const uint32_t last = (uint32_t)gs_dyn_array_size(h->data) - 1;
+
+    // Swap and pop, fixing up moved element's slot through its back-pointer
+    if (di != last) {
+        memcpy((uint8_t*)h->data + (size_t)di * val_len, (uint8_t*)h->data + (size_t)last * val_len, val_len);
+        h->handles[di] = h->handles[last];
+        h->slots[gs_slot_array_gen_handle_index(h->handles[di])].idx = di;
+    }
+    gs_dyn_array_head(h->data)->size--;
+    gs_dyn_array_head(h->handles)->size--;
+
+    // Free slot: bump generation so outstanding handles go stale, queue it for reuse
+    h->slots[si].gen = (h->slots[si].gen + 1) & GS_SLOT_ARRAY_GEN_GEN_MASK;
+    __gs_slot_array_gen_free_push(h, si);
+}
+
+GS_API_DECL void
+gs_slot_array_gen_clear_func(void* sa)
+{
+    __gs_slot_array_gen_dummy_header* h = (__gs_slot_array_gen_dummy_header*)sa;
+
+    // Every slot is freed, so all outstanding handles go stale
+    // Ascending, so pushing a slot only ever rewrites ones already visited
+    h->free_head = GS_SLOT_ARRAY_INVALID_HANDLE;
+    for (uint32_t i = 0; i < (uint32_t)gs_dyn_array_size(h->slots); ++i)
+    {
+        if (__gs_slot_array_gen_is_live(h, i)) {
+            h->slots[i].gen = (h->slots[i].gen + 1) & GS_SLOT_ARRAY_GEN_GEN_MASK;
+        }
+        __gs_slot_array_gen_free_push(h, i);
+    }
+    gs_dyn_array_clear(h->data);
+    gs_dyn_array_clear(h->handles);
+}
+
+GS_API_DECL void
+gs_slot_array_gen_reserve_func(void* sa, uint32_t ct, size_t val_len)
+{
+    __gs_slot_array_gen_dummy_header* h = (__gs_slot_array_gen_dummy_header*)sa;
+    if ((uint32_t)gs_dyn_array_capacity(h->data) <= ct) {
+        h->data = gs_dyn_array_resize_impl(h->data, val_len, ct + 1);
+    }
+    if ((uint32_t)gs_dyn_array_capacity(h->handles) <= ct) {
+        h->handles = (uint32_t*)gs_dyn_array_resize_impl(h->handles, sizeof(uint32_t), ct + 1);
+    }
+    if ((uint32_t)gs_dyn_array_capacity(h->slots) <= ct) {
+        h->slots = (gs_slot_array_gen_slot_t*)gs_dyn_array_resize_impl(h->slots, sizeof(gs_slot_array_gen_slot_t), ct + 1);
+    }
+}
+
+GS_API_DECL void
+gs_slot_array_gen_compact_func(void* sa, size_t val_len)
+{
+    __gs_slot_array_gen_dummy_header* h = (__gs_slot_array_gen_dummy_header*)sa;
+    const uint32_t n = (uint32_t)gs_dyn_array_size(h->data);
+    uint32_t ns = (uint32_t)gs_dyn_array_size(h->slots);
+    if (!ns) return;
+
+    // Determine live slots up front, before slot indices are rewritten
+    uint8_t* live = (uint8_t*)gs_malloc(ns);
+    for (uint32_t i = 0; i < ns; ++i) {
+        live[i] = __gs_slot_array_gen_is_live(h, i) ? 1 : 0;
+    }
+
+    // Reorder data (and back-pointers) into slot order, so handle order and iteration order walk memory the same way
+    if (n)
+    {
+        uint8_t* tdata = (uint8_t*)gs_malloc((size_t)n * val_len);
+        uint32_t* thndls = (uint32_t*)gs_malloc((size_t)n * sizeof(uint32_t));
+        uint32_t di = 0;
+        for (uint32_t i = 0; i < ns; ++i)
+        {
+            if (!live[i]) continue;
+            const uint32_t src = h->slots[i].idx;
+            memcpy(tdata + (size_t)di * val_len, (uint8_t*)h->data + (size_t)src * val_len, val_len);
+            thndls[di] = h->handles[src];
+            h->slots[i].idx = di++;
+        }
+        memcpy(h->data, tdata, (size_t)n * val_len);
+        memcpy(h->handles, thndls, (size_t)n * sizeof(uint32_t));
+        gs_free(tdata);
+        gs_free(thndls);
+    }
+
+    // Trim trailing free slots. New slots start past their generation, so stale handles to them stay stale.
+    while (ns && !live[ns - 1]) {
+        h->gen_base = gs_max(h->gen_base, h->slots[ns - 1].gen);
+        --ns;
+    }
+    gs_dyn_array_head(h->slots)->size = (int32_t)ns;
+
+    // Rebuild free list in ascending order, so new inserts fill the lowest holes first
+    h->free_head = GS_SLOT_ARRAY_INVALID_HANDLE;
+    for (uint32_t i = 0; i < ns; ++i)
+    {
+        if (!live[i]) __gs_slot_array_gen_free_push(h, i);
+    }
+    gs_free(live);
+
+    // Release excess capacity
+    h->data = gs_dyn_array_resize_impl(h->data, val_len, n + 1);
+    h->handles = (uint32_t*)gs_dyn_array_resize_impl(h->handles, sizeof(uint32_t), n + 1);
+    h->slots = (gs_slot_array_gen_slot_t*)gs_dyn_array_resize_impl(h->slots, sizeof(gs_slot_array_gen_slot_t), ns + 1);
+}
+
+#endif // GS_SLOT_ARRAY_GEN_IMPL
+#endif // GS_SLOT_ARRAY_GEN_H
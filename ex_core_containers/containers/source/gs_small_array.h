@@ -0,0 +1,155 @@
+#ifndef GS_SMALL_ARRAY_H
+#define GS_SMALL_ARRAY_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger small array implementation like this:
+
+        #define GS_SMALL_ARRAY_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_SMALL_ARRAY_IMPL
+        #include "gs_small_array.h"
+
+    All other files should just #include "gs_small_array.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_SMALL_ARRAY_IMPL
+        #include "gs_small_array.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Array with inline storage for N elements that only spills to the heap when it outgrows them:
+
+        * A plain struct (zero initialized), meant to be embedded in other structs. Short lists (components,
+          children, contacts) never allocate.
+        * On spill, contents move to a heap buffer that doubles like a gs_dyn_array. Freeing returns to inline storage.
+        * No pointer into itself is stored, so the struct can be copied while inline; once spilled, copies share the heap buffer.
+
+    Iterate it like a gs_dyn_array:
+
+        gs_small_array(uint32_t, 8) arr = {0};
+        gs_small_array_push(arr, 42);
+        for (uint32_t i = 0; i < gs_small_array_size(arr); ++i) {
+            uint32_t v = gs_small_array_get(arr, i);
+        }
+        gs_small_array_free(arr);
+*/
+
+/*==== Interface ====*/
+
+#define gs_small_array(__T, __N)\
+    struct {\
+        __T* heap;\
+        uint32_t size;\
+        uint32_t capacity;\
+        __T buf[__N];\
+    }
+
+GS_API_DECL void
+gs_small_array_grow_func(void** heap, const void* buf, uint32_t size, uint32_t* capacity, uint32_t new_capacity, size_t val_len);
+
+#define gs_small_array_is_inline(__A)\
+    ((__A).heap == NULL)
+
+#define gs_small_array_data(__A)\
+    ((__A).heap ? (__A).heap : (__A).buf)
+
+#define gs_small_array_size(__A)\
+    ((__A).size)
+
+#define gs_small_array_capacity(__A)\
+    ((__A).heap ? (__A).capacity : (uint32_t)gs_array_size((__A).buf))
+
+#define gs_small_array_empty(__A)\
+    ((__A).size == 0)
+
+#define gs_small_array_get(__A, __I)\
+    (gs_small_array_data(__A)[(__I)])
+
+#define gs_small_array_back(__A)\
+    (gs_small_array_data(__A)[(__A).size - 1])
+
+#define gs_small_array_reserve(__A, __CT)\
+    do {\
+        if ((uint32_t)(__CT) > gs_small_array_capacity(__A)) {\
+            gs_small_array_grow_func((void**)&(__A).heap, (__A).buf, (__A).size, &(__A).capacity, (uint32_t)(__CT), sizeof(*(__A).buf));\
+        }\
+    } while (0)
+
+#define gs_small_array_push(__A, __V)\
+    do {\
+        if ((__A).size == gs_small_array_capacity(__A)) {\
+            gs_small_array_grow_func((void**)&(__A).heap, (__A).buf, (__A).size, &(__A).capacity, (__A).size * 2, sizeof(*(__A).buf));\
+        }\
+        gs_small_array_data(__A)[(__A).size++] = (__V);\
+    } while (0)
+
+#define gs_small_array_pop(__A)\
+    do {\
+        if ((__A).size) (__A).size--;\
+    } while (0)
+
+// Keeps order, shifts the tail down
+#define gs_small_array_erase(__A, __I)\
+    do {\
+        uint32_t __SAI = (uint32_t)(__I);\
+        memmove(gs_small_array_data(__A) + __SAI, gs_small_array_data(__A) + __SAI + 1,\
+            ((__A).size - __SAI - 1) * sizeof(*(__A).buf));\
+        (__A).size--;\
+    } while (0)
+
+// Moves last element into the hole
+#define gs_small_array_erase_swap(__A, __I)\
+    do {\
+        gs_small_array_get((__A), (__I)) = gs_small_array_back(__A);\
+        (__A).size--;\
+    } while (0)
+
+#define gs_small_array_clear(__A)\
+    do {\
+        (__A).size = 0;\
+    } while (0)
+
+#define gs_small_array_free(__A)\
+    do {\
+        if ((__A).heap) gs_free((__A).heap);\
+        (__A).heap = NULL;\
+        (__A).size = 0;\
+        (__A).capacity = 0;\
+    } while (0)
+
+/*==== Implementation ====*/
+
+#ifdef GS_SMALL_ARRAY_IMPL
+
+GS_API_DECL void
+gs_small_array_grow_func(void** heap, const void* buf, uint32_t size, uint32_t* capacity, uint32_t new_capacity, size_t val_len)
+{
+    if (new_capacity < 8) new_capacity = 8;
+    if (*heap)
+    {
+        *heap = gs_realloc(*heap, (size_t)new_capacity * val_len);
+    }
+    else
+    {
+        // First spill, move inline contents out
+        *heap = gs_malloc((size_t)new_capacity * val_len);
+        memcpy(*heap, buf, (size_t)size * val_len);
+    }
+    *capacity = new_capacity;
+}
+
+#endif // GS_SMALL_ARRAY_IMPL
+#endif // GS_SMALL_ARRAY_H
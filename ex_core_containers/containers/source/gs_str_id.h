@@ -0,0 +1,278 @@
+#ifndef GS_STR_ID_H
+#define GS_STR_ID_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger string id implementation like this:
+
+        #define GS_STR_ID_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_STR_ID_IMPL
+        #include "gs_str_id.h"
+
+    All other files should just #include "gs_str_id.h" without the #define.
+
+    MUST include "gs.h", "gs_thread.h" and "gs_hash_table_concurrent.h" BEFORE this file, since this file relies on them:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+        #define GS_HASH_TABLE_CONCURRENT_IMPL
+        #include "gs_hash_table_concurrent.h"
+
+        #define GS_STR_ID_IMPL
+        #include "gs_str_id.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Global string interner, so names are hashed once instead of every frame:
+
+        * A gs_str_id_t holds the string's gs_hash_str64() hash and a pointer to a stable copy of it. Ids compare
+          with a single integer compare, and the hash can be used directly wherever gs code keys by gs_hash_str64().
+        * gs_str_id_intern() copies new strings into an append-only arena that lives until gs_str_id_shutdown(), so
+          returned pointers never move. Lookups of known strings are lock-free; only first interns take a lock.
+        * gs_str_id_lit() builds an id from a string literal at compile time, without touching the interner. In C
+          the hash is an unrolled expression that optimizing compilers fold to a constant (literals up to
+          GS_STR_ID_LIT_MAX chars, longer ones hash at runtime); in C++ it is a constexpr function.
+        * gs_hash_str64() is a 32 bit hash, so two different strings can share an id. Interning reports it.
+
+            gs_str_id_init();
+
+            gs_str_id_t a = gs_str_id_intern(name_from_file);
+            gs_str_id_t b = gs_str_id_lit("u_mvp");
+            if (gs_str_id_eq(a, b)) {}
+            gs_slot_map_get(sm, gs_str_id_hash(a));
+
+            gs_str_id_shutdown();
+*/
+
+/*==== Interface ====*/
+
+#ifndef GS_STR_ID_ARENA_BLOCK_SIZE
+    #define GS_STR_ID_ARENA_BLOCK_SIZE      16384
+#endif
+
+#define GS_STR_ID_LIT_MAX                   64      // Longest literal hashed at compile time in C
+
+typedef struct gs_str_id_t
+{
+    uint64_t hash;
+    const char* str;
+} gs_str_id_t;
+
+#define gs_str_id_hash(__ID)\
+    ((__ID).hash)
+
+#define gs_str_id_cstr(__ID)\
+    ((__ID).str)
+
+#define gs_str_id_valid(__ID)\
+    ((__ID).str != NULL)
+
+#define gs_str_id_eq(__A, __B)\
+    ((__A).hash == (__B).hash)
+
+GS_API_DECL void
+gs_str_id_init();
+
+GS_API_DECL void
+gs_str_id_shutdown();
+
+GS_API_DECL gs_str_id_t
+gs_str_id_intern(const char* str);
+
+// Interns the first len chars of str (need not be null terminated)
+GS_API_DECL gs_str_id_t
+gs_str_id_intern_n(const char* str, size_t len);
+
+// Returns the interned string for hash, or NULL if none was interned
+GS_API_DECL const char*
+gs_str_id_lookup(uint64_t hash);
+
+// Same hash as gs_hash_str64(), over len chars
+GS_API_DECL uint64_t
+gs_str_id_hash_n(const char* str, size_t len);
+
+/*==== Compile Time Ids ====*/
+
+#ifdef __cplusplus
+
+    constexpr uint32_t
+    __gs_str_id_lit_step(const char* s, size_t i, size_t n, uint32_t seed)
+    {
+        return i < n ? (uint32_t)(__gs_str_id_lit_step(s, i + 1, n, seed) * 33u) ^ (uint32_t)s[i] : seed;
+    }
+
+    constexpr uint64_t
+    __gs_str_id_lit_hash_cx(const char* s, size_t n)
+    {
+        return (uint64_t)(uint32_t)(__gs_str_id_lit_step(s, 0, n, 5381) * 4096u + __gs_str_id_lit_step(s, 0, n, 52711));
+    }
+
+    #define gs_str_id_lit_hash(__S)\
+        __gs_str_id_lit_hash_cx("" __S "", sizeof(__S) - 1)
+
+    #define gs_str_id_lit(__S)\
+        gs_str_id_t{gs_str_id_lit_hash(__S), "" __S ""}
+
+#else
+
+    // gs_hash_str64() walks the string back to front, so the innermost step is the last char. Steps past the end
+    // pass the hash through; __H must only appear once or the expansion doubles per char.
+    #define __gs_str_id_lit_step(__S, __I, __H)\
+        ((uint32_t)((uint32_t)(__H) * ((__I) < sizeof(__S) - 1 ? 33u : 1u)) ^\
+            ((__I) < sizeof(__S) - 1 ? (uint32_t)(__S)[(__I) < sizeof(__S) ? (__I) : 0] : 0u))
+
+    #define __gs_str_id_lit_step8(__S, __I, __H)\
+        __gs_str_id_lit_step(__S, (__I) + 0, __gs_str_id_lit_step(__S, (__I) + 1,\
+        __gs_str_id_lit_step(__S, (__I) + 2, __gs_str_id_lit_step(__S, (__I) + 3,\
+        __gs_str_id_lit_step(__S, (__I) + 4, __gs_str_id_lit_step(__S, (__I) + 5,\
+        __gs_str_id_lit_step(__S, (__I) + 6, __gs_str_id_lit_step(__S, (__I) + 7, __H))))))))
+
+    #define __gs_str_id_lit_step64(__S, __SEED)\
+        __gs_str_id_lit_step8(__S, 0,  __gs_str_id_lit_step8(__S, 8,\
+        __gs_str_id_lit_step8(__S, 16, __gs_str_id_lit_step8(__S, 24,\
+        __gs_str_id_lit_step8(__S, 32, __gs_str_id_lit_step8(__S, 40,\
+        __gs_str_id_lit_step8(__S, 48, __gs_str_id_lit_step8(__S, 56, __SEED))))))))
+
+    #define gs_str_id_lit_hash(__S)\
+        (sizeof("" __S "") - 1 <= GS_STR_ID_LIT_MAX ?\
+            (uint64_t)(uint32_t)(__gs_str_id_lit_step64(__S, 5381u) * 4096u + __gs_str_id_lit_step64(__S, 52711u)) :\
+            gs_hash_str64(__S))
+
+    #define gs_str_id_lit(__S)\
+        ((gs_str_id_t){gs_str_id_lit_hash(__S), (__S)})
+
+#endif
+
+/*==== Implementation ====*/
+
+#ifdef GS_STR_ID_IMPL
+
+typedef struct __gs_str_id_interner_t
+{
+    gs_hash_table_concurrent(uint64_t, const char*) table;
+    gs_spinlock_t lock;                 // Guards the arena and first interns
+    gs_dyn_array(char*) blocks;
+    uint32_t block_used;
+    uint32_t block_capacity;
+} __gs_str_id_interner_t;
+
+static __gs_str_id_interner_t __gs_str_id_interner = {0};
+
+GS_API_DECL void
+gs_str_id_init()
+{
+    gs_hash_table_concurrent_init(__gs_str_id_interner.table, 1024);
+}
+
+GS_API_DECL void
+gs_str_id_shutdown()
+{
+    __gs_str_id_interner_t* si = &__gs_str_id_interner;
+    for (int32_t i = 0; i < gs_dyn_array_size(si->blocks); ++i) {
+        gs_free(si->blocks[i]);
+    }
+    gs_dyn_array_free(si->blocks);
+    gs_hash_table_concurrent_free(si->table);
+    memset(si, 0, sizeof(*si));
+}
+
+GS_API_DECL uint64_t
+gs_str_id_hash_n(const char* str, size_t len)
+{
+    uint32_t hash1 = 5381;
+    uint32_t hash2 = 52711;
+    size_t i = len;
+    while (i--)
+    {
+        char c = str[i];
+        hash1 = (hash1 * 33) ^ c;
+        hash2 = (hash2 * 33) ^ c;
+    }
+    return (uint64_t)(uint32_t)(hash1 * 4096 + hash2);
+}
+
+static const char*
+__gs_str_id_arena_copy(__gs_str_id_interner_t* si, const char* str, size_t len)
+{
+    size_t need = len + 1;
+    if (!si->blocks || si->block_used + need > si->block_capacity)
+    {
+        // Oversized strings get a block of their own
+        size_t cap = need > GS_STR_ID_ARENA_BLOCK_SIZE ? need : GS_STR_ID_ARENA_BLOCK_SIZE;
+        char* block = (char*)gs_malloc(cap);
+        gs_dyn_array_push(si->blocks, block);
+        si->block_used = 0;
+        si->block_capacity = (uint32_t)cap;
+    }
+    char* dst = gs_dyn_array_back(si->blocks) + si->block_used;
+    memcpy(dst, str, len);
+    dst[len] = '\0';
+    si->block_used += (uint32_t)need;
+    return dst;
+}
+
+gs_force_inline bool
+__gs_str_id_matches(const char* interned, const char* str, size_t len)
+{
+    return memcmp(interned, str, len) == 0 && interned[len] == '\0';
+}
+
+GS_API_DECL gs_str_id_t
+gs_str_id_intern_n(const char* str, size_t len)
+{
+    __gs_str_id_interner_t* si = &__gs_str_id_interner;
+    gs_str_id_t id = {0};
+    id.hash = gs_str_id_hash_n(str, len);
+
+    // Known strings never take the lock
+    if (!gs_hash_table_concurrent_get(si->table, &id.hash, &id.str))
+    {
+        gs_spinlock_lock(&si->lock);
+        {
+            // Another thread may have interned it meanwhile
+            if (!gs_hash_table_concurrent_get(si->table, &id.hash, &id.str))
+            {
+                id.str = __gs_str_id_arena_copy(si, str, len);
+                gs_hash_table_concurrent_insert(si->table, &id.hash, &id.str);
+            }
+        }
+        gs_spinlock_unlock(&si->lock);
+    }
+
+    if (!__gs_str_id_matches(id.str, str, len))
+    {
+        gs_println("gs_str_id: hash collision between \"%s\" and \"%.*s\"", id.str, (int)len, str);
+        gs_assert(false);
+    }
+
+    return id;
+}
+
+GS_API_DECL gs_str_id_t
+gs_str_id_intern(const char* str)
+{
+    return gs_str_id_intern_n(str, strlen(str));
+}
+
+GS_API_DECL const char*
+gs_str_id_lookup(uint64_t hash)
+{
+    const char* str = NULL;
+    return gs_hash_table_concurrent_get(__gs_str_id_interner.table, &hash, &str) ? str : NULL;
+}
+
+#endif // GS_STR_ID_IMPL
+#endif // GS_STR_ID_H
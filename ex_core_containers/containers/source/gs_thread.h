@@ -0,0 +1,417 @@
+#ifndef GS_THREAD_H
+#define GS_THREAD_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger thread implementation like this:
+
+        #define GS_THREAD_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+    All other files should just #include "gs_thread.h" without the #define.
+
+    MUST include "gs.h" and declare GS_IMPL BEFORE this file, since this file relies on that:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+    On posix platforms, link with -pthread.
+
+    ================================================================================================================
+*/
+
+/*
+    Minimal threading layer shared by the concurrent containers and allocators:
+
+        * gs_atomic_*:      sequentially consistent / acquire / release operations on 32 bit, 64 bit and pointer values
+        * GS_THREAD_LOCAL:  thread local storage qualifier
+        * gs_spinlock_t:    test-and-test-and-set lock, for short critical sections only
+        * gs_thread_t:      create/join os threads, query hardware thread count
+        * gs_semaphore_t:   counting semaphore, for parking idle threads without spinning
+*/
+
+/*==== Interface ====*/
+
+#if (defined _MSC_VER)
+    #include <intrin.h>
+    #define GS_THREAD_LOCAL __declspec(thread)
+#else
+    #define GS_THREAD_LOCAL __thread
+#endif
+
+#if (defined _MSC_VER)
+
+    #define gs_atomic_load_u32(__P)             (*(volatile uint32_t*)(__P))
+    #define gs_atomic_store_u32(__P, __V)       (void)_InterlockedExchange((volatile long*)(__P), (long)(__V))
+    #define gs_atomic_add_u32(__P, __V)         ((uint32_t)_InterlockedExchangeAdd((volatile long*)(__P), (long)(__V)))
+    #define gs_atomic_xchg_u32(__P, __V)        ((uint32_t)_InterlockedExchange((volatile long*)(__P), (long)(__V)))
+    #define gs_atomic_cas_u32(__P, __E, __D)    ((uint32_t)_InterlockedCompareExchange((volatile long*)(__P), (long)(__D), (long)(__E)) == (uint32_t)(__E))
+
+    #define gs_atomic_load_u64(__P)             (*(volatile uint64_t*)(__P))
+    #define gs_atomic_store_u64(__P, __V)       (void)_InterlockedExchange64((volatile long long*)(__P), (long long)(__V))
+    #define gs_atomic_add_u64(__P, __V)         ((uint64_t)_InterlockedExchangeAdd64((volatile long long*)(__P), (long long)(__V)))
+    #define gs_atomic_cas_u64(__P, __E, __D)    ((uint64_t)_InterlockedCompareExchange64((volatile long long*)(__P), (long long)(__D), (long long)(__E)) == (uint64_t)(__E))
+
+    #define gs_atomic_load_ptr(__P)             (*(void* volatile*)(__P))
+    #define gs_atomic_store_ptr(__P, __V)       (void)_InterlockedExchangePointer((void* volatile*)(__P), (void*)(__V))
+    #define gs_atomic_xchg_ptr(__P, __V)        _InterlockedExchangePointer((void* volatile*)(__P), (void*)(__V))
+    #define gs_atomic_cas_ptr(__P, __E, __D)    (_InterlockedCompareExchangePointer((void* volatile*)(__P), (void*)(__D), (void*)(__E)) == (void*)(__E))
+
+    // x86/x64 loads are acquire and stores are release, only the compiler needs restraining
+    #define gs_atomic_load_acq_u32(__P)         (_ReadWriteBarrier(), *(volatile uint32_t*)(__P))
+    #define gs_atomic_store_rel_u32(__P, __V)   do { _ReadWriteBarrier(); *(volatile uint32_t*)(__P) = (__V); } while (0)
+    #define gs_atomic_load_acq_u64(__P)         (_ReadWriteBarrier(), *(volatile uint64_t*)(__P))
+    #define gs_atomic_store_rel_u64(__P, __V)   do { _ReadWriteBarrier(); *(volatile uint64_t*)(__P) = (__V); } while (0)
+    #define gs_atomic_load_acq_ptr(__P)         (_ReadWriteBarrier(), *(void* volatile*)(__P))
+    #define gs_atomic_fence_acq()               _ReadWriteBarrier()
+    #define gs_atomic_fence_rel()               _ReadWriteBarrier()
+
+    #define gs_atomic_fence()                   _mm_mfence()
+    #define gs_cpu_relax()                      _mm_pause()
+
+#else
+
+    #define gs_atomic_load_u32(__P)             __atomic_load_n((uint32_t*)(__P), __ATOMIC_SEQ_CST)
+    #define gs_atomic_store_u32(__P, __V)       __atomic_store_n((uint32_t*)(__P), (uint32_t)(__V), __ATOMIC_SEQ_CST)
+    #define gs_atomic_add_u32(__P, __V)         __atomic_fetch_add((uint32_t*)(__P), (uint32_t)(__V), __ATOMIC_SEQ_CST)
+    #define gs_atomic_xchg_u32(__P, __V)        __atomic_exchange_n((uint32_t*)(__P), (uint32_t)(__V), __ATOMIC_SEQ_CST)
+    #define gs_atomic_cas_u32(__P, __E, __D)    __gs_atomic_cas_u32((uint32_t*)(__P), (uint32_t)(__E), (uint32_t)(__D))
+
+    #define gs_atomic_load_u64(__P)             __atomic_load_n((uint64_t*)(__P), __ATOMIC_SEQ_CST)
+    #define gs_atomic_store_u64(__P, __V)       __atomic_store_n((uint64_t*)(__P), (uint64_t)(__V), __ATOMIC_SEQ_CST)
+    #define gs_atomic_add_u64(__P, __V)         __atomic_fetch_add((uint64_t*)(__P), (uint64_t)(__V), __ATOMIC_SEQ_CST)
+    #define gs_atomic_cas_u64(__P, __E, __D)    __gs_atomic_cas_u64((uint64_t*)(__P), (uint64_t)(__E), (uint64_t)(__D))
+
+    #define gs_atomic_load_ptr(__P)             __atomic_load_n((void**)(__P), __ATOMIC_SEQ_CST)
+    #define gs_atomic_store_ptr(__P, __V)       __atomic_store_n((void**)(__P), (void*)(__V), __ATOMIC_SEQ_CST)
+    #define gs_atomic_xchg_ptr(__P, __V)        __atomic_exchange_n((void**)(__P), (void*)(__V), __ATOMIC_SEQ_CST)
+    #define gs_atomic_cas_ptr(__P, __E, __D)    __gs_atomic_cas_ptr((void**)(__P), (void*)(__E), (void*)(__D))
+
+    #define gs_atomic_load_acq_u32(__P)         __atomic_load_n((uint32_t*)(__P), __ATOMIC_ACQUIRE)
+    #define gs_atomic_store_rel_u32(__P, __V)   __atomic_store_n((uint32_t*)(__P), (uint32_t)(__V), __ATOMIC_RELEASE)
+    #define gs_atomic_load_acq_u64(__P)         __atomic_load_n((uint64_t*)(__P), __ATOMIC_ACQUIRE)
+    #define gs_atomic_store_rel_u64(__P, __V)   __atomic_store_n((uint64_t*)(__P), (uint64_t)(__V), __ATOMIC_RELEASE)
+    #define gs_atomic_load_acq_ptr(__P)         __atomic_load_n((void**)(__P), __ATOMIC_ACQUIRE)
+    #define gs_atomic_fence_acq()               __atomic_thread_fence(__ATOMIC_ACQUIRE)
+    #define gs_atomic_fence_rel()               __atomic_thread_fence(__ATOMIC_RELEASE)
+
+    #define gs_atomic_fence()                   __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+    #if (defined __i386__ || defined __x86_64__)
+        #define gs_cpu_relax()                  __builtin_ia32_pause()
+    #elif (defined __aarch64__ || defined __arm__)
+        #define gs_cpu_relax()                  __asm__ __volatile__("yield")
+    #else
+        #define gs_cpu_relax()                  ((void)0)
+    #endif
+
+    gs_force_inline
+    bool __gs_atomic_cas_u32(uint32_t* p, uint32_t e, uint32_t d)
+    {
+        return __atomic_compare_exchange_n(p, &e, d, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+
+    gs_force_inline
+    bool __gs_atomic_cas_u64(uint64_t* p, uint64_t e, uint64_t d)
+    {
+        return __atomic_compare_exchange_n(p, &e, d, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+
+    gs_force_inline
+    bool __gs_atomic_cas_ptr(void** p, void* e, void* d)
+    {
+        return __atomic_compare_exchange_n(p, &e, d, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+
+#endif
+
+// Keeps independently written fields on separate cache lines
+#define GS_CACHE_LINE_SIZE  64
+
+/*=== Threads ===*/
+
+typedef void (* gs_thread_func_t)(void* user_data);
+
+typedef struct gs_thread_t
+{
+    void* handle;
+} gs_thread_t;
+
+GS_API_DECL gs_thread_t
+gs_thread_create(gs_thread_func_t func, void* user_data);
+
+GS_API_DECL void
+gs_thread_join(gs_thread_t thread);
+
+GS_API_DECL uint32_t
+gs_thread_hardware_concurrency();
+
+GS_API_DECL void
+gs_thread_yield();
+
+/*=== Semaphore ===*/
+
+typedef struct gs_semaphore_t
+{
+    void* handle;
+} gs_semaphore_t;
+
+GS_API_DECL gs_semaphore_t
+gs_semaphore_new(uint32_t count);
+
+GS_API_DECL void
+gs_semaphore_free(gs_semaphore_t* sem);
+
+// Adds count, waking up to count waiters
+GS_API_DECL void
+gs_semaphore_post(gs_semaphore_t sem, uint32_t count);
+
+// Blocks until count is non zero, then takes one
+GS_API_DECL void
+gs_semaphore_wait(gs_semaphore_t sem);
+
+/*=== Spinlock ===*/
+
+typedef struct gs_spinlock_t
+{
+    uint32_t locked;
+} gs_spinlock_t;
+
+gs_force_inline
+void gs_spinlock_lock(gs_spinlock_t* lock)
+{
+    for (uint32_t spins = 0;; )
+    {
+        if (!gs_atomic_xchg_u32(&lock->locked, 1)) return;
+        while (gs_atomic_load_acq_u32(&lock->locked))
+        {
+            // Give up time slice if holder looks preempted
+            if (++spins & 63) gs_cpu_relax();
+            else gs_thread_yield();
+        }
+    }
+}
+
+gs_force_inline
+bool gs_spinlock_try_lock(gs_spinlock_t* lock)
+{
+    return !gs_atomic_load_acq_u32(&lock->locked) && !gs_atomic_xchg_u32(&lock->locked, 1);
+}
+
+gs_force_inline
+void gs_spinlock_unlock(gs_spinlock_t* lock)
+{
+    gs_atomic_store_rel_u32(&lock->locked, 0);
+}
+
+/*==== Implementation ====*/
+
+#ifdef GS_THREAD_IMPL
+
+#if (defined _WIN32 || defined _WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <unistd.h>
+#endif
+
+typedef struct __gs_thread_start_t
+{
+    gs_thread_func_t func;
+    void* user_data;
+} __gs_thread_start_t;
+
+#if (defined _WIN32 || defined _WIN64)
+
+static DWORD WINAPI
+__gs_thread_entry(LPVOID arg)
+{
+    __gs_thread_start_t s = *(__gs_thread_start_t*)arg;
+    gs_free(arg);
+    s.func(s.user_data);
+    return 0;
+}
+
+GS_API_DECL gs_thread_t
+gs_thread_create(gs_thread_func_t func, void* user_data)
+{
+    gs_thread_t t = gs_default_val();
+    __gs_thread_start_t* s = gs_malloc(sizeof(__gs_thread_start_t));
+    s->func = func;
+    s->user_data = user_data;
+    t.handle = (void*)CreateThread(NULL, 0, __gs_thread_entry, s, 0, NULL);
+    if (!t.handle) gs_free(s);
+    return t;
+}
+
+GS_API_DECL void
+gs_thread_join(gs_thread_t thread)
+{
+    if (!thread.handle) return;
+    WaitForSingleObject((HANDLE)thread.handle, INFINITE);
+    CloseHandle((HANDLE)thread.handle);
+}
+
+GS_API_DECL uint32_t
+gs_thread_hardware_concurrency()
+{
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (uint32_t)gs_max(si.dwNumberOfProcessors, 1);
+}
+
+GS_API_DECL void
+gs_thread_yield()
+{
+    SwitchToThread();
+}
+
+GS_API_DECL gs_semaphore_t
+gs_semaphore_new(uint32_t count)
+{
+    gs_semaphore_t sem = gs_default_val();
+    sem.handle = (void*)CreateSemaphoreA(NULL, (LONG)count, 0x7fffffff, NULL);
+    return sem;
+}
+
+GS_API_DECL void
+gs_semaphore_free(gs_semaphore_t* sem)
+{
+    if (!sem->handle) return;
+    CloseHandle((HANDLE)sem->handle);
+    sem->handle = NULL;
+}
+
+GS_API_DECL void
+gs_semaphore_post(gs_semaphore_t sem, uint32_t count)
+{
+    if (count) ReleaseSemaphore((HANDLE)sem.handle, (LONG)count, NULL);
+}
+
+GS_API_DECL void
+gs_semaphore_wait(gs_semaphore_t sem)
+{
+    WaitForSingleObject((HANDLE)sem.handle, INFINITE);
+}
+
+#else
+
+static void*
+__gs_thread_entry(void* arg)
+{
+    __gs_thread_start_t s = *(__gs_thread_start_t*)arg;
+    gs_free(arg);
+    s.func(s.user_data);
+    return NULL;
+}
+
+GS_API_DECL gs_thread_t
+gs_thread_create(gs_thread_func_t func, void* user_data)
+{
+    gs_thread_t t = gs_default_val();
+    __gs_thread_start_t* s = gs_malloc(sizeof(__gs_thread_start_t));
+    s->func = func;
+    s->user_data = user_data;
+    pthread_t* pt = gs_malloc(sizeof(pthread_t));
+    if (pthread_create(pt, NULL, __gs_thread_entry, s) != 0) {
+        gs_free(pt);
+        gs_free(s);
+        return t;
+    }
+    t.handle = pt;
+    return t;
+}
+
+GS_API_DECL void
+gs_thread_join(gs_thread_t thread)
+{
+    if (!thread.handle) return;
+    pthread_join(*(pthread_t*)thread.handle, NULL);
+    gs_free(thread.handle);
+}
+
+GS_API_DECL uint32_t
+gs_thread_hardware_concurrency()
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (uint32_t)n : 1;
+}
+
+GS_API_DECL void
+gs_thread_yield()
+{
+    sched_yield();
+}
+
+// Unnamed posix semaphores aren't available on osx, so build one from a mutex and condition variable
+typedef struct __gs_semaphore_posix_t
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+} __gs_semaphore_posix_t;
+
+GS_API_DECL gs_semaphore_t
+gs_semaphore_new(uint32_t count)
+{
+    gs_semaphore_t sem = gs_default_val();
+    __gs_semaphore_posix_t* s = gs_malloc(sizeof(__gs_semaphore_posix_t));
+    pthread_mutex_init(&s->mutex, NULL);
+    pthread_cond_init(&s->cond, NULL);
+    s->count = count;
+    sem.handle = s;
+    return sem;
+}
+
+GS_API_DECL void
+gs_semaphore_free(gs_semaphore_t* sem)
+{
+    __gs_semaphore_posix_t* s = (__gs_semaphore_posix_t*)sem->handle;
+    if (!s) return;
+    pthread_cond_destroy(&s->cond);
+    pthread_mutex_destroy(&s->mutex);
+    gs_free(s);
+    sem->handle = NULL;
+}
+
+GS_API_DECL void
+gs_semaphore_post(gs_semaphore_t sem, uint32_t count)
+{
+    __gs_semaphore_posix_t* s = (__gs_semaphore_posix_t*)sem.handle;
+    if (!count) return;
+    pthread_mutex_lock(&s->mutex);
+    s->count += count;
+    if (count == 1) pthread_cond_signal(&s->cond);
+    else pthread_cond_broadcast(&s->cond);
+    pthread_mutex_unlock(&s->mutex);
+}
+
+GS_API_DECL void
+gs_semaphore_wait(gs_semaphore_t sem)
+{
+    __gs_semaphore_posix_t* s = (__gs_semaphore_posix_t*)sem.handle;
+    pthread_mutex_lock(&s->mutex);
+    while (!s->count) pthread_cond_wait(&s->cond, &s->mutex);
+    s->count--;
+    pthread_mutex_unlock(&s->mutex);
+}
+
+#endif
+
+#endif // GS_THREAD_IMPL
+#endif // GS_THREAD_H
@@ -11,6 +11,17 @@
         * gs_slot_array(T): double indirection array of type 'T'
         * gs_slot_map(K, V): indirection array of type 'V' with custom key type 'K'
         * gs_byte_buffer_t: uint8_t data buffer, capable of storing any type of mixed data
+        * gs_hash_table_simd(K, V): open addressing hash table with simd probed control bytes
+            (opted into below, so all gs_hash_table/gs_slot_map calls in this file use it)
+        * gs_slot_array_gen(T): slot array with generation tagged handles and densely packed data
+            (opted into below, so gs_slot_array/gs_slot_map calls in this file use it)
+        * gs_byte_buffer_view/gs_byte_buffer_map_file: read-only, zero-copy byte buffers over external memory or mapped files
+        * Bulk insertion: gs_hash_table_insert_range/gs_slot_map_insert_range size containers once up front
+        * gs_byte_buffer codecs: varint, zigzag, delta and bitpacked integer encodings with bulk decoding
+        * gs_arena_t/gs_frame_allocator_t: linear allocators that dynamic arrays and hash tables can be bound to
+        * gs_flat_map(K, V): sorted key/value arrays, for small tables that are looked up far more than modified
+        * gs_small_array(T, N): array with inline storage for 'N' elements before spilling to the heap
+        * gs_str_id_t: interned strings with precomputed gs_hash_str64 hashes, compile time for literals
 
     Press `esc` to exit the application.
 ================================================================*/
@@ -18,6 +29,45 @@
 #define GS_IMPL
 #include <gs/gs.h> 
 
+// Before gs_hash_table_simd.h, so hash tables can be bound to allocators
+#define GS_ALLOCATOR_IMPL
+#include "gs_allocator.h"
+
+// Swap gs_hash_table (and gs_slot_map's internal table) over to the simd backend
+#define GS_HASH_TABLE_SIMD_IMPL
+#define GS_HASH_TABLE_SIMD_OVERRIDE
+#include "gs_hash_table_simd.h"
+
+// Swap gs_slot_array (and gs_slot_map's internal slot array) over to generational handles
+#define GS_SLOT_ARRAY_GEN_IMPL
+#define GS_SLOT_ARRAY_GEN_OVERRIDE
+#include "gs_slot_array_gen.h"
+
+#define GS_BYTE_BUFFER_VIEW_IMPL
+#include "gs_byte_buffer_view.h"
+
+#define GS_CONTAINERS_BULK_IMPL
+#include "gs_containers_bulk.h"
+
+#define GS_BYTE_BUFFER_CODEC_IMPL
+#include "gs_byte_buffer_codec.h"
+
+#define GS_FLAT_MAP_IMPL
+#include "gs_flat_map.h"
+
+#define GS_SMALL_ARRAY_IMPL
+#include "gs_small_array.h"
+
+// String interner sits on the concurrent hash table, so ids can be interned from any thread
+#define GS_THREAD_IMPL
+#include "gs_thread.h"
+
+#define GS_HASH_TABLE_CONCURRENT_IMPL
+#include "gs_hash_table_concurrent.h"
+
+#define GS_STR_ID_IMPL
+#include "gs_str_id.h"
+
 #define ITER_CT   5
 
 // Helper macro for printing console commands
@@ -28,6 +78,8 @@
         gs_println("(3): Print hash table with custom key");\
         gs_println("(4): Print slot array");\
         gs_println("(5): Print slot map");\
+        gs_println("(6): Print byte buffer");\
+        gs_println("(7): Print flat map and small array");\
     } while(0)
 
 typedef struct custom_key_t 
@@ -42,6 +94,9 @@ gs_hash_table(custom_key_t, uint32_t) htc = NULL; // Hash table with custom key
 gs_slot_array(double) sa = NULL;                  // Slot array
 gs_slot_map(uint64_t, uint32_t) sm = NULL;        // Slot map (hashed str64 bit key)
 gs_byte_buffer_t bb = {0};                        // Byte buffer
+gs_frame_allocator_t fa = {0};                    // Per frame scratch memory
+gs_flat_map(uint64_t, uint32_t) fm = {0};         // Flat map (hashed str64 bit key)
+gs_small_array(uint32_t, 4) small = {0};          // Small array (spills to heap after 4 elements)
 
 // Keys for slot map
 const char* smkeys[ITER_CT] = 
@@ -53,14 +108,31 @@ const char* smkeys[ITER_CT] =
     "Wayne"
 }; 
 
+// Interned slot map keys, hashed once at init instead of on every lookup
+gs_str_id_t smids[ITER_CT] = {0};
+
 void init()
 { 
+    // Construct string interner
+    gs_str_id_init();
+
     // Construct byte buffer
     bb = gs_byte_buffer_new();
 
+    // Construct frame allocator (grows to fit the busiest frame if 4KB isn't enough)
+    fa = gs_frame_allocator_new(4096);
+
     // Write total amount to be written into byte buffer
     gs_byte_buffer_write(&bb, uint32_t, ITER_CT);
 
+    // Key/value arrays for bulk insertion into tables
+    float ht_keys[ITER_CT] = {0};
+    uint32_t ht_vals[ITER_CT] = {0};
+    custom_key_t htc_keys[ITER_CT] = {0};
+    uint32_t htc_vals[ITER_CT] = {0};
+    uint64_t sm_keys[ITER_CT] = {0};
+    uint32_t sm_vals[ITER_CT] = {0};
+
     // Insertion
     for (uint32_t i = 0; i < ITER_CT; ++i) 
     {
@@ -68,22 +140,36 @@ void init()
         gs_dyn_array_push(arr, i);
 
         // Hash table
-        gs_hash_table_insert(ht, (float)i, i);
+        ht_keys[i] = (float)i;
+        ht_vals[i] = i;
 
         // Hash table with custom key
-        custom_key_t k = {.uval = i, .fval = (float)i * 2.f};
-        gs_hash_table_insert(htc, k, i * 2);
+        htc_keys[i] = (custom_key_t){.uval = i, .fval = (float)i * 2.f};
+        htc_vals[i] = i * 2;
 
         // Slot array
         gs_slot_array_insert(sa, (double)i * 3.f);
 
         // Slot map
-        gs_slot_map_insert(sm, gs_hash_str64(smkeys[i]), i);
+        smids[i] = gs_str_id_intern(smkeys[i]);
+        sm_keys[i] = gs_str_id_hash(smids[i]);
+        sm_vals[i] = i;
+
+        // Flat map (kept sorted by key on insert)
+        gs_flat_map_insert(fm, sm_keys[i], i);
+
+        // Small array
+        gs_small_array_push(small, i);
 
         // Byte buffer write
         gs_byte_buffer_write(&bb, uint32_t, i);
     }
 
+    // Bulk insertion (each container is sized once, then filled without rehashing)
+    gs_hash_table_insert_range(ht, ht_keys, ht_vals, ITER_CT);
+    gs_hash_table_insert_range(htc, htc_keys, htc_vals, ITER_CT);
+    gs_slot_map_insert_range(sm, sm_keys, sm_vals, ITER_CT);
+
     // Rewind byte buffer to beginning for reading
     gs_byte_buffer_seek_to_beg(&bb);
 
@@ -94,6 +180,9 @@ void update()
 {
     if (gs_platform_key_pressed(GS_KEYCODE_ESC)) gs_quit();
 
+    // Everything allocated from the frame allocator two frames ago is released here
+    gs_frame_allocator_begin(&fa);
+
     // To print array
     if (gs_platform_key_pressed(GS_KEYCODE_1)) 
     {
@@ -103,6 +192,28 @@ void update()
             gs_printf("%zu, ", arr[i]);
         }
         gs_println("]");
+
+        // Temporary containers bound to the frame allocator (no heap allocations, no need to free)
+        gs_allocator_t* scratch = gs_frame_allocator_current(&fa);
+        gs_dyn_array_bound(uint32_t) sq = {0};
+        gs_hash_table(uint32_t, uint32_t) sq_lookup = NULL;
+        gs_dyn_array_init_with_allocator(sq, scratch, 0);
+        gs_hash_table_init_with_allocator(sq_lookup, uint32_t, uint32_t, scratch);
+        for (uint32_t i = 0; i < gs_dyn_array_size(arr); ++i)
+        {
+            gs_dyn_array_push_bound(sq, arr[i] * arr[i]);
+            gs_hash_table_insert(sq_lookup, arr[i] * arr[i], arr[i]);
+        }
+
+        gs_printf("gs_dyn_array (frame allocated): [");
+        for (uint32_t i = 0; i < gs_dyn_array_size_bound(sq); ++i)
+        {
+            gs_printf("%zu (sqrt: %zu), ", sq.data[i], gs_hash_table_get(sq_lookup, sq.data[i]));
+        }
+        gs_println("]");
+
+        gs_allocator_stats_t st = gs_frame_allocator_stats(&fa);
+        gs_println("gs_frame_allocator_t: in use: %zu, high water: %zu, reserved: %zu", st.in_use, st.high_water, st.reserved);
     }
 
     // Iterate hash table
@@ -137,6 +248,13 @@ void update()
             gs_println("  {k: {%zu, %.2f}, v: %zu},", kp->uval, kp->fval, v);
         }
         gs_println("]");
+
+        // Hash key once, then reuse it for lookups (valid for any table sharing the key type)
+        custom_key_t k = {.uval = 2, .fval = 4.f};
+        size_t h = gs_hash_table_key_hashp(&k);
+        if (gs_hash_table_exists_h(htc, k, h)) {
+            gs_println("gs_hash_table (precomputed hash): {k: {%zu, %.2f}, v: %zu}", k.uval, k.fval, gs_hash_table_get_h(htc, k, h));
+        }
     }
 
     // Iterate slot array
@@ -149,10 +267,23 @@ void update()
             gs_slot_array_iter_advance(sa, it)
         )
         {
+            // Iteration only touches live elements, contiguously. Iterator is a dense index, not a handle.
             double v = gs_slot_array_iter_get(sa, it);    
-            gs_println("  id: %zu, v: %.2f", it, v);
+            gs_println("  id: %zu, v: %.2f", gs_slot_array_iter_handle(sa, it), v);
         }
         gs_println("]");
+
+        // Erasing bumps the slot's generation, so old handles are detected as stale after the slot is reused
+        uint32_t hndl = gs_slot_array_insert(sa, 42.0);
+        gs_slot_array_erase(sa, hndl);
+        uint32_t nhndl = gs_slot_array_insert(sa, 43.0);
+        gs_println("stale handle valid: %s, reused handle valid: %s", 
+            gs_slot_array_handle_valid(sa, hndl) ? "true" : "false",
+            gs_slot_array_handle_valid(sa, nhndl) ? "true" : "false");
+        gs_slot_array_erase(sa, nhndl);
+
+        // Repack data into slot order and release free slots/capacity
+        gs_slot_array_compact(sa);
     }
 
     // Iterate slot map
@@ -162,11 +293,16 @@ void update()
         gs_println("gs_slot_map (manual): [");
         for (uint32_t i = 0; i < ITER_CT; ++i)
         {
-            uint32_t v = gs_slot_map_get(sm, gs_hash_str64(smkeys[i]));
-            gs_println("k: %s, h: %lu, v: %zu", smkeys[i], gs_hash_str64(smkeys[i]), v);
+            uint32_t v = gs_slot_map_get(sm, gs_str_id_hash(smids[i]));
+            gs_println("k: %s, h: %lu, v: %zu", gs_str_id_cstr(smids[i]), gs_str_id_hash(smids[i]), v);
         }
         gs_println("]");
 
+        // Literal keys hash at compile time, and match their interned ids
+        gs_str_id_t harry = gs_str_id_lit("Harry");
+        gs_println("Harry (literal): v: %zu, matches interned: %d", gs_slot_map_get(sm, gs_str_id_hash(harry)),
+            gs_str_id_eq(harry, smids[2]));
+
         gs_println("gs_slot_map (iterator): [");
         for (
             gs_slot_map_iter it = gs_slot_map_iter_new(sm);
@@ -199,6 +335,61 @@ void update()
 
         // Seek back to beginning to read again
         gs_byte_buffer_seek_to_beg(&bb);
+
+        // Read-only view over the same bytes (nothing copied, has its own read position)
+        // Files can be walked the same way with gs_byte_buffer_map_file()/gs_byte_buffer_unmap()
+        gs_byte_buffer_t view = gs_byte_buffer_view(bb.data, bb.size);
+        gs_byte_buffer_readc(&view, uint32_t, vct);
+        const uint32_t* vals = gs_byte_buffer_read_ptr(&view, uint32_t, vct);
+        gs_printf("gs_byte_buffer_t (view): [");
+        for (uint32_t i = 0; i < vct; ++i)
+        {
+            gs_printf("%zu, ", vals[i]);
+        }
+        gs_println("]");
+
+        // Same values through compact encodings, decoded back in bulk
+        gs_byte_buffer_t cbb = gs_byte_buffer_new();
+        gs_byte_buffer_write_varint_i32(&cbb, -(int32_t)vct);
+        gs_byte_buffer_write_delta_u32(&cbb, vals, vct);
+        gs_byte_buffer_write_bitpacked_u32(&cbb, vals, vct, gs_bitpack_width_u32(vals, vct));
+        gs_println("gs_byte_buffer_t (encoded): %zu bytes vs. %zu raw", cbb.size, bb.size);
+
+        gs_byte_buffer_seek_to_beg(&cbb);
+        uint32_t dec[ITER_CT] = {0};
+        uint32_t dct = (uint32_t)-gs_byte_buffer_read_varint_i32(&cbb);
+        gs_byte_buffer_read_delta_u32(&cbb, dec, gs_min(dct, ITER_CT));
+        gs_printf("gs_byte_buffer_t (delta): [");
+        for (uint32_t i = 0; i < gs_min(dct, ITER_CT); ++i)
+        {
+            gs_printf("%zu, ", dec[i]);
+        }
+        gs_println("]");
+        gs_byte_buffer_free(&cbb);
+    }
+
+    if (gs_platform_key_pressed(GS_KEYCODE_7))
+    {
+        // Iterated like a dynamic array, in ascending key order
+        gs_println("Flat Map: [");
+        for (uint32_t i = 0; i < gs_flat_map_size(fm); ++i)
+        {
+            gs_println("\tk: %llu, v: %zu", fm.keys[i], fm.vals[i]);
+        }
+        gs_println("]");
+
+        // Lookup by hashed string key
+        for (uint32_t i = 0; i < ITER_CT; ++i)
+        {
+            gs_println("%s: %zu", smkeys[i], gs_flat_map_get(fm, gs_str_id_hash(smids[i])));
+        }
+
+        gs_printf("Small Array (%s): [", gs_small_array_is_inline(small) ? "inline" : "heap");
+        for (uint32_t i = 0; i < gs_small_array_size(small); ++i)
+        {
+            gs_printf("%zu, ", gs_small_array_get(small, i));
+        }
+        gs_println("]");
     }
 }
 
@@ -218,6 +409,10 @@ void cleanup()
     gs_slot_array_free(sa);
     gs_slot_map_free(sm);
     gs_byte_buffer_free(&bb);
+    gs_frame_allocator_free(&fa);
+    gs_flat_map_free(fm);
+    gs_small_array_free(small);
+    gs_str_id_shutdown();
 }
 
 gs_app_desc_t gs_main(int32_t argc, char** argv)
@@ -9,11 +9,13 @@ proj_root_dir=$(pwd)/../
 
 flags=(
 	-std=gnu99 -Wl,--no-as-needed -ldl -lGL -lX11 -pthread -lXi
+	-fno-math-errno -fno-trapping-math	# Lets the batched move loop vectorize (sqrtf and the compare stay branch free)
 )
 
 # Include directories
 inc=(
 	-I ../../../third_party/include/
+	-I ../../../ex_core_containers/containers/source/	# Thread/job pool headers for batched ticking
 )
 
 # Source files
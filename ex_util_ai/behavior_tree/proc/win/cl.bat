@@ -7,7 +7,7 @@ rem Name
 set name=App
 
 rem Include directories 
-set inc=/I ..\..\..\third_party\include\
+set inc=/I ..\..\..\third_party\include\ /I ..\..\..\ex_core_containers\containers\source\
 
 rem Source files
 set src_main=..\source\main.c
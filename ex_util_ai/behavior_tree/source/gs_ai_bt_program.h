@@ -0,0 +1,622 @@
+#ifndef GS_AI_BT_PROGRAM_H
+#define GS_AI_BT_PROGRAM_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger behavior tree program implementation like this:
+
+        #define GS_AI_BT_PROGRAM_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_AI_BT_PROGRAM_IMPL
+        #include "gs_ai_bt_program.h"
+
+    All other files should just #include "gs_ai_bt_program.h" without the #define.
+
+    MUST include "gs.h" and "gs_ai.h" BEFORE this file, since this file relies on them. Batched ticking
+    (gs_ai_bt_program_tick_batch()) is only declared when "gs_job.h" is included before this file too:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_AI_IMPL
+        #include <gs/util/gs_ai.h>
+
+        #define GS_JOB_IMPL
+        #include "gs_job.h"
+
+        #define GS_AI_BT_PROGRAM_IMPL
+        #include "gs_ai_bt_program.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Behavior trees built once into a flat program, then ticked for any number of agents:
+
+        * gsai_bt() and friends rebuild their tree while ticking it, for one gs_ai_bt_t. A gs_ai_bt_program_t is
+          built once, with the same nesting, into an array of ops in depth first order. Each op knows its parent and
+          where its subtree ends, so stepping to a sibling or back up is an index, not a search.
+        * Ticking runs the ops in one loop, down through each composite's running child to a leaf and back up with
+          its result. No recursion, no allocation.
+        * Everything an agent carries between ticks is one uint16_t per sequence and selector (their running child),
+          gs_ai_bt_program_state_size() bytes. Zero it to start an agent from the top. Keep agent states in one array
+          and the program is shared by all of them, read only.
+        * Sequences and selectors resume at their running child, like gsai_sequence()/gsai_selector(). Conditions
+          are checked again every tick on the way down, so a failed one stops the running branch under it. A repeater
+          runs its child again from the start once it finishes, and is always running.
+        * Leaves and conditions take the agent and the tick's user_data, and return GS_AI_BT_STATE_* / a bool.
+
+            gs_ai_bt_program_t bt = gs_ai_bt_program_new();
+            gsai_program_repeater(&bt, {
+                gsai_program_selector(&bt, {
+                    gsai_program_sequence(&bt, {
+                        gsai_program_leaf(&bt, task_health_check);
+                        gsai_program_leaf(&bt, task_heal);
+                    });
+                    gsai_program_condition(&bt, cond_healthy, {
+                        gsai_program_leaf(&bt, task_move_to);
+                    });
+                });
+            });
+
+            uint16_t* states = gs_malloc(ct * gs_ai_bt_program_state_size(&bt));
+            memset(states, 0, ct * gs_ai_bt_program_state_size(&bt));
+
+            // Every frame
+            gs_ai_bt_program_tick_all(&bt, states, agents, sizeof(agent_t), ct, &frame);
+
+        * gs_ai_bt_program_tick_batch() ticks many agents together, split into ranges over a gs_job_pool_t. Within a
+          range, agents advance in rounds: each one steps down to its next leaf, agents waiting at the same leaf are
+          handed to it as one batch, then each steps on with its result. Batch leaves (gsai_program_leaf_batch())
+          take every agent at that leaf at once, so they can loop over plain arrays instead of calling per agent:
+
+            void task_move_to_batch(const gs_ai_bt_batch_t* b) {
+                for (uint32_t i = 0; i < b->ct; ++i) {
+                    agent_t* a = gs_ai_bt_batch_agent(b, agent_t, i);
+                    ...
+                    b->results[i] = GS_AI_BT_STATE_RUNNING;
+                }
+            }
+
+            gs_ai_bt_program_tick_batch(&bt, &(gs_ai_bt_tick_desc_t){
+                .agents = agents, .agent_stride = sizeof(agent_t), .states = states, .ct = ct,
+                .user_data = &frame, .pool = pool
+            });
+
+        * Per agent and batch leaves mix freely. gs_ai_bt_program_tick() hands batch leaves a batch of one, batched
+          ticks call per agent leaves once per agent.
+        * Batch indices are ascending. Ranges tick at the same time on different workers, so leaves may only touch
+          their own agents (and whatever they guard themselves).
+        * Up to 65535 ops per program.
+*/
+
+/*==== Interface ====*/
+
+typedef enum gs_ai_bt_op_type
+{
+    GS_AI_BT_OP_LEAF = 0x00,
+    GS_AI_BT_OP_CONDITION,      // Fails without running its child when the check is false
+    GS_AI_BT_OP_SEQUENCE,       // Children in order until one doesn't succeed
+    GS_AI_BT_OP_SELECTOR,       // Children in order until one doesn't fail
+    GS_AI_BT_OP_INVERTER,       // Swaps its child's success and failure
+    GS_AI_BT_OP_REPEATER        // Runs its child forever
+} gs_ai_bt_op_type;
+
+// Agents waiting at the same leaf or condition
+typedef struct gs_ai_bt_batch_t
+{
+    const uint32_t* idx;        // Into agents, ascending
+    uint32_t ct;
+    int16_t* results;           // One per agent. Leaves write GS_AI_BT_STATE_*, conditions SUCCESS or FAILURE.
+    void* agents;
+    size_t agent_stride;
+    void* user_data;            // The tick's
+} gs_ai_bt_batch_t;
+
+#define gs_ai_bt_batch_agent(__BATCH, __T, __I)\
+    ((__T*)((uint8_t*)(__BATCH)->agents + (size_t)(__BATCH)->idx[(__I)] * (__BATCH)->agent_stride))
+
+// Return GS_AI_BT_STATE_SUCCESS, GS_AI_BT_STATE_FAILURE or GS_AI_BT_STATE_RUNNING
+typedef int16_t (* gs_ai_bt_task_func)(void* agent, void* user_data);
+typedef bool (* gs_ai_bt_cond_func)(void* agent, void* user_data);
+typedef void (* gs_ai_bt_batch_func)(const gs_ai_bt_batch_t* batch);
+
+// One of task, cond or batch is set
+typedef struct gs_ai_bt_program_func_t
+{
+    gs_ai_bt_task_func task;
+    gs_ai_bt_cond_func cond;
+    gs_ai_bt_batch_func batch;
+} gs_ai_bt_program_func_t;
+
+typedef struct gs_ai_bt_op_t
+{
+    uint16_t type;              // gs_ai_bt_op_type
+    uint16_t func;              // Leaves and conditions: index into funcs
+    uint16_t parent;            // The root is its own parent
+    uint16_t next;              // One past this op's subtree: its next sibling, if its parent's subtree goes on
+    uint16_t slot;              // First state slot in the subtree (a sequence's or selector's own)
+    uint16_t slot_end;          // One past the subtree's last state slot
+} gs_ai_bt_op_t;
+
+typedef struct gs_ai_bt_program_t
+{
+    gs_dyn_array(gs_ai_bt_op_t) ops;
+    gs_dyn_array(gs_ai_bt_program_func_t) funcs;
+    gs_dyn_array(uint16_t) open;                    // Ops begun and not yet ended, while building
+    uint32_t slot_ct;
+} gs_ai_bt_program_t;
+
+GS_API_DECL gs_ai_bt_program_t
+gs_ai_bt_program_new();
+
+GS_API_DECL void
+gs_ai_bt_program_free(gs_ai_bt_program_t* prog);
+
+// Building, in the same nesting as the tree. Composites and decorators are begun and ended, leaves are added.
+GS_API_DECL void
+gs_ai_bt_program_begin(gs_ai_bt_program_t* prog, gs_ai_bt_op_type type);
+
+GS_API_DECL void
+gs_ai_bt_program_condition_begin(gs_ai_bt_program_t* prog, gs_ai_bt_cond_func cond);
+
+GS_API_DECL void
+gs_ai_bt_program_condition_batch_begin(gs_ai_bt_program_t* prog, gs_ai_bt_batch_func cond);
+
+GS_API_DECL void
+gs_ai_bt_program_end(gs_ai_bt_program_t* prog);
+
+GS_API_DECL void
+gs_ai_bt_program_leaf(gs_ai_bt_program_t* prog, gs_ai_bt_task_func task);
+
+GS_API_DECL void
+gs_ai_bt_program_leaf_batch(gs_ai_bt_program_t* prog, gs_ai_bt_batch_func task);
+
+#define gsai_program_sequence(__P, ...)\
+    do {\
+        gs_ai_bt_program_begin((__P), GS_AI_BT_OP_SEQUENCE);\
+        __VA_ARGS__\
+        gs_ai_bt_program_end((__P));\
+    } while (0)
+
+#define gsai_program_selector(__P, ...)\
+    do {\
+        gs_ai_bt_program_begin((__P), GS_AI_BT_OP_SELECTOR);\
+        __VA_ARGS__\
+        gs_ai_bt_program_end((__P));\
+    } while (0)
+
+#define gsai_program_inverter(__P, ...)\
+    do {\
+        gs_ai_bt_program_begin((__P), GS_AI_BT_OP_INVERTER);\
+        __VA_ARGS__\
+        gs_ai_bt_program_end((__P));\
+    } while (0)
+
+#define gsai_program_repeater(__P, ...)\
+    do {\
+        gs_ai_bt_program_begin((__P), GS_AI_BT_OP_REPEATER);\
+        __VA_ARGS__\
+        gs_ai_bt_program_end((__P));\
+    } while (0)
+
+#define gsai_program_condition(__P, __COND, ...)\
+    do {\
+        gs_ai_bt_program_condition_begin((__P), (__COND));\
+        __VA_ARGS__\
+        gs_ai_bt_program_end((__P));\
+    } while (0)
+
+#define gsai_program_condition_batch(__P, __COND, ...)\
+    do {\
+        gs_ai_bt_program_condition_batch_begin((__P), (__COND));\
+        __VA_ARGS__\
+        gs_ai_bt_program_end((__P));\
+    } while (0)
+
+#define gsai_program_leaf(__P, __TASK)\
+    gs_ai_bt_program_leaf((__P), (__TASK))
+
+#define gsai_program_leaf_batch(__P, __TASK)\
+    gs_ai_bt_program_leaf_batch((__P), (__TASK))
+
+// Bytes of state per agent
+GS_API_DECL size_t
+gs_ai_bt_program_state_size(const gs_ai_bt_program_t* prog);
+
+// Ticks one agent, returns the root's result. state is the agent's gs_ai_bt_program_state_size() bytes.
+GS_API_DECL int16_t
+gs_ai_bt_program_tick(const gs_ai_bt_program_t* prog, uint16_t* state, void* agent, void* user_data);
+
+// Ticks ct agents, agent_stride bytes apart, with their states packed one after another in states
+GS_API_DECL void
+gs_ai_bt_program_tick_all(const gs_ai_bt_program_t* prog, uint16_t* states, void* agents, size_t agent_stride,
+    uint32_t ct, void* user_data);
+
+#ifdef GS_JOB_H
+
+#define GS_AI_BT_TICK_BATCH_SIZE_DEFAULT    1024
+
+typedef struct gs_ai_bt_tick_desc_t
+{
+    void* agents;
+    size_t agent_stride;
+    uint16_t* states;           // gs_ai_bt_program_state_size() bytes per agent, packed
+    uint32_t ct;
+    void* user_data;            // Handed to every leaf and condition
+    int16_t* results;           // Optional, the root's result per agent
+    gs_job_pool_t* pool;        // NULL ticks every range on the calling thread
+    uint32_t batch_size;        // Agents per range, GS_AI_BT_TICK_BATCH_SIZE_DEFAULT if 0
+} gs_ai_bt_tick_desc_t;
+
+// Ticks desc->ct agents over desc->pool, returns once all of them have ticked
+GS_API_DECL void
+gs_ai_bt_program_tick_batch(const gs_ai_bt_program_t* prog, const gs_ai_bt_tick_desc_t* desc);
+
+#endif // GS_JOB_H
+
+/*==== Implementation ====*/
+
+#ifdef GS_AI_BT_PROGRAM_IMPL
+
+#define GS_AI_BT_PROGRAM_MAX_OPS        UINT16_MAX
+
+GS_API_DECL gs_ai_bt_program_t
+gs_ai_bt_program_new()
+{
+    gs_ai_bt_program_t prog = gs_default_val();
+    return prog;
+}
+
+GS_API_DECL void
+gs_ai_bt_program_free(gs_ai_bt_program_t* prog)
+{
+    gs_dyn_array_free(prog->ops);
+    gs_dyn_array_free(prog->funcs);
+    gs_dyn_array_free(prog->open);
+    memset(prog, 0, sizeof(gs_ai_bt_program_t));
+}
+
+// Appends an op under the innermost open one
+static uint16_t
+__gs_ai_bt_program_push(gs_ai_bt_program_t* prog, gs_ai_bt_op_type type, uint16_t func)
+{
+    const uint32_t idx = gs_dyn_array_size(prog->ops);
+    const uint32_t open_ct = gs_dyn_array_size(prog->open);
+    if (idx && !open_ct) {
+        gs_println("Error: gs_ai_bt_program: a tree has one root, this op is outside of it");
+        gs_assert(false);
+    }
+    if (idx >= GS_AI_BT_PROGRAM_MAX_OPS) {
+        gs_println("Error: gs_ai_bt_program: more than %u ops", GS_AI_BT_PROGRAM_MAX_OPS);
+        gs_assert(false);
+    }
+
+    gs_ai_bt_op_t op = gs_default_val();
+    op.type = (uint16_t)type;
+    op.func = func;
+    op.parent = open_ct ? prog->open[open_ct - 1] : 0;
+    op.next = (uint16_t)(idx + 1);
+    op.slot = (uint16_t)prog->slot_ct;
+    op.slot_end = (uint16_t)prog->slot_ct;
+    if (type == GS_AI_BT_OP_SEQUENCE || type == GS_AI_BT_OP_SELECTOR) prog->slot_ct++;
+    gs_dyn_array_push(prog->ops, op);
+    return (uint16_t)idx;
+}
+
+GS_API_DECL void
+gs_ai_bt_program_begin(gs_ai_bt_program_t* prog, gs_ai_bt_op_type type)
+{
+    const uint16_t idx = __gs_ai_bt_program_push(prog, type, 0);
+    gs_dyn_array_push(prog->open, idx);
+}
+
+static uint16_t
+__gs_ai_bt_program_push_func(gs_ai_bt_program_t* prog, gs_ai_bt_op_type type, gs_ai_bt_program_func_t func)
+{
+    const uint16_t idx = __gs_ai_bt_program_push(prog, type, (uint16_t)gs_dyn_array_size(prog->funcs));
+    gs_dyn_array_push(prog->funcs, func);
+    return idx;
+}
+
+GS_API_DECL void
+gs_ai_bt_program_condition_begin(gs_ai_bt_program_t* prog, gs_ai_bt_cond_func cond)
+{
+    const uint16_t idx = __gs_ai_bt_program_push_func(prog, GS_AI_BT_OP_CONDITION, (gs_ai_bt_program_func_t){.cond = cond});
+    gs_dyn_array_push(prog->open, idx);
+}
+
+GS_API_DECL void
+gs_ai_bt_program_condition_batch_begin(gs_ai_bt_program_t* prog, gs_ai_bt_batch_func cond)
+{
+    const uint16_t idx = __gs_ai_bt_program_push_func(prog, GS_AI_BT_OP_CONDITION, (gs_ai_bt_program_func_t){.batch = cond});
+    gs_dyn_array_push(prog->open, idx);
+}
+
+GS_API_DECL void
+gs_ai_bt_program_leaf(gs_ai_bt_program_t* prog, gs_ai_bt_task_func task)
+{
+    __gs_ai_bt_program_push_func(prog, GS_AI_BT_OP_LEAF, (gs_ai_bt_program_func_t){.task = task});
+}
+
+GS_API_DECL void
+gs_ai_bt_program_leaf_batch(gs_ai_bt_program_t* prog, gs_ai_bt_batch_func task)
+{
+    __gs_ai_bt_program_push_func(prog, GS_AI_BT_OP_LEAF, (gs_ai_bt_program_func_t){.batch = task});
+}
+
+GS_API_DECL void
+gs_ai_bt_program_end(gs_ai_bt_program_t* prog)
+{
+    if (!gs_dyn_array_size(prog->open)) {
+        gs_println("Error: gs_ai_bt_program_end: nothing to end");
+        gs_assert(false);
+        return;
+    }
+    const uint16_t idx = gs_dyn_array_back(prog->open);
+    gs_dyn_array_pop(prog->open);
+
+    gs_ai_bt_op_t* op = &prog->ops[idx];
+    op->next = (uint16_t)gs_dyn_array_size(prog->ops);
+    op->slot_end = (uint16_t)prog->slot_ct;
+
+    uint32_t child_ct = 0;
+    for (uint32_t c = idx + 1u; c < op->next; c = prog->ops[c].next) child_ct++;
+    const bool decorator = op->type != GS_AI_BT_OP_SEQUENCE && op->type != GS_AI_BT_OP_SELECTOR;
+    if (child_ct == 0 || (decorator && child_ct != 1)) {
+        gs_println("Error: gs_ai_bt_program_end: op %u has %u children, %s", idx, child_ct,
+            decorator ? "decorators take exactly one" : "composites take at least one");
+        gs_assert(false);
+    }
+}
+
+GS_API_DECL size_t
+gs_ai_bt_program_state_size(const gs_ai_bt_program_t* prog)
+{
+    return prog->slot_ct * sizeof(uint16_t);
+}
+
+// Steps down from pc, through each composite's running child, to the next leaf or condition
+static uint16_t
+__gs_ai_bt_program_down(const gs_ai_bt_program_t* prog, const uint16_t* state, uint16_t pc)
+{
+    for (;;)
+    {
+        const gs_ai_bt_op_t* op = &prog->ops[pc];
+        switch (op->type)
+        {
+            case GS_AI_BT_OP_LEAF:
+            case GS_AI_BT_OP_CONDITION:
+                return pc;
+
+            case GS_AI_BT_OP_SEQUENCE:
+            case GS_AI_BT_OP_SELECTOR:
+                pc = state[op->slot] ? state[op->slot] : (uint16_t)(pc + 1);
+                break;
+
+            default:
+                pc++;
+                break;
+        }
+    }
+}
+
+// Goes on after the leaf or condition at pc returned *res. Returns the op to step down from next, or 0 once the root
+// has its result (in *res).
+static uint16_t
+__gs_ai_bt_program_step(const gs_ai_bt_program_t* prog, uint16_t* state, uint16_t pc, int16_t* res)
+{
+    const gs_ai_bt_op_t* ops = prog->ops;
+    if (ops[pc].type == GS_AI_BT_OP_CONDITION)
+    {
+        if (*res == GS_AI_BT_STATE_SUCCESS) return (uint16_t)(pc + 1);
+
+        // Anything running under it is abandoned
+        for (uint32_t s = ops[pc].slot; s < ops[pc].slot_end; ++s) state[s] = 0;
+        *res = GS_AI_BT_STATE_FAILURE;
+    }
+
+    // Up with the result, until the root has it or a composite goes on to its next child
+    while (pc)
+    {
+        const uint16_t child = pc;
+        pc = ops[child].parent;
+        const gs_ai_bt_op_t* op = &ops[pc];
+        switch (op->type)
+        {
+            case GS_AI_BT_OP_SEQUENCE:
+            case GS_AI_BT_OP_SELECTOR:
+            {
+                const int16_t go_on = op->type == GS_AI_BT_OP_SEQUENCE ? GS_AI_BT_STATE_SUCCESS : GS_AI_BT_STATE_FAILURE;
+                if (*res == GS_AI_BT_STATE_RUNNING) {
+                    state[op->slot] = child;
+                }
+                else if (*res == go_on && ops[child].next < op->next) {
+                    return ops[child].next;
+                }
+                else {
+                    state[op->slot] = 0;
+                }
+            } break;
+
+            case GS_AI_BT_OP_INVERTER:
+            {
+                if (*res == GS_AI_BT_STATE_SUCCESS) *res = GS_AI_BT_STATE_FAILURE;
+                else if (*res == GS_AI_BT_STATE_FAILURE) *res = GS_AI_BT_STATE_SUCCESS;
+            } break;
+
+            case GS_AI_BT_OP_REPEATER:
+            {
+                *res = GS_AI_BT_STATE_RUNNING;
+            } break;
+
+            default: break;
+        }
+    }
+    return 0;
+}
+
+// Runs the leaf or condition at pc for one agent
+static int16_t
+__gs_ai_bt_program_call(const gs_ai_bt_program_t* prog, uint16_t pc, void* agent, void* user_data)
+{
+    const gs_ai_bt_program_func_t* f = &prog->funcs[prog->ops[pc].func];
+    if (f->task) return f->task(agent, user_data);
+    if (f->cond) return f->cond(agent, user_data) ? GS_AI_BT_STATE_SUCCESS : GS_AI_BT_STATE_FAILURE;
+
+    const uint32_t idx = 0;
+    int16_t res = GS_AI_BT_STATE_FAILURE;
+    gs_ai_bt_batch_t batch = {.idx = &idx, .ct = 1, .results = &res, .agents = agent, .user_data = user_data};
+    f->batch(&batch);
+    return res;
+}
+
+GS_API_DECL int16_t
+gs_ai_bt_program_tick(const gs_ai_bt_program_t* prog, uint16_t* state, void* agent, void* user_data)
+{
+    if (!prog->ops) return GS_AI_BT_STATE_FAILURE;
+
+    uint16_t pc = 0;
+    int16_t res = GS_AI_BT_STATE_FAILURE;
+    do {
+        pc = __gs_ai_bt_program_down(prog, state, pc);
+        res = __gs_ai_bt_program_call(prog, pc, agent, user_data);
+        pc = __gs_ai_bt_program_step(prog, state, pc, &res);
+    } while (pc);
+    return res;
+}
+
+GS_API_DECL void
+gs_ai_bt_program_tick_all(const gs_ai_bt_program_t* prog, uint16_t* states, void* agents, size_t agent_stride,
+    uint32_t ct, void* user_data)
+{
+    const uint32_t slot_ct = prog->slot_ct;
+    for (uint32_t i = 0; i < ct; ++i) {
+        gs_ai_bt_program_tick(prog, states + (size_t)i * slot_ct, (uint8_t*)agents + i * agent_stride, user_data);
+    }
+}
+
+#ifdef GS_JOB_H
+
+typedef struct __gs_ai_bt_program_tick_t
+{
+    const gs_ai_bt_program_t* prog;
+    const gs_ai_bt_tick_desc_t* desc;
+} __gs_ai_bt_program_tick_t;
+
+static void
+__gs_ai_bt_program_tick_range(uint32_t start, uint32_t end, void* user_data)
+{
+    const __gs_ai_bt_program_tick_t* tick = (const __gs_ai_bt_program_tick_t*)user_data;
+    const gs_ai_bt_program_t* prog = tick->prog;
+    const gs_ai_bt_tick_desc_t* desc = tick->desc;
+    const uint32_t slot_ct = prog->slot_ct;
+    const uint32_t op_ct = gs_dyn_array_size(prog->ops);
+    const uint32_t n = end - start;
+
+    // Scratch for the range: where each agent is, who is still ticking, and them grouped by op
+    uint8_t* scratch = gs_malloc(n * (2 * sizeof(uint32_t) + sizeof(uint16_t) + sizeof(int16_t)) + (op_ct + 1) * sizeof(uint32_t));
+    uint32_t* waiting = (uint32_t*)scratch;
+    uint32_t* order = waiting + n;
+    uint32_t* offsets = order + n;
+    uint16_t* pc = (uint16_t*)(offsets + op_ct + 1);
+    int16_t* res = (int16_t*)(pc + n);
+
+    for (uint32_t i = 0; i < n; ++i) {
+        waiting[i] = i;
+        pc[i] = 0;
+    }
+
+    // Each round moves every ticking agent to its next leaf, runs each leaf once for all of its agents, then steps on
+    uint32_t wait_ct = n;
+    while (wait_ct)
+    {
+        memset(offsets, 0, (op_ct + 1) * sizeof(uint32_t));
+        for (uint32_t w = 0; w < wait_ct; ++w) {
+            const uint32_t a = waiting[w];
+            pc[a] = __gs_ai_bt_program_down(prog, desc->states + (size_t)(start + a) * slot_ct, pc[a]);
+            offsets[pc[a] + 1]++;
+        }
+        for (uint32_t o = 0; o < op_ct; ++o) offsets[o + 1] += offsets[o];
+
+        // Stable, so each op's agents stay ascending
+        for (uint32_t w = 0; w < wait_ct; ++w) {
+            const uint32_t a = waiting[w];
+            order[offsets[pc[a]]++] = start + a;
+        }
+
+        for (uint32_t g = 0; g < wait_ct;)
+        {
+            const uint16_t op = pc[order[g] - start];
+            uint32_t gct = 1;
+            while (g + gct < wait_ct && pc[order[g + gct] - start] == op) gct++;
+
+            // The group's results land at its position in order, res[k] is order[k]'s
+            int16_t* out = res + g;
+            const gs_ai_bt_program_func_t* f = &prog->funcs[prog->ops[op].func];
+            if (f->batch)
+            {
+                gs_ai_bt_batch_t batch = {
+                    .idx = order + g,
+                    .ct = gct,
+                    .results = out,
+                    .agents = desc->agents,
+                    .agent_stride = desc->agent_stride,
+                    .user_data = desc->user_data
+                };
+                f->batch(&batch);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < gct; ++i) {
+                    void* agent = (uint8_t*)desc->agents + (size_t)order[g + i] * desc->agent_stride;
+                    out[i] = __gs_ai_bt_program_call(prog, op, agent, desc->user_data);
+                }
+            }
+            g += gct;
+        }
+
+        // Step on in order (res[k] belongs to order[k]), then keep the agents that haven't finished, ascending
+        for (uint32_t k = 0; k < wait_ct; ++k)
+        {
+            const uint32_t a = order[k] - start;
+            int16_t r = res[k];
+            pc[a] = __gs_ai_bt_program_step(prog, desc->states + (size_t)(start + a) * slot_ct, pc[a], &r);
+            if (!pc[a] && desc->results) desc->results[start + a] = r;
+        }
+        uint32_t kept = 0;
+        for (uint32_t w = 0; w < wait_ct; ++w) {
+            if (pc[waiting[w]]) waiting[kept++] = waiting[w];
+        }
+        wait_ct = kept;
+    }
+
+    gs_free(scratch);
+}
+
+GS_API_DECL void
+gs_ai_bt_program_tick_batch(const gs_ai_bt_program_t* prog, const gs_ai_bt_tick_desc_t* desc)
+{
+    if (!prog->ops || !desc->ct) return;
+
+    __gs_ai_bt_program_tick_t tick = {.prog = prog, .desc = desc};
+    const uint32_t batch_size = desc->batch_size ? desc->batch_size : GS_AI_BT_TICK_BATCH_SIZE_DEFAULT;
+    if (desc->pool) {
+        gs_job_pool_parallel_for(desc->pool, desc->ct, batch_size, __gs_ai_bt_program_tick_range, &tick);
+        return;
+    }
+    for (uint32_t start = 0; start < desc->ct; start += batch_size) {
+        __gs_ai_bt_program_tick_range(start, gs_min(start + batch_size, desc->ct), &tick);
+    }
+}
+
+#endif // GS_JOB_H
+
+#endif // GS_AI_BT_PROGRAM_IMPL
+#endif // GS_AI_BT_PROGRAM_H
@@ -4,6 +4,12 @@
 
     Simple Behavior Tree example.  
 
+    The tree is built once into a flat program (gs_ai_bt_program.h) and
+    ticked for a whole crowd of agents every frame, split over a job pool.
+    Moving runs as a batch leaf, once for every agent that's moving. The
+    first agent is drawn with its axes and target, the rest as lines
+    colored by state.
+
     Press `esc` to exit the application.
 =================================================================*/
 
@@ -19,6 +25,29 @@
 #define GS_AI_IMPL
 #include <gs/util/gs_ai.h> 
 
+// Batched ticking runs on the worker pool (from ex_core_containers/containers/source)
+#define GS_THREAD_IMPL
+#include "gs_thread.h"
+
+#define GS_CONCURRENT_QUEUE_IMPL
+#include "gs_concurrent_queue.h"
+
+#define GS_JOB_IMPL
+#include "gs_job.h"
+
+#define GS_AI_BT_PROGRAM_IMPL
+#include "gs_ai_bt_program.h"
+
+#if (defined _WIN32 || defined _WIN64)
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#define AI_CROWD_CT     20000
+#define AI_DRAIN        5.f         // Health lost per second while moving
+#define AI_MOVE_LANES   64          // Movers gathered per pass of ai_task_target_move_to()
+
 enum 
 {
     AI_STATE_MOVE = 0x00,
@@ -31,26 +60,38 @@ typedef struct
     gs_vec3 target;
     float health;
     int16_t state;
+    uint32_t rng;
 } ai_t;
 
+// Shared by every agent for a tick
+typedef struct
+{
+    float dt;
+} ai_frame_t;
+
 typedef struct
 {
     gs_command_buffer_t cb;
     gs_gui_context_t gui;
     gs_immediate_draw_t gsi;
     gs_camera_t camera;
-    gs_ai_bt_t bt;
-    ai_t ai;
+    gs_ai_bt_program_t bt;
+    gs_job_pool_t* pool;
+    ai_t* ai;                   // AI_CROWD_CT agents
+    uint16_t* ai_state;         // Their behavior tree states, packed
+    double tick_ms;
 } app_t;
 
 void app_camera_update();
+double app_now_ms();
 
 // Behavior tree functions
-void ai_behavior_tree_frame(struct gs_ai_bt_t* ctx); 
-void ai_task_target_find(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node);
-void ai_task_target_move_to(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node);
-void ai_task_health_check(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node);
-void ai_task_heal(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node);
+void ai_behavior_tree_build(gs_ai_bt_program_t* bt);
+int16_t ai_task_target_find(void* agent, void* user_data);
+void ai_task_target_move_to(const gs_ai_bt_batch_t* batch);
+int16_t ai_task_health_check(void* agent, void* user_data);
+int16_t ai_task_heal(void* agent, void* user_data);
+bool ai_cond_healthy(void* agent, void* user_data);
 
 void app_init()
 {
@@ -67,21 +108,29 @@ void app_init()
         .scale = gs_v3s(1.f)
     };
 
-    // Initialize ai information
-    app->ai = (ai_t) {
-        .xform = (gs_vqs) {
-            .translation = gs_v3s(0.f), 
-            .rotation = gs_quat_default(), 
-            .scale = gs_v3s(1.f)
-        },
-        .target = gs_v3s(0.f),
-        .health = 100.f
-    };
+    // Initialize ai information, each agent with its own random targets and starting health
+    app->ai = gs_malloc(AI_CROWD_CT * sizeof(ai_t));
+    for (uint32_t i = 0; i < AI_CROWD_CT; ++i)
+    {
+        app->ai[i] = (ai_t) {
+            .xform = (gs_vqs) {
+                .translation = gs_v3s(0.f), 
+                .rotation = gs_quat_default(), 
+                .scale = gs_v3s(1.f)
+            },
+            .target = gs_v3s(0.f),
+            .health = 100.f - (float)(i % 50),
+            .rng = i * 2654435761u + 1
+        };
+    }
 
-    // Behavior tree contexts hold onto a to an internal ai context. 
-    // This context can hold global/shared information to which the nodes of the BT can read/write.
-    // We'll set our BT's internal context user data to the address of our AI's information.
-    app->bt.ctx.user_data = &app->ai;
+    // The tree is built once. Each agent only carries its own state for it (zeroed starts at the top).
+    app->bt = gs_ai_bt_program_new();
+    ai_behavior_tree_build(&app->bt);
+    const size_t state_size = gs_ai_bt_program_state_size(&app->bt);
+    app->ai_state = gs_malloc(AI_CROWD_CT * state_size);
+    memset(app->ai_state, 0, AI_CROWD_CT * state_size);
+    app->pool = gs_job_pool_new((gs_job_pool_desc_t){0});
 }
 
 void app_update()
@@ -102,7 +151,18 @@ void app_update()
         gs_platform_lock_mouse(gs_platform_main_window(), false);
     }
 
-    ai_behavior_tree_frame(&app->bt);
+    ai_t* ai = &app->ai[0];
+    ai_frame_t frame = {.dt = gs_platform_time()->delta};
+    const double t0 = app_now_ms();
+    gs_ai_bt_program_tick_batch(&app->bt, &(gs_ai_bt_tick_desc_t){
+        .agents = app->ai,
+        .agent_stride = sizeof(ai_t),
+        .states = app->ai_state,
+        .ct = AI_CROWD_CT,
+        .user_data = &frame,
+        .pool = app->pool
+    });
+    app->tick_ms = app_now_ms() - t0;
 
     // Update/render scene
     gsi_camera(gsi, &app->camera, (uint32_t)fbs.x, (uint32_t)fbs.y);
@@ -111,9 +171,16 @@ void app_update()
     // Render ground
     gsi_rect3Dv(gsi, gs_v3(-15.f, -0.5f, -15.f), gs_v3(15.f, -0.5f, 15.f), gs_v2s(0.f), gs_v2s(1.f), gs_color(50, 50, 50, 255), GS_GRAPHICS_PRIMITIVE_TRIANGLES);
 
+    // Render crowd
+    for (uint32_t i = 1; i < AI_CROWD_CT; ++i)
+    {
+        const gs_vec3 p = app->ai[i].xform.translation;
+        gsi_line3Dv(gsi, p, gs_v3(p.x, p.y + 0.5f, p.z), app->ai[i].state == AI_STATE_HEAL ? GS_COLOR_GREEN : GS_COLOR_WHITE);
+    }
+
     // Render ai 
     gsi_push_matrix(gsi, GSI_MATRIX_MODELVIEW);
-        gsi_mul_matrix(gsi, gs_vqs_to_mat4(&app->ai.xform));
+        gsi_mul_matrix(gsi, gs_vqs_to_mat4(&ai->xform));
         gsi_box(gsi, 0.f, 0.f, 0.f, 0.5f, 0.5f, 0.5f, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES);
         gsi_line3Dv(gsi, gs_v3s(0.f), GS_ZAXIS, GS_COLOR_BLUE);
         gsi_line3Dv(gsi, gs_v3s(0.f), GS_XAXIS, GS_COLOR_RED);
@@ -122,7 +189,7 @@ void app_update()
 
     // Render target
     gsi_push_matrix(gsi, GSI_MATRIX_MODELVIEW);
-        gsi_translatev(gsi, app->ai.target);
+        gsi_translatev(gsi, ai->target);
         gsi_box(gsi, 0.f, 0.f, 0.f, 0.5f, 0.5f, 0.5f, 255, 255, 0, 255, GS_GRAPHICS_PRIMITIVE_LINES);
     gsi_pop_matrix(gsi);
 
@@ -132,17 +199,18 @@ void app_update()
     // Do gui
     gs_gui_begin(gui, (gs_gui_hints_t*)NULL);
     { 
-        gs_gui_window_begin(gui, "AI", gs_gui_rect(10, 10, 350, 220));
-        gs_gui_layout_row(gui, 1, (int[]){-1}, 100);
+        gs_gui_window_begin(gui, "AI", gs_gui_rect(10, 10, 350, 260));
+        gs_gui_layout_row(gui, 1, (int[]){-1}, 120);
         gs_gui_text(gui, " * The AI will continue to move towards a random location as long as its health is not lower than 50.\n\n" 
-            " * If health drops below 50, the AI will pause to heal back up to 100 then continue moving towards its target.\n\n"
+            " * Moving drains health. If it drops below 50, the AI will pause to heal back up to 100 then continue moving towards its target.\n\n"
             " * After it reaches its target, it will find another random location to move towards.");
 
         gs_gui_layout_row(gui, 1, (int[]){-1}, 0);
-        gs_gui_label(gui, "state: %s", app->ai.state == AI_STATE_HEAL ? "HEAL" : "MOVE");
+        gs_gui_label(gui, "agents: %u, tick: %.3f ms", AI_CROWD_CT, app->tick_ms);
+        gs_gui_label(gui, "state: %s", ai->state == AI_STATE_HEAL ? "HEAL" : "MOVE");
         gs_gui_layout_row(gui, 2, (int[]){55, 50}, 0);
         gs_gui_label(gui, "health: ");
-        gs_gui_number(gui, &app->ai.health, 0.1f);
+        gs_gui_number(gui, &ai->health, 0.1f);
         gs_gui_window_end(gui);
     }
     gs_gui_end(gui);
@@ -157,6 +225,10 @@ void app_shutdown()
     gs_command_buffer_free(&app->cb);
     gs_immediate_draw_free(&app->gsi);
     gs_gui_free(&app->gui);
+    gs_ai_bt_program_free(&app->bt);
+    gs_job_pool_free(app->pool);
+    gs_free(app->ai);
+    gs_free(app->ai_state);
 }
 
 gs_app_desc_t gs_main(int32_t argc, char** argv)
@@ -170,93 +242,136 @@ gs_app_desc_t gs_main(int32_t argc, char** argv)
     };
 }   
 
-void ai_behavior_tree_frame(struct gs_ai_bt_t* ctx)
+void ai_behavior_tree_build(gs_ai_bt_program_t* bt)
 {
-    ai_t* ai = (ai_t*)ctx->ctx.user_data;
+    gsai_program_repeater(bt, {
+        gsai_program_selector(bt, {
 
-    gsai_bt(ctx, {
-        gsai_repeater(ctx, {
-            gsai_selector(ctx, {
+            // Heal
+            gsai_program_sequence(bt, { 
+                gsai_program_leaf(bt, ai_task_health_check);
+                gsai_program_leaf(bt, ai_task_heal);
+            });
 
-                // Heal
-                gsai_sequence(ctx, { 
-                    gsai_leaf(ctx, ai_task_health_check);
-                    gsai_leaf(ctx, ai_task_heal);
+            // Move to
+            gsai_program_sequence(bt, {
+                gsai_program_leaf(bt, ai_task_target_find);
+                gsai_program_condition(bt, ai_cond_healthy, {
+                    gsai_program_leaf_batch(bt, ai_task_target_move_to);
                 });
+            }); 
 
-                // Move to
-                gsai_sequence(ctx, {
-                    gsai_leaf(ctx, ai_task_target_find);
-                    gsai_condition(ctx, (ai->health > 50.f), {
-                        gsai_leaf(ctx, ai_task_target_move_to);
-                    });
-                }); 
-
-            });
         });
-    }); 
+    });
 } 
 
-void ai_task_health_check(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node)
+int16_t ai_task_health_check(void* agent, void* user_data)
 {
-    ai_t* ai = (ai_t*)ctx->ctx.user_data;
-    node->state = ai->health >= 50 ? GS_AI_BT_STATE_FAILURE : GS_AI_BT_STATE_SUCCESS;
+    ai_t* ai = (ai_t*)agent;
+    return ai->health >= 50 ? GS_AI_BT_STATE_FAILURE : GS_AI_BT_STATE_SUCCESS;
 }
 
-void ai_task_heal(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node)
+int16_t ai_task_heal(void* agent, void* user_data)
 {
-    ai_t* ai = (ai_t*)ctx->ctx.user_data;
+    ai_t* ai = (ai_t*)agent;
     if (ai->health < 100.f) {
         ai->health += 1.f;
-        node->state = GS_AI_BT_STATE_RUNNING; 
         ai->state = AI_STATE_HEAL;
+        return GS_AI_BT_STATE_RUNNING; 
     }
-    else {
-        node->state = GS_AI_BT_STATE_SUCCESS;
-    }
+    return GS_AI_BT_STATE_SUCCESS;
+}
+
+bool ai_cond_healthy(void* agent, void* user_data)
+{
+    ai_t* ai = (ai_t*)agent;
+    return ai->health >= 50.f;
+}
+
+// Per agent xorshift, so agents don't share targets (or reseed a generator for every pick)
+float ai_rand_range(ai_t* ai, float lo, float hi)
+{
+    ai->rng ^= ai->rng << 13;
+    ai->rng ^= ai->rng >> 17;
+    ai->rng ^= ai->rng << 5;
+    return lo + (hi - lo) * (float)(ai->rng & 0xffffff) / (float)0xffffff;
 }
 
-void ai_task_target_find(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node)
+int16_t ai_task_target_find(void* agent, void* user_data)
 {
-    ai_t* ai = (ai_t*)ctx->ctx.user_data;
+    ai_t* ai = (ai_t*)agent;
     float dist = gs_vec3_dist(ai->xform.translation, ai->target);
     if (dist < 1.f) {
-        gs_mt_rand_t rand = gs_rand_seed(time(NULL));
-        gs_vec3 target = gs_v3(
-            gs_rand_gen_range(&rand, -10.f, 10.f),
+        ai->target = gs_v3(
+            ai_rand_range(ai, -10.f, 10.f),
             0.f,
-            gs_rand_gen_range(&rand, -10.f, 10.f)
+            ai_rand_range(ai, -10.f, 10.f)
         );
-        ai->target = target;
     }
-    node->state = GS_AI_BT_STATE_SUCCESS;
+    return GS_AI_BT_STATE_SUCCESS;
 } 
 
-void ai_task_target_move_to(struct gs_ai_bt_t* ctx, struct gs_ai_bt_node_t* node)
+// Every agent moving this tick, AI_MOVE_LANES at a time: positions and targets are gathered into
+// plain arrays so the step itself is one float loop the compiler can vectorize
+void ai_task_target_move_to(const gs_ai_bt_batch_t* batch)
 {
-    ai_t* ai = (ai_t*)ctx->ctx.user_data;
-    const float dt = gs_platform_time()->delta;
-    float dist = gs_vec3_dist(ai->xform.translation, ai->target);
-    float speed = 25.f * dt;
-    if (dist > speed) {
-        gs_vec3 dir = gs_vec3_norm(gs_vec3_sub(ai->target, ai->xform.translation));
-        gs_vec3 vel = gs_vec3_scale(dir, speed);
-        gs_vec3 np = gs_vec3_add(ai->xform.translation, vel);
-        ai->xform.translation = gs_v3(
-            gs_interp_linear(ai->xform.translation.x, np.x, 0.05f),
-            gs_interp_linear(ai->xform.translation.y, np.y, 0.05f),
-            gs_interp_linear(ai->xform.translation.z, np.z, 0.05f)
-        );
-        // Look at target rotation
-        ai->xform.rotation = gs_quat_look_rotation(ai->xform.translation, ai->target, GS_YAXIS);
-        node->state = GS_AI_BT_STATE_RUNNING;
-        ai->state = AI_STATE_MOVE;
-    }
-    else {
-        node->state = GS_AI_BT_STATE_SUCCESS;
+    const float dt = ((ai_frame_t*)batch->user_data)->dt;
+    const float speed = 25.f * dt;
+    float px[AI_MOVE_LANES], py[AI_MOVE_LANES], pz[AI_MOVE_LANES];
+    float tx[AI_MOVE_LANES], ty[AI_MOVE_LANES], tz[AI_MOVE_LANES];
+    float dist[AI_MOVE_LANES];
+
+    for (uint32_t base = 0; base < batch->ct; base += AI_MOVE_LANES)
+    {
+        const uint32_t n = gs_min(AI_MOVE_LANES, batch->ct - base);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const ai_t* ai = gs_ai_bt_batch_agent(batch, ai_t, base + i);
+            px[i] = ai->xform.translation.x; py[i] = ai->xform.translation.y; pz[i] = ai->xform.translation.z;
+            tx[i] = ai->target.x; ty[i] = ai->target.y; tz[i] = ai->target.z;
+        }
+
+        // Step towards the target, eased by 0.05
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const float dx = tx[i] - px[i], dy = ty[i] - py[i], dz = tz[i] - pz[i];
+            dist[i] = sqrtf(dx * dx + dy * dy + dz * dz);
+            const float step = 0.05f * speed / gs_max(dist[i], 1e-6f);
+            const float s = dist[i] > speed ? step : 0.f;
+            px[i] += dx * s; py[i] += dy * s; pz[i] += dz * s;
+        }
+
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            ai_t* ai = gs_ai_bt_batch_agent(batch, ai_t, base + i);
+            if (dist[i] <= speed) {
+                batch->results[base + i] = GS_AI_BT_STATE_SUCCESS;
+                continue;
+            }
+            ai->xform.translation = gs_v3(px[i], py[i], pz[i]);
+            // Look at target rotation
+            ai->xform.rotation = gs_quat_look_rotation(ai->xform.translation, ai->target, GS_YAXIS);
+            ai->health = gs_max(ai->health - AI_DRAIN * dt, 0.f);
+            ai->state = AI_STATE_MOVE;
+            batch->results[base + i] = GS_AI_BT_STATE_RUNNING;
+        }
     }
 }
 
+double app_now_ms()
+{
+#if (defined _WIN32 || defined _WIN64)
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart * 1e3 / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec * 1e-6;
+#endif
+}
+
 #define SENSITIVITY 0.2f
 static float pitch = 0.f;
 static float speed = 2.f;
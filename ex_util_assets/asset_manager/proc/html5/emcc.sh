@@ -14,6 +14,7 @@ flags=(
 # Include directories
 inc=(
     -I ../../../third_party/include/   # Gunslinger includes
+    -I ../../../ex_core_containers/containers/source/   # Job pool (runs inline without pthreads)
 )
 
 # Source files
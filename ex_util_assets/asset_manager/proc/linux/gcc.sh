@@ -14,6 +14,7 @@ flags=(
 # Include directories
 inc=(
 	-I ../../../third_party/include/
+	-I ../../../ex_core_containers/containers/source/	# Thread/job pool headers for async loading
 )
 
 # Source files
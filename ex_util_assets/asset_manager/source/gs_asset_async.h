@@ -0,0 +1,1391 @@
+#ifndef GS_ASSET_ASYNC_H
+#define GS_ASSET_ASYNC_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger async asset implementation like this:
+
+        #define GS_ASSET_ASYNC_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+    All other files should just #include "gs_asset_async.h" without the #define.
+
+    MUST include "gs.h", "gs_asset.h" and the job pool (ex_core_containers/containers/source) BEFORE this file:
+
+        #define GS_IMPL
+        #include <gs/gs.h>
+
+        #define GS_ASSET_IMPL
+        #include <gs/util/gs_asset.h>
+
+        #define GS_THREAD_IMPL
+        #include "gs_thread.h"
+
+        #define GS_CONCURRENT_QUEUE_IMPL
+        #include "gs_concurrent_queue.h"
+
+        #define GS_JOB_IMPL
+        #include "gs_job.h"
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Asynchronous asset loading for gs_asset_manager_t:
+
+        * gs_assets_load_async() creates the asset in the manager (zeroed) and returns its handle right away. File
+          reads and decoding run as jobs on a gs_job_pool_t.
+        * Anything touching the graphics or audio backends happens on the main thread in gs_assets_async_update(),
+          called once per frame. Texture pixels are uploaded through the given command buffer.
+        * gs_assets_status() reports QUEUED -> DECODING -> DECODED -> READY, or FAILED. Until READY the asset in the
+          manager is zeroed.
+        * Optional loader arguments are designated initializers for gs_asset_load_params_t, copied at the call:
+
+            gs_asset_t tex = gs_assets_load_async(&gsa, gs_asset_texture_t, "./assets/champ.png");
+            gs_asset_t fnt = gs_assets_load_async(&gsa, gs_asset_font_t, "./assets/font.ttf", .point_size = 32);
+
+            // Every frame, before submitting gcb
+            gs_assets_async_update(&gcb);
+            if (gs_assets_ready(&gsa, tex)) {}
+
+        * Built in: gs_asset_texture_t (PNG/JPG/TGA/BMP decoded on workers), gs_asset_audio_t (WAV/OGG/MP3 decoded
+          on workers), gs_asset_mesh_t (glTF parsed and vertex data built on workers) and gs_asset_font_t (file read
+          on workers; glyphs are baked on the main thread, since gs_asset's font loader creates its atlas texture
+          while baking). Other types register decode/finalize callbacks with gs_assets_register_async_importer().
+        * With gs_asset_mesh_optimize.h included before this file, .mesh_optimize = true also reorders a mesh's
+          indices and vertices for the vertex cache on the worker, its primitives spread over the pool.
+        * gs_assets_load_batch() loads many files of one type in a few jobs. Importers with a decode_batch callback
+          get each job's paths in one call, to amortize per file setup over thousands of tiny files:
+
+            gs_asset_t navs[256];
+            gs_assets_load_batch(&gsa, navmesh_t, paths, 256, navs, gs_asset_params(navmesh_params_t, .cell_size = 0.3f));
+
+        * Custom importers can take typed params: params_size in the importer, gs_asset_params() at the load and
+          gs_asset_params_get() in decode. They are copied like any user_data.
+        * gs_assets_reload_async() decodes a READY asset's file again and swaps the result into the same handle at the
+          next update, destroying the old one. Audio sources are left registered, instances may still be playing them.
+        * Every load keeps its path and timings (queued, decoding, decoded, done) once it is done, for gs_asset_stats.h.
+        * stb_image's vertical flip flag is global, so workers always decode unflipped and flip rows themselves.
+        * gs_assets_load_async(), gs_assets_async_update() and gs_assets_status() are main thread only.
+*/
+
+/*==== Interface ====*/
+
+typedef enum gs_asset_status
+{
+    GS_ASSET_STATUS_NONE = 0x00,    // Not an async load
+    GS_ASSET_STATUS_QUEUED,
+    GS_ASSET_STATUS_DECODING,
+    GS_ASSET_STATUS_DECODED,        // Waiting for gs_assets_async_update()
+    GS_ASSET_STATUS_READY,
+    GS_ASSET_STATUS_FAILED,
+    GS_ASSET_STATUS_EVICTED         // Unloaded by gs_assets_async_unload(), zeroed until loaded again
+} gs_asset_status;
+
+typedef struct gs_asset_load_params_t
+{
+    gs_graphics_texture_desc_t* texture_desc;   // gs_asset_texture_t: format/filtering (size and data are filled in)
+    bool32_t flip_on_load;                      // gs_asset_texture_t
+    uint32_t point_size;                        // gs_asset_font_t, 16 if 0
+    gs_asset_mesh_decl_t* mesh_decl;            // gs_asset_mesh_t
+    bool32_t mesh_optimize;                     // gs_asset_mesh_t, vertex cache order (with gs_asset_mesh_optimize.h)
+    const void* user_data;                      // Custom importers, user_data_size bytes are copied
+    size_t user_data_size;
+} gs_asset_load_params_t;
+
+// Typed custom importer params, in place of user_data/user_data_size:
+//  gs_assets_load_async(&gsa, navmesh_t, path, gs_asset_params(navmesh_params_t, .cell_size = 0.3f))
+#define gs_asset_params(__T, ...)\
+    .user_data = &(__T){__VA_ARGS__}, .user_data_size = sizeof(__T)
+
+// Importer side: the load's params as a const __T*, NULL if it has none (or they aren't a __T)
+#define gs_asset_params_get(__PARAMS, __T)\
+    ((__PARAMS)->user_data_size == sizeof(__T) ? (const __T*)(__PARAMS)->user_data : NULL)
+
+typedef struct gs_asset_async_importer_desc_t
+{
+    // Worker thread: read and decode path into decoded (decoded_size zeroed bytes). Must not touch the
+    // graphics/audio backends or the asset manager, and must release everything it allocated when failing.
+    bool (* decode)(const char* path, void* decoded, const gs_asset_load_params_t* params);
+
+    // Main thread: build the asset at out from decoded, recording uploads into cb. Releases decoded's
+    // allocations whether or not it succeeds. Must not create assets (out points into the manager).
+    bool (* finalize)(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb);
+
+    // Releases decoded's allocations for loads still unfinalized at gs_assets_async_shutdown() (optional)
+    void (* release)(void* decoded);
+
+    // Main thread: releases a READY asset's backend resources when a reload replaces it or it is unloaded (optional)
+    void (* destroy)(void* asset);
+
+    // Worker thread, after decode: bytes the finished asset will hold on CPU and GPU, for budgets (optional)
+    size_t (* size)(const void* decoded, const gs_asset_load_params_t* params);
+
+    // Worker thread: decodes ct loads of one gs_assets_load_batch() call at once, decoded[i] and ok[i] being path[i]'s
+    // (optional, batches call decode per path otherwise). Same rules as decode, per load.
+    void (* decode_batch)(const char* const* paths, void** decoded, bool* ok, uint32_t ct,
+        const gs_asset_load_params_t* params);
+
+    size_t decoded_size;
+    size_t asset_size;      // sizeof the asset type, reloads build into a copy before swapping it in
+    size_t params_size;     // sizeof the typed params (gs_asset_params()), loads with other params fail (optional)
+    uint32_t batch_size;    // Loads per decode_batch call, GS_ASSET_ASYNC_BATCH_SIZE_DEFAULT if 0
+} gs_asset_async_importer_desc_t;
+
+#define GS_ASSET_ASYNC_BATCH_SIZE_DEFAULT       64
+
+typedef struct gs_asset_async_desc_t
+{
+    gs_job_pool_t* pool;            // Shared pool, or NULL to create one with thread_ct workers
+    uint32_t thread_ct;             // 0 for hardware threads - 1
+    uint32_t finalize_max;          // Loads finalized per gs_assets_async_update(), 0 for all
+} gs_asset_async_desc_t;
+
+// Optional, called with defaults by the first load otherwise
+GS_API_DECL void
+gs_assets_async_init(gs_asset_async_desc_t desc);
+
+// Waits for in flight decodes and releases their data. Assets already READY stay in their managers.
+GS_API_DECL void
+gs_assets_async_shutdown();
+
+GS_API_DECL void
+gs_assets_register_async_importer_func(uint64_t type_id, const gs_asset_async_importer_desc_t* desc);
+
+// Names type_id in stats (gs_asset_stats.h), gs_assets_register_async_importer() does it for its type
+GS_API_DECL void
+gs_assets_async_name_type(uint64_t type_id, const char* name);
+
+// Variadic so the desc can be a compound literal
+#define gs_assets_register_async_importer(__T, ...)\
+    (gs_assets_async_name_type(gs_hash_str64(gs_to_str(__T)), gs_to_str(__T)),\
+        gs_assets_register_async_importer_func(gs_hash_str64(gs_to_str(__T)), (__VA_ARGS__)))
+
+GS_API_DECL gs_asset_t
+gs_assets_load_async_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params);
+
+#define gs_assets_load_async(__AM, __T, __PATH, ...)\
+    gs_assets_load_async_func((__AM), gs_hash_str64(gs_to_str(__T)), gs_assets_create_asset((__AM), __T, &(__T){0}),\
+        (__PATH), &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+// Loads ct paths into assets (one per path) with the same params, batch_size loads per worker job
+GS_API_DECL void
+gs_assets_load_batch_func(gs_asset_manager_t* am, uint64_t type_id, const gs_asset_t* assets, const char* const* paths,
+    uint32_t ct, const gs_asset_load_params_t* params);
+
+// Creates the assets, writing their handles to __OUT (__CT of them)
+#define gs_assets_load_batch(__AM, __T, __PATHS, __CT, __OUT, ...)\
+    do {\
+        for (uint32_t __gs_i = 0; __gs_i < (uint32_t)(__CT); ++__gs_i) {\
+            (__OUT)[__gs_i] = gs_assets_create_asset((__AM), __T, &(__T){0});\
+        }\
+        gs_assets_load_batch_func((__AM), gs_hash_str64(gs_to_str(__T)), (__OUT), (const char* const*)(__PATHS),\
+            (uint32_t)(__CT), &(gs_asset_load_params_t){0, __VA_ARGS__});\
+    } while (0)
+
+// Decodes path again and swaps the result into asset in gs_assets_async_update(). The old asset is destroyed, and
+// stays in place if the reload fails. gs_assets_status() is unaffected. Returns false unless the asset is READY and
+// not reloading already.
+GS_API_DECL bool
+gs_assets_reload_async_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params);
+
+#define gs_assets_reload_async(__AM, __T, __HNDL, __PATH, ...)\
+    gs_assets_reload_async_func((__AM), gs_hash_str64(gs_to_str(__T)), (__HNDL), (__PATH),\
+        &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+// Hands an asset loaded some other way to the async loader as READY, so it can be reloaded and unloaded. Returns false
+// if the loader already knows the asset or type_id has no async importer.
+GS_API_DECL bool
+gs_assets_async_adopt_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path);
+
+#define gs_assets_async_adopt(__AM, __T, __HNDL, __PATH)\
+    gs_assets_async_adopt_func((__AM), gs_hash_str64(gs_to_str(__T)), (__HNDL), (__PATH))
+
+// Finalizes decoded loads on the main thread, returns how many are still in flight
+GS_API_DECL uint32_t
+gs_assets_async_update(gs_command_buffer_t* cb);
+
+// Blocks until every load has finished, running decode jobs on the calling thread meanwhile
+GS_API_DECL void
+gs_assets_async_wait(gs_command_buffer_t* cb);
+
+GS_API_DECL gs_asset_status
+gs_assets_status(gs_asset_manager_t* am, gs_asset_t asset);
+
+// Destroys a READY asset and zeroes it (status EVICTED). Returns false if it isn't READY, is reloading, or its
+// importer can't destroy. gs_assets_load_async_func() into the same handle brings it back.
+GS_API_DECL bool
+gs_assets_async_unload(gs_asset_manager_t* am, gs_asset_t asset);
+
+// What the importer's size callback reported for a READY asset, 0 otherwise
+GS_API_DECL size_t
+gs_assets_async_bytes(gs_asset_manager_t* am, gs_asset_t asset);
+
+// File sources serve paths under a prefix (like a mounted pack, see gs_asset_pack.h) from memory. The async importers
+// and gs_assets_read_file() look there before the disk.
+typedef struct gs_asset_file_source_desc_t
+{
+    const char* prefix;
+    // Any thread: path's bytes (valid until the source is removed) and size, NULL if the source doesn't have it
+    const void* (* find)(const char* path, size_t* size, void* user_data);
+    void* user_data;
+} gs_asset_file_source_desc_t;
+
+#define GS_ASSET_FILE_SOURCE_MAX        8
+
+GS_API_DECL bool
+gs_assets_add_file_source(const gs_asset_file_source_desc_t* desc);
+
+// Not while loads from it are in flight
+GS_API_DECL void
+gs_assets_remove_file_source(const char* prefix);
+
+// Whole file from a file source, or the disk otherwise. Free with gs_free().
+GS_API_DECL void*
+gs_assets_read_file(const char* path, size_t* size);
+
+#define gs_assets_ready(__AM, __HNDL)\
+    (gs_assets_status((__AM), (__HNDL)) == GS_ASSET_STATUS_READY)
+
+#define gs_assets_failed(__AM, __HNDL)\
+    (gs_assets_status((__AM), (__HNDL)) == GS_ASSET_STATUS_FAILED)
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_ASYNC_IMPL
+
+#if (defined _WIN32 || defined _WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#elif !(defined __EMSCRIPTEN__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+#include <time.h>
+
+// Load params with copies of everything they point at, must not move once copied into
+typedef struct __gs_asset_async_params_t
+{
+    gs_asset_load_params_t params;
+    gs_graphics_texture_desc_t texture_desc;
+    gs_asset_mesh_decl_t mesh_decl;
+} __gs_asset_async_params_t;
+
+typedef struct __gs_asset_async_request_t
+{
+    gs_asset_manager_t* am;
+    gs_asset_t asset;
+    uint64_t type_id;
+    gs_asset_async_importer_desc_t importer;
+    char* path;                                 // Kept once done, for stats
+    __gs_asset_async_params_t params;
+    void* decoded;
+    size_t bytes;
+    bool reload;
+    bool done;                                  // Out of inflight, only status (and stats) is left
+    uint32_t status;                            // Written by workers until DECODED/FAILED
+    double queued;                              // __gs_asset_async_now() when loaded, decoding, decoded and done
+    double decode_begin;                        // (the decode times are written by workers, like status)
+    double decode_end;
+    double finished;
+} __gs_asset_async_request_t;
+
+typedef struct __gs_asset_async_type_name_t
+{
+    char name[64];
+} __gs_asset_async_type_name_t;
+
+typedef struct __gs_asset_async_t
+{
+    bool initialized;
+    gs_job_pool_t* pool;
+    bool owns_pool;
+    uint32_t finalize_max;
+    gs_job_counter_t decoding;
+    gs_hash_table(uint64_t, gs_asset_async_importer_desc_t) importers;
+    gs_hash_table(uint64_t, __gs_asset_async_type_name_t) type_names;
+    gs_hash_table(uint64_t, __gs_asset_async_request_t*) requests;  // Every async load, by handle
+    gs_dyn_array(__gs_asset_async_request_t*) inflight;
+} __gs_asset_async_t;
+
+static __gs_asset_async_t __gs_asset_async = {0};
+
+// Seconds, any thread
+static double
+__gs_asset_async_now()
+{
+#if (defined _WIN32 || defined _WIN64)
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static char*
+__gs_asset_async_strdup(const char* str)
+{
+    const size_t len = strlen(str);
+    char* out = gs_malloc(len + 1);
+    memcpy(out, str, len + 1);
+    return out;
+}
+
+static uint64_t
+__gs_asset_async_key(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    uint64_t h = gs_hash_bytes(&asset, sizeof(gs_asset_t), GS_HASH_TABLE_HASH_SEED);
+    return h ^ (uint64_t)(uintptr_t)am;
+}
+
+static void
+__gs_asset_async_flip_rows(uint8_t* pixels, uint32_t width, uint32_t height, uint32_t bpp)
+{
+    const size_t row = (size_t)width * bpp;
+    uint8_t tmp[1024];
+    for (uint32_t y = 0; y < height / 2; ++y)
+    {
+        uint8_t* a = pixels + y * row;
+        uint8_t* b = pixels + (height - 1 - y) * row;
+        for (size_t o = 0; o < row; o += sizeof(tmp))
+        {
+            size_t n = gs_min(sizeof(tmp), row - o);
+            memcpy(tmp, a + o, n);
+            memcpy(a + o, b + o, n);
+            memcpy(b + o, tmp, n);
+        }
+    }
+}
+
+/*=== Files ===*/
+
+typedef struct __gs_asset_map_t
+{
+    uint8_t* data;
+    size_t size;
+} __gs_asset_map_t;
+
+static bool
+__gs_asset_map_file(const char* path, __gs_asset_map_t* map)
+{
+#if (defined _WIN32 || defined _WIN64)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER sz = {0};
+    if (!GetFileSizeEx(file, &sz) || !sz.QuadPart) {
+        CloseHandle(file);
+        return false;
+    }
+    // The view keeps the mapping alive once both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return false;
+    map->data = (uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    map->size = (size_t)sz.QuadPart;
+    CloseHandle(mapping);
+    return map->data != NULL;
+#elif (defined __EMSCRIPTEN__)
+    // No real mmap in the browser's file system
+    map->data = (uint8_t*)gs_platform_read_file_contents(path, "rb", &map->size);
+    return map->data != NULL;
+#else
+    int32_t fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    map->data = (uint8_t*)data;
+    map->size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+static void
+__gs_asset_unmap_file(__gs_asset_map_t* map)
+{
+    if (!map->data) return;
+#if (defined _WIN32 || defined _WIN64)
+    UnmapViewOfFile(map->data);
+#elif (defined __EMSCRIPTEN__)
+    gs_free(map->data);
+#else
+    munmap(map->data, map->size);
+#endif
+    map->data = NULL;
+    map->size = 0;
+}
+
+typedef struct __gs_asset_file_sources_t
+{
+    gs_spinlock_t lock;
+    gs_asset_file_source_desc_t sources[GS_ASSET_FILE_SOURCE_MAX];
+    char prefixes[GS_ASSET_FILE_SOURCE_MAX][64];
+    uint32_t ct;
+} __gs_asset_file_sources_t;
+
+// Apart from __gs_asset_async, sources outlive async shutdown
+static __gs_asset_file_sources_t __gs_asset_file_sources = {0};
+
+GS_API_DECL bool
+gs_assets_add_file_source(const gs_asset_file_source_desc_t* desc)
+{
+    __gs_asset_file_sources_t* fs = &__gs_asset_file_sources;
+    if (!desc->prefix || !desc->find || strlen(desc->prefix) >= sizeof(fs->prefixes[0])) return false;
+
+    bool ok = false;
+    gs_spinlock_lock(&fs->lock);
+    if (fs->ct < GS_ASSET_FILE_SOURCE_MAX)
+    {
+        gs_snprintf(fs->prefixes[fs->ct], sizeof(fs->prefixes[0]), "%s", desc->prefix);
+        fs->sources[fs->ct] = *desc;
+        fs->sources[fs->ct].prefix = fs->prefixes[fs->ct];
+        gs_atomic_add_u32(&fs->ct, 1);
+        ok = true;
+    }
+    gs_spinlock_unlock(&fs->lock);
+    return ok;
+}
+
+GS_API_DECL void
+gs_assets_remove_file_source(const char* prefix)
+{
+    __gs_asset_file_sources_t* fs = &__gs_asset_file_sources;
+    gs_spinlock_lock(&fs->lock);
+    for (uint32_t i = 0; i < fs->ct; ++i)
+    {
+        if (strcmp(fs->prefixes[i], prefix) != 0) continue;
+        // Later sources move down, their prefixes with them
+        for (uint32_t j = i; j + 1 < fs->ct; ++j) {
+            memcpy(fs->prefixes[j], fs->prefixes[j + 1], sizeof(fs->prefixes[0]));
+            fs->sources[j] = fs->sources[j + 1];
+            fs->sources[j].prefix = fs->prefixes[j];
+        }
+        gs_atomic_add_u32(&fs->ct, (uint32_t)-1);
+        break;
+    }
+    gs_spinlock_unlock(&fs->lock);
+}
+
+// Zero copy when a file source has the file, read from disk (and owned) otherwise
+typedef struct __gs_asset_file_t
+{
+    const void* data;
+    size_t size;
+    void* owned;
+} __gs_asset_file_t;
+
+static bool
+__gs_asset_file_open(const char* path, __gs_asset_file_t* f)
+{
+    __gs_asset_file_sources_t* fs = &__gs_asset_file_sources;
+    memset(f, 0, sizeof(__gs_asset_file_t));
+
+    if (gs_atomic_load_acq_u32(&fs->ct))
+    {
+        gs_spinlock_lock(&fs->lock);
+        for (uint32_t i = 0; i < fs->ct; ++i)
+        {
+            const size_t len = strlen(fs->prefixes[i]);
+            if (strncmp(path, fs->prefixes[i], len) != 0) continue;
+            f->data = fs->sources[i].find(path + len, &f->size, fs->sources[i].user_data);
+            break;
+        }
+        gs_spinlock_unlock(&fs->lock);
+        if (f->data) return true;
+    }
+
+    f->owned = gs_platform_read_file_contents(path, "rb", &f->size);
+    f->data = f->owned;
+    return f->data != NULL;
+}
+
+static void
+__gs_asset_file_close(__gs_asset_file_t* f)
+{
+    if (f->owned) gs_free(f->owned);
+    memset(f, 0, sizeof(__gs_asset_file_t));
+}
+
+GS_API_DECL void*
+gs_assets_read_file(const char* path, size_t* size)
+{
+    __gs_asset_file_t f = gs_default_val();
+    if (!__gs_asset_file_open(path, &f)) return NULL;
+    if (f.owned) {
+        *size = f.size;
+        return f.owned;
+    }
+
+    // Null terminated, like gs_platform_read_file_contents()
+    char* out = gs_malloc(f.size + 1);
+    memcpy(out, f.data, f.size);
+    out[f.size] = '\0';
+    *size = f.size;
+    return out;
+}
+
+/*=== Texture ===*/
+
+typedef struct __gs_asset_async_texture_t
+{
+    void* pixels;
+    int32_t width;
+    int32_t height;
+    uint32_t comps;
+} __gs_asset_async_texture_t;
+
+static bool
+__gs_asset_async_texture_decode(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_texture_t* t = (__gs_asset_async_texture_t*)decoded;
+    __gs_asset_file_t file = gs_default_val();
+    if (!__gs_asset_file_open(path, &file)) return false;
+
+    bool ok = gs_util_load_texture_data_from_memory(file.data, file.size, &t->width, &t->height, &t->comps, &t->pixels, false);
+    __gs_asset_file_close(&file);
+    if (!ok || !t->pixels) return false;
+
+    // Decoded as rgba8
+    if (params->flip_on_load) __gs_asset_async_flip_rows((uint8_t*)t->pixels, t->width, t->height, 4);
+    return true;
+}
+
+// Creates tex from rgba8 pixels. The update copies them into cb, so they can be released right after
+static void
+__gs_asset_async_texture_upload(const __gs_asset_async_texture_t* t, gs_asset_texture_t* tex,
+    const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    gs_graphics_texture_desc_t desc = gs_default_val();
+    if (params->texture_desc) {
+        desc = *params->texture_desc;
+    } else {
+        desc.type = GS_GRAPHICS_TEXTURE_2D;
+        desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
+        desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
+        desc.mag_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
+        desc.wrap_s = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
+        desc.wrap_t = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
+    }
+    desc.width = t->width;
+    desc.height = t->height;
+    memset(&desc.data, 0, sizeof(desc.data));
+
+    // Storage is allocated now, pixels go through the command buffer with the rest of the frame
+    tex->hndl = gs_graphics_texture_create(&desc);
+    tex->desc = desc;
+
+    // desc.data is a face array in some gs versions, the pointer goes in the first slot either way
+    memcpy(&desc.data, &t->pixels, sizeof(void*));
+    gs_graphics_texture_request_update(cb, tex->hndl, &desc);
+}
+
+static bool
+__gs_asset_async_texture_finalize(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    __gs_asset_async_texture_t* t = (__gs_asset_async_texture_t*)decoded;
+    __gs_asset_async_texture_upload(t, (gs_asset_texture_t*)out, params, cb);
+    gs_free(t->pixels);
+    return true;
+}
+
+static void
+__gs_asset_async_texture_release(void* decoded)
+{
+    gs_free(((__gs_asset_async_texture_t*)decoded)->pixels);
+}
+
+static void
+__gs_asset_async_texture_destroy(void* asset)
+{
+    gs_graphics_texture_destroy(((gs_asset_texture_t*)asset)->hndl);
+}
+
+static size_t
+__gs_asset_async_texture_size(const void* decoded, const gs_asset_load_params_t* params)
+{
+    const __gs_asset_async_texture_t* t = (const __gs_asset_async_texture_t*)decoded;
+    return (size_t)t->width * t->height * 4;
+}
+
+/*=== Audio ===*/
+
+typedef struct __gs_asset_async_audio_t
+{
+    gs_audio_source_t src;
+} __gs_asset_async_audio_t;
+
+static bool
+__gs_asset_async_audio_decode(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_audio_t* a = (__gs_asset_async_audio_t*)decoded;
+    gs_audio_source_t* src = &a->src;
+    char ext[64] = gs_default_val();
+    gs_platform_file_extension(ext, sizeof(ext), path);
+
+    if (gs_string_compare_equal(ext, "ogg")) {
+        return gs_audio_load_ogg_data_from_file(path, &src->sample_count, &src->channels, &src->sample_rate, &src->samples);
+    }
+    if (gs_string_compare_equal(ext, "wav")) {
+        return gs_audio_load_wav_data_from_file(path, &src->sample_count, &src->channels, &src->sample_rate, &src->samples);
+    }
+    if (gs_string_compare_equal(ext, "mp3")) {
+        return gs_audio_load_mp3_data_from_file(path, &src->sample_count, &src->channels, &src->sample_rate, &src->samples);
+    }
+    return false;
+}
+
+static size_t
+__gs_asset_async_audio_size(const void* decoded, const gs_asset_load_params_t* params)
+{
+    const gs_audio_source_t* src = &((const __gs_asset_async_audio_t*)decoded)->src;
+    return (size_t)src->sample_count * src->channels * sizeof(int16_t);
+}
+
+static bool
+__gs_asset_async_audio_finalize(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    __gs_asset_async_audio_t* a = (__gs_asset_async_audio_t*)decoded;
+    gs_asset_audio_t* aud = (gs_asset_audio_t*)out;
+
+    // Same registration gs_audio_load_from_file() does once samples are decoded
+    gs_audio_t* audio = gs_engine_subsystem(audio);
+    aud->hndl = gs_handle_create(gs_audio_source_t, gs_slot_array_insert(audio->sources, a->src));
+    return true;
+}
+
+static void
+__gs_asset_async_audio_release(void* decoded)
+{
+    gs_free(((__gs_asset_async_audio_t*)decoded)->src.samples);
+}
+
+/*=== Font ===*/
+
+typedef struct __gs_asset_async_font_t
+{
+    void* file;
+    size_t size;
+} __gs_asset_async_font_t;
+
+static bool
+__gs_asset_async_font_decode(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_font_t* f = (__gs_asset_async_font_t*)decoded;
+    f->file = gs_assets_read_file(path, &f->size);
+    return f->file != NULL;
+}
+
+static bool
+__gs_asset_async_font_finalize(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    __gs_asset_async_font_t* f = (__gs_asset_async_font_t*)decoded;
+    bool ok = gs_asset_font_load_from_memory(f->file, f->size, out, params->point_size ? params->point_size : 16);
+    gs_free(f->file);
+    return ok;
+}
+
+static void
+__gs_asset_async_font_release(void* decoded)
+{
+    gs_free(((__gs_asset_async_font_t*)decoded)->file);
+}
+
+static void
+__gs_asset_async_font_destroy(void* asset)
+{
+    gs_graphics_texture_destroy(((gs_asset_font_t*)asset)->texture.hndl);
+}
+
+// Atlas gs_asset_font_load_from_memory() will bake, 16 glyph cells per side
+static size_t
+__gs_asset_async_font_size(const void* decoded, const gs_asset_load_params_t* params)
+{
+    uint32_t wh = 1;
+    while (wh < gs_max(params->point_size ? params->point_size : 16, 32)) wh <<= 1;
+    wh *= 16;
+    return (size_t)wh * wh * 4;
+}
+
+/*=== Mesh ===*/
+
+typedef struct __gs_asset_async_mesh_t
+{
+    gs_asset_mesh_raw_data_t* meshes;
+    uint32_t mesh_count;
+} __gs_asset_async_mesh_t;
+
+static void
+__gs_asset_async_mesh_raw_free(__gs_asset_async_mesh_t* m)
+{
+    for (uint32_t i = 0; i < m->mesh_count; ++i)
+    {
+        gs_asset_mesh_raw_data_t* md = &m->meshes[i];
+        for (uint32_t p = 0; p < md->prim_count; ++p) {
+            gs_free(md->vertices[p]);
+            gs_free(md->indices[p]);
+        }
+        gs_free(md->vertex_sizes);
+        gs_free(md->index_sizes);
+        gs_free(md->vertices);
+        gs_free(md->indices);
+    }
+    if (m->meshes) gs_free(m->meshes);
+    m->meshes = NULL;
+    m->mesh_count = 0;
+}
+
+static bool
+__gs_asset_async_mesh_decode(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_mesh_t* m = (__gs_asset_async_mesh_t*)decoded;
+    if (!gs_util_load_gltf_data_from_file(path, params->mesh_decl, &m->meshes, &m->mesh_count)) {
+        __gs_asset_async_mesh_raw_free(m);
+        return false;
+    }
+#ifdef GS_ASSET_MESH_OPTIMIZE_H
+    // Primitives are spread over the pool, waiting runs other jobs meanwhile
+    if (params->mesh_optimize) {
+        gs_asset_mesh_raw_optimize(m->meshes, m->mesh_count, params->mesh_decl, __gs_asset_async.pool);
+    }
+#endif
+    return true;
+}
+
+static void
+__gs_asset_async_mesh_create(const __gs_asset_async_mesh_t* m, gs_asset_mesh_t* mesh, const gs_asset_load_params_t* params)
+{
+    const size_t index_size = params->mesh_decl && params->mesh_decl->index_buffer_element_size ?
+        params->mesh_decl->index_buffer_element_size : sizeof(uint32_t);
+
+    for (uint32_t i = 0; i < m->mesh_count; ++i)
+    {
+        gs_asset_mesh_raw_data_t* md = &m->meshes[i];
+        for (uint32_t p = 0; p < md->prim_count; ++p)
+        {
+            gs_asset_mesh_primitive_t prim = gs_default_val();
+            prim.vbo = gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
+                .data = md->vertices[p],
+                .size = md->vertex_sizes[p]
+            });
+            prim.ibo = gs_graphics_index_buffer_create(&(gs_graphics_index_buffer_desc_t){
+                .data = md->indices[p],
+                .size = md->index_sizes[p]
+            });
+            prim.count = (uint32_t)(md->index_sizes[p] / index_size);
+            gs_dyn_array_push(mesh->primitives, prim);
+        }
+    }
+}
+
+static bool
+__gs_asset_async_mesh_finalize(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    __gs_asset_async_mesh_t* m = (__gs_asset_async_mesh_t*)decoded;
+    __gs_asset_async_mesh_create(m, (gs_asset_mesh_t*)out, params);
+    __gs_asset_async_mesh_raw_free(m);
+    return true;
+}
+
+static void
+__gs_asset_async_mesh_release(void* decoded)
+{
+    __gs_asset_async_mesh_raw_free((__gs_asset_async_mesh_t*)decoded);
+}
+
+static size_t
+__gs_asset_async_mesh_size(const void* decoded, const gs_asset_load_params_t* params)
+{
+    const __gs_asset_async_mesh_t* m = (const __gs_asset_async_mesh_t*)decoded;
+    size_t bytes = 0;
+    for (uint32_t i = 0; i < m->mesh_count; ++i) {
+        for (uint32_t p = 0; p < m->meshes[i].prim_count; ++p) {
+            bytes += m->meshes[i].vertex_sizes[p] + m->meshes[i].index_sizes[p];
+        }
+    }
+    return bytes;
+}
+
+static void
+__gs_asset_async_mesh_destroy(void* asset)
+{
+    gs_asset_mesh_t* mesh = (gs_asset_mesh_t*)asset;
+    for (uint32_t i = 0; i < gs_dyn_array_size(mesh->primitives); ++i) {
+        gs_graphics_vertex_buffer_destroy(mesh->primitives[i].vbo);
+        gs_graphics_index_buffer_destroy(mesh->primitives[i].ibo);
+    }
+    gs_dyn_array_free(mesh->primitives);
+}
+
+/*=== Loader ===*/
+
+GS_API_DECL void
+gs_assets_async_name_type(uint64_t type_id, const char* name)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+    if (gs_hash_table_exists(aa->type_names, type_id)) return;
+    __gs_asset_async_type_name_t tn = gs_default_val();
+    gs_snprintf(tn.name, sizeof(tn.name), "%s", name);
+    gs_hash_table_insert(aa->type_names, type_id, tn);
+}
+
+GS_API_DECL void
+gs_assets_register_async_importer_func(uint64_t type_id, const gs_asset_async_importer_desc_t* desc)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+    gs_hash_table_insert(aa->importers, type_id, *desc);
+}
+
+GS_API_DECL void
+gs_assets_async_init(gs_asset_async_desc_t desc)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (aa->initialized) return;
+    aa->initialized = true;
+    aa->finalize_max = desc.finalize_max;
+    aa->owns_pool = desc.pool == NULL;
+    aa->pool = desc.pool ? desc.pool : gs_job_pool_new((gs_job_pool_desc_t){.thread_ct = desc.thread_ct});
+
+    gs_assets_register_async_importer(gs_asset_texture_t, &(gs_asset_async_importer_desc_t){
+        .decode = __gs_asset_async_texture_decode,
+        .finalize = __gs_asset_async_texture_finalize,
+        .release = __gs_asset_async_texture_release,
+        .destroy = __gs_asset_async_texture_destroy,
+        .size = __gs_asset_async_texture_size,
+        .decoded_size = sizeof(__gs_asset_async_texture_t),
+        .asset_size = sizeof(gs_asset_texture_t)
+    });
+    gs_assets_register_async_importer(gs_asset_audio_t, &(gs_asset_async_importer_desc_t){
+        .decode = __gs_asset_async_audio_decode,
+        .finalize = __gs_asset_async_audio_finalize,
+        .release = __gs_asset_async_audio_release,
+        .size = __gs_asset_async_audio_size,
+        .decoded_size = sizeof(__gs_asset_async_audio_t),
+        .asset_size = sizeof(gs_asset_audio_t)
+    });
+    gs_assets_register_async_importer(gs_asset_font_t, &(gs_asset_async_importer_desc_t){
+        .decode = __gs_asset_async_font_decode,
+        .finalize = __gs_asset_async_font_finalize,
+        .release = __gs_asset_async_font_release,
+        .destroy = __gs_asset_async_font_destroy,
+        .size = __gs_asset_async_font_size,
+        .decoded_size = sizeof(__gs_asset_async_font_t),
+        .asset_size = sizeof(gs_asset_font_t)
+    });
+    gs_assets_register_async_importer(gs_asset_mesh_t, &(gs_asset_async_importer_desc_t){
+        .decode = __gs_asset_async_mesh_decode,
+        .finalize = __gs_asset_async_mesh_finalize,
+        .release = __gs_asset_async_mesh_release,
+        .destroy = __gs_asset_async_mesh_destroy,
+        .size = __gs_asset_async_mesh_size,
+        .decoded_size = sizeof(__gs_asset_async_mesh_t),
+        .asset_size = sizeof(gs_asset_mesh_t)
+    });
+}
+
+static void
+__gs_asset_async_params_copy(__gs_asset_async_params_t* dst, const gs_asset_load_params_t* src)
+{
+    memset(dst, 0, sizeof(__gs_asset_async_params_t));
+    dst->params = *src;
+    if (src->texture_desc) {
+        dst->texture_desc = *src->texture_desc;
+        dst->params.texture_desc = &dst->texture_desc;
+    }
+    if (src->mesh_decl) {
+        dst->mesh_decl = *src->mesh_decl;
+        dst->mesh_decl.layout = NULL;
+        if (src->mesh_decl->layout && src->mesh_decl->layout_size) {
+            dst->mesh_decl.layout = gs_malloc(src->mesh_decl->layout_size);
+            memcpy(dst->mesh_decl.layout, src->mesh_decl->layout, src->mesh_decl->layout_size);
+        }
+        dst->params.mesh_decl = &dst->mesh_decl;
+    }
+    dst->params.user_data = NULL;
+    if (src->user_data && src->user_data_size) {
+        void* ud = gs_malloc(src->user_data_size);
+        memcpy(ud, src->user_data, src->user_data_size);
+        dst->params.user_data = ud;
+    }
+}
+
+static void
+__gs_asset_async_params_free(__gs_asset_async_params_t* p)
+{
+    if (p->mesh_decl.layout) gs_free(p->mesh_decl.layout);
+    if (p->params.user_data) gs_free((void*)p->params.user_data);
+    p->mesh_decl.layout = NULL;
+    p->params.user_data = NULL;
+}
+
+// Done loading, only the path stays
+static void
+__gs_asset_async_request_finish(__gs_asset_async_request_t* req)
+{
+    if (req->decoded) gs_free(req->decoded);
+    __gs_asset_async_params_free(&req->params);
+    req->decoded = NULL;
+}
+
+static void
+__gs_asset_async_request_free(__gs_asset_async_request_t* req)
+{
+    __gs_asset_async_request_finish(req);
+    if (req->path) gs_free(req->path);
+    req->path = NULL;
+}
+
+GS_API_DECL void
+gs_assets_async_shutdown()
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) return;
+    gs_job_pool_wait(aa->pool, &aa->decoding);
+
+    // Decoded but never finalized, nothing was handed to the backends yet
+    for (uint32_t i = 0; i < gs_dyn_array_size(aa->inflight); ++i) {
+        __gs_asset_async_request_t* req = aa->inflight[i];
+        if (req->status == GS_ASSET_STATUS_DECODED) {
+            gs_println("gs_assets_async_shutdown: dropping unfinalized load %s", req->path);
+            if (req->importer.release) req->importer.release(req->decoded);
+        }
+        // Reloads aren't in the requests table
+        if (req->reload) {
+            __gs_asset_async_request_free(req);
+            gs_free(req);
+        }
+    }
+
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(aa->requests);
+        gs_hash_table_iter_valid(aa->requests, it);
+        gs_hash_table_iter_advance(aa->requests, it)
+    )
+    {
+        __gs_asset_async_request_t* req = gs_hash_table_iter_get(aa->requests, it);
+        __gs_asset_async_request_free(req);
+        gs_free(req);
+    }
+
+    if (aa->owns_pool) gs_job_pool_free(aa->pool);
+    gs_hash_table_free(aa->importers);
+    gs_hash_table_free(aa->type_names);
+    gs_hash_table_free(aa->requests);
+    gs_dyn_array_free(aa->inflight);
+    memset(aa, 0, sizeof(__gs_asset_async_t));
+}
+
+static void
+__gs_asset_async_decode_job(void* user_data)
+{
+    __gs_asset_async_request_t* req = (__gs_asset_async_request_t*)user_data;
+    req->decode_begin = __gs_asset_async_now();
+    gs_atomic_store_rel_u32(&req->status, GS_ASSET_STATUS_DECODING);
+    bool ok = req->importer.decode(req->path, req->decoded, &req->params.params);
+    if (ok && req->importer.size) req->bytes = req->importer.size(req->decoded, &req->params.params);
+    req->decode_end = __gs_asset_async_now();
+    gs_atomic_store_rel_u32(&req->status, ok ? GS_ASSET_STATUS_DECODED : GS_ASSET_STATUS_FAILED);
+}
+
+// Queues req as inflight, the caller submits a job decoding it
+static void
+__gs_asset_async_prepare(__gs_asset_async_request_t* req, const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+
+    __gs_asset_async_params_copy(&req->params, params);
+
+    req->decoded = gs_malloc(gs_max(req->importer.decoded_size, 1));
+    memset(req->decoded, 0, gs_max(req->importer.decoded_size, 1));
+    req->status = GS_ASSET_STATUS_QUEUED;
+    gs_dyn_array_push(aa->inflight, req);
+}
+
+static void
+__gs_asset_async_submit(__gs_asset_async_request_t* req, const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_prepare(req, params);
+    gs_job_pool_submit(__gs_asset_async.pool, __gs_asset_async_decode_job, req, &__gs_asset_async.decoding);
+}
+
+// Whether a reload of asset is in flight
+static bool
+__gs_asset_async_reloading(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    for (uint32_t i = 0; i < gs_dyn_array_size(aa->inflight); ++i) {
+        if (aa->inflight[i]->reload && __gs_asset_async_key(am, aa->inflight[i]->asset) == key) return true;
+    }
+    return false;
+}
+
+// Request for loading into asset, NULL if it can't be submitted (already loading or loaded, or FAILED right away)
+static __gs_asset_async_request_t*
+__gs_asset_async_request(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+
+    // Loading into the same handle again (retrying a failed load, bringing back an evicted one) reuses its finished
+    // request. A READY asset would be overwritten without being destroyed, that's what reloading is for.
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    __gs_asset_async_request_t* req = NULL;
+    if (gs_hash_table_exists(aa->requests, key))
+    {
+        req = gs_hash_table_get(aa->requests, key);
+        if (!req->done) {
+            gs_println("gs_assets_load_async: %s is already loading into this asset", path);
+            return NULL;
+        }
+        if (req->status != GS_ASSET_STATUS_FAILED && req->status != GS_ASSET_STATUS_EVICTED) {
+            gs_println("gs_assets_load_async: asset is already loaded, use gs_assets_reload_async() for %s", path);
+            return NULL;
+        }
+        __gs_asset_async_request_free(req);
+    }
+    else
+    {
+        req = gs_malloc(sizeof(__gs_asset_async_request_t));
+        gs_hash_table_insert(aa->requests, key, req);
+    }
+
+    // Everything the caller pointed at may be gone by the time a worker runs
+    memset(req, 0, sizeof(__gs_asset_async_request_t));
+    req->am = am;
+    req->asset = asset;
+    req->type_id = type_id;
+    req->path = __gs_asset_async_strdup(path);
+    req->queued = __gs_asset_async_now();
+
+    if (!gs_hash_table_exists(aa->importers, type_id)) {
+        gs_println("gs_assets_load_async: no async importer registered for %s", path);
+        req->status = GS_ASSET_STATUS_FAILED;
+        req->done = true;
+        req->finished = req->queued;
+        return NULL;
+    }
+    req->importer = gs_hash_table_get(aa->importers, type_id);
+
+    // Params of another type would be read as the importer's
+    if (req->importer.params_size && params->user_data_size && params->user_data_size != req->importer.params_size) {
+        gs_println("gs_assets_load_async: %s has params of %zu bytes, its importer takes %zu", path,
+            params->user_data_size, req->importer.params_size);
+        req->status = GS_ASSET_STATUS_FAILED;
+        req->done = true;
+        req->finished = req->queued;
+        return NULL;
+    }
+    return req;
+}
+
+GS_API_DECL gs_asset_t
+gs_assets_load_async_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+
+    __gs_asset_async_request_t* req = __gs_asset_async_request(am, type_id, asset, path, params);
+    if (req) __gs_asset_async_submit(req, params);
+    return asset;
+}
+
+// One job's share of a gs_assets_load_batch(), freed by the job
+typedef struct __gs_asset_async_batch_t
+{
+    gs_asset_async_importer_desc_t importer;
+    uint32_t ct;
+    __gs_asset_async_request_t** reqs;          // Allocated along with the batch
+} __gs_asset_async_batch_t;
+
+static void
+__gs_asset_async_batch_job(void* user_data)
+{
+    __gs_asset_async_batch_t* batch = (__gs_asset_async_batch_t*)user_data;
+    const gs_asset_async_importer_desc_t* imp = &batch->importer;
+    const uint32_t ct = batch->ct;
+
+    const char** paths = gs_malloc(ct * sizeof(char*));
+    void** decoded = gs_malloc(ct * sizeof(void*));
+    bool* ok = gs_malloc(ct * sizeof(bool));
+    for (uint32_t i = 0; i < ct; ++i) {
+        paths[i] = batch->reqs[i]->path;
+        decoded[i] = batch->reqs[i]->decoded;
+        ok[i] = false;
+        batch->reqs[i]->decode_begin = __gs_asset_async_now();
+        gs_atomic_store_rel_u32(&batch->reqs[i]->status, GS_ASSET_STATUS_DECODING);
+    }
+
+    // Every request has its own copy of the same params
+    const gs_asset_load_params_t* params = &batch->reqs[0]->params.params;
+    if (imp->decode_batch) imp->decode_batch(paths, decoded, ok, ct, params);
+    else for (uint32_t i = 0; i < ct; ++i) ok[i] = imp->decode(paths[i], decoded[i], params);
+
+    // The batch decoded together, so each load is charged the whole batch's time
+    const double end = __gs_asset_async_now();
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        __gs_asset_async_request_t* req = batch->reqs[i];
+        if (ok[i] && imp->size) req->bytes = imp->size(req->decoded, &req->params.params);
+        req->decode_end = end;
+        gs_atomic_store_rel_u32(&req->status, ok[i] ? GS_ASSET_STATUS_DECODED : GS_ASSET_STATUS_FAILED);
+    }
+
+    gs_free(ok);
+    gs_free(decoded);
+    gs_free(paths);
+    gs_free(batch);
+}
+
+GS_API_DECL void
+gs_assets_load_batch_func(gs_asset_manager_t* am, uint64_t type_id, const gs_asset_t* assets, const char* const* paths,
+    uint32_t ct, const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+
+    const gs_asset_async_importer_desc_t* imp = gs_hash_table_exists(aa->importers, type_id) ?
+        gs_hash_table_getp(aa->importers, type_id) : NULL;
+    const uint32_t batch_size = imp && imp->batch_size ? imp->batch_size : GS_ASSET_ASYNC_BATCH_SIZE_DEFAULT;
+
+    __gs_asset_async_batch_t* batch = NULL;
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        __gs_asset_async_request_t* req = __gs_asset_async_request(am, type_id, assets[i], paths[i], params);
+        if (!req) continue;
+        __gs_asset_async_prepare(req, params);
+
+        if (!batch) {
+            batch = gs_malloc(sizeof(__gs_asset_async_batch_t) + batch_size * sizeof(__gs_asset_async_request_t*));
+            batch->importer = req->importer;
+            batch->ct = 0;
+            batch->reqs = (__gs_asset_async_request_t**)(batch + 1);
+        }
+        batch->reqs[batch->ct++] = req;
+        if (batch->ct == batch_size) {
+            gs_job_pool_submit(aa->pool, __gs_asset_async_batch_job, batch, &aa->decoding);
+            batch = NULL;
+        }
+    }
+    if (batch) gs_job_pool_submit(aa->pool, __gs_asset_async_batch_job, batch, &aa->decoding);
+}
+
+GS_API_DECL bool
+gs_assets_reload_async_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+
+    gs_asset_async_importer_desc_t* imp = gs_hash_table_exists(aa->importers, type_id) ?
+        gs_hash_table_getp(aa->importers, type_id) : NULL;
+    if (!imp || !imp->asset_size) {
+        gs_println("gs_assets_reload_async: no reloadable async importer registered for %s", path);
+        return false;
+    }
+
+    // Anything else has no finished asset to swap out, or one that's about to be swapped already
+    if (gs_assets_status(am, asset) != GS_ASSET_STATUS_READY || __gs_asset_async_reloading(am, asset)) {
+        gs_println("gs_assets_reload_async: asset isn't READY, or is reloading already, for %s", path);
+        return false;
+    }
+
+    // Not in the requests table, the asset keeps its status while it reloads
+    __gs_asset_async_request_t* req = gs_malloc(sizeof(__gs_asset_async_request_t));
+    memset(req, 0, sizeof(__gs_asset_async_request_t));
+    req->am = am;
+    req->asset = asset;
+    req->importer = *imp;
+    req->type_id = type_id;
+    req->path = __gs_asset_async_strdup(path);
+    req->reload = true;
+    req->queued = __gs_asset_async_now();
+    __gs_asset_async_submit(req, params);
+    return true;
+}
+
+GS_API_DECL bool
+gs_assets_async_adopt_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    if (gs_hash_table_exists(aa->requests, key) || !gs_hash_table_exists(aa->importers, type_id)) return false;
+
+    // A finished request with nothing to decode, stats show it done the moment it's adopted
+    __gs_asset_async_request_t* req = gs_malloc(sizeof(__gs_asset_async_request_t));
+    memset(req, 0, sizeof(__gs_asset_async_request_t));
+    req->am = am;
+    req->asset = asset;
+    req->type_id = type_id;
+    req->importer = gs_hash_table_get(aa->importers, type_id);
+    req->path = __gs_asset_async_strdup(path);
+    req->status = GS_ASSET_STATUS_READY;
+    req->done = true;
+    req->queued = req->decode_begin = req->decode_end = req->finished = __gs_asset_async_now();
+    gs_hash_table_insert(aa->requests, key, req);
+    return true;
+}
+
+// Builds the reloaded asset aside, so a failed reload leaves the old one untouched
+static bool
+__gs_asset_async_reload_finalize(__gs_asset_async_request_t* req, gs_command_buffer_t* cb)
+{
+    void* staged = gs_malloc(req->importer.asset_size);
+    memset(staged, 0, req->importer.asset_size);
+
+    bool ok = req->importer.finalize(req->decoded, staged, &req->params.params, cb);
+    if (ok)
+    {
+        void* out = gs_assets_getp(req->am, void, req->asset);
+        if (req->importer.destroy) req->importer.destroy(out);
+        memcpy(out, staged, req->importer.asset_size);
+
+        const uint64_t key = __gs_asset_async_key(req->am, req->asset);
+        if (gs_hash_table_exists(__gs_asset_async.requests, key)) {
+            gs_hash_table_get(__gs_asset_async.requests, key)->bytes = req->bytes;
+        }
+    }
+
+    gs_free(staged);
+    return ok;
+}
+
+GS_API_DECL uint32_t
+gs_assets_async_update(gs_command_buffer_t* cb)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) return 0;
+
+    uint32_t finalized = 0;
+    for (uint32_t i = 0; i < gs_dyn_array_size(aa->inflight);)
+    {
+        __gs_asset_async_request_t* req = aa->inflight[i];
+        const uint32_t status = gs_atomic_load_acq_u32(&req->status);
+        const bool budget_left = !aa->finalize_max || finalized < aa->finalize_max;
+
+        if (status == GS_ASSET_STATUS_DECODED && budget_left && req->reload)
+        {
+            if (!__gs_asset_async_reload_finalize(req, cb)) {
+                gs_println("gs_assets_async_update: failed to reload %s", req->path);
+            }
+            finalized++;
+        }
+        else if (status == GS_ASSET_STATUS_DECODED && budget_left)
+        {
+            void* out = gs_assets_getp(req->am, void, req->asset);
+            bool ok = req->importer.finalize(req->decoded, out, &req->params.params, cb);
+            if (!ok) gs_println("gs_assets_async_update: failed to load %s", req->path);
+            req->status = ok ? GS_ASSET_STATUS_READY : GS_ASSET_STATUS_FAILED;
+            finalized++;
+        }
+        else if (status != GS_ASSET_STATUS_FAILED)
+        {
+            ++i;
+            continue;
+        }
+        else
+        {
+            gs_println("gs_assets_async_update: failed to decode %s", req->path);
+        }
+
+        // Done, order of the remaining loads doesn't matter
+        req->done = true;
+        req->finished = __gs_asset_async_now();
+        if (req->reload) {
+            __gs_asset_async_request_free(req);
+            gs_free(req);
+        }
+        else {
+            __gs_asset_async_request_finish(req);
+        }
+        aa->inflight[i] = gs_dyn_array_back(aa->inflight);
+        gs_dyn_array_pop(aa->inflight);
+    }
+
+    return gs_dyn_array_size(aa->inflight);
+}
+
+GS_API_DECL void
+gs_assets_async_wait(gs_command_buffer_t* cb)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) return;
+    while (gs_assets_async_update(cb))
+    {
+        if (!gs_job_pool_run_one(aa->pool)) gs_thread_yield();
+    }
+}
+
+GS_API_DECL gs_asset_status
+gs_assets_status(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    if (!aa->initialized || !gs_hash_table_exists(aa->requests, key)) return GS_ASSET_STATUS_NONE;
+    __gs_asset_async_request_t* req = gs_hash_table_get(aa->requests, key);
+    return (gs_asset_status)gs_atomic_load_acq_u32(&req->status);
+}
+
+GS_API_DECL bool
+gs_assets_async_unload(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    if (!aa->initialized || !gs_hash_table_exists(aa->requests, key)) return false;
+
+    __gs_asset_async_request_t* req = gs_hash_table_get(aa->requests, key);
+    if (req->status != GS_ASSET_STATUS_READY || !req->importer.destroy || !req->importer.asset_size) return false;
+
+    // A reload in flight would swap into the zeroed asset
+    if (__gs_asset_async_reloading(am, asset)) return false;
+
+    void* out = gs_assets_getp(am, void, asset);
+    req->importer.destroy(out);
+    memset(out, 0, req->importer.asset_size);
+    req->status = GS_ASSET_STATUS_EVICTED;
+    req->bytes = 0;
+    return true;
+}
+
+GS_API_DECL size_t
+gs_assets_async_bytes(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    if (!aa->initialized || !gs_hash_table_exists(aa->requests, key)) return 0;
+    __gs_asset_async_request_t* req = gs_hash_table_get(aa->requests, key);
+    return req->status == GS_ASSET_STATUS_READY ? req->bytes : 0;
+}
+
+#endif // GS_ASSET_ASYNC_IMPL
+#endif // GS_ASSET_ASYNC_H
@@ -0,0 +1,860 @@
+#ifndef GS_ASSET_CACHE_H
+#define GS_ASSET_CACHE_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger cooked asset cache implementation like this:
+
+        #define GS_ASSET_CACHE_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_CACHE_IMPL
+        #include "gs_asset_cache.h"
+
+    All other files should just #include "gs_asset_cache.h" without the #define.
+
+    MUST include "gs_asset_async.h" (and everything it relies on) BEFORE this file:
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+        #define GS_ASSET_CACHE_IMPL
+        #include "gs_asset_cache.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Cooked binary cache for async loaded textures, meshes and fonts:
+
+        * gs_asset_cache_init() swaps the async importers for gs_asset_texture_t, gs_asset_mesh_t and gs_asset_font_t
+          for cached ones. gs_assets_load_async() calls don't change.
+        * The first load of an asset decodes it from its source format as before and writes a GPU ready blob (rgba8
+          pixels, interleaved vertex/index data, baked font atlas and glyphs) to the cache directory. Later loads
+          memory map the blob and upload straight from the mapping.
+        * Blobs are keyed by a hash of the source file's contents and the import options that change the output
+          (flip_on_load, the mesh decl layout, index size and mesh_optimize, the font point size). Editing a source
+          or changing options cooks a new blob; identical sources share one. glTF keys also cover the external files
+          the .gltf references by uri.
+        * Font atlases are baked on the worker, so a cached font never rasterizes on the main thread either.
+        * gs_assets_cook() runs the same decode and write without creating anything, for offline cook steps. It
+          doesn't touch the graphics backend, so it can run on any thread.
+        * Stale blobs are never deleted. Clear the directory to reclaim space.
+
+            gs_asset_cache_init((gs_asset_cache_desc_t){.dir = "./.gs_cache"});
+
+            gs_asset_t tex = gs_assets_load_async(&gsa, gs_asset_texture_t, "./assets/champ.png");
+
+            // Shutdown order: async first. Shutting the cache down first also works, it waits for decodes in flight
+            // and puts the uncached importers back.
+            gs_assets_async_shutdown();
+            gs_asset_cache_shutdown();
+*/
+
+/*==== Interface ====*/
+
+#define GS_ASSET_CACHE_VERSION          1
+#define GS_ASSET_CACHE_DIR_DEFAULT      "./.gs_cache"
+
+typedef struct gs_asset_cache_desc_t
+{
+    const char* dir;        // Blob directory, GS_ASSET_CACHE_DIR_DEFAULT if NULL (created if missing, one level)
+    bool read_only;         // Only read blobs, for shipping a pre-cooked cache
+} gs_asset_cache_desc_t;
+
+typedef struct gs_asset_cache_stats_t
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t writes;
+} gs_asset_cache_stats_t;
+
+GS_API_DECL void
+gs_asset_cache_init(gs_asset_cache_desc_t desc);
+
+GS_API_DECL void
+gs_asset_cache_shutdown();
+
+GS_API_DECL gs_asset_cache_stats_t
+gs_asset_cache_stats();
+
+// Makes sure path has a blob for these params, returns false if the source couldn't be decoded
+GS_API_DECL bool
+gs_assets_cook_func(uint64_t type_id, const char* path, const gs_asset_load_params_t* params);
+
+#define gs_assets_cook(__T, __PATH, ...)\
+    gs_assets_cook_func(gs_hash_str64(gs_to_str(__T)), (__PATH), &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_CACHE_IMPL
+
+#if (defined _WIN32 || defined _WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#elif !(defined __EMSCRIPTEN__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#define __GS_ASSET_CACHE_MAGIC      0x4b435347      // "GSCK"
+#define __GS_ASSET_CACHE_ALIGN      16
+
+typedef enum __gs_asset_cache_kind
+{
+    __GS_ASSET_CACHE_KIND_TEXTURE = 0x01,
+    __GS_ASSET_CACHE_KIND_MESH,
+    __GS_ASSET_CACHE_KIND_FONT
+} __gs_asset_cache_kind;
+
+// Blob layout: header, kind specific info, then data sections at __GS_ASSET_CACHE_ALIGN offsets
+typedef struct __gs_asset_cache_header_t
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t size;
+    uint32_t kind;
+    uint32_t pad;
+} __gs_asset_cache_header_t;
+
+typedef struct __gs_asset_cache_texture_info_t
+{
+    uint32_t width;
+    uint32_t height;
+    uint64_t pixels;
+} __gs_asset_cache_texture_info_t;
+
+typedef struct __gs_asset_cache_mesh_info_t
+{
+    uint32_t mesh_count;
+    uint32_t prim_count;
+    uint64_t prim_counts;       // uint32_t per mesh
+    uint64_t prims;             // __gs_asset_cache_prim_t per primitive
+} __gs_asset_cache_mesh_info_t;
+
+typedef struct __gs_asset_cache_prim_t
+{
+    uint64_t vertices;
+    uint64_t vertex_size;
+    uint64_t indices;
+    uint64_t index_size;
+} __gs_asset_cache_prim_t;
+
+typedef struct __gs_asset_cache_font_info_t
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t point_size;
+    uint32_t glyph_size;        // sizeof(gs_asset_font_t.glyphs) when cooked
+    float ascent;
+    float descent;
+    uint64_t glyphs;
+    uint64_t pixels;
+} __gs_asset_cache_font_info_t;
+
+typedef struct __gs_asset_cache_section_t
+{
+    const void* data;
+    size_t size;
+    uint64_t offset;            // Filled in by __gs_asset_cache_layout()
+} __gs_asset_cache_section_t;
+
+typedef struct __gs_asset_cache_t
+{
+    bool initialized;
+    char* dir;
+    bool read_only;
+    gs_asset_cache_stats_t stats;
+    uint32_t tmp_id;
+    gs_hash_table(uint64_t, gs_asset_async_importer_desc_t) importers;
+    gs_hash_table(uint64_t, gs_asset_async_importer_desc_t) replaced;     // Async importers swapped out, by type
+} __gs_asset_cache_t;
+
+static __gs_asset_cache_t __gs_asset_cache = {0};
+
+/*=== Files ===*/
+
+static void
+__gs_asset_cache_mkdir(const char* dir)
+{
+#if (defined _WIN32 || defined _WIN64)
+    CreateDirectoryA(dir, NULL);
+#elif !(defined __EMSCRIPTEN__)
+    mkdir(dir, 0755);
+#endif
+}
+
+static void
+__gs_asset_cache_blob_path(char* buf, size_t sz, uint64_t key)
+{
+    gs_snprintf(buf, sz, "%s/%016llx.gsc", __gs_asset_cache.dir, (unsigned long long)key);
+}
+
+/*=== Blobs ===*/
+
+static uint64_t
+__gs_asset_cache_key(uint32_t kind, uint64_t content, const void* opts, size_t opts_size)
+{
+    uint64_t tag[2] = {((uint64_t)GS_ASSET_CACHE_VERSION << 32) | kind, content};
+    uint64_t key = gs_hash_bytes(tag, sizeof(tag), GS_HASH_TABLE_HASH_SEED);
+    return opts_size ? gs_hash_bytes((void*)opts, opts_size, key) : key;
+}
+
+gs_force_inline bool
+__gs_asset_cache_in_range(const __gs_asset_map_t* map, uint64_t offset, uint64_t size)
+{
+    return offset <= map->size && size <= map->size - offset;
+}
+
+// Maps the blob for key, returning a pointer to its info struct. Anything that doesn't match is a miss.
+static const void*
+__gs_asset_cache_open(uint64_t key, uint32_t kind, size_t info_size, __gs_asset_map_t* map)
+{
+    char path[1024] = gs_default_val();
+    __gs_asset_cache_blob_path(path, sizeof(path), key);
+    if (!__gs_asset_map_file(path, map)) return NULL;
+
+    const __gs_asset_cache_header_t* hdr = (const __gs_asset_cache_header_t*)map->data;
+    if (
+        map->size < sizeof(__gs_asset_cache_header_t) + info_size ||
+        hdr->magic != __GS_ASSET_CACHE_MAGIC || hdr->version != GS_ASSET_CACHE_VERSION ||
+        hdr->key != key || hdr->kind != kind || hdr->size != map->size
+    )
+    {
+        __gs_asset_unmap_file(map);
+        return NULL;
+    }
+    return map->data + sizeof(__gs_asset_cache_header_t);
+}
+
+// Assigns aligned offsets to sections following the header, returns the blob size
+static uint64_t
+__gs_asset_cache_layout(__gs_asset_cache_section_t* sections, uint32_t count)
+{
+    uint64_t offset = sizeof(__gs_asset_cache_header_t);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        offset = (offset + __GS_ASSET_CACHE_ALIGN - 1) & ~(uint64_t)(__GS_ASSET_CACHE_ALIGN - 1);
+        sections[i].offset = offset;
+        offset += sections[i].size;
+    }
+    return offset;
+}
+
+// Writes through a temporary file, so readers never map a partial blob
+static void
+__gs_asset_cache_write(uint64_t key, uint32_t kind, const __gs_asset_cache_section_t* sections, uint32_t count,
+    uint64_t size)
+{
+    __gs_asset_cache_t* ac = &__gs_asset_cache;
+    if (ac->read_only) return;
+
+    char path[1024] = gs_default_val();
+    char tmp[1040] = gs_default_val();
+    __gs_asset_cache_blob_path(path, sizeof(path), key);
+    gs_snprintf(tmp, sizeof(tmp), "%s.%u.tmp", path, gs_atomic_add_u32(&ac->tmp_id, 1));
+
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) {
+        gs_println("gs_asset_cache: unable to write %s", tmp);
+        return;
+    }
+
+    __gs_asset_cache_header_t hdr = {
+        .magic = __GS_ASSET_CACHE_MAGIC,
+        .version = GS_ASSET_CACHE_VERSION,
+        .key = key,
+        .size = size,
+        .kind = kind
+    };
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+
+    uint64_t at = sizeof(hdr);
+    const uint8_t zeros[__GS_ASSET_CACHE_ALIGN] = {0};
+    for (uint32_t i = 0; i < count && ok; ++i)
+    {
+        ok = fwrite(zeros, 1, (size_t)(sections[i].offset - at), fp) == sections[i].offset - at;
+        if (ok && sections[i].size) ok = fwrite(sections[i].data, sections[i].size, 1, fp) == 1;
+        at = sections[i].offset + sections[i].size;
+    }
+    ok = (fclose(fp) == 0) && ok;
+
+    // Someone else may have cooked the same blob meanwhile, theirs is identical
+    if (!ok || rename(tmp, path) != 0) {
+        remove(tmp);
+        if (!ok) gs_println("gs_asset_cache: unable to write %s", path);
+        return;
+    }
+    gs_atomic_add_u32(&ac->stats.writes, 1);
+}
+
+static void
+__gs_asset_cache_count(bool hit)
+{
+    gs_atomic_add_u32(hit ? &__gs_asset_cache.stats.hits : &__gs_asset_cache.stats.misses, 1);
+}
+
+/*=== Texture ===*/
+
+// Async decoded data first, so the async size callbacks work on these too
+typedef struct __gs_asset_cache_texture_t
+{
+    __gs_asset_async_texture_t texture;
+    __gs_asset_map_t map;                   // Pixels point into it on a hit
+} __gs_asset_cache_texture_t;
+
+static bool
+__gs_asset_cache_texture_decode(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    __gs_asset_cache_texture_t* c = (__gs_asset_cache_texture_t*)decoded;
+    __gs_asset_async_texture_t* t = &c->texture;
+
+    __gs_asset_file_t file = gs_default_val();
+    if (!__gs_asset_file_open(path, &file)) return false;
+
+    const uint32_t opts = params->flip_on_load ? 1 : 0;
+    const uint64_t key = __gs_asset_cache_key(__GS_ASSET_CACHE_KIND_TEXTURE,
+        gs_hash_bytes((void*)file.data, file.size, GS_HASH_TABLE_HASH_SEED), &opts, sizeof(opts));
+
+    const __gs_asset_cache_texture_info_t* info = (const __gs_asset_cache_texture_info_t*)__gs_asset_cache_open(
+        key, __GS_ASSET_CACHE_KIND_TEXTURE, sizeof(__gs_asset_cache_texture_info_t), &c->map);
+    if (info && __gs_asset_cache_in_range(&c->map, info->pixels, (uint64_t)info->width * info->height * 4))
+    {
+        __gs_asset_file_close(&file);
+        t->width = info->width;
+        t->height = info->height;
+        t->comps = 4;
+        t->pixels = c->map.data + info->pixels;
+        __gs_asset_cache_count(true);
+        return true;
+    }
+    __gs_asset_unmap_file(&c->map);
+    __gs_asset_cache_count(false);
+
+    bool ok = gs_util_load_texture_data_from_memory(file.data, file.size, &t->width, &t->height, &t->comps, &t->pixels, false);
+    __gs_asset_file_close(&file);
+    if (!ok || !t->pixels) return false;
+    if (params->flip_on_load) __gs_asset_async_flip_rows((uint8_t*)t->pixels, t->width, t->height, 4);
+
+    __gs_asset_cache_texture_info_t ti = {.width = (uint32_t)t->width, .height = (uint32_t)t->height};
+    __gs_asset_cache_section_t sections[] = {
+        {&ti, sizeof(ti)},
+        {t->pixels, (size_t)t->width * t->height * 4}
+    };
+    const uint64_t size = __gs_asset_cache_layout(sections, 2);
+    ti.pixels = sections[1].offset;
+    __gs_asset_cache_write(key, __GS_ASSET_CACHE_KIND_TEXTURE, sections, 2, size);
+    return true;
+}
+
+static void
+__gs_asset_cache_texture_release(void* decoded)
+{
+    __gs_asset_cache_texture_t* c = (__gs_asset_cache_texture_t*)decoded;
+    if (c->map.data) __gs_asset_unmap_file(&c->map);
+    else gs_free(c->texture.pixels);
+}
+
+static bool
+__gs_asset_cache_texture_finalize(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    __gs_asset_cache_texture_t* c = (__gs_asset_cache_texture_t*)decoded;
+    __gs_asset_async_texture_upload(&c->texture, (gs_asset_texture_t*)out, params, cb);
+    __gs_asset_cache_texture_release(decoded);
+    return true;
+}
+
+/*=== Mesh ===*/
+
+typedef struct __gs_asset_cache_mesh_t
+{
+    __gs_asset_async_mesh_t mesh;
+    __gs_asset_map_t map;                   // Vertex/index data point into it on a hit
+} __gs_asset_cache_mesh_t;
+
+// Hashes the .gltf and every external file it references by uri (data uris are already in the .gltf)
+static uint64_t
+__gs_asset_cache_gltf_hash(const char* path, const char* file, size_t sz)
+{
+    uint64_t hash = gs_hash_bytes((void*)file, sz, GS_HASH_TABLE_HASH_SEED);
+
+    const char* slash = strrchr(path, '/');
+    const char* bslash = strrchr(path, '\\');
+    if (bslash > slash) slash = bslash;
+    const size_t dir_len = slash ? (size_t)(slash - path) + 1 : 0;
+
+    for (const char* at = file; (at = strstr(at, "\"uri\"")) != NULL;)
+    {
+        at += 5;
+        while (*at == ' ' || *at == '\t' || *at == '\r' || *at == '\n' || *at == ':') at++;
+        if (*at++ != '"') continue;
+        const char* end = strchr(at, '"');
+        if (!end) break;
+
+        const size_t len = (size_t)(end - at);
+        if (len && strncmp(at, "data:", 5) != 0 && dir_len + len < 1024)
+        {
+            char ref[1024] = gs_default_val();
+            memcpy(ref, path, dir_len);
+            memcpy(ref + dir_len, at, len);
+
+            size_t ref_sz = 0;
+            char* ref_file = (char*)gs_assets_read_file(ref, &ref_sz);
+            if (ref_file) {
+                hash = gs_hash_bytes(ref_file, ref_sz, hash);
+                gs_free(ref_file);
+            }
+        }
+        at = end + 1;
+    }
+    return hash;
+}
+
+static bool
+__gs_asset_cache_mesh_from_blob(__gs_asset_cache_mesh_t* c, const __gs_asset_cache_mesh_info_t* info)
+{
+    const __gs_asset_map_t* map = &c->map;
+    if (
+        !__gs_asset_cache_in_range(map, info->prim_counts, (uint64_t)info->mesh_count * sizeof(uint32_t)) ||
+        !__gs_asset_cache_in_range(map, info->prims, (uint64_t)info->prim_count * sizeof(__gs_asset_cache_prim_t))
+    )
+    {
+        return false;
+    }
+
+    const uint32_t* prim_counts = (const uint32_t*)(map->data + info->prim_counts);
+    const __gs_asset_cache_prim_t* prims = (const __gs_asset_cache_prim_t*)(map->data + info->prims);
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < info->mesh_count; ++i) total += prim_counts[i];
+    if (total != info->prim_count) return false;
+    for (uint32_t p = 0; p < info->prim_count; ++p) {
+        if (
+            !__gs_asset_cache_in_range(map, prims[p].vertices, prims[p].vertex_size) ||
+            !__gs_asset_cache_in_range(map, prims[p].indices, prims[p].index_size)
+        ) return false;
+    }
+
+    // Same shape as gs_util_load_gltf_data_from_file()'s output, with the data left in the mapping
+    __gs_asset_async_mesh_t* m = &c->mesh;
+    m->mesh_count = info->mesh_count;
+    m->meshes = gs_malloc(gs_max(info->mesh_count, 1) * sizeof(gs_asset_mesh_raw_data_t));
+    memset(m->meshes, 0, gs_max(info->mesh_count, 1) * sizeof(gs_asset_mesh_raw_data_t));
+    for (uint32_t i = 0, p = 0; i < info->mesh_count; ++i)
+    {
+        gs_asset_mesh_raw_data_t* md = &m->meshes[i];
+        const uint32_t ct = gs_max(prim_counts[i], 1);
+        md->prim_count = prim_counts[i];
+        md->vertex_sizes = gs_malloc(ct * sizeof(size_t));
+        md->index_sizes = gs_malloc(ct * sizeof(size_t));
+        md->vertices = gs_malloc(ct * sizeof(void*));
+        md->indices = gs_malloc(ct * sizeof(void*));
+        for (uint32_t j = 0; j < md->prim_count; ++j, ++p)
+        {
+            md->vertex_sizes[j] = (size_t)prims[p].vertex_size;
+            md->index_sizes[j] = (size_t)prims[p].index_size;
+            md->vertices[j] = map->data + prims[p].vertices;
+            md->indices[j] = map->data + prims[p].indices;
+        }
+    }
+    return true;
+}
+
+static void
+__gs_asset_cache_mesh_write(uint64_t key, const __gs_asset_async_mesh_t* m)
+{
+    __gs_asset_cache_mesh_info_t info = {.mesh_count = m->mesh_count};
+    for (uint32_t i = 0; i < m->mesh_count; ++i) info.prim_count += m->meshes[i].prim_count;
+
+    uint32_t* prim_counts = gs_malloc(gs_max(info.mesh_count, 1) * sizeof(uint32_t));
+    __gs_asset_cache_prim_t* prims = gs_malloc(gs_max(info.prim_count, 1) * sizeof(__gs_asset_cache_prim_t));
+    const uint32_t section_ct = 3 + info.prim_count * 2;
+    __gs_asset_cache_section_t* sections = gs_malloc(section_ct * sizeof(__gs_asset_cache_section_t));
+
+    sections[0] = (__gs_asset_cache_section_t){&info, sizeof(info)};
+    sections[1] = (__gs_asset_cache_section_t){prim_counts, info.mesh_count * sizeof(uint32_t)};
+    sections[2] = (__gs_asset_cache_section_t){prims, info.prim_count * sizeof(__gs_asset_cache_prim_t)};
+    uint32_t s = 3;
+    for (uint32_t i = 0; i < m->mesh_count; ++i)
+    {
+        const gs_asset_mesh_raw_data_t* md = &m->meshes[i];
+        prim_counts[i] = md->prim_count;
+        for (uint32_t j = 0; j < md->prim_count; ++j) {
+            sections[s++] = (__gs_asset_cache_section_t){md->vertices[j], md->vertex_sizes[j]};
+            sections[s++] = (__gs_asset_cache_section_t){md->indices[j], md->index_sizes[j]};
+        }
+    }
+
+    const uint64_t size = __gs_asset_cache_layout(sections, section_ct);
+    info.prim_counts = sections[1].offset;
+    info.prims = sections[2].offset;
+    for (uint32_t p = 0; p < info.prim_count; ++p) {
+        prims[p] = (__gs_asset_cache_prim_t){
+            .vertices = sections[3 + p * 2].offset,
+            .vertex_size = sections[3 + p * 2].size,
+            .indices = sections[4 + p * 2].offset,
+            .index_size = sections[4 + p * 2].size
+        };
+    }
+    __gs_asset_cache_write(key, __GS_ASSET_CACHE_KIND_MESH, sections, section_ct, size);
+
+    gs_free(sections);
+    gs_free(prims);
+    gs_free(prim_counts);
+}
+
+static bool
+__gs_asset_cache_mesh_decode(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    __gs_asset_cache_mesh_t* c = (__gs_asset_cache_mesh_t*)decoded;
+
+    size_t sz = 0;
+    char* file = (char*)gs_assets_read_file(path, &sz);
+    if (!file) return false;
+    uint64_t content = __gs_asset_cache_gltf_hash(path, file, sz);
+    gs_free(file);
+
+    // Layout decides what gets interleaved, index size how indices are stored
+    const gs_asset_mesh_decl_t* decl = params->mesh_decl;
+    if (decl && decl->layout && decl->layout_size) content = gs_hash_bytes(decl->layout, decl->layout_size, content);
+#ifdef GS_ASSET_MESH_OPTIMIZE_H
+    // Optimized blobs are kept apart from plain ones, for the same source
+    if (params->mesh_optimize) {
+        const uint32_t cache_size = GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE;
+        content = gs_hash_bytes((void*)&cache_size, sizeof(cache_size), content);
+    }
+#endif
+    const uint64_t index_size = decl ? (uint64_t)decl->index_buffer_element_size : 0;
+    const uint64_t key = __gs_asset_cache_key(__GS_ASSET_CACHE_KIND_MESH, content, &index_size, sizeof(index_size));
+
+    const __gs_asset_cache_mesh_info_t* info = (const __gs_asset_cache_mesh_info_t*)__gs_asset_cache_open(
+        key, __GS_ASSET_CACHE_KIND_MESH, sizeof(__gs_asset_cache_mesh_info_t), &c->map);
+    if (info && __gs_asset_cache_mesh_from_blob(c, info)) {
+        __gs_asset_cache_count(true);
+        return true;
+    }
+    __gs_asset_unmap_file(&c->map);
+    __gs_asset_cache_count(false);
+
+    if (!__gs_asset_async_mesh_decode(path, &c->mesh, params)) return false;
+    __gs_asset_cache_mesh_write(key, &c->mesh);
+    return true;
+}
+
+static void
+__gs_asset_cache_mesh_release(void* decoded)
+{
+    __gs_asset_cache_mesh_t* c = (__gs_asset_cache_mesh_t*)decoded;
+    if (!c->map.data) {
+        __gs_asset_async_mesh_raw_free(&c->mesh);
+        return;
+    }
+
+    // Only the arrays are ours, the data is in the mapping
+    for (uint32_t i = 0; i < c->mesh.mesh_count; ++i) {
+        gs_asset_mesh_raw_data_t* md = &c->mesh.meshes[i];
+        gs_free(md->vertex_sizes);
+        gs_free(md->index_sizes);
+        gs_free(md->vertices);
+        gs_free(md->indices);
+    }
+    if (c->mesh.meshes) gs_free(c->mesh.meshes);
+    c->mesh.meshes = NULL;
+    c->mesh.mesh_count = 0;
+    __gs_asset_unmap_file(&c->map);
+}
+
+static bool
+__gs_asset_cache_mesh_finalize(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    __gs_asset_cache_mesh_t* c = (__gs_asset_cache_mesh_t*)decoded;
+    __gs_asset_async_mesh_create(&c->mesh, (gs_asset_mesh_t*)out, params);
+    __gs_asset_cache_mesh_release(decoded);
+    return true;
+}
+
+/*=== Font ===*/
+
+#define __GS_ASSET_CACHE_FONT_GLYPH_SIZE    sizeof(((gs_asset_font_t*)NULL)->glyphs)
+
+typedef struct __gs_asset_cache_font_t
+{
+    __gs_asset_cache_font_info_t info;
+    const void* glyphs;
+    void* pixels;                           // rgba8 atlas
+    __gs_asset_map_t map;                   // Glyphs and pixels point into it on a hit
+} __gs_asset_cache_font_t;
+
+// Same atlas gs_asset_font_load_from_memory() bakes: 96 glyphs from ' ', white with coverage in alpha
+static bool
+__gs_asset_cache_font_bake(__gs_asset_cache_font_t* f, const uint8_t* ttf, uint32_t point_size)
+{
+    stbtt_fontinfo font = gs_default_val();
+    if (!stbtt_InitFont(&font, ttf, stbtt_GetFontOffsetForIndex(ttf, 0))) return false;
+
+    uint32_t wh = 1;
+    while (wh < gs_max(point_size, 32)) wh <<= 1;
+    wh *= 16;
+
+    uint8_t* alpha = gs_malloc(wh * wh);
+    memset(alpha, 0, wh * wh);
+    void* glyphs = gs_malloc(__GS_ASSET_CACHE_FONT_GLYPH_SIZE);
+    memset(glyphs, 0, __GS_ASSET_CACHE_FONT_GLYPH_SIZE);
+
+    int32_t v = stbtt_BakeFontBitmap(ttf, 0, (float)point_size, alpha, wh, wh, 32, 96, (stbtt_bakedchar*)glyphs);
+    if (v <= 0) gs_println("gs_asset_cache: font atlas too small, some glyphs were not baked");
+
+    uint8_t* rgba = gs_malloc(wh * wh * 4);
+    for (uint32_t i = 0; i < wh * wh; ++i) {
+        rgba[i * 4 + 0] = 255;
+        rgba[i * 4 + 1] = 255;
+        rgba[i * 4 + 2] = 255;
+        rgba[i * 4 + 3] = alpha[i];
+    }
+    gs_free(alpha);
+
+    int32_t ascent = 0, descent = 0, line_gap = 0;
+    const float scale = stbtt_ScaleForPixelHeight(&font, (float)point_size);
+    stbtt_GetFontVMetrics(&font, &ascent, &descent, &line_gap);
+
+    f->info = (__gs_asset_cache_font_info_t){
+        .width = wh,
+        .height = wh,
+        .point_size = point_size,
+        .glyph_size = (uint32_t)__GS_ASSET_CACHE_FONT_GLYPH_SIZE,
+        .ascent = ascent * scale,
+        .descent = descent * scale
+    };
+    f->glyphs = glyphs;
+    f->pixels = rgba;
+    return true;
+}
+
+static bool
+__gs_asset_cache_font_decode(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    __gs_asset_cache_font_t* f = (__gs_asset_cache_font_t*)decoded;
+
+    size_t sz = 0;
+    char* file = (char*)gs_assets_read_file(path, &sz);
+    if (!file) return false;
+
+    const uint32_t point_size = params->point_size ? params->point_size : 16;
+    const uint64_t key = __gs_asset_cache_key(__GS_ASSET_CACHE_KIND_FONT, gs_hash_bytes(file, sz, GS_HASH_TABLE_HASH_SEED),
+        &point_size, sizeof(point_size));
+
+    const __gs_asset_cache_font_info_t* info = (const __gs_asset_cache_font_info_t*)__gs_asset_cache_open(
+        key, __GS_ASSET_CACHE_KIND_FONT, sizeof(__gs_asset_cache_font_info_t), &f->map);
+    if (
+        info && info->glyph_size == __GS_ASSET_CACHE_FONT_GLYPH_SIZE &&
+        __gs_asset_cache_in_range(&f->map, info->glyphs, info->glyph_size) &&
+        __gs_asset_cache_in_range(&f->map, info->pixels, (uint64_t)info->width * info->height * 4)
+    )
+    {
+        gs_free(file);
+        f->info = *info;
+        f->glyphs = f->map.data + info->glyphs;
+        f->pixels = f->map.data + info->pixels;
+        __gs_asset_cache_count(true);
+        return true;
+    }
+    __gs_asset_unmap_file(&f->map);
+    __gs_asset_cache_count(false);
+
+    bool ok = __gs_asset_cache_font_bake(f, (const uint8_t*)file, point_size);
+    gs_free(file);
+    if (!ok) return false;
+
+    __gs_asset_cache_font_info_t fi = f->info;
+    __gs_asset_cache_section_t sections[] = {
+        {&fi, sizeof(fi)},
+        {f->glyphs, fi.glyph_size},
+        {f->pixels, (size_t)fi.width * fi.height * 4}
+    };
+    const uint64_t size = __gs_asset_cache_layout(sections, 3);
+    fi.glyphs = sections[1].offset;
+    fi.pixels = sections[2].offset;
+    __gs_asset_cache_write(key, __GS_ASSET_CACHE_KIND_FONT, sections, 3, size);
+    return true;
+}
+
+static size_t
+__gs_asset_cache_font_size(const void* decoded, const gs_asset_load_params_t* params)
+{
+    const __gs_asset_cache_font_t* f = (const __gs_asset_cache_font_t*)decoded;
+    return (size_t)f->info.width * f->info.height * 4;
+}
+
+static void
+__gs_asset_cache_font_release(void* decoded)
+{
+    __gs_asset_cache_font_t* f = (__gs_asset_cache_font_t*)decoded;
+    if (f->map.data) {
+        __gs_asset_unmap_file(&f->map);
+        return;
+    }
+    if (f->glyphs) gs_free((void*)f->glyphs);
+    if (f->pixels) gs_free(f->pixels);
+}
+
+static bool
+__gs_asset_cache_font_finalize(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    __gs_asset_cache_font_t* f = (__gs_asset_cache_font_t*)decoded;
+    gs_asset_font_t* font = (gs_asset_font_t*)out;
+
+    gs_graphics_texture_desc_t desc = gs_default_val();
+    desc.type = GS_GRAPHICS_TEXTURE_2D;
+    desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
+    desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST;
+    desc.mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST;
+
+    gs_asset_load_params_t tparams = *params;
+    tparams.texture_desc = &desc;
+    __gs_asset_async_texture_t atlas = {.pixels = f->pixels, .width = (int32_t)f->info.width, .height = (int32_t)f->info.height, .comps = 4};
+    __gs_asset_async_texture_upload(&atlas, &font->texture, &tparams, cb);
+
+    memcpy(font->glyphs, f->glyphs, sizeof(font->glyphs));
+    font->ascent = f->info.ascent;
+    font->descent = f->info.descent;
+
+    __gs_asset_cache_font_release(decoded);
+    return true;
+}
+
+/*=== Cache ===*/
+
+static void
+__gs_asset_cache_register(uint64_t type_id, gs_asset_async_importer_desc_t desc)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (!aa->initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+    if (gs_hash_table_exists(aa->importers, type_id)) {
+        gs_hash_table_insert(__gs_asset_cache.replaced, type_id, gs_hash_table_get(aa->importers, type_id));
+    }
+    gs_hash_table_insert(__gs_asset_cache.importers, type_id, desc);
+    gs_assets_register_async_importer_func(type_id, &desc);
+}
+
+GS_API_DECL void
+gs_asset_cache_init(gs_asset_cache_desc_t desc)
+{
+    __gs_asset_cache_t* ac = &__gs_asset_cache;
+    if (ac->initialized) return;
+    ac->initialized = true;
+    ac->read_only = desc.read_only;
+
+    const char* dir = desc.dir ? desc.dir : GS_ASSET_CACHE_DIR_DEFAULT;
+    const size_t len = strlen(dir);
+    ac->dir = gs_malloc(len + 1);
+    memcpy(ac->dir, dir, len + 1);
+    if (!ac->read_only) __gs_asset_cache_mkdir(ac->dir);
+
+    // Replaces the uncached built-ins
+    __gs_asset_cache_register(gs_hash_str64(gs_to_str(gs_asset_texture_t)), (gs_asset_async_importer_desc_t){
+        .decode = __gs_asset_cache_texture_decode,
+        .finalize = __gs_asset_cache_texture_finalize,
+        .release = __gs_asset_cache_texture_release,
+        .destroy = __gs_asset_async_texture_destroy,
+        .size = __gs_asset_async_texture_size,
+        .decoded_size = sizeof(__gs_asset_cache_texture_t),
+        .asset_size = sizeof(gs_asset_texture_t)
+    });
+    __gs_asset_cache_register(gs_hash_str64(gs_to_str(gs_asset_mesh_t)), (gs_asset_async_importer_desc_t){
+        .decode = __gs_asset_cache_mesh_decode,
+        .finalize = __gs_asset_cache_mesh_finalize,
+        .release = __gs_asset_cache_mesh_release,
+        .destroy = __gs_asset_async_mesh_destroy,
+        .size = __gs_asset_async_mesh_size,
+        .decoded_size = sizeof(__gs_asset_cache_mesh_t),
+        .asset_size = sizeof(gs_asset_mesh_t)
+    });
+    __gs_asset_cache_register(gs_hash_str64(gs_to_str(gs_asset_font_t)), (gs_asset_async_importer_desc_t){
+        .decode = __gs_asset_cache_font_decode,
+        .finalize = __gs_asset_cache_font_finalize,
+        .release = __gs_asset_cache_font_release,
+        .destroy = __gs_asset_async_font_destroy,
+        .size = __gs_asset_cache_font_size,
+        .decoded_size = sizeof(__gs_asset_cache_font_t),
+        .asset_size = sizeof(gs_asset_font_t)
+    });
+}
+
+GS_API_DECL void
+gs_asset_cache_shutdown()
+{
+    __gs_asset_cache_t* ac = &__gs_asset_cache;
+    if (!ac->initialized) return;
+
+    // Async is still up: put back the importers swapped out, unless someone swapped ours out since, and let decodes
+    // already running with ours finish before the directory goes
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    if (aa->initialized)
+    {
+        for (
+            gs_hash_table_iter it = gs_hash_table_iter_new(ac->importers);
+            gs_hash_table_iter_valid(ac->importers, it);
+            gs_hash_table_iter_advance(ac->importers, it)
+        )
+        {
+            const uint64_t type_id = gs_hash_table_iter_getk(ac->importers, it);
+            gs_asset_async_importer_desc_t* ours = gs_hash_table_iter_getp(ac->importers, it);
+            if (!gs_hash_table_exists(aa->importers, type_id)) continue;
+            if (gs_hash_table_getp(aa->importers, type_id)->decode != ours->decode) continue;
+            if (gs_hash_table_exists(ac->replaced, type_id)) {
+                gs_hash_table_insert(aa->importers, type_id, gs_hash_table_get(ac->replaced, type_id));
+            }
+            else {
+                gs_hash_table_erase(aa->importers, type_id);
+            }
+        }
+        gs_job_pool_wait(aa->pool, &aa->decoding);
+    }
+
+    gs_free(ac->dir);
+    gs_hash_table_free(ac->importers);
+    gs_hash_table_free(ac->replaced);
+    memset(ac, 0, sizeof(__gs_asset_cache_t));
+}
+
+GS_API_DECL gs_asset_cache_stats_t
+gs_asset_cache_stats()
+{
+    gs_asset_cache_stats_t* s = &__gs_asset_cache.stats;
+    gs_asset_cache_stats_t stats = {
+        .hits = gs_atomic_load_acq_u32(&s->hits),
+        .misses = gs_atomic_load_acq_u32(&s->misses),
+        .writes = gs_atomic_load_acq_u32(&s->writes)
+    };
+    return stats;
+}
+
+GS_API_DECL bool
+gs_assets_cook_func(uint64_t type_id, const char* path, const gs_asset_load_params_t* params)
+{
+    __gs_asset_cache_t* ac = &__gs_asset_cache;
+    if (!ac->initialized || !gs_hash_table_exists(ac->importers, type_id)) {
+        gs_println("gs_assets_cook: no cooked format for %s", path);
+        return false;
+    }
+
+    gs_asset_async_importer_desc_t* imp = gs_hash_table_getp(ac->importers, type_id);
+    void* decoded = gs_malloc(imp->decoded_size);
+    memset(decoded, 0, imp->decoded_size);
+    bool ok = imp->decode(path, decoded, params);
+    if (ok) imp->release(decoded);
+    gs_free(decoded);
+    return ok;
+}
+
+#endif // GS_ASSET_CACHE_IMPL
+#endif // GS_ASSET_CACHE_H
@@ -0,0 +1,445 @@
+#ifndef GS_ASSET_HOT_RELOAD_H
+#define GS_ASSET_HOT_RELOAD_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger asset hot reload implementation like this:
+
+        #define GS_ASSET_HOT_RELOAD_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_HOT_RELOAD_IMPL
+        #include "gs_asset_hot_reload.h"
+
+    All other files should just #include "gs_asset_hot_reload.h" without the #define.
+
+    MUST include "gs_asset_async.h" (and everything it relies on) BEFORE this file:
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+        #define GS_ASSET_HOT_RELOAD_IMPL
+        #include "gs_asset_hot_reload.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Hot reload for async loaded assets, keeping their gs_asset_t handles:
+
+        * gs_assets_load_watched() is gs_assets_load_async() plus a watch on the file. gs_assets_watch() adds a watch
+          to an asset loaded some other way, handing it to the async loader as READY (gs_assets_async_adopt()).
+        * A background thread waits for changes: inotify on linux (one watch per directory), polling file size and
+          modification time everywhere else.
+        * Changes are batched and debounced. gs_asset_hot_reload_update() queues reloads only once no watched file
+          has changed for debounce_ms, so an editor saving in several writes, or an export touching hundreds of
+          files, reloads everything once and together.
+        * Reloads decode on the async worker pool. gs_assets_async_update() swaps each result into the same handle at
+          the start of a frame, so handles held anywhere stay valid. A failed reload keeps the old asset, and a
+          failed first load is retried as a load.
+
+            gs_asset_hot_reload_init((gs_asset_hot_reload_desc_t){0});
+            gs_asset_t tex = gs_assets_load_watched(&gsa, gs_asset_texture_t, "./assets/champ.png");
+
+            // Every frame
+            gs_asset_hot_reload_update();
+            gs_assets_async_update(&gcb);
+
+            // Shutdown order: watcher first, it queues async reloads
+            gs_asset_hot_reload_shutdown();
+            gs_assets_async_shutdown();
+*/
+
+/*==== Interface ====*/
+
+typedef struct gs_asset_hot_reload_desc_t
+{
+    uint32_t debounce_ms;       // Quiet time before a batch of changes reloads, 200 if 0
+    uint32_t poll_ms;           // Polling interval where inotify isn't available, 500 if 0
+} gs_asset_hot_reload_desc_t;
+
+// Optional, called with defaults by the first watch otherwise
+GS_API_DECL void
+gs_asset_hot_reload_init(gs_asset_hot_reload_desc_t desc);
+
+GS_API_DECL void
+gs_asset_hot_reload_shutdown();
+
+GS_API_DECL void
+gs_assets_watch_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params);
+
+#define gs_assets_watch(__AM, __T, __HNDL, __PATH, ...)\
+    gs_assets_watch_func((__AM), gs_hash_str64(gs_to_str(__T)), (__HNDL), (__PATH), &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+GS_API_DECL gs_asset_t
+gs_assets_load_watched_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params);
+
+#define gs_assets_load_watched(__AM, __T, __PATH, ...)\
+    gs_assets_load_watched_func((__AM), gs_hash_str64(gs_to_str(__T)), gs_assets_create_asset((__AM), __T, &(__T){0}),\
+        (__PATH), &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+// Once per frame before gs_assets_async_update(), returns how many reloads were queued
+GS_API_DECL uint32_t
+gs_asset_hot_reload_update();
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_HOT_RELOAD_IMPL
+
+#if (defined __linux__ && !defined __ANDROID__)
+    #define __GS_ASSET_HOT_RELOAD_INOTIFY
+    #include <sys/inotify.h>
+    #include <poll.h>
+    #include <unistd.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+
+typedef struct __gs_asset_watch_t
+{
+    gs_asset_manager_t* am;
+    uint64_t type_id;
+    gs_asset_t asset;
+    char* path;
+    uint64_t key;                       // Hash of dir + "/" + name, which is what the watcher reports
+    __gs_asset_async_params_t params;
+    int64_t mtime;                      // Polling only
+    int64_t size;
+} __gs_asset_watch_t;
+
+typedef struct __gs_asset_watch_dir_t
+{
+    char* dir;
+    int32_t wd;
+} __gs_asset_watch_dir_t;
+
+// Shared type so the changed set can be swapped out whole
+typedef gs_hash_table(uint64_t, uint32_t) __gs_asset_hot_reload_keys_t;
+
+typedef struct __gs_asset_hot_reload_t
+{
+    bool initialized;
+    uint32_t debounce_ms;
+    uint32_t poll_ms;
+    gs_spinlock_t lock;                                 // Guards everything the watcher thread touches
+    gs_dyn_array(__gs_asset_watch_t*) watches;
+    gs_dyn_array(__gs_asset_watch_dir_t) dirs;
+    __gs_asset_hot_reload_keys_t watched;               // Key -> watch count
+    __gs_asset_hot_reload_keys_t changed;               // Keys changed since the last batch
+    uint32_t generation;                                // Bumped by the watcher on every change
+    uint32_t seen_generation;
+    float quiet_since;
+    gs_thread_t thread;
+    uint32_t running;
+    int32_t fd;
+} __gs_asset_hot_reload_t;
+
+static __gs_asset_hot_reload_t __gs_asset_hot_reload = {0};
+
+static uint64_t
+__gs_asset_hot_reload_key(const char* dir, size_t dir_len, const char* name)
+{
+    char path[1024] = gs_default_val();
+    gs_snprintf(path, sizeof(path), "%.*s/%s", (int)dir_len, dir, name);
+    return gs_hash_str64(path);
+}
+
+static bool
+__gs_asset_hot_reload_stat(const char* path, int64_t* mtime, int64_t* size)
+{
+    struct stat st;
+    if (stat(path, &st) != 0) return false;
+    // Sub-second times where there are some, editors can save twice within a second
+#if (defined __APPLE__)
+    *mtime = (int64_t)st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+#elif (defined _WIN32 || defined _WIN64)
+    *mtime = (int64_t)st.st_mtime;
+#else
+    *mtime = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    *size = (int64_t)st.st_size;
+    return true;
+}
+
+// Watcher thread, with the lock held
+static void
+__gs_asset_hot_reload_mark(uint64_t key)
+{
+    __gs_asset_hot_reload_t* hr = &__gs_asset_hot_reload;
+    if (!gs_hash_table_exists(hr->watched, key)) return;
+    gs_hash_table_insert(hr->changed, key, 1);
+    gs_atomic_add_u32(&hr->generation, 1);
+}
+
+#ifdef __GS_ASSET_HOT_RELOAD_INOTIFY
+
+static void
+__gs_asset_hot_reload_watcher(void* user_data)
+{
+    __gs_asset_hot_reload_t* hr = (__gs_asset_hot_reload_t*)user_data;
+    union {
+        struct inotify_event ev;
+        char buf[4096];
+    } events;
+
+    while (gs_atomic_load_acq_u32(&hr->running))
+    {
+        // Timeout so shutdown is noticed
+        struct pollfd pfd = {.fd = hr->fd, .events = POLLIN};
+        if (poll(&pfd, 1, 100) <= 0) continue;
+
+        ssize_t len = read(hr->fd, events.buf, sizeof(events.buf));
+        if (len <= 0) continue;
+
+        gs_spinlock_lock(&hr->lock);
+        for (char* at = events.buf; at < events.buf + len;)
+        {
+            struct inotify_event* ev = (struct inotify_event*)at;
+            at += sizeof(struct inotify_event) + ev->len;
+            if (!ev->len) continue;
+
+            for (uint32_t i = 0; i < gs_dyn_array_size(hr->dirs); ++i) {
+                if (hr->dirs[i].wd != ev->wd) continue;
+                __gs_asset_hot_reload_mark(__gs_asset_hot_reload_key(hr->dirs[i].dir, strlen(hr->dirs[i].dir), ev->name));
+                break;
+            }
+        }
+        gs_spinlock_unlock(&hr->lock);
+    }
+}
+
+static void
+__gs_asset_hot_reload_add_dir(__gs_asset_watch_dir_t* dir)
+{
+    // Editors commonly save by writing a temp file and renaming it over the original
+    dir->wd = inotify_add_watch(__gs_asset_hot_reload.fd, dir->dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (dir->wd < 0) gs_println("gs_asset_hot_reload: unable to watch %s", dir->dir);
+}
+
+#else
+
+static void
+__gs_asset_hot_reload_watcher(void* user_data)
+{
+    __gs_asset_hot_reload_t* hr = (__gs_asset_hot_reload_t*)user_data;
+    while (gs_atomic_load_acq_u32(&hr->running))
+    {
+        for (uint32_t t = 0; t < hr->poll_ms && gs_atomic_load_acq_u32(&hr->running); t += 50) {
+            gs_platform_sleep(50.f);
+        }
+
+        gs_spinlock_lock(&hr->lock);
+        for (uint32_t i = 0; i < gs_dyn_array_size(hr->watches); ++i)
+        {
+            __gs_asset_watch_t* w = hr->watches[i];
+            int64_t mtime = 0, size = 0;
+            if (!__gs_asset_hot_reload_stat(w->path, &mtime, &size)) continue;
+            if (mtime == w->mtime && size == w->size) continue;
+            w->mtime = mtime;
+            w->size = size;
+            __gs_asset_hot_reload_mark(w->key);
+        }
+        gs_spinlock_unlock(&hr->lock);
+    }
+}
+
+static void
+__gs_asset_hot_reload_add_dir(__gs_asset_watch_dir_t* dir)
+{
+    dir->wd = -1;
+}
+
+#endif
+
+GS_API_DECL void
+gs_asset_hot_reload_init(gs_asset_hot_reload_desc_t desc)
+{
+    __gs_asset_hot_reload_t* hr = &__gs_asset_hot_reload;
+    if (hr->initialized) return;
+    hr->initialized = true;
+    hr->debounce_ms = desc.debounce_ms ? desc.debounce_ms : 200;
+    hr->poll_ms = desc.poll_ms ? desc.poll_ms : 500;
+    hr->fd = -1;
+
+#ifdef __GS_ASSET_HOT_RELOAD_INOTIFY
+    hr->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (hr->fd < 0) {
+        gs_println("gs_asset_hot_reload: inotify unavailable, files won't be watched");
+        return;
+    }
+#endif
+
+    hr->running = 1;
+    hr->thread = gs_thread_create(__gs_asset_hot_reload_watcher, hr);
+    if (!hr->thread.handle) {
+        gs_println("gs_asset_hot_reload: unable to start the watcher thread, files won't be watched");
+        hr->running = 0;
+    }
+}
+
+GS_API_DECL void
+gs_asset_hot_reload_shutdown()
+{
+    __gs_asset_hot_reload_t* hr = &__gs_asset_hot_reload;
+    if (!hr->initialized) return;
+
+    if (hr->running) {
+        gs_atomic_store_rel_u32(&hr->running, 0);
+        gs_thread_join(hr->thread);
+    }
+#ifdef __GS_ASSET_HOT_RELOAD_INOTIFY
+    if (hr->fd >= 0) close(hr->fd);
+#endif
+
+    for (uint32_t i = 0; i < gs_dyn_array_size(hr->watches); ++i) {
+        __gs_asset_watch_t* w = hr->watches[i];
+        __gs_asset_async_params_free(&w->params);
+        gs_free(w->path);
+        gs_free(w);
+    }
+    for (uint32_t i = 0; i < gs_dyn_array_size(hr->dirs); ++i) {
+        gs_free(hr->dirs[i].dir);
+    }
+    gs_dyn_array_free(hr->watches);
+    gs_dyn_array_free(hr->dirs);
+    gs_hash_table_free(hr->watched);
+    gs_hash_table_free(hr->changed);
+    memset(hr, 0, sizeof(__gs_asset_hot_reload_t));
+}
+
+GS_API_DECL void
+gs_assets_watch_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params)
+{
+    __gs_asset_hot_reload_t* hr = &__gs_asset_hot_reload;
+    if (!hr->initialized) gs_asset_hot_reload_init((gs_asset_hot_reload_desc_t){0});
+
+    __gs_asset_watch_t* w = gs_malloc(sizeof(__gs_asset_watch_t));
+    memset(w, 0, sizeof(__gs_asset_watch_t));
+    w->am = am;
+    w->type_id = type_id;
+    w->asset = asset;
+    const size_t path_len = strlen(path);
+    w->path = gs_malloc(path_len + 1);
+    memcpy(w->path, path, path_len + 1);
+    __gs_asset_async_params_copy(&w->params, params);
+    __gs_asset_hot_reload_stat(path, &w->mtime, &w->size);
+
+    // Only READY assets reload, one the async loader has never seen is taken as loaded
+    if (gs_assets_status(am, asset) == GS_ASSET_STATUS_NONE) gs_assets_async_adopt_func(am, type_id, asset, path);
+
+    // Split into the directory to watch and the name events report
+    const char* slash = strrchr(path, '/');
+    const char* bslash = strrchr(path, '\\');
+    if (bslash > slash) slash = bslash;
+    const char* dir = slash ? path : ".";
+    const size_t dir_len = slash ? (size_t)(slash - path) : 1;
+    w->key = __gs_asset_hot_reload_key(dir, dir_len, slash ? slash + 1 : path);
+
+    gs_spinlock_lock(&hr->lock);
+    {
+        gs_dyn_array_push(hr->watches, w);
+        const uint32_t ct = gs_hash_table_exists(hr->watched, w->key) ? gs_hash_table_get(hr->watched, w->key) : 0;
+        gs_hash_table_insert(hr->watched, w->key, ct + 1);
+
+        bool known = false;
+        for (uint32_t i = 0; i < gs_dyn_array_size(hr->dirs) && !known; ++i) {
+            known = strlen(hr->dirs[i].dir) == dir_len && !strncmp(hr->dirs[i].dir, dir, dir_len);
+        }
+        if (!known)
+        {
+            __gs_asset_watch_dir_t d = {.dir = gs_malloc(dir_len + 1)};
+            memcpy(d.dir, dir, dir_len);
+            d.dir[dir_len] = '\0';
+            if (hr->fd >= 0) __gs_asset_hot_reload_add_dir(&d);
+            gs_dyn_array_push(hr->dirs, d);
+        }
+    }
+    gs_spinlock_unlock(&hr->lock);
+}
+
+GS_API_DECL gs_asset_t
+gs_assets_load_watched_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params)
+{
+    gs_assets_load_async_func(am, type_id, asset, path, params);
+    gs_assets_watch_func(am, type_id, asset, path, params);
+    return asset;
+}
+
+GS_API_DECL uint32_t
+gs_asset_hot_reload_update()
+{
+    __gs_asset_hot_reload_t* hr = &__gs_asset_hot_reload;
+    if (!hr->initialized) return 0;
+
+    // Any change restarts the quiet period
+    const float now = gs_platform_elapsed_time();
+    const uint32_t generation = gs_atomic_load_acq_u32(&hr->generation);
+    if (generation != hr->seen_generation) {
+        hr->seen_generation = generation;
+        hr->quiet_since = now;
+        return 0;
+    }
+    if (now - hr->quiet_since < (float)hr->debounce_ms) return 0;
+
+    __gs_asset_hot_reload_keys_t batch = NULL;
+    gs_spinlock_lock(&hr->lock);
+    {
+        if (gs_hash_table_size(hr->changed)) {
+            batch = hr->changed;
+            hr->changed = NULL;
+        }
+    }
+    gs_spinlock_unlock(&hr->lock);
+    if (!batch) return 0;
+
+    // Only the main thread adds watches, no lock needed to read them
+    uint32_t queued = 0;
+    for (uint32_t i = 0; i < gs_dyn_array_size(hr->watches); ++i)
+    {
+        __gs_asset_watch_t* w = hr->watches[i];
+        if (!gs_hash_table_exists(batch, w->key)) continue;
+
+        switch (gs_assets_status(w->am, w->asset))
+        {
+            case GS_ASSET_STATUS_READY:
+            {
+                queued += gs_assets_reload_async_func(w->am, w->type_id, w->asset, w->path, &w->params.params);
+            } break;
+
+            case GS_ASSET_STATUS_FAILED:
+            {
+                gs_assets_load_async_func(w->am, w->type_id, w->asset, w->path, &w->params.params);
+                queued++;
+            } break;
+
+            // Reads the new file whenever it's loaded again
+            case GS_ASSET_STATUS_EVICTED: break;
+
+            // No async importer for its type, so it couldn't be adopted
+            case GS_ASSET_STATUS_NONE: break;
+
+            // Still loading, goes in the next batch
+            default:
+            {
+                gs_spinlock_lock(&hr->lock);
+                __gs_asset_hot_reload_mark(w->key);
+                gs_spinlock_unlock(&hr->lock);
+            } break;
+        }
+    }
+
+    gs_hash_table_free(batch);
+    return queued;
+}
+
+#endif // GS_ASSET_HOT_RELOAD_IMPL
+#endif // GS_ASSET_HOT_RELOAD_H
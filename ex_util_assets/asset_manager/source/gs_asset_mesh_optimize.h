@@ -0,0 +1,415 @@
+#ifndef GS_ASSET_MESH_OPTIMIZE_H
+#define GS_ASSET_MESH_OPTIMIZE_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger mesh optimizer implementation like this:
+
+        #define GS_ASSET_MESH_OPTIMIZE_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_MESH_OPTIMIZE_IMPL
+        #include "gs_asset_mesh_optimize.h"
+
+    All other files should just #include "gs_asset_mesh_optimize.h" without the #define.
+
+    MUST include "gs_job.h" (and everything it relies on) BEFORE this file. Include it BEFORE "gs_asset_async.h" for
+    async mesh loads to use it:
+
+        #define GS_JOB_IMPL
+        #include "gs_job.h"
+
+        #define GS_ASSET_MESH_OPTIMIZE_IMPL
+        #include "gs_asset_mesh_optimize.h"
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Post-import mesh optimization for triangle lists:
+
+        * gs_asset_mesh_optimize_indices() reorders triangles so vertices are reused while they are still in the
+          GPU's post-transform cache (Tom Forsyth's linear-speed vertex cache optimisation). Triangles keep their
+          winding.
+        * gs_asset_mesh_optimize_vertex_fetch() then renumbers vertices in the order the indices first use them, so
+          vertex fetches walk the buffer forwards. Unused vertices move to the end, the buffer keeps its size.
+        * gs_asset_mesh_raw_optimize() runs both over gs_util_load_gltf_data_from_file() output, one job per
+          primitive on a gs_job_pool_t (so a scene's primitives optimize in parallel). gs_gfxt meshes can run it
+          on their raw data before creating buffers.
+        * Async loads opt in per load, and cooked caches store the optimized result:
+
+            gs_asset_t msh = gs_assets_load_async(&gsa, gs_asset_mesh_t, "./assets/duck/Duck.gltf",
+                .mesh_decl = &decl, .mesh_optimize = true);
+
+        * Vertices are only renumbered when the stride is known: every attribute in the decl layout must be one of
+          POSITION, NORMAL, TEXCOORD or COLOR (what gs interleaves as vec3, vec3, vec2 and 4 bytes). Otherwise only
+          the index order changes.
+        * gs_asset_mesh_acmr() measures the result: average vertex shader runs per triangle for a FIFO cache of the
+          given size (3.0 worst, 0.5 best for large regular meshes).
+*/
+
+/*==== Interface ====*/
+
+#define GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE       32          // Modelled LRU cache, in vertices
+
+// indices are uint16_t or uint32_t (index_size), index_ct a multiple of 3 and every index below vertex_ct
+GS_API_DECL void
+gs_asset_mesh_optimize_indices(void* indices, size_t index_size, uint32_t index_ct, uint32_t vertex_ct);
+
+GS_API_DECL void
+gs_asset_mesh_optimize_vertex_fetch(void* vertices, size_t stride, uint32_t vertex_ct, void* indices,
+    size_t index_size, uint32_t index_ct);
+
+// Interleaved vertex size for decl's layout, 0 if it has none or holds attributes of unknown size
+GS_API_DECL size_t
+gs_asset_mesh_vertex_stride(const gs_asset_mesh_decl_t* decl);
+
+// Optimizes every primitive in place, pool may be NULL to run on the calling thread
+GS_API_DECL void
+gs_asset_mesh_raw_optimize(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_ct, const gs_asset_mesh_decl_t* decl,
+    gs_job_pool_t* pool);
+
+GS_API_DECL float
+gs_asset_mesh_acmr(const void* indices, size_t index_size, uint32_t index_ct, uint32_t cache_size);
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_MESH_OPTIMIZE_IMPL
+
+#define __GS_ASSET_MESH_OPT_VALENCE_MAX     32      // Scores for more live triangles than this are all the same
+
+// Indices are worked on as uint32_t, whatever they are stored as
+static uint32_t*
+__gs_asset_mesh_opt_read_indices(const void* indices, size_t index_size, uint32_t index_ct)
+{
+    uint32_t* out = gs_malloc(gs_max(index_ct, 1) * sizeof(uint32_t));
+    if (index_size == sizeof(uint16_t)) {
+        const uint16_t* src = (const uint16_t*)indices;
+        for (uint32_t i = 0; i < index_ct; ++i) out[i] = src[i];
+    } else {
+        memcpy(out, indices, index_ct * sizeof(uint32_t));
+    }
+    return out;
+}
+
+static void
+__gs_asset_mesh_opt_write_indices(void* indices, size_t index_size, const uint32_t* src, uint32_t index_ct)
+{
+    if (index_size == sizeof(uint16_t)) {
+        uint16_t* dst = (uint16_t*)indices;
+        for (uint32_t i = 0; i < index_ct; ++i) dst[i] = (uint16_t)src[i];
+    } else {
+        memcpy(indices, src, index_ct * sizeof(uint32_t));
+    }
+}
+
+typedef struct __gs_asset_mesh_opt_scores_t
+{
+    float cache[GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE];
+    float valence[__GS_ASSET_MESH_OPT_VALENCE_MAX + 1];
+} __gs_asset_mesh_opt_scores_t;
+
+// Forsyth's scoring: the last triangle's vertices get a flat bonus, older cache entries decay with their position,
+// and vertices with few triangles left are boosted so they get finished off instead of stranded
+static void
+__gs_asset_mesh_opt_scores_init(__gs_asset_mesh_opt_scores_t* s)
+{
+    for (uint32_t i = 0; i < GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE; ++i) {
+        const float t = 1.f - (float)((int32_t)i - 3) / (float)(GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE - 3);
+        s->cache[i] = i < 3 ? 0.75f : powf(t, 1.5f);
+    }
+    s->valence[0] = 0.f;
+    for (uint32_t i = 1; i <= __GS_ASSET_MESH_OPT_VALENCE_MAX; ++i) {
+        s->valence[i] = 2.f / sqrtf((float)i);
+    }
+}
+
+static float
+__gs_asset_mesh_opt_score(const __gs_asset_mesh_opt_scores_t* s, int32_t cache_pos, uint32_t live)
+{
+    if (!live) return -1.f;
+    const float c = cache_pos >= 0 ? s->cache[cache_pos] : 0.f;
+    return c + s->valence[gs_min(live, __GS_ASSET_MESH_OPT_VALENCE_MAX)];
+}
+
+GS_API_DECL void
+gs_asset_mesh_optimize_indices(void* indices, size_t index_size, uint32_t index_ct, uint32_t vertex_ct)
+{
+    const uint32_t tri_ct = index_ct / 3;
+    if (tri_ct < 2 || !vertex_ct) return;
+
+    __gs_asset_mesh_opt_scores_t scores;
+    __gs_asset_mesh_opt_scores_init(&scores);
+
+    uint32_t* in = __gs_asset_mesh_opt_read_indices(indices, index_size, tri_ct * 3);
+    uint32_t* out = gs_malloc(tri_ct * 3 * sizeof(uint32_t));
+
+    // Per vertex: live triangles and their list (live ones first), cache position and score
+    uint32_t* live = gs_malloc(vertex_ct * sizeof(uint32_t));
+    uint32_t* adj_offset = gs_malloc((vertex_ct + 1) * sizeof(uint32_t));
+    uint32_t* adj = gs_malloc(tri_ct * 3 * sizeof(uint32_t));
+    int32_t* cache_pos = gs_malloc(vertex_ct * sizeof(int32_t));
+    float* vscore = gs_malloc(vertex_ct * sizeof(float));
+    float* tscore = gs_malloc(tri_ct * sizeof(float));
+    bool* emitted = gs_malloc(tri_ct * sizeof(bool));
+    memset(live, 0, vertex_ct * sizeof(uint32_t));
+    memset(emitted, 0, tri_ct * sizeof(bool));
+
+    for (uint32_t i = 0; i < tri_ct * 3; ++i) live[in[i]]++;
+    adj_offset[0] = 0;
+    for (uint32_t v = 0; v < vertex_ct; ++v) adj_offset[v + 1] = adj_offset[v] + live[v];
+    memset(live, 0, vertex_ct * sizeof(uint32_t));
+    for (uint32_t t = 0; t < tri_ct; ++t) {
+        for (uint32_t k = 0; k < 3; ++k) {
+            const uint32_t v = in[t * 3 + k];
+            adj[adj_offset[v] + live[v]++] = t;
+        }
+    }
+    for (uint32_t v = 0; v < vertex_ct; ++v) {
+        cache_pos[v] = -1;
+        vscore[v] = __gs_asset_mesh_opt_score(&scores, -1, live[v]);
+    }
+
+    float best_score = -1.f;
+    uint32_t best = 0;
+    for (uint32_t t = 0; t < tri_ct; ++t) {
+        tscore[t] = vscore[in[t * 3]] + vscore[in[t * 3 + 1]] + vscore[in[t * 3 + 2]];
+        if (tscore[t] > best_score) { best_score = tscore[t]; best = t; }
+    }
+
+    // Modelled cache, with room for the 3 vertices pushed in before the oldest fall out
+    uint32_t cache[GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE + 3];
+    uint32_t cache_ct = 0;
+    uint32_t cursor = 0;
+
+    for (uint32_t emit = 0; emit < tri_ct; ++emit)
+    {
+        // Nothing in the cache scored, fall back to the next triangle not yet emitted
+        if (best_score < 0.f) {
+            while (emitted[cursor]) cursor++;
+            best = cursor;
+        }
+
+        const uint32_t* tri = &in[best * 3];
+        memcpy(&out[emit * 3], tri, 3 * sizeof(uint32_t));
+        emitted[best] = true;
+
+        // Drop the triangle from its vertices' live lists
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            const uint32_t v = tri[k];
+            uint32_t* list = &adj[adj_offset[v]];
+            for (uint32_t j = 0; j < live[v]; ++j) {
+                if (list[j] != best) continue;
+                list[j] = list[live[v] - 1];
+                list[live[v] - 1] = best;
+                break;
+            }
+            live[v]--;
+        }
+
+        // Triangle's vertices go to the front, the rest keep their order behind them
+        uint32_t next[GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE + 3];
+        uint32_t next_ct = 0;
+        for (uint32_t k = 0; k < 3; ++k) next[next_ct++] = tri[k];
+        for (uint32_t c = 0; c < cache_ct; ++c) {
+            const uint32_t v = cache[c];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) next[next_ct++] = v;
+        }
+        for (uint32_t c = 0; c < next_ct; ++c)
+        {
+            const uint32_t v = next[c];
+            cache_pos[v] = c < GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE ? (int32_t)c : -1;
+            vscore[v] = __gs_asset_mesh_opt_score(&scores, cache_pos[v], live[v]);
+        }
+        cache_ct = gs_min(next_ct, GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE);
+        memcpy(cache, next, next_ct * sizeof(uint32_t));
+
+        // Only triangles touching the cache changed score (plus those of vertices just pushed out)
+        best_score = -1.f;
+        for (uint32_t c = 0; c < next_ct; ++c)
+        {
+            const uint32_t v = next[c];
+            const uint32_t* list = &adj[adj_offset[v]];
+            for (uint32_t j = 0; j < live[v]; ++j)
+            {
+                const uint32_t t = list[j];
+                tscore[t] = vscore[in[t * 3]] + vscore[in[t * 3 + 1]] + vscore[in[t * 3 + 2]];
+                if (c < cache_ct && tscore[t] > best_score) { best_score = tscore[t]; best = t; }
+            }
+        }
+    }
+
+    __gs_asset_mesh_opt_write_indices(indices, index_size, out, tri_ct * 3);
+
+    gs_free(emitted);
+    gs_free(tscore);
+    gs_free(vscore);
+    gs_free(cache_pos);
+    gs_free(adj);
+    gs_free(adj_offset);
+    gs_free(live);
+    gs_free(out);
+    gs_free(in);
+}
+
+GS_API_DECL void
+gs_asset_mesh_optimize_vertex_fetch(void* vertices, size_t stride, uint32_t vertex_ct, void* indices,
+    size_t index_size, uint32_t index_ct)
+{
+    if (!vertex_ct || !stride) return;
+
+    uint32_t* idx = __gs_asset_mesh_opt_read_indices(indices, index_size, index_ct);
+    uint32_t* remap = gs_malloc(vertex_ct * sizeof(uint32_t));
+    memset(remap, 0xff, vertex_ct * sizeof(uint32_t));
+
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < index_ct; ++i) {
+        if (remap[idx[i]] == UINT32_MAX) remap[idx[i]] = next++;
+        idx[i] = remap[idx[i]];
+    }
+    for (uint32_t v = 0; v < vertex_ct; ++v) {
+        if (remap[v] == UINT32_MAX) remap[v] = next++;
+    }
+
+    uint8_t* tmp = gs_malloc(vertex_ct * stride);
+    const uint8_t* src = (const uint8_t*)vertices;
+    for (uint32_t v = 0; v < vertex_ct; ++v) {
+        memcpy(tmp + remap[v] * stride, src + v * stride, stride);
+    }
+    memcpy(vertices, tmp, vertex_ct * stride);
+    __gs_asset_mesh_opt_write_indices(indices, index_size, idx, index_ct);
+
+    gs_free(tmp);
+    gs_free(remap);
+    gs_free(idx);
+}
+
+GS_API_DECL size_t
+gs_asset_mesh_vertex_stride(const gs_asset_mesh_decl_t* decl)
+{
+    if (!decl || !decl->layout || !decl->layout_size) return 0;
+
+    size_t stride = 0;
+    const uint32_t ct = (uint32_t)(decl->layout_size / sizeof(gs_asset_mesh_layout_t));
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        switch (decl->layout[i].type)
+        {
+            case GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION: stride += sizeof(float) * 3; break;
+            case GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL:   stride += sizeof(float) * 3; break;
+            case GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD: stride += sizeof(float) * 2; break;
+            case GS_ASSET_MESH_ATTRIBUTE_TYPE_COLOR:    stride += sizeof(uint8_t) * 4; break;
+            default: return 0;
+        }
+    }
+    return stride;
+}
+
+typedef struct __gs_asset_mesh_opt_prim_t
+{
+    void* vertices;
+    size_t vertex_size;
+    void* indices;
+    size_t index_size;
+} __gs_asset_mesh_opt_prim_t;
+
+typedef struct __gs_asset_mesh_opt_job_t
+{
+    __gs_asset_mesh_opt_prim_t* prims;
+    size_t index_size;
+    size_t stride;
+} __gs_asset_mesh_opt_job_t;
+
+static void
+__gs_asset_mesh_opt_run(uint32_t start, uint32_t end, void* user_data)
+{
+    const __gs_asset_mesh_opt_job_t* job = (const __gs_asset_mesh_opt_job_t*)user_data;
+    for (uint32_t p = start; p < end; ++p)
+    {
+        const __gs_asset_mesh_opt_prim_t* prim = &job->prims[p];
+        const uint32_t index_ct = (uint32_t)(prim->index_size / job->index_size);
+        if (!index_ct) continue;
+
+        // No vertex is under 4 bytes, so indices past that are broken data, left alone. Stride only counts if the
+        // vertex buffer is a whole number of vertices that covers every index.
+        uint32_t* idx = __gs_asset_mesh_opt_read_indices(prim->indices, job->index_size, index_ct);
+        uint32_t max = 0;
+        for (uint32_t i = 0; i < index_ct; ++i) max = gs_max(max, idx[i]);
+        gs_free(idx);
+        if (max >= prim->vertex_size / 4) continue;
+        const bool fetch = job->stride && prim->vertex_size % job->stride == 0 &&
+            max < prim->vertex_size / job->stride;
+
+        gs_asset_mesh_optimize_indices(prim->indices, job->index_size, index_ct, max + 1);
+        if (fetch) {
+            gs_asset_mesh_optimize_vertex_fetch(prim->vertices, job->stride, (uint32_t)(prim->vertex_size / job->stride),
+                prim->indices, job->index_size, index_ct);
+        }
+    }
+}
+
+GS_API_DECL void
+gs_asset_mesh_raw_optimize(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_ct, const gs_asset_mesh_decl_t* decl,
+    gs_job_pool_t* pool)
+{
+    // Flattened, so one mesh with many primitives spreads over the pool as well as many meshes do
+    gs_dyn_array(__gs_asset_mesh_opt_prim_t) prims = NULL;
+    for (uint32_t i = 0; i < mesh_ct; ++i) {
+        for (uint32_t p = 0; p < meshes[i].prim_count; ++p) {
+            __gs_asset_mesh_opt_prim_t prim = {
+                .vertices = meshes[i].vertices[p],
+                .vertex_size = meshes[i].vertex_sizes[p],
+                .indices = meshes[i].indices[p],
+                .index_size = meshes[i].index_sizes[p]
+            };
+            gs_dyn_array_push(prims, prim);
+        }
+    }
+
+    __gs_asset_mesh_opt_job_t job = {
+        .prims = prims,
+        .index_size = decl && decl->index_buffer_element_size ? decl->index_buffer_element_size : sizeof(uint32_t),
+        .stride = gs_asset_mesh_vertex_stride(decl)
+    };
+    const uint32_t ct = gs_dyn_array_size(prims);
+    if (pool) gs_job_pool_parallel_for(pool, ct, 1, __gs_asset_mesh_opt_run, &job);
+    else __gs_asset_mesh_opt_run(0, ct, &job);
+    gs_dyn_array_free(prims);
+}
+
+GS_API_DECL float
+gs_asset_mesh_acmr(const void* indices, size_t index_size, uint32_t index_ct, uint32_t cache_size)
+{
+    const uint32_t tri_ct = index_ct / 3;
+    if (!tri_ct || !cache_size) return 0.f;
+
+    uint32_t* idx = __gs_asset_mesh_opt_read_indices(indices, index_size, index_ct);
+    uint32_t max = 0;
+    for (uint32_t i = 0; i < index_ct; ++i) max = gs_max(max, idx[i]);
+
+    // FIFO: a vertex is cached if it was pushed within the last cache_size misses
+    uint32_t* pushed = gs_malloc((max + 1) * sizeof(uint32_t));
+    memset(pushed, 0, (max + 1) * sizeof(uint32_t));
+    uint32_t misses = 0;
+    for (uint32_t i = 0; i < tri_ct * 3; ++i) {
+        const uint32_t v = idx[i];
+        if (pushed[v] && misses - pushed[v] < cache_size) continue;
+        pushed[v] = ++misses;
+    }
+
+    gs_free(pushed);
+    gs_free(idx);
+    return (float)misses / (float)tri_ct;
+}
+
+#endif // GS_ASSET_MESH_OPTIMIZE_IMPL
+#endif // GS_ASSET_MESH_OPTIMIZE_H
@@ -0,0 +1,447 @@
+#ifndef GS_ASSET_PACK_H
+#define GS_ASSET_PACK_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger asset pack implementation like this:
+
+        #define GS_ASSET_PACK_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_PACK_IMPL
+        #include "gs_asset_pack.h"
+
+    All other files should just #include "gs_asset_pack.h" without the #define.
+
+    MUST include "gs_asset_async.h" (and everything it relies on) BEFORE this file:
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+        #define GS_ASSET_PACK_IMPL
+        #include "gs_asset_pack.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Asset packs, a whole directory of assets in one file:
+
+        * Layout: header, index of (name hash, offset, size) sorted by hash, names, then each file's bytes aligned
+          to GS_ASSET_PACK_ALIGN. Files are stored in name order, so a directory's files sit next to each other.
+        * gs_asset_pack_open() maps the pack once (mmap/MapViewOfFile). Finding a file is a binary search over the
+          index and returns a pointer into the mapping, so no per-file open/read/close or seek.
+        * gs_asset_pack_mount() also adds the pack as an async file source under a prefix. Async loads and
+          gs_assets_read_file() on "prefix/name" then come from the pack:
+
+            gs_asset_pack_t* pack = gs_asset_pack_mount("./assets.gspk", "pack://");
+            gs_asset_t tex = gs_assets_load_async(&gsa, gs_asset_texture_t, "pack://champ.png");
+            ...
+            gs_asset_pack_unmount(pack);
+
+        * Served from packs: textures, fonts and cache lookups, plus custom importers reading through
+          gs_assets_read_file(). Audio and glTF loaders in gs take file paths (glTF also opens its buffers by
+          path), so those still load from loose files.
+        * gs_asset_pack_build() writes a pack from a directory. The asset_pack example is a command line tool
+          around it, with a benchmark against loose files.
+*/
+
+/*==== Interface ====*/
+
+#define GS_ASSET_PACK_MAGIC         0x4b505347      // "GSPK"
+#define GS_ASSET_PACK_VERSION       1
+#define GS_ASSET_PACK_ALIGN         16
+
+typedef struct gs_asset_pack_header_t
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_ct;
+    uint32_t names_size;
+    uint64_t index;             // Offset of entry_ct gs_asset_pack_entry_t, sorted by hash
+    uint64_t names;             // Offset of the null terminated names, relative paths with '/'
+    uint64_t size;              // Whole pack, catches truncated files
+} gs_asset_pack_header_t;
+
+typedef struct gs_asset_pack_entry_t
+{
+    uint64_t hash;              // gs_hash_str64() of the name
+    uint64_t offset;
+    uint64_t size;
+    uint32_t name;              // Offset into the names
+    uint32_t name_len;
+} gs_asset_pack_entry_t;
+
+typedef struct gs_asset_pack_t gs_asset_pack_t;
+
+// NULL if the file is missing or isn't a valid pack
+GS_API_DECL gs_asset_pack_t*
+gs_asset_pack_open(const char* path);
+
+GS_API_DECL void
+gs_asset_pack_close(gs_asset_pack_t* pack);
+
+// Pointer into the pack (valid until it is closed), NULL if it has no file by that name
+GS_API_DECL const void*
+gs_asset_pack_find(const gs_asset_pack_t* pack, const char* name, size_t* size);
+
+GS_API_DECL uint32_t
+gs_asset_pack_count(const gs_asset_pack_t* pack);
+
+// Name and size of the i'th file, in index order
+GS_API_DECL const char*
+gs_asset_pack_name(const gs_asset_pack_t* pack, uint32_t i, size_t* size);
+
+// Opens the pack and serves it to async loads under prefix
+GS_API_DECL gs_asset_pack_t*
+gs_asset_pack_mount(const char* path, const char* prefix);
+
+// Not while loads from the pack are in flight
+GS_API_DECL void
+gs_asset_pack_unmount(gs_asset_pack_t* pack);
+
+// Packs every file under dir into out_path, returns the number of files packed or -1 on failure
+GS_API_DECL int32_t
+gs_asset_pack_build(const char* dir, const char* out_path);
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_PACK_IMPL
+
+#if (defined _WIN32 || defined _WIN64)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <sys/stat.h>
+#endif
+
+#define __gs_asset_pack_align(__X)\
+    (((__X) + GS_ASSET_PACK_ALIGN - 1) & ~(uint64_t)(GS_ASSET_PACK_ALIGN - 1))
+
+struct gs_asset_pack_t
+{
+    __gs_asset_map_t map;
+    const gs_asset_pack_header_t* header;
+    const gs_asset_pack_entry_t* entries;
+    const char* names;
+    char prefix[64];            // Mounted under, empty otherwise
+};
+
+GS_API_DECL gs_asset_pack_t*
+gs_asset_pack_open(const char* path)
+{
+    __gs_asset_map_t map = gs_default_val();
+    if (!__gs_asset_map_file(path, &map)) return NULL;
+
+    // Everything the index points at must be inside the file
+    const gs_asset_pack_header_t* hdr = (const gs_asset_pack_header_t*)map.data;
+    bool ok = map.size >= sizeof(gs_asset_pack_header_t) &&
+        hdr->magic == GS_ASSET_PACK_MAGIC && hdr->version == GS_ASSET_PACK_VERSION && hdr->size == map.size &&
+        hdr->index <= map.size && (uint64_t)hdr->entry_ct * sizeof(gs_asset_pack_entry_t) <= map.size - hdr->index &&
+        hdr->names <= map.size && hdr->names_size <= map.size - hdr->names;
+
+    const gs_asset_pack_entry_t* entries = ok ? (const gs_asset_pack_entry_t*)(map.data + hdr->index) : NULL;
+    for (uint32_t i = 0; ok && i < hdr->entry_ct; ++i)
+    {
+        const gs_asset_pack_entry_t* e = &entries[i];
+        ok = e->offset <= map.size && e->size <= map.size - e->offset &&
+            (uint64_t)e->name + e->name_len < hdr->names_size;
+    }
+    if (!ok) {
+        gs_println("gs_asset_pack_open: %s is not a valid pack", path);
+        __gs_asset_unmap_file(&map);
+        return NULL;
+    }
+
+    gs_asset_pack_t* pack = gs_malloc(sizeof(gs_asset_pack_t));
+    memset(pack, 0, sizeof(gs_asset_pack_t));
+    pack->map = map;
+    pack->header = hdr;
+    pack->entries = entries;
+    pack->names = (const char*)(map.data + hdr->names);
+    return pack;
+}
+
+GS_API_DECL void
+gs_asset_pack_close(gs_asset_pack_t* pack)
+{
+    if (!pack) return;
+    __gs_asset_unmap_file(&pack->map);
+    gs_free(pack);
+}
+
+GS_API_DECL const void*
+gs_asset_pack_find(const gs_asset_pack_t* pack, const char* name, size_t* size)
+{
+    while (name[0] == '.' && name[1] == '/') name += 2;
+    while (name[0] == '/') name++;
+
+    const uint64_t hash = gs_hash_str64(name);
+    const size_t name_len = strlen(name);
+
+    // Lower bound, then every entry with the same hash
+    uint32_t lo = 0, hi = pack->header->entry_ct;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (pack->entries[mid].hash < hash) lo = mid + 1;
+        else hi = mid;
+    }
+    for (uint32_t i = lo; i < pack->header->entry_ct && pack->entries[i].hash == hash; ++i)
+    {
+        const gs_asset_pack_entry_t* e = &pack->entries[i];
+        if (e->name_len != name_len || memcmp(pack->names + e->name, name, name_len) != 0) continue;
+        if (size) *size = (size_t)e->size;
+        return pack->map.data + e->offset;
+    }
+    return NULL;
+}
+
+GS_API_DECL uint32_t
+gs_asset_pack_count(const gs_asset_pack_t* pack)
+{
+    return pack ? pack->header->entry_ct : 0;
+}
+
+GS_API_DECL const char*
+gs_asset_pack_name(const gs_asset_pack_t* pack, uint32_t i, size_t* size)
+{
+    if (!pack || i >= pack->header->entry_ct) return NULL;
+    if (size) *size = (size_t)pack->entries[i].size;
+    return pack->names + pack->entries[i].name;
+}
+
+static const void*
+__gs_asset_pack_source_find(const char* path, size_t* size, void* user_data)
+{
+    return gs_asset_pack_find((const gs_asset_pack_t*)user_data, path, size);
+}
+
+GS_API_DECL gs_asset_pack_t*
+gs_asset_pack_mount(const char* path, const char* prefix)
+{
+    gs_asset_pack_t* pack = gs_asset_pack_open(path);
+    if (!pack) return NULL;
+
+    gs_snprintf(pack->prefix, sizeof(pack->prefix), "%s", prefix);
+    if (!gs_assets_add_file_source(&(gs_asset_file_source_desc_t){
+        .prefix = pack->prefix,
+        .find = __gs_asset_pack_source_find,
+        .user_data = pack
+    }))
+    {
+        gs_println("gs_asset_pack_mount: can't mount %s under %s", path, prefix);
+        gs_asset_pack_close(pack);
+        return NULL;
+    }
+    return pack;
+}
+
+GS_API_DECL void
+gs_asset_pack_unmount(gs_asset_pack_t* pack)
+{
+    if (!pack) return;
+    if (pack->prefix[0]) gs_assets_remove_file_source(pack->prefix);
+    gs_asset_pack_close(pack);
+}
+
+/*=== Build ===*/
+
+typedef struct __gs_asset_pack_build_file_t
+{
+    char* name;                 // Relative to the packed directory
+    size_t size;
+    uint64_t hash;
+    uint64_t offset;
+    uint32_t name_offset;
+} __gs_asset_pack_build_file_t;
+
+static void
+__gs_asset_pack_add_file(gs_dyn_array(__gs_asset_pack_build_file_t)* files, const char* name, size_t size)
+{
+    __gs_asset_pack_build_file_t f = gs_default_val();
+    const size_t len = strlen(name);
+    f.name = gs_malloc(len + 1);
+    memcpy(f.name, name, len + 1);
+    f.size = size;
+    f.hash = gs_hash_str64(f.name);
+    gs_dyn_array_push(*files, f);
+}
+
+static void
+__gs_asset_pack_walk(const char* root, const char* rel, const char* skip, gs_dyn_array(__gs_asset_pack_build_file_t)* files);
+
+static void
+__gs_asset_pack_visit(const char* root, const char* rel, const char* entry, bool is_dir, size_t size, const char* skip,
+    gs_dyn_array(__gs_asset_pack_build_file_t)* files)
+{
+    if (entry[0] == '.' && (!entry[1] || (entry[1] == '.' && !entry[2]))) return;
+
+    char name[1024] = gs_default_val();
+    if (rel[0]) gs_snprintf(name, sizeof(name), "%s/%s", rel, entry);
+    else gs_snprintf(name, sizeof(name), "%s", entry);
+    if (is_dir) {
+        __gs_asset_pack_walk(root, name, skip, files);
+        return;
+    }
+
+    // Never pack an older copy of the pack being written
+    char path[1024] = gs_default_val();
+    gs_snprintf(path, sizeof(path), "%s/%s", root, name);
+    if (skip && strcmp(path, skip) == 0) return;
+    __gs_asset_pack_add_file(files, name, size);
+}
+
+// Recurses into sub directories, rel is the path below the packed directory ("" at the top)
+static void
+__gs_asset_pack_walk(const char* root, const char* rel, const char* skip, gs_dyn_array(__gs_asset_pack_build_file_t)* files)
+{
+    char dir[1024] = gs_default_val();
+    if (rel[0]) gs_snprintf(dir, sizeof(dir), "%s/%s", root, rel);
+    else gs_snprintf(dir, sizeof(dir), "%s", root);
+
+#if (defined _WIN32 || defined _WIN64)
+    char pattern[1024] = gs_default_val();
+    gs_snprintf(pattern, sizeof(pattern), "%s/*", dir);
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA(pattern, &fd);
+    if (h == INVALID_HANDLE_VALUE) return;
+    do
+    {
+        const bool is_dir = (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        const size_t size = (size_t)(((uint64_t)fd.nFileSizeHigh << 32) | fd.nFileSizeLow);
+        __gs_asset_pack_visit(root, rel, fd.cFileName, is_dir, size, skip, files);
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+#else
+    DIR* d = opendir(dir);
+    if (!d) return;
+    for (struct dirent* de = readdir(d); de; de = readdir(d))
+    {
+        char path[1024] = gs_default_val();
+        gs_snprintf(path, sizeof(path), "%s/%s", dir, de->d_name);
+        struct stat st;
+        if (stat(path, &st) != 0 || !(S_ISDIR(st.st_mode) || S_ISREG(st.st_mode))) continue;
+        __gs_asset_pack_visit(root, rel, de->d_name, S_ISDIR(st.st_mode), (size_t)st.st_size, skip, files);
+    }
+    closedir(d);
+#endif
+}
+
+static int32_t
+__gs_asset_pack_name_cmp(const void* a, const void* b)
+{
+    return strcmp(((const __gs_asset_pack_build_file_t*)a)->name, ((const __gs_asset_pack_build_file_t*)b)->name);
+}
+
+static int32_t
+__gs_asset_pack_entry_cmp(const void* a, const void* b)
+{
+    const uint64_t ha = ((const gs_asset_pack_entry_t*)a)->hash, hb = ((const gs_asset_pack_entry_t*)b)->hash;
+    return ha < hb ? -1 : ha > hb ? 1 : 0;
+}
+
+static bool
+__gs_asset_pack_pad(FILE* fp, uint64_t* at, uint64_t to)
+{
+    static const uint8_t zeros[GS_ASSET_PACK_ALIGN] = {0};
+    const size_t n = (size_t)(to - *at);
+    *at = to;
+    return !n || fwrite(zeros, 1, n, fp) == n;
+}
+
+GS_API_DECL int32_t
+gs_asset_pack_build(const char* dir, const char* out_path)
+{
+    gs_dyn_array(__gs_asset_pack_build_file_t) files = NULL;
+    __gs_asset_pack_walk(dir, "", out_path, &files);
+    const uint32_t ct = gs_dyn_array_size(files);
+    if (ct) qsort(files, ct, sizeof(__gs_asset_pack_build_file_t), __gs_asset_pack_name_cmp);
+
+    // Names, then data offsets in name order
+    uint64_t names_size = 0;
+    for (uint32_t i = 0; i < ct; ++i) {
+        files[i].name_offset = (uint32_t)names_size;
+        names_size += strlen(files[i].name) + 1;
+    }
+    gs_asset_pack_header_t hdr = {
+        .magic = GS_ASSET_PACK_MAGIC,
+        .version = GS_ASSET_PACK_VERSION,
+        .entry_ct = ct,
+        .names_size = (uint32_t)names_size,
+        .index = sizeof(gs_asset_pack_header_t)
+    };
+    hdr.names = hdr.index + (uint64_t)ct * sizeof(gs_asset_pack_entry_t);
+    uint64_t at = __gs_asset_pack_align(hdr.names + names_size);
+    for (uint32_t i = 0; i < ct; ++i) {
+        files[i].offset = at;
+        at = __gs_asset_pack_align(at + files[i].size);
+    }
+    hdr.size = at;
+
+    gs_asset_pack_entry_t* entries = gs_malloc(gs_max(ct, 1) * sizeof(gs_asset_pack_entry_t));
+    for (uint32_t i = 0; i < ct; ++i) {
+        entries[i] = (gs_asset_pack_entry_t){
+            .hash = files[i].hash,
+            .offset = files[i].offset,
+            .size = files[i].size,
+            .name = files[i].name_offset,
+            .name_len = (uint32_t)strlen(files[i].name)
+        };
+    }
+    if (ct) qsort(entries, ct, sizeof(gs_asset_pack_entry_t), __gs_asset_pack_entry_cmp);
+
+    bool ok = true;
+    FILE* fp = fopen(out_path, "wb");
+    if (!fp) {
+        gs_println("gs_asset_pack_build: can't write %s", out_path);
+        ok = false;
+    }
+    if (ok)
+    {
+        ok &= fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+        ok &= !ct || fwrite(entries, sizeof(gs_asset_pack_entry_t), ct, fp) == ct;
+        for (uint32_t i = 0; i < ct && ok; ++i) {
+            ok &= fwrite(files[i].name, 1, strlen(files[i].name) + 1, fp) == strlen(files[i].name) + 1;
+        }
+
+        at = hdr.names + names_size;
+        for (uint32_t i = 0; i < ct && ok; ++i)
+        {
+            if (!files[i].size) continue;
+            char path[1024] = gs_default_val();
+            gs_snprintf(path, sizeof(path), "%s/%s", dir, files[i].name);
+            size_t sz = 0;
+            char* data = gs_platform_read_file_contents(path, "rb", &sz);
+            if (!data || sz != files[i].size) {
+                gs_println("gs_asset_pack_build: %s changed or can't be read", path);
+                if (data) gs_free(data);
+                ok = false;
+                break;
+            }
+            ok &= __gs_asset_pack_pad(fp, &at, files[i].offset);
+            ok &= fwrite(data, 1, sz, fp) == sz;
+            at += sz;
+            gs_free(data);
+        }
+        ok &= __gs_asset_pack_pad(fp, &at, hdr.size);
+        ok &= fclose(fp) == 0;
+        if (!ok) remove(out_path);
+    }
+
+    for (uint32_t i = 0; i < ct; ++i) gs_free(files[i].name);
+    gs_dyn_array_free(files);
+    gs_free(entries);
+    return ok ? (int32_t)ct : -1;
+}
+
+#endif // GS_ASSET_PACK_IMPL
+#endif // GS_ASSET_PACK_H
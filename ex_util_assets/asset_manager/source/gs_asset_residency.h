@@ -0,0 +1,394 @@
+#ifndef GS_ASSET_RESIDENCY_H
+#define GS_ASSET_RESIDENCY_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger asset residency implementation like this:
+
+        #define GS_ASSET_RESIDENCY_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_RESIDENCY_IMPL
+        #include "gs_asset_residency.h"
+
+    All other files should just #include "gs_asset_residency.h" without the #define.
+
+    MUST include "gs_asset_async.h" (and everything it relies on) BEFORE this file:
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+        #define GS_ASSET_RESIDENCY_IMPL
+        #include "gs_asset_residency.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Bounded residency for async loaded assets, keeping their gs_asset_t handles:
+
+        * gs_assets_load_resident() is gs_assets_load_async() plus the path and params needed to load the asset
+          again. gs_assets_track_resident() does the same for an asset loaded some other way (like
+          gs_assets_load_watched()).
+        * gs_assets_acquire() / gs_assets_release() count references. Referenced assets are never evicted.
+        * Each asset type gets a byte budget (CPU and GPU, as reported by the async importer's size callback).
+          gs_asset_residency_update() evicts unreferenced assets of every type over its budget, least recently used
+          first. Assets used since the last update count as in use, so nothing drawn this frame is evicted.
+        * Evicted assets are destroyed and zeroed in place. gs_assets_getp_resident() (or gs_assets_use()) on one
+          queues it to load again in the background, into the same handle. Until it is READY again the asset is
+          zeroed, so check gs_assets_ready() before using its contents.
+        * Only types whose importer can destroy assets are evicted (textures, meshes and fonts, not audio).
+
+            gs_asset_residency_init((gs_asset_residency_desc_t){0});
+            gs_asset_residency_set_budget(gs_asset_texture_t, 256 * 1024 * 1024);
+            gs_asset_t tex = gs_assets_load_resident(&gsa, gs_asset_texture_t, "./assets/champ.png");
+
+            // Every frame
+            gs_asset_residency_update();
+            gs_assets_async_update(&gcb);
+            gs_asset_texture_t* tp = gs_assets_getp_resident(&gsa, gs_asset_texture_t, tex);
+            if (gs_assets_ready(&gsa, tex)) gsi_texture(&gsi, tp->hndl);
+
+            // Shutdown order: residency first, it queues async loads
+            gs_asset_residency_shutdown();
+            gs_assets_async_shutdown();
+*/
+
+/*==== Interface ====*/
+
+typedef struct gs_asset_residency_desc_t
+{
+    size_t default_budget;      // Bytes per type without gs_asset_residency_set_budget(), 0 for unlimited
+} gs_asset_residency_desc_t;
+
+typedef struct gs_asset_residency_stats_t
+{
+    size_t budget;
+    size_t resident_bytes;
+    uint32_t resident_ct;
+    uint32_t evicted_ct;        // Currently evicted
+    uint64_t evictions;         // Totals since init
+    uint64_t reloads;
+} gs_asset_residency_stats_t;
+
+// Optional, called with defaults by the first tracked asset otherwise
+GS_API_DECL void
+gs_asset_residency_init(gs_asset_residency_desc_t desc);
+
+GS_API_DECL void
+gs_asset_residency_shutdown();
+
+// 0 for unlimited
+GS_API_DECL void
+gs_asset_residency_set_budget_func(uint64_t type_id, size_t budget);
+
+#define gs_asset_residency_set_budget(__T, __BYTES)\
+    gs_asset_residency_set_budget_func(gs_hash_str64(gs_to_str(__T)), (__BYTES))
+
+// As of the last gs_asset_residency_update()
+GS_API_DECL gs_asset_residency_stats_t
+gs_asset_residency_stats_func(uint64_t type_id);
+
+#define gs_asset_residency_stats(__T)\
+    gs_asset_residency_stats_func(gs_hash_str64(gs_to_str(__T)))
+
+GS_API_DECL void
+gs_assets_track_resident_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params);
+
+#define gs_assets_track_resident(__AM, __T, __HNDL, __PATH, ...)\
+    gs_assets_track_resident_func((__AM), gs_hash_str64(gs_to_str(__T)), (__HNDL), (__PATH),\
+        &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+GS_API_DECL gs_asset_t
+gs_assets_load_resident_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params);
+
+#define gs_assets_load_resident(__AM, __T, __PATH, ...)\
+    gs_assets_load_resident_func((__AM), gs_hash_str64(gs_to_str(__T)), gs_assets_create_asset((__AM), __T, &(__T){0}),\
+        (__PATH), &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+// Both return the new reference count. Acquiring an evicted asset loads it again.
+GS_API_DECL uint32_t
+gs_assets_acquire(gs_asset_manager_t* am, gs_asset_t asset);
+
+GS_API_DECL uint32_t
+gs_assets_release(gs_asset_manager_t* am, gs_asset_t asset);
+
+GS_API_DECL uint32_t
+gs_assets_refcount(gs_asset_manager_t* am, gs_asset_t asset);
+
+// Marks the asset used for LRU and queues an evicted one to load again, returns its status
+GS_API_DECL gs_asset_status
+gs_assets_use(gs_asset_manager_t* am, gs_asset_t asset);
+
+#define gs_assets_getp_resident(__AM, __T, __HNDL)\
+    (gs_assets_use((__AM), (__HNDL)), gs_assets_getp((__AM), __T, (__HNDL)))
+
+// Once per frame before gs_assets_async_update(), returns how many assets were evicted
+GS_API_DECL uint32_t
+gs_asset_residency_update();
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_RESIDENCY_IMPL
+
+typedef struct __gs_asset_resident_t
+{
+    gs_asset_manager_t* am;
+    uint64_t type_id;
+    gs_asset_t asset;
+    char* path;
+    __gs_asset_async_params_t params;
+    uint32_t refs;
+    uint64_t last_used;
+} __gs_asset_resident_t;
+
+typedef struct __gs_asset_residency_t
+{
+    bool initialized;
+    size_t default_budget;
+    gs_hash_table(uint64_t, __gs_asset_resident_t*) residents;     // By async key
+    gs_hash_table(uint64_t, gs_asset_residency_stats_t) types;
+    gs_dyn_array(__gs_asset_resident_t*) candidates;               // Scratch for update
+    uint64_t tick;                                                  // Bumped on every use
+    uint64_t update_tick;                                           // Tick at the last update
+} __gs_asset_residency_t;
+
+static __gs_asset_residency_t __gs_asset_residency = {0};
+
+static gs_asset_residency_stats_t*
+__gs_asset_residency_type(uint64_t type_id)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    if (!gs_hash_table_exists(ar->types, type_id)) {
+        gs_asset_residency_stats_t stats = gs_default_val();
+        stats.budget = ar->default_budget;
+        gs_hash_table_insert(ar->types, type_id, stats);
+    }
+    return gs_hash_table_getp(ar->types, type_id);
+}
+
+static __gs_asset_resident_t*
+__gs_asset_residency_find(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    return gs_hash_table_exists(ar->residents, key) ? gs_hash_table_get(ar->residents, key) : NULL;
+}
+
+GS_API_DECL void
+gs_asset_residency_init(gs_asset_residency_desc_t desc)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    if (ar->initialized) return;
+    ar->initialized = true;
+    ar->default_budget = desc.default_budget;
+}
+
+GS_API_DECL void
+gs_asset_residency_shutdown()
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    if (!ar->initialized) return;
+
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(ar->residents);
+        gs_hash_table_iter_valid(ar->residents, it);
+        gs_hash_table_iter_advance(ar->residents, it)
+    )
+    {
+        __gs_asset_resident_t* r = gs_hash_table_iter_get(ar->residents, it);
+        __gs_asset_async_params_free(&r->params);
+        gs_free(r->path);
+        gs_free(r);
+    }
+    gs_hash_table_free(ar->residents);
+    gs_hash_table_free(ar->types);
+    gs_dyn_array_free(ar->candidates);
+    memset(ar, 0, sizeof(__gs_asset_residency_t));
+}
+
+GS_API_DECL void
+gs_asset_residency_set_budget_func(uint64_t type_id, size_t budget)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    if (!ar->initialized) gs_asset_residency_init((gs_asset_residency_desc_t){0});
+    __gs_asset_residency_type(type_id)->budget = budget;
+}
+
+GS_API_DECL gs_asset_residency_stats_t
+gs_asset_residency_stats_func(uint64_t type_id)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    if (!ar->initialized || !gs_hash_table_exists(ar->types, type_id)) {
+        gs_asset_residency_stats_t stats = gs_default_val();
+        stats.budget = ar->default_budget;
+        return stats;
+    }
+    return gs_hash_table_get(ar->types, type_id);
+}
+
+GS_API_DECL void
+gs_assets_track_resident_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    if (!ar->initialized) gs_asset_residency_init((gs_asset_residency_desc_t){0});
+
+    if (__gs_asset_residency_find(am, asset)) {
+        gs_println("gs_assets_track_resident: %s is already tracked", path);
+        return;
+    }
+
+    __gs_asset_resident_t* r = gs_malloc(sizeof(__gs_asset_resident_t));
+    memset(r, 0, sizeof(__gs_asset_resident_t));
+    r->am = am;
+    r->type_id = type_id;
+    r->asset = asset;
+    const size_t path_len = strlen(path);
+    r->path = gs_malloc(path_len + 1);
+    memcpy(r->path, path, path_len + 1);
+    __gs_asset_async_params_copy(&r->params, params);
+    r->last_used = ++ar->tick;
+
+    gs_hash_table_insert(ar->residents, __gs_asset_async_key(am, asset), r);
+    __gs_asset_residency_type(type_id);
+}
+
+GS_API_DECL gs_asset_t
+gs_assets_load_resident_func(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t asset, const char* path,
+    const gs_asset_load_params_t* params)
+{
+    gs_assets_load_async_func(am, type_id, asset, path, params);
+    gs_assets_track_resident_func(am, type_id, asset, path, params);
+    return asset;
+}
+
+GS_API_DECL gs_asset_status
+gs_assets_use(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    __gs_asset_resident_t* r = ar->initialized ? __gs_asset_residency_find(am, asset) : NULL;
+    if (!r) return gs_assets_status(am, asset);
+
+    r->last_used = ++ar->tick;
+    gs_asset_status status = gs_assets_status(am, asset);
+    if (status == GS_ASSET_STATUS_EVICTED)
+    {
+        gs_assets_load_async_func(am, r->type_id, asset, r->path, &r->params.params);
+        __gs_asset_residency_type(r->type_id)->reloads++;
+        status = gs_assets_status(am, asset);
+    }
+    return status;
+}
+
+GS_API_DECL uint32_t
+gs_assets_acquire(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    __gs_asset_resident_t* r = ar->initialized ? __gs_asset_residency_find(am, asset) : NULL;
+    if (!r) {
+        gs_println("gs_assets_acquire: asset isn't tracked for residency");
+        return 0;
+    }
+    gs_assets_use(am, asset);
+    return ++r->refs;
+}
+
+GS_API_DECL uint32_t
+gs_assets_release(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    __gs_asset_resident_t* r = ar->initialized ? __gs_asset_residency_find(am, asset) : NULL;
+    if (!r || !r->refs) {
+        gs_println("gs_assets_release: asset isn't acquired");
+        return 0;
+    }
+    // Eviction picks it up from here, least recently released first
+    r->last_used = ++ar->tick;
+    return --r->refs;
+}
+
+GS_API_DECL uint32_t
+gs_assets_refcount(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    __gs_asset_resident_t* r = ar->initialized ? __gs_asset_residency_find(am, asset) : NULL;
+    return r ? r->refs : 0;
+}
+
+static int32_t
+__gs_asset_residency_lru_cmp(const void* a, const void* b)
+{
+    const uint64_t la = (*(const __gs_asset_resident_t**)a)->last_used;
+    const uint64_t lb = (*(const __gs_asset_resident_t**)b)->last_used;
+    return la < lb ? -1 : la > lb ? 1 : 0;
+}
+
+GS_API_DECL uint32_t
+gs_asset_residency_update()
+{
+    __gs_asset_residency_t* ar = &__gs_asset_residency;
+    if (!ar->initialized) return 0;
+
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(ar->types);
+        gs_hash_table_iter_valid(ar->types, it);
+        gs_hash_table_iter_advance(ar->types, it)
+    )
+    {
+        gs_asset_residency_stats_t* stats = gs_hash_table_iter_getp(ar->types, it);
+        stats->resident_bytes = 0;
+        stats->resident_ct = 0;
+        stats->evicted_ct = 0;
+    }
+
+    // Tally every type, and gather what could go from those over budget
+    gs_dyn_array_clear(ar->candidates);
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(ar->residents);
+        gs_hash_table_iter_valid(ar->residents, it);
+        gs_hash_table_iter_advance(ar->residents, it)
+    )
+    {
+        __gs_asset_resident_t* r = gs_hash_table_iter_get(ar->residents, it);
+        gs_asset_residency_stats_t* stats = gs_hash_table_getp(ar->types, r->type_id);
+        const gs_asset_status status = gs_assets_status(r->am, r->asset);
+        if (status == GS_ASSET_STATUS_EVICTED) stats->evicted_ct++;
+        if (status != GS_ASSET_STATUS_READY) continue;
+
+        stats->resident_bytes += gs_assets_async_bytes(r->am, r->asset);
+        stats->resident_ct++;
+        if (!r->refs && r->last_used <= ar->update_tick) gs_dyn_array_push(ar->candidates, r);
+    }
+
+    uint32_t evicted = 0;
+    const uint32_t ct = gs_dyn_array_size(ar->candidates);
+    if (ct) qsort(ar->candidates, ct, sizeof(__gs_asset_resident_t*), __gs_asset_residency_lru_cmp);
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        __gs_asset_resident_t* r = ar->candidates[i];
+        gs_asset_residency_stats_t* stats = gs_hash_table_getp(ar->types, r->type_id);
+        if (!stats->budget || stats->resident_bytes <= stats->budget) continue;
+
+        const size_t bytes = gs_assets_async_bytes(r->am, r->asset);
+        if (!gs_assets_async_unload(r->am, r->asset)) continue;
+        stats->resident_bytes -= bytes;
+        stats->resident_ct--;
+        stats->evicted_ct++;
+        stats->evictions++;
+        evicted++;
+    }
+
+    ar->update_tick = ar->tick;
+    return evicted;
+}
+
+#endif // GS_ASSET_RESIDENCY_IMPL
+#endif // GS_ASSET_RESIDENCY_H
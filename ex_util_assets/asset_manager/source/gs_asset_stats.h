@@ -0,0 +1,507 @@
+#ifndef GS_ASSET_STATS_H
+#define GS_ASSET_STATS_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger asset stats implementation like this:
+
+        #define GS_ASSET_STATS_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_STATS_IMPL
+        #include "gs_asset_stats.h"
+
+    All other files should just #include "gs_asset_stats.h" without the #define.
+
+    MUST include "gs_asset_async.h" (and everything it relies on) BEFORE this file, in the same file as its
+    implementation. gs_asset_stats_window() is only declared when gs_gui.h is included before this file:
+
+        #define GS_GUI_IMPL
+        #include <gs/util/gs_gui.h>
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+        #define GS_ASSET_STATS_IMPL
+        #include "gs_asset_stats.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Statistics for async loaded assets, to see what is taking memory and what is slow to load:
+
+        * gs_asset_stats_capture() snapshots every asset loaded through gs_asset_async.h (of one manager, or all of
+          them with NULL): its type, source path, status, bytes and how long each step of its load took.
+        * Per type: how many assets are ready, loading, failed and evicted, their bytes (CPU and GPU, as reported
+          by the importer's size callback) and load times. With gs_asset_residency.h included before this file,
+          each type's residency budget too.
+        * Load times are wall clock: queued (waiting for a worker), decode (on the worker) and finalize (decoded
+          until gs_assets_async_update() finished it, waiting for the update included). Loads decoded in one
+          batch each report the whole batch's decode time.
+        * Snapshots are plain data, sorted by bytes (types) and by load time (assets). They can be written as JSON
+          or CSV, or shown live in a gs_gui window.
+
+            gs_asset_stats_t stats = gs_asset_stats_capture(&gsa);
+            gs_asset_stats_write_json(&stats, "./asset_stats.json");
+            gs_asset_stats_write_csv(&stats, "-");      // stdout
+            gs_asset_stats_free(&stats);
+
+            // Every frame, between gs_gui_begin() and gs_gui_end()
+            gs_asset_stats_window(&gui, &gsa, gs_gui_rect(10, 10, 480, 360));
+
+        * Only async loads are tracked. Synchronous gs_assets_load_from_file() and gs_assets_create_asset() assets
+          live in gs_asset_manager_t and don't go through gs_asset_async.h. Textures streamed by
+          gs_asset_texture_stream.h aren't either.
+        * Main thread only, like the rest of gs_asset_async.h.
+*/
+
+/*==== Interface ====*/
+
+typedef struct gs_asset_stats_type_t
+{
+    uint64_t type_id;
+    char name[64];              // Type name given to gs_assets_register_async_importer(), hex id otherwise
+    uint32_t ready_ct;
+    uint32_t loading_ct;        // Queued, decoding or decoded
+    uint32_t failed_ct;
+    uint32_t evicted_ct;
+    size_t bytes;               // Of READY assets
+    size_t budget;              // Residency budget, 0 for unlimited (or without gs_asset_residency.h)
+    double load_ms;             // Summed over finished loads, queued until done
+    double decode_ms;
+    double max_load_ms;
+} gs_asset_stats_type_t;
+
+typedef struct gs_asset_stats_asset_t
+{
+    gs_asset_manager_t* am;
+    gs_asset_t asset;
+    uint64_t type_id;
+    uint32_t type;              // Index into gs_asset_stats_t.types
+    gs_asset_status status;
+    size_t bytes;               // 0 unless READY
+    double queue_ms;            // Queued until a worker started decoding
+    double decode_ms;           // On the worker
+    double finalize_ms;         // Decoded until done
+    double load_ms;             // Queued until done, or until the capture while loading
+    char* path;                 // Owned by the snapshot
+} gs_asset_stats_asset_t;
+
+typedef struct gs_asset_stats_t
+{
+    gs_dyn_array(gs_asset_stats_type_t) types;      // Most bytes first
+    gs_dyn_array(gs_asset_stats_asset_t) assets;    // Slowest load first
+    uint32_t ready_ct;
+    uint32_t loading_ct;
+    uint32_t failed_ct;
+    uint32_t evicted_ct;
+    size_t bytes;
+    double load_ms;
+} gs_asset_stats_t;
+
+// am NULL for the assets of every manager
+GS_API_DECL gs_asset_stats_t
+gs_asset_stats_capture(gs_asset_manager_t* am);
+
+GS_API_DECL void
+gs_asset_stats_free(gs_asset_stats_t* stats);
+
+GS_API_DECL const char*
+gs_asset_stats_status_name(gs_asset_status status);
+
+// path "-" writes to stdout. Return false if the file can't be written.
+GS_API_DECL bool
+gs_asset_stats_write_json(const gs_asset_stats_t* stats, const char* path);
+
+// One row per asset: type,path,status,bytes,queue_ms,decode_ms,finalize_ms,load_ms
+GS_API_DECL bool
+gs_asset_stats_write_csv(const gs_asset_stats_t* stats, const char* path);
+
+#ifdef GS_GUI_H
+// Captures am (NULL for all managers) and shows totals, types and the slowest and largest assets. Window begin/end
+// included, so call it between gs_gui_begin() and gs_gui_end().
+GS_API_DECL void
+gs_asset_stats_window(gs_gui_context_t* gui, gs_asset_manager_t* am, gs_gui_rect_t rect);
+#endif
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_STATS_IMPL
+
+#include <stdio.h>
+
+#define GS_ASSET_STATS_WINDOW_ROWS      8       // Slowest and largest assets listed in gs_asset_stats_window()
+
+static double
+__gs_asset_stats_ms(double from, double to)
+{
+    return from > 0.0 && to >= from ? (to - from) * 1e3 : 0.0;
+}
+
+static int
+__gs_asset_stats_cmp_type(const void* a, const void* b)
+{
+    const gs_asset_stats_type_t* ta = (const gs_asset_stats_type_t*)a;
+    const gs_asset_stats_type_t* tb = (const gs_asset_stats_type_t*)b;
+    if (ta->bytes != tb->bytes) return ta->bytes > tb->bytes ? -1 : 1;
+    return strcmp(ta->name, tb->name);
+}
+
+static int
+__gs_asset_stats_cmp_asset(const void* a, const void* b)
+{
+    const gs_asset_stats_asset_t* aa = (const gs_asset_stats_asset_t*)a;
+    const gs_asset_stats_asset_t* ab = (const gs_asset_stats_asset_t*)b;
+    if (aa->load_ms != ab->load_ms) return aa->load_ms > ab->load_ms ? -1 : 1;
+    return strcmp(aa->path, ab->path);
+}
+
+static int
+__gs_asset_stats_cmp_bytes(const void* a, const void* b)
+{
+    const gs_asset_stats_asset_t* aa = *(const gs_asset_stats_asset_t* const*)a;
+    const gs_asset_stats_asset_t* ab = *(const gs_asset_stats_asset_t* const*)b;
+    if (aa->bytes != ab->bytes) return aa->bytes > ab->bytes ? -1 : 1;
+    return strcmp(aa->path, ab->path);
+}
+
+static gs_asset_stats_type_t
+__gs_asset_stats_type(uint64_t type_id)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    gs_asset_stats_type_t type = gs_default_val();
+    type.type_id = type_id;
+    if (gs_hash_table_exists(aa->type_names, type_id)) {
+        gs_snprintf(type.name, sizeof(type.name), "%s", gs_hash_table_getp(aa->type_names, type_id)->name);
+    }
+    else {
+        gs_snprintf(type.name, sizeof(type.name), "0x%016llx", (unsigned long long)type_id);
+    }
+#ifdef GS_ASSET_RESIDENCY_H
+    type.budget = gs_asset_residency_stats_func(type_id).budget;
+#endif
+    return type;
+}
+
+GS_API_DECL gs_asset_stats_t
+gs_asset_stats_capture(gs_asset_manager_t* am)
+{
+    __gs_asset_async_t* aa = &__gs_asset_async;
+    gs_asset_stats_t stats = gs_default_val();
+    if (!aa->initialized) return stats;
+
+    gs_hash_table(uint64_t, uint32_t) index = NULL;
+    const double now = __gs_asset_async_now();
+
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(aa->requests);
+        gs_hash_table_iter_valid(aa->requests, it);
+        gs_hash_table_iter_advance(aa->requests, it)
+    )
+    {
+        __gs_asset_async_request_t* req = gs_hash_table_iter_get(aa->requests, it);
+        if (am && req->am != am) continue;
+
+        // Workers write the decode times and bytes before publishing the status that makes them readable
+        const uint32_t status = gs_atomic_load_acq_u32(&req->status);
+        const bool decoding = status != GS_ASSET_STATUS_QUEUED;
+        const bool decoded = decoding && status != GS_ASSET_STATUS_DECODING;
+
+        gs_asset_stats_asset_t a = gs_default_val();
+        a.am = req->am;
+        a.asset = req->asset;
+        a.type_id = req->type_id;
+        a.status = (gs_asset_status)status;
+        a.bytes = status == GS_ASSET_STATUS_READY ? req->bytes : 0;
+        a.queue_ms = __gs_asset_stats_ms(req->queued, decoding ? req->decode_begin : now);
+        a.decode_ms = decoding ? __gs_asset_stats_ms(req->decode_begin, decoded ? req->decode_end : now) : 0.0;
+        a.finalize_ms = decoded ? __gs_asset_stats_ms(req->decode_end, req->done ? req->finished : now) : 0.0;
+        a.load_ms = __gs_asset_stats_ms(req->queued, req->done ? req->finished : now);
+
+        const char* path = req->path ? req->path : "";
+        const size_t len = strlen(path);
+        a.path = gs_malloc(len + 1);
+        memcpy(a.path, path, len + 1);
+
+        if (!gs_hash_table_exists(index, req->type_id)) {
+            gs_hash_table_insert(index, req->type_id, gs_dyn_array_size(stats.types));
+            gs_dyn_array_push(stats.types, __gs_asset_stats_type(req->type_id));
+        }
+        a.type = gs_hash_table_get(index, req->type_id);
+        gs_asset_stats_type_t* type = &stats.types[a.type];
+        switch (a.status)
+        {
+            case GS_ASSET_STATUS_READY:   type->ready_ct++;   break;
+            case GS_ASSET_STATUS_FAILED:  type->failed_ct++;  break;
+            case GS_ASSET_STATUS_EVICTED: type->evicted_ct++; break;
+            default:                      type->loading_ct++; break;
+        }
+        type->bytes += a.bytes;
+        if (req->done) {
+            type->load_ms += a.load_ms;
+            type->decode_ms += a.decode_ms;
+            type->max_load_ms = gs_max(type->max_load_ms, a.load_ms);
+        }
+
+        gs_dyn_array_push(stats.assets, a);
+    }
+    gs_hash_table_free(index);
+
+    for (uint32_t i = 0; i < gs_dyn_array_size(stats.types); ++i)
+    {
+        const gs_asset_stats_type_t* type = &stats.types[i];
+        stats.ready_ct += type->ready_ct;
+        stats.loading_ct += type->loading_ct;
+        stats.failed_ct += type->failed_ct;
+        stats.evicted_ct += type->evicted_ct;
+        stats.bytes += type->bytes;
+        stats.load_ms += type->load_ms;
+    }
+
+    // Assets refer to their type by index, so remap them after sorting the types
+    const uint32_t type_ct = gs_dyn_array_size(stats.types);
+    if (type_ct > 1)
+    {
+        qsort(stats.types, type_ct, sizeof(gs_asset_stats_type_t), __gs_asset_stats_cmp_type);
+        gs_hash_table(uint64_t, uint32_t) sorted = NULL;
+        for (uint32_t i = 0; i < type_ct; ++i) gs_hash_table_insert(sorted, stats.types[i].type_id, i);
+        for (uint32_t i = 0; i < gs_dyn_array_size(stats.assets); ++i) {
+            stats.assets[i].type = gs_hash_table_get(sorted, stats.assets[i].type_id);
+        }
+        gs_hash_table_free(sorted);
+    }
+    if (gs_dyn_array_size(stats.assets) > 1) {
+        qsort(stats.assets, gs_dyn_array_size(stats.assets), sizeof(gs_asset_stats_asset_t), __gs_asset_stats_cmp_asset);
+    }
+
+    return stats;
+}
+
+GS_API_DECL void
+gs_asset_stats_free(gs_asset_stats_t* stats)
+{
+    for (uint32_t i = 0; i < gs_dyn_array_size(stats->assets); ++i) gs_free(stats->assets[i].path);
+    gs_dyn_array_free(stats->assets);
+    gs_dyn_array_free(stats->types);
+    memset(stats, 0, sizeof(gs_asset_stats_t));
+}
+
+GS_API_DECL const char*
+gs_asset_stats_status_name(gs_asset_status status)
+{
+    switch (status)
+    {
+        case GS_ASSET_STATUS_QUEUED:   return "queued";
+        case GS_ASSET_STATUS_DECODING: return "decoding";
+        case GS_ASSET_STATUS_DECODED:  return "decoded";
+        case GS_ASSET_STATUS_READY:    return "ready";
+        case GS_ASSET_STATUS_FAILED:   return "failed";
+        case GS_ASSET_STATUS_EVICTED:  return "evicted";
+        default:                       return "none";
+    }
+}
+
+static FILE*
+__gs_asset_stats_open(const char* path)
+{
+    if (strcmp(path, "-") == 0) return stdout;
+    FILE* fp = fopen(path, "w");
+    if (!fp) gs_println("gs_asset_stats: can't write %s", path);
+    return fp;
+}
+
+static bool
+__gs_asset_stats_close(FILE* fp)
+{
+    if (fp == stdout) return fflush(fp) == 0;
+    return fclose(fp) == 0;
+}
+
+static void
+__gs_asset_stats_json_str(FILE* fp, const char* str)
+{
+    fputc('"', fp);
+    for (const char* c = str; *c; ++c)
+    {
+        switch (*c)
+        {
+            case '"':  fputs("\\\"", fp); break;
+            case '\\': fputs("\\\\", fp); break;
+            case '\n': fputs("\\n", fp);  break;
+            case '\r': fputs("\\r", fp);  break;
+            case '\t': fputs("\\t", fp);  break;
+            default:
+            {
+                if ((uint8_t)*c < 0x20) fprintf(fp, "\\u%04x", (uint32_t)(uint8_t)*c);
+                else fputc(*c, fp);
+            } break;
+        }
+    }
+    fputc('"', fp);
+}
+
+static void
+__gs_asset_stats_csv_str(FILE* fp, const char* str)
+{
+    if (!strpbrk(str, ",\"\n\r")) {
+        fputs(str, fp);
+        return;
+    }
+    fputc('"', fp);
+    for (const char* c = str; *c; ++c)
+    {
+        if (*c == '"') fputc('"', fp);
+        fputc(*c, fp);
+    }
+    fputc('"', fp);
+}
+
+GS_API_DECL bool
+gs_asset_stats_write_json(const gs_asset_stats_t* stats, const char* path)
+{
+    FILE* fp = __gs_asset_stats_open(path);
+    if (!fp) return false;
+
+    fprintf(fp, "{\n  \"totals\": {\"ready\": %u, \"loading\": %u, \"failed\": %u, \"evicted\": %u, "
+        "\"bytes\": %llu, \"load_ms\": %.3f},\n", stats->ready_ct, stats->loading_ct, stats->failed_ct,
+        stats->evicted_ct, (unsigned long long)stats->bytes, stats->load_ms);
+
+    fprintf(fp, "  \"types\": [\n");
+    for (uint32_t i = 0; i < gs_dyn_array_size(stats->types); ++i)
+    {
+        const gs_asset_stats_type_t* t = &stats->types[i];
+        fprintf(fp, "    {\"name\": ");
+        __gs_asset_stats_json_str(fp, t->name);
+        fprintf(fp, ", \"ready\": %u, \"loading\": %u, \"failed\": %u, \"evicted\": %u, \"bytes\": %llu, "
+            "\"budget\": %llu, \"load_ms\": %.3f, \"decode_ms\": %.3f, \"max_load_ms\": %.3f}%s\n",
+            t->ready_ct, t->loading_ct, t->failed_ct, t->evicted_ct, (unsigned long long)t->bytes,
+            (unsigned long long)t->budget, t->load_ms, t->decode_ms, t->max_load_ms,
+            i + 1 < gs_dyn_array_size(stats->types) ? "," : "");
+    }
+    fprintf(fp, "  ],\n  \"assets\": [\n");
+    for (uint32_t i = 0; i < gs_dyn_array_size(stats->assets); ++i)
+    {
+        const gs_asset_stats_asset_t* a = &stats->assets[i];
+        fprintf(fp, "    {\"type\": ");
+        __gs_asset_stats_json_str(fp, stats->types[a->type].name);
+        fprintf(fp, ", \"path\": ");
+        __gs_asset_stats_json_str(fp, a->path);
+        fprintf(fp, ", \"status\": \"%s\", \"bytes\": %llu, \"queue_ms\": %.3f, \"decode_ms\": %.3f, "
+            "\"finalize_ms\": %.3f, \"load_ms\": %.3f}%s\n", gs_asset_stats_status_name(a->status),
+            (unsigned long long)a->bytes, a->queue_ms, a->decode_ms, a->finalize_ms, a->load_ms,
+            i + 1 < gs_dyn_array_size(stats->assets) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+
+    return __gs_asset_stats_close(fp);
+}
+
+GS_API_DECL bool
+gs_asset_stats_write_csv(const gs_asset_stats_t* stats, const char* path)
+{
+    FILE* fp = __gs_asset_stats_open(path);
+    if (!fp) return false;
+
+    fprintf(fp, "type,path,status,bytes,queue_ms,decode_ms,finalize_ms,load_ms\n");
+    for (uint32_t i = 0; i < gs_dyn_array_size(stats->assets); ++i)
+    {
+        const gs_asset_stats_asset_t* a = &stats->assets[i];
+        __gs_asset_stats_csv_str(fp, stats->types[a->type].name);
+        fputc(',', fp);
+        __gs_asset_stats_csv_str(fp, a->path);
+        fprintf(fp, ",%s,%llu,%.3f,%.3f,%.3f,%.3f\n", gs_asset_stats_status_name(a->status),
+            (unsigned long long)a->bytes, a->queue_ms, a->decode_ms, a->finalize_ms, a->load_ms);
+    }
+
+    return __gs_asset_stats_close(fp);
+}
+
+#ifdef GS_GUI_H
+
+static void
+__gs_asset_stats_bytes_str(char* buf, size_t sz, size_t bytes)
+{
+    if (bytes >= 1024 * 1024) gs_snprintf(buf, sz, "%.1f MB", (double)bytes / (1024.0 * 1024.0));
+    else if (bytes >= 1024) gs_snprintf(buf, sz, "%.1f KB", (double)bytes / 1024.0);
+    else gs_snprintf(buf, sz, "%zu B", bytes);
+}
+
+GS_API_DECL void
+gs_asset_stats_window(gs_gui_context_t* gui, gs_asset_manager_t* am, gs_gui_rect_t rect)
+{
+    gs_asset_stats_t stats = gs_asset_stats_capture(am);
+    char bytes[32] = gs_default_val();
+    char budget[32] = gs_default_val();
+
+    gs_gui_window_begin(gui, "Asset Stats", rect);
+    {
+        __gs_asset_stats_bytes_str(bytes, sizeof(bytes), stats.bytes);
+        gs_gui_layout_row(gui, 1, (int[]){-1}, 0);
+        gs_gui_label(gui, "%u ready, %u loading, %u failed, %u evicted, %s", stats.ready_ct, stats.loading_ct,
+            stats.failed_ct, stats.evicted_ct, bytes);
+
+        gs_gui_layout_row(gui, 5, (int[]){150, 70, 90, 90, -1}, 0);
+        gs_gui_label(gui, "type");
+        gs_gui_label(gui, "ready");
+        gs_gui_label(gui, "bytes");
+        gs_gui_label(gui, "budget");
+        gs_gui_label(gui, "avg / max ms");
+        for (uint32_t i = 0; i < gs_dyn_array_size(stats.types); ++i)
+        {
+            const gs_asset_stats_type_t* t = &stats.types[i];
+            const uint32_t done = t->ready_ct + t->failed_ct + t->evicted_ct;
+            __gs_asset_stats_bytes_str(bytes, sizeof(bytes), t->bytes);
+            if (t->budget) __gs_asset_stats_bytes_str(budget, sizeof(budget), t->budget);
+            else gs_snprintf(budget, sizeof(budget), "-");
+
+            gs_gui_label(gui, "%s", t->name);
+            gs_gui_label(gui, "%u/%u", t->ready_ct, done + t->loading_ct);
+            gs_gui_label(gui, "%s", bytes);
+            gs_gui_label(gui, "%s", budget);
+            gs_gui_label(gui, "%.1f / %.1f", done ? t->load_ms / done : 0.0, t->max_load_ms);
+        }
+
+        // Already slowest first
+        const uint32_t ct = gs_min(gs_dyn_array_size(stats.assets), GS_ASSET_STATS_WINDOW_ROWS);
+        gs_gui_layout_row(gui, 1, (int[]){-1}, 0);
+        gs_gui_label(gui, "Slowest loads");
+        gs_gui_layout_row(gui, 3, (int[]){80, 80, -1}, 0);
+        for (uint32_t i = 0; i < ct; ++i)
+        {
+            const gs_asset_stats_asset_t* a = &stats.assets[i];
+            gs_gui_label(gui, "%.1f ms", a->load_ms);
+            gs_gui_label(gui, "%s", gs_asset_stats_status_name(a->status));
+            gs_gui_label(gui, "%s", a->path);
+        }
+
+        gs_asset_stats_asset_t** largest = gs_malloc(gs_max(gs_dyn_array_size(stats.assets), 1) * sizeof(void*));
+        for (uint32_t i = 0; i < gs_dyn_array_size(stats.assets); ++i) largest[i] = &stats.assets[i];
+        qsort(largest, gs_dyn_array_size(stats.assets), sizeof(void*), __gs_asset_stats_cmp_bytes);
+
+        gs_gui_layout_row(gui, 1, (int[]){-1}, 0);
+        gs_gui_label(gui, "Largest assets");
+        gs_gui_layout_row(gui, 3, (int[]){80, 80, -1}, 0);
+        for (uint32_t i = 0; i < ct && largest[i]->bytes; ++i)
+        {
+            __gs_asset_stats_bytes_str(bytes, sizeof(bytes), largest[i]->bytes);
+            gs_gui_label(gui, "%s", bytes);
+            gs_gui_label(gui, "%s", stats.types[largest[i]->type].name);
+            gs_gui_label(gui, "%s", largest[i]->path);
+        }
+        gs_free(largest);
+    }
+    gs_gui_window_end(gui);
+
+    gs_asset_stats_free(&stats);
+}
+
+#endif // GS_GUI_H
+
+#endif // GS_ASSET_STATS_IMPL
+#endif // GS_ASSET_STATS_H
@@ -0,0 +1,470 @@
+#ifndef GS_ASSET_TEXTURE_STREAM_H
+#define GS_ASSET_TEXTURE_STREAM_H
+
+/*
+    USAGE: (IMPORTANT)
+
+    =================================================================================================================
+
+    Before including, define the gunslinger texture streaming implementation like this:
+
+        #define GS_ASSET_TEXTURE_STREAM_IMPL
+
+    in EXACTLY ONE C or C++ file that includes this header, BEFORE the
+    include, like this:
+
+        #define GS_ASSET_TEXTURE_STREAM_IMPL
+        #include "gs_asset_texture_stream.h"
+
+    All other files should just #include "gs_asset_texture_stream.h" without the #define.
+
+    MUST include "gs_asset_async.h" (and everything it relies on) BEFORE this file:
+
+        #define GS_ASSET_ASYNC_IMPL
+        #include "gs_asset_async.h"
+
+        #define GS_ASSET_TEXTURE_STREAM_IMPL
+        #include "gs_asset_texture_stream.h"
+
+    ================================================================================================================
+*/
+
+/*
+    Streamed textures, sized on the GPU to what is on screen:
+
+        * gs_assets_load_streamed() decodes the image and builds its whole mip chain on the async worker pool. The
+          main thread never decodes or downsamples.
+        * The smallest mip at or under min_size goes up first, so every streamed texture is drawable (blurry) as
+          soon as it has decoded.
+        * Each frame, gs_assets_stream_hint() reports how many pixels a texture covers on screen (the largest
+          hint of the frame wins). gs_asset_texture_stream_update() moves each texture one mip level at a time
+          towards the level that covers its hint, largest hints first, until upload_budget bytes have gone up.
+        * Textures without a hint for idle_frames drop back to their smallest mip, so VRAM follows what is drawn.
+        * Changing level recreates the texture at that mip's size, in place in the same gs_asset_texture_t. Its
+          desc.width/height are the resident mip's. GPU mips below it come from desc.num_mips as usual.
+        * The CPU mip chain stays in memory, so paging a level back in is an upload, not a decode.
+
+            gs_asset_t tex = gs_assets_load_streamed(&gsa, "./assets/terrain.png");
+
+            // Every frame
+            gs_assets_async_update(&gcb);
+            gs_asset_texture_stream_update(&gcb);
+
+            // While drawing
+            gs_assets_stream_hint(&gsa, tex, gs_asset_texture_stream_screen_size(2.f, dist, 60.f, fb.y));
+            if (gs_assets_stream_ready(&gsa, tex)) gsi_texture(&gsi, gs_assets_getp(&gsa, gs_asset_texture_t, tex)->hndl);
+
+            // Shutdown order: streams first, they decode on the async pool
+            gs_asset_texture_stream_shutdown();
+            gs_assets_async_shutdown();
+*/
+
+/*==== Interface ====*/
+
+#define GS_ASSET_TEXTURE_STREAM_MAX_LEVELS      16
+
+typedef struct gs_asset_texture_stream_desc_t
+{
+    size_t upload_budget;       // Bytes uploaded per gs_asset_texture_stream_update(), 4MB if 0
+    uint32_t min_size;          // Largest side of the first mip uploaded, 32 if 0
+    uint32_t idle_frames;       // Updates without a hint before a texture drops to its first mip, 120 if 0
+} gs_asset_texture_stream_desc_t;
+
+typedef struct gs_asset_texture_stream_info_t
+{
+    gs_asset_status status;     // READY once the first mip is up
+    uint32_t width;             // Full resolution
+    uint32_t height;
+    uint32_t level_ct;
+    uint32_t resident_level;    // level_ct while nothing is uploaded
+    uint32_t desired_level;
+} gs_asset_texture_stream_info_t;
+
+typedef struct gs_asset_texture_stream_stats_t
+{
+    uint32_t texture_ct;
+    uint32_t streaming_ct;      // Not at their desired level yet
+    size_t resident_bytes;      // Resident levels, without GPU generated mips
+    size_t uploaded_bytes;      // During the last update
+} gs_asset_texture_stream_stats_t;
+
+// Optional, called with defaults by the first streamed load otherwise
+GS_API_DECL void
+gs_asset_texture_stream_init(gs_asset_texture_stream_desc_t desc);
+
+GS_API_DECL void
+gs_asset_texture_stream_shutdown();
+
+GS_API_DECL gs_asset_t
+gs_assets_load_streamed_func(gs_asset_manager_t* am, gs_asset_t asset, const char* path, const gs_asset_load_params_t* params);
+
+// Optional params as with gs_assets_load_async(): .texture_desc, .flip_on_load
+#define gs_assets_load_streamed(__AM, __PATH, ...)\
+    gs_assets_load_streamed_func((__AM), gs_assets_create_asset((__AM), gs_asset_texture_t, &(gs_asset_texture_t){0}),\
+        (__PATH), &(gs_asset_load_params_t){0, __VA_ARGS__})
+
+// Pixels the texture covers on screen along its largest side this frame
+GS_API_DECL void
+gs_assets_stream_hint(gs_asset_manager_t* am, gs_asset_t asset, float screen_px);
+
+// Projected size in pixels of something world_size across at distance, for a perspective camera
+GS_API_DECL float
+gs_asset_texture_stream_screen_size(float world_size, float distance, float fov_y_deg, float viewport_h);
+
+// Once per frame after gs_assets_async_update(), returns the bytes uploaded
+GS_API_DECL size_t
+gs_asset_texture_stream_update(gs_command_buffer_t* cb);
+
+GS_API_DECL gs_asset_texture_stream_info_t
+gs_assets_stream_info(gs_asset_manager_t* am, gs_asset_t asset);
+
+GS_API_DECL gs_asset_texture_stream_stats_t
+gs_asset_texture_stream_stats();
+
+#define gs_assets_stream_ready(__AM, __HNDL)\
+    (gs_assets_stream_info((__AM), (__HNDL)).status == GS_ASSET_STATUS_READY)
+
+/*==== Implementation ====*/
+
+#ifdef GS_ASSET_TEXTURE_STREAM_IMPL
+
+typedef struct __gs_asset_texture_stream_t
+{
+    gs_asset_manager_t* am;
+    gs_asset_t asset;
+    char* path;
+    __gs_asset_async_params_t params;
+    uint32_t status;                                                // Written by workers until DECODED/FAILED
+    __gs_asset_async_texture_t mips[GS_ASSET_TEXTURE_STREAM_MAX_LEVELS];
+    void* chain;                                                    // Levels 1 and up, level 0 is the decode
+    uint32_t level_ct;
+    uint32_t base_level;
+    uint32_t resident_level;
+    uint32_t desired_level;
+    float hint_px;                                                  // Largest hint since the last update
+    float priority;                                                 // Hint the last update went by
+    uint64_t hint_frame;
+    bool reported;
+} __gs_asset_texture_stream_t;
+
+typedef struct __gs_asset_texture_stream_ctx_t
+{
+    bool initialized;
+    size_t upload_budget;
+    uint32_t min_size;
+    uint32_t idle_frames;
+    gs_job_counter_t decoding;
+    gs_hash_table(uint64_t, __gs_asset_texture_stream_t*) streams;     // By async key
+    gs_dyn_array(__gs_asset_texture_stream_t*) upgrades;               // Scratch for update
+    uint64_t frame;
+    gs_asset_texture_stream_stats_t stats;
+} __gs_asset_texture_stream_ctx_t;
+
+static __gs_asset_texture_stream_ctx_t __gs_asset_texture_stream = {0};
+
+static __gs_asset_texture_stream_t*
+__gs_asset_texture_stream_find(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    const uint64_t key = __gs_asset_async_key(am, asset);
+    return gs_hash_table_exists(ts->streams, key) ? gs_hash_table_get(ts->streams, key) : NULL;
+}
+
+gs_force_inline size_t
+__gs_asset_texture_stream_level_bytes(const __gs_asset_texture_stream_t* s, uint32_t level)
+{
+    return (size_t)s->mips[level].width * s->mips[level].height * 4;
+}
+
+// 2x2 box filter, edge texels repeat on odd sizes
+static void
+__gs_asset_texture_stream_downsample(const uint8_t* src, uint32_t sw, uint32_t sh, uint8_t* dst, uint32_t dw, uint32_t dh)
+{
+    for (uint32_t y = 0; y < dh; ++y)
+    {
+        const uint8_t* r0 = src + (size_t)gs_min(y * 2, sh - 1) * sw * 4;
+        const uint8_t* r1 = src + (size_t)gs_min(y * 2 + 1, sh - 1) * sw * 4;
+        uint8_t* out = dst + (size_t)y * dw * 4;
+        for (uint32_t x = 0; x < dw; ++x)
+        {
+            const uint32_t x0 = gs_min(x * 2, sw - 1) * 4;
+            const uint32_t x1 = gs_min(x * 2 + 1, sw - 1) * 4;
+            for (uint32_t c = 0; c < 4; ++c) {
+                out[x * 4 + c] = (uint8_t)((r0[x0 + c] + r0[x1 + c] + r1[x0 + c] + r1[x1 + c] + 2) >> 2);
+            }
+        }
+    }
+}
+
+static void
+__gs_asset_texture_stream_decode_job(void* user_data)
+{
+    __gs_asset_texture_stream_t* s = (__gs_asset_texture_stream_t*)user_data;
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    gs_atomic_store_rel_u32(&s->status, GS_ASSET_STATUS_DECODING);
+
+    if (!__gs_asset_async_texture_decode(s->path, &s->mips[0], &s->params.params)) {
+        gs_atomic_store_rel_u32(&s->status, GS_ASSET_STATUS_FAILED);
+        return;
+    }
+
+    // Level sizes first, so the chain is one allocation
+    uint32_t w = (uint32_t)s->mips[0].width, h = (uint32_t)s->mips[0].height;
+    size_t chain_bytes = 0;
+    s->level_ct = 1;
+    while ((w > 1 || h > 1) && s->level_ct < GS_ASSET_TEXTURE_STREAM_MAX_LEVELS)
+    {
+        w = gs_max(w >> 1, 1);
+        h = gs_max(h >> 1, 1);
+        s->mips[s->level_ct++] = (__gs_asset_async_texture_t){.width = (int32_t)w, .height = (int32_t)h, .comps = 4};
+        chain_bytes += (size_t)w * h * 4;
+    }
+
+    uint8_t* chain = chain_bytes ? gs_malloc(chain_bytes) : NULL;
+    s->chain = chain;
+    for (uint32_t i = 1; i < s->level_ct; ++i)
+    {
+        const __gs_asset_async_texture_t* src = &s->mips[i - 1];
+        __gs_asset_async_texture_t* dst = &s->mips[i];
+        dst->pixels = chain;
+        __gs_asset_texture_stream_downsample(src->pixels, src->width, src->height, dst->pixels, dst->width, dst->height);
+        chain += __gs_asset_texture_stream_level_bytes(s, i);
+    }
+
+    // First level at or under min_size
+    s->base_level = s->level_ct - 1;
+    for (uint32_t i = 0; i < s->level_ct; ++i) {
+        if ((uint32_t)gs_max(s->mips[i].width, s->mips[i].height) <= ts->min_size) {
+            s->base_level = i;
+            break;
+        }
+    }
+
+    gs_atomic_store_rel_u32(&s->status, GS_ASSET_STATUS_DECODED);
+}
+
+static void
+__gs_asset_texture_stream_free(__gs_asset_texture_stream_t* s)
+{
+    if (s->mips[0].pixels) gs_free(s->mips[0].pixels);
+    if (s->chain) gs_free(s->chain);
+    __gs_asset_async_params_free(&s->params);
+    gs_free(s->path);
+    gs_free(s);
+}
+
+GS_API_DECL void
+gs_asset_texture_stream_init(gs_asset_texture_stream_desc_t desc)
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    if (ts->initialized) return;
+    ts->initialized = true;
+    ts->upload_budget = desc.upload_budget ? desc.upload_budget : 4 * 1024 * 1024;
+    ts->min_size = desc.min_size ? desc.min_size : 32;
+    ts->idle_frames = desc.idle_frames ? desc.idle_frames : 120;
+    if (!__gs_asset_async.initialized) gs_assets_async_init((gs_asset_async_desc_t){0});
+}
+
+GS_API_DECL void
+gs_asset_texture_stream_shutdown()
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    if (!ts->initialized) return;
+    gs_job_pool_wait(__gs_asset_async.pool, &ts->decoding);
+
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(ts->streams);
+        gs_hash_table_iter_valid(ts->streams, it);
+        gs_hash_table_iter_advance(ts->streams, it)
+    )
+    {
+        __gs_asset_texture_stream_free(gs_hash_table_iter_get(ts->streams, it));
+    }
+    gs_hash_table_free(ts->streams);
+    gs_dyn_array_free(ts->upgrades);
+    memset(ts, 0, sizeof(__gs_asset_texture_stream_ctx_t));
+}
+
+GS_API_DECL gs_asset_t
+gs_assets_load_streamed_func(gs_asset_manager_t* am, gs_asset_t asset, const char* path, const gs_asset_load_params_t* params)
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    if (!ts->initialized) gs_asset_texture_stream_init((gs_asset_texture_stream_desc_t){0});
+
+    if (__gs_asset_texture_stream_find(am, asset)) {
+        gs_println("gs_assets_load_streamed: %s is already streaming into this asset", path);
+        return asset;
+    }
+
+    __gs_asset_texture_stream_t* s = gs_malloc(sizeof(__gs_asset_texture_stream_t));
+    memset(s, 0, sizeof(__gs_asset_texture_stream_t));
+    s->am = am;
+    s->asset = asset;
+    const size_t path_len = strlen(path);
+    s->path = gs_malloc(path_len + 1);
+    memcpy(s->path, path, path_len + 1);
+    __gs_asset_async_params_copy(&s->params, params);
+    s->status = GS_ASSET_STATUS_QUEUED;
+    s->resident_level = GS_ASSET_TEXTURE_STREAM_MAX_LEVELS;
+    s->desired_level = GS_ASSET_TEXTURE_STREAM_MAX_LEVELS;
+
+    gs_hash_table_insert(ts->streams, __gs_asset_async_key(am, asset), s);
+    gs_job_pool_submit(__gs_asset_async.pool, __gs_asset_texture_stream_decode_job, s, &ts->decoding);
+    return asset;
+}
+
+GS_API_DECL void
+gs_assets_stream_hint(gs_asset_manager_t* am, gs_asset_t asset, float screen_px)
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    __gs_asset_texture_stream_t* s = ts->initialized ? __gs_asset_texture_stream_find(am, asset) : NULL;
+    if (!s) return;
+    s->hint_px = gs_max(s->hint_px, gs_max(screen_px, 1.f));
+    s->hint_frame = ts->frame;
+}
+
+GS_API_DECL float
+gs_asset_texture_stream_screen_size(float world_size, float distance, float fov_y_deg, float viewport_h)
+{
+    const float half = tanf(gs_deg2rad(fov_y_deg) * 0.5f) * gs_max(distance, 0.0001f);
+    return world_size / (2.f * half) * viewport_h;
+}
+
+// Smallest mip still covering px, never below base_level
+static uint32_t
+__gs_asset_texture_stream_level_for(const __gs_asset_texture_stream_t* s, float px)
+{
+    uint32_t level = s->base_level;
+    while (level > 0 && (float)gs_max(s->mips[level].width, s->mips[level].height) < px) level--;
+    return level;
+}
+
+static size_t
+__gs_asset_texture_stream_make_resident(__gs_asset_texture_stream_t* s, uint32_t level, gs_command_buffer_t* cb)
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    gs_asset_texture_t* tex = gs_assets_getp(s->am, gs_asset_texture_t, s->asset);
+    if (s->resident_level < s->level_ct) {
+        gs_graphics_texture_destroy(tex->hndl);
+        ts->stats.resident_bytes -= __gs_asset_texture_stream_level_bytes(s, s->resident_level);
+    }
+
+    // The update copies the level into cb, the chain stays for later levels
+    __gs_asset_async_texture_upload(&s->mips[level], tex, &s->params.params, cb);
+    s->resident_level = level;
+
+    const size_t bytes = __gs_asset_texture_stream_level_bytes(s, level);
+    ts->stats.resident_bytes += bytes;
+    ts->stats.uploaded_bytes += bytes;
+    return bytes;
+}
+
+static int32_t
+__gs_asset_texture_stream_priority_cmp(const void* a, const void* b)
+{
+    const __gs_asset_texture_stream_t* sa = *(const __gs_asset_texture_stream_t**)a;
+    const __gs_asset_texture_stream_t* sb = *(const __gs_asset_texture_stream_t**)b;
+
+    // Nothing resident yet goes first, then largest on screen
+    const bool na = sa->resident_level >= sa->level_ct, nb = sb->resident_level >= sb->level_ct;
+    if (na != nb) return na ? -1 : 1;
+    return sa->priority > sb->priority ? -1 : sa->priority < sb->priority ? 1 : 0;
+}
+
+GS_API_DECL size_t
+gs_asset_texture_stream_update(gs_command_buffer_t* cb)
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    if (!ts->initialized) return 0;
+
+    ts->stats.uploaded_bytes = 0;
+    ts->stats.texture_ct = 0;
+    ts->stats.streaming_ct = 0;
+    gs_dyn_array_clear(ts->upgrades);
+
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(ts->streams);
+        gs_hash_table_iter_valid(ts->streams, it);
+        gs_hash_table_iter_advance(ts->streams, it)
+    )
+    {
+        __gs_asset_texture_stream_t* s = gs_hash_table_iter_get(ts->streams, it);
+        ts->stats.texture_ct++;
+
+        const uint32_t status = gs_atomic_load_acq_u32(&s->status);
+        if (status == GS_ASSET_STATUS_FAILED && !s->reported) {
+            gs_println("gs_asset_texture_stream_update: failed to decode %s", s->path);
+            s->reported = true;
+        }
+        if (status != GS_ASSET_STATUS_DECODED && status != GS_ASSET_STATUS_READY) continue;
+
+        // Hinted this frame: follow the hint. Unseen for a while: back to the first mip. Otherwise hold.
+        s->priority = s->hint_px;
+        s->hint_px = 0.f;
+        if (s->hint_frame == ts->frame && s->priority > 0.f) {
+            s->desired_level = __gs_asset_texture_stream_level_for(s, s->priority);
+        } else if (s->resident_level >= s->level_ct || ts->frame - s->hint_frame > ts->idle_frames) {
+            s->desired_level = s->base_level;
+        } else {
+            s->desired_level = s->resident_level;
+        }
+
+        // Dropping levels frees VRAM and is small, never held back by the budget
+        if (s->resident_level < s->level_ct && s->desired_level > s->resident_level) {
+            __gs_asset_texture_stream_make_resident(s, s->desired_level, cb);
+        }
+        if (s->desired_level < s->resident_level) {
+            gs_dyn_array_push(ts->upgrades, s);
+        }
+    }
+
+    const uint32_t ct = gs_dyn_array_size(ts->upgrades);
+    if (ct) qsort(ts->upgrades, ct, sizeof(__gs_asset_texture_stream_t*), __gs_asset_texture_stream_priority_cmp);
+
+    // One level per texture per frame, always at least one upload so large levels can't starve
+    size_t uploaded = 0;
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        __gs_asset_texture_stream_t* s = ts->upgrades[i];
+        const uint32_t level = s->resident_level >= s->level_ct ? s->base_level : s->resident_level - 1;
+        const size_t bytes = __gs_asset_texture_stream_level_bytes(s, level);
+        if (uploaded && uploaded + bytes > ts->upload_budget) {
+            ts->stats.streaming_ct++;
+            continue;
+        }
+
+        uploaded += __gs_asset_texture_stream_make_resident(s, level, cb);
+        gs_atomic_store_rel_u32(&s->status, GS_ASSET_STATUS_READY);
+        if (s->desired_level < s->resident_level) ts->stats.streaming_ct++;
+    }
+
+    ts->frame++;
+    return ts->stats.uploaded_bytes;
+}
+
+GS_API_DECL gs_asset_texture_stream_info_t
+gs_assets_stream_info(gs_asset_manager_t* am, gs_asset_t asset)
+{
+    __gs_asset_texture_stream_ctx_t* ts = &__gs_asset_texture_stream;
+    __gs_asset_texture_stream_t* s = ts->initialized ? __gs_asset_texture_stream_find(am, asset) : NULL;
+    gs_asset_texture_stream_info_t info = gs_default_val();
+    if (!s) return info;
+
+    info.status = (gs_asset_status)gs_atomic_load_acq_u32(&s->status);
+    if (info.status != GS_ASSET_STATUS_DECODED && info.status != GS_ASSET_STATUS_READY) return info;
+    info.width = (uint32_t)s->mips[0].width;
+    info.height = (uint32_t)s->mips[0].height;
+    info.level_ct = s->level_ct;
+    info.resident_level = gs_min(s->resident_level, s->level_ct);
+    info.desired_level = gs_min(s->desired_level, s->level_ct);
+    return info;
+}
+
+GS_API_DECL gs_asset_texture_stream_stats_t
+gs_asset_texture_stream_stats()
+{
+    return __gs_asset_texture_stream.stats;
+}
+
+#endif // GS_ASSET_TEXTURE_STREAM_IMPL
+#endif // GS_ASSET_TEXTURE_STREAM_H
@@ -15,7 +15,16 @@
         * Registering custom asset importer
         * Creating custom asset data
         * Getting raw asset data from asset manager using asset handles
-
+        * Loading assets asynchronously: decoded on a worker pool, uploaded on the main thread
+        * Caching cooked (decoded, GPU ready) assets on disk so later runs skip decoding
+        * Hot reloading assets when their files change (edit champ.png while running)
+        * Bounding resident textures with a memory budget, evicting unused ones and reloading them on use
+        * Streaming a texture's mips in by how large it is on screen
+        * Reordering mesh indices and vertices for the GPU's vertex cache on import
+        * Loading many small custom asset files in batches on the worker pool, with typed params
+        * Per type and per asset memory and load time stats in a gui window, dumped to JSON and CSV
+
+    Press `s` to write asset stats to ./asset_stats.json and ./asset_stats.csv.
     Press `esc` to exit the application.
 ================================================================*/
 
@@ -28,14 +37,51 @@
 #define GS_ASSET_IMPL
 #include <gs/util/gs_asset.h>
 
+#define GS_GUI_IMPL
+#include <gs/util/gs_gui.h>
+
+// Worker pool for async loads (from ex_core_containers/containers/source)
+#define GS_THREAD_IMPL
+#include "gs_thread.h"
+
+#define GS_CONCURRENT_QUEUE_IMPL
+#include "gs_concurrent_queue.h"
+
+#define GS_JOB_IMPL
+#include "gs_job.h"
+
+// Before gs_asset_async.h, so async mesh loads can use it
+#define GS_ASSET_MESH_OPTIMIZE_IMPL
+#include "gs_asset_mesh_optimize.h"
+
+#define GS_ASSET_ASYNC_IMPL
+#include "gs_asset_async.h"
+
+#define GS_ASSET_CACHE_IMPL
+#include "gs_asset_cache.h"
+
+#define GS_ASSET_HOT_RELOAD_IMPL
+#include "gs_asset_hot_reload.h"
+
+#define GS_ASSET_RESIDENCY_IMPL
+#include "gs_asset_residency.h"
+
+#define GS_ASSET_TEXTURE_STREAM_IMPL
+#include "gs_asset_texture_stream.h"
+
+// After gs_gui.h and gs_asset_residency.h, for its window and type budgets
+#define GS_ASSET_STATS_IMPL
+#include "gs_asset_stats.h"
+
 gs_command_buffer_t                     gcb = {0}; 
 gs_immediate_draw_t                     gsi = {0};
 gs_asset_manager_t                      gsa = {0};
+gs_gui_context_t                        gui = {0};
 
 // Custom asset definition
 typedef struct custom_asset_t
 {
-    const char* name;
+    char name[32];
     uint32_t udata;
     float fdata;
 } custom_asset_t;
@@ -54,6 +100,40 @@ void load_custom_asset_from_file(const char* path, void* out, uint32_t optional_
     ca->fdata = (float)optional_float_param;
 }
 
+// Typed params for async custom asset loads
+typedef struct custom_asset_params_t
+{
+    uint32_t udata_scale;
+} custom_asset_params_t;
+
+// Worker thread: parses a "name udata fdata" file. Nothing else touches the backends, so decoded is the asset itself.
+bool decode_custom_asset(const char* path, void* decoded, const gs_asset_load_params_t* params)
+{
+    size_t sz = 0;
+    char* text = (char*)gs_assets_read_file(path, &sz);
+    if (!text) return false;
+
+    custom_asset_t* ca = (custom_asset_t*)decoded;
+    const custom_asset_params_t* cp = gs_asset_params_get(params, custom_asset_params_t);
+    bool ok = sscanf(text, "%31s %u %f", ca->name, &ca->udata, &ca->fdata) == 3;
+    if (cp) ca->udata *= cp->udata_scale;
+    gs_free(text);
+    return ok;
+}
+
+// Worker thread: a whole batch of loads in one call (a real format would share its parser setup across them)
+void decode_custom_assets(const char* const* paths, void** decoded, bool* ok, uint32_t ct,
+    const gs_asset_load_params_t* params)
+{
+    for (uint32_t i = 0; i < ct; ++i) ok[i] = decode_custom_asset(paths[i], decoded[i], params);
+}
+
+bool finalize_custom_asset(void* decoded, void* out, const gs_asset_load_params_t* params, gs_command_buffer_t* cb)
+{
+    memcpy(out, decoded, sizeof(custom_asset_t));
+    return true;
+}
+
 // Asset handles
 gs_asset_t tex_hndl   = {0};
 gs_asset_t fnt_hndl   = {0};
@@ -62,12 +142,14 @@ gs_asset_t msh_hndl   = {0};
 gs_asset_t cust_hndl  = {0};
 gs_asset_t cust_hndl0 = {0};
 gs_asset_t dtex_hndl  = {0};
+gs_asset_t cust_batch[3] = {0};
 
 void init()
 {
     gcb = gs_command_buffer_new();
     gsi = gs_immediate_draw_new(gs_platform_main_window());
     gsa = gs_asset_manager_new();
+    gs_gui_init(&gui, gs_platform_main_window());
 
     // Registering custom asset importer
     gs_assets_register_importer(&gsa, custom_asset_t, &(gs_asset_importer_desc_t){
@@ -87,28 +169,26 @@ void init()
         .layout_size = sizeof(mesh_layout)
     };
 
-    gs_asset_texture_t tex0 = {0};
-    gs_asset_texture_t tex1 = {0};
-    gs_asset_audio_t   aud  = {0};
-    gs_asset_mesh_t    msh  = {0};
-    gs_asset_font_t    fnt  = {0};
-
-    // Load asset data
-    gs_asset_texture_load_from_file("./assets/champ.png", &tex0, NULL, false, false);
-    gs_asset_audio_load_from_file("./assets/jump.wav", &aud);
-    gs_asset_font_load_from_file("./assets/font.ttf", &fnt, 32);
-    gs_asset_mesh_load_from_file("./assets/duck/Duck.gltf", &msh, &mesh_decl, NULL, 0);
-    gs_asset_texture_load_from_file("./assets/duck/DuckCM.png", &tex1, NULL, false, false);
-
-    // Create and place assets
-    tex_hndl = gs_assets_create_asset(&gsa, gs_asset_texture_t, &tex0);
-    dtex_hndl = gs_assets_create_asset(&gsa, gs_asset_texture_t, &tex1);
-    aud_hndl = gs_assets_create_asset(&gsa, gs_asset_audio_t, &aud);
-    fnt_hndl = gs_assets_create_asset(&gsa, gs_asset_font_t, &fnt);
-    msh_hndl = gs_assets_create_asset(&gsa, gs_asset_mesh_t, &msh);
+    // First run cooks textures, meshes and fonts into ./.gs_cache, later runs map the cooked blobs instead
+    gs_asset_cache_init((gs_asset_cache_desc_t){.dir = "./.gs_cache"});
+
+    // Queue asset loads. Handles are valid right away, files decode on worker threads
+    // and are finalized (gpu uploads etc.) by gs_assets_async_update() in update().
+    // Watched loads are also reloaded into the same handles whenever their files change.
+    tex_hndl = gs_assets_load_watched(&gsa, gs_asset_texture_t, "./assets/champ.png");
+    aud_hndl = gs_assets_load_watched(&gsa, gs_asset_audio_t, "./assets/jump.wav");
+    fnt_hndl = gs_assets_load_watched(&gsa, gs_asset_font_t, "./assets/font.ttf", .point_size = 32);
+    msh_hndl = gs_assets_load_watched(&gsa, gs_asset_mesh_t, "./assets/duck/Duck.gltf", .mesh_decl = &mesh_decl,
+        .mesh_optimize = true);
+
+    // The duck texture starts at a small mip and pages in larger ones as it needs them (hinted in update())
+    dtex_hndl = gs_assets_load_streamed(&gsa, "./assets/duck/DuckCM.png");
+
+    // Textures past 64MB are evicted least recently used first. The champ texture is drawn every frame, so it stays.
+    gs_asset_residency_set_budget(gs_asset_texture_t, 64 * 1024 * 1024);
+    gs_assets_track_resident(&gsa, gs_asset_texture_t, tex_hndl, "./assets/champ.png");
 
     // Create asset and get handle for custom data placed into asset manager
-    // Might have to just do this instead. Load from file just isn't going to work.
     custom_asset_t custom = (custom_asset_t){
         .name = "whatever", 
         .udata = 10,
@@ -124,6 +204,19 @@ void init()
 
     // // Load custom data "from file" (can provide optional data AFTER path)
     cust_hndl0 = gs_assets_create_asset(&gsa, custom_asset_t, &custom);
+
+    // Or load custom data from files asynchronously, in batches, through an async importer
+    gs_assets_register_async_importer(custom_asset_t, &(gs_asset_async_importer_desc_t){
+        .decode = decode_custom_asset,
+        .decode_batch = decode_custom_assets,
+        .finalize = finalize_custom_asset,
+        .decoded_size = sizeof(custom_asset_t),
+        .asset_size = sizeof(custom_asset_t),
+        .params_size = sizeof(custom_asset_params_t)
+    });
+    const char* custom_paths[] = {"./assets/custom/a.txt", "./assets/custom/b.txt", "./assets/custom/c.txt"};
+    gs_assets_load_batch(&gsa, custom_asset_t, custom_paths, 3, cust_batch,
+        gs_asset_params(custom_asset_params_t, .udata_scale = 10));
 }
 
 void update()
@@ -133,8 +226,28 @@ void update()
     const gs_vec2 fb = gs_platform_framebuffer_sizev(gs_platform_main_window());
     const gs_vec2 ws = gs_platform_window_sizev(gs_platform_main_window());
 
+    // Queue reloads for changed files, then finish any async loads decoded since last frame
+    // (texture uploads are recorded into gcb, reloads are swapped in here)
+    gs_asset_hot_reload_update();
+    gs_asset_residency_update();
+    uint32_t loading = gs_assets_async_update(&gcb);
+    gs_asset_texture_stream_update(&gcb);
+
+    // Live stats of every async load
+    gs_gui_begin(&gui, NULL);
+    gs_asset_stats_window(&gui, &gsa, gs_gui_rect(fb.x - 500.f, 10.f, 490.f, 380.f));
+    gs_gui_end(&gui);
+
+    if (gs_platform_key_pressed(GS_KEYCODE_S)) {
+        gs_asset_stats_t stats = gs_asset_stats_capture(&gsa);
+        gs_asset_stats_write_json(&stats, "./asset_stats.json");
+        gs_asset_stats_write_csv(&stats, "./asset_stats.csv");
+        gs_println("wrote asset stats for %u assets", gs_dyn_array_size(stats.assets));
+        gs_asset_stats_free(&stats);
+    }
+
     // Whenever user presses key, play transient sound effect
-    if (gs_platform_key_pressed(GS_KEYCODE_SPACE)) {
+    if (gs_platform_key_pressed(GS_KEYCODE_SPACE) && gs_assets_ready(&gsa, aud_hndl)) {
         // Grab audio asset pointer from assets
         gs_asset_audio_t* ap = gs_assets_getp(&gsa, gs_asset_audio_t, aud_hndl);
         gs_println("playing sound");
@@ -142,32 +255,52 @@ void update()
     }
 
     // Grab texture asset pointer from assets
-    gs_asset_texture_t* tp = gs_assets_getp(&gsa, gs_asset_texture_t, tex_hndl);
+    gs_asset_texture_t* tp = gs_assets_getp_resident(&gsa, gs_asset_texture_t, tex_hndl);
     custom_asset_t* cp = gs_assets_getp(&gsa, custom_asset_t, cust_hndl);
     custom_asset_t* cp0 = gs_assets_getp(&gsa, custom_asset_t, cust_hndl0);
     gs_asset_font_t* fp = gs_assets_getp(&gsa, gs_asset_font_t, fnt_hndl);
     gs_asset_mesh_t* mp = gs_assets_getp(&gsa, gs_asset_mesh_t, msh_hndl);
     gs_asset_texture_t* dtp = gs_assets_getp(&gsa, gs_asset_texture_t, dtex_hndl);
 
+    // Duck is roughly 8 units across, 30 units away
+    gs_assets_stream_hint(&gsa, dtex_hndl, gs_asset_texture_stream_screen_size(8.f, 30.f, 60.f, fb.y));
+
     gsi_camera3D(&gsi, (uint32_t)fb.x, (uint32_t)fb.y);
     gsi_face_cull_enabled(&gsi, true);
     gsi_translatef(&gsi, -2.f, 0.f, -5.f);
     gsi_rotatev(&gsi, -gs_platform_elapsed_time() * 0.001f, GS_YAXIS);
     gsi_sphere(&gsi, 0.f, 0.f, 0.f, 1.5f, 20, 50, 150, 100, GS_GRAPHICS_PRIMITIVE_LINES);
-    gsi_texture(&gsi, tp->hndl);
-    gsi_sphere(&gsi, 0.f, 0.f, 0.f, 1.5f, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+    if (gs_assets_ready(&gsa, tex_hndl)) {
+        gsi_texture(&gsi, tp->hndl);
+        gsi_sphere(&gsi, 0.f, 0.f, 0.f, 1.5f, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+    }
 
     // Default text
-    gsi_defaults(&gsi);
-    gsi_camera2D(&gsi, (uint32_t)fb.x, (uint32_t)fb.y);
-    gsi_text(&gsi, 120.f, 100.f, "Press P to play jump sound", fp, false, 255, 255, 255, 255);
-
-    // Print text of custom asset metric
-    gs_snprintfc(cbuff, 256, "CP: %s, %zu, %.2f", cp->name, cp->udata, cp->fdata);
-    gsi_text(&gsi, 175.f, 500.f, cbuff, fp, false, 255, 255, 255, 255);
+    if (gs_assets_ready(&gsa, fnt_hndl))
+    {
+        gsi_defaults(&gsi);
+        gsi_camera2D(&gsi, (uint32_t)fb.x, (uint32_t)fb.y);
+        gsi_text(&gsi, 120.f, 100.f, "Press P to play jump sound", fp, false, 255, 255, 255, 255);
+
+        // Print text of custom asset metric
+        gs_snprintfc(cbuff, 256, "CP: %s, %zu, %.2f", cp->name, cp->udata, cp->fdata);
+        gsi_text(&gsi, 175.f, 500.f, cbuff, fp, false, 255, 255, 255, 255);
+
+        gs_snprintfc(cbuff0, 256, "CP0: %s, %zu, %.2f", cp0->name, cp0->udata, cp0->fdata);
+        gsi_text(&gsi, 165.f, 550.f, cbuff0, fp, false, 255, 255, 255, 255);
+
+        for (uint32_t i = 0; i < 3; ++i) {
+            if (!gs_assets_ready(&gsa, cust_batch[i])) continue;
+            custom_asset_t* cb = gs_assets_getp(&gsa, custom_asset_t, cust_batch[i]);
+            gs_snprintfc(bbuff, 256, "Batch %u: %s, %u, %.2f", i, cb->name, cb->udata, cb->fdata);
+            gsi_text(&gsi, 165.f, 600.f + 50.f * i, bbuff, fp, false, 255, 255, 255, 255);
+        }
 
-    gs_snprintfc(cbuff0, 256, "CP0: %s, %zu, %.2f", cp0->name, cp0->udata, cp0->fdata);
-    gsi_text(&gsi, 165.f, 550.f, cbuff0, fp, false, 255, 255, 255, 255);
+        if (loading) {
+            gs_snprintfc(lbuff, 256, "Loading: %u assets left", loading);
+            gsi_text(&gsi, 120.f, 150.f, lbuff, fp, false, 255, 255, 255, 255);
+        }
+    }
 
     gs_graphics_clear_desc_t clear = {.actions = &(gs_graphics_clear_action_t){.color = 0.1f, 0.1f, 0.1f, 255}};
 
@@ -201,8 +334,8 @@ void update()
             gs_mat4_scale(0.05f, 0.05f, 0.05f)
         );
 
-        // For each primitive in mesh
-        for (uint32_t i = 0; i < gs_dyn_array_size(mp->primitives); ++i)
+        // For each primitive in mesh (no primitives until it has loaded)
+        for (uint32_t i = 0; i < gs_dyn_array_size(mp->primitives) && gs_assets_stream_ready(&gsa, dtex_hndl); ++i)
         {
             gs_asset_mesh_primitive_t* prim = &mp->primitives[i];
 
@@ -223,16 +356,30 @@ void update()
             gs_graphics_draw(&gcb, &(gs_graphics_draw_desc_t){.start = 0, .count = prim->count});
         }
 
+        gs_gui_render(&gui, &gcb);
+
     gs_graphics_renderpass_end(&gcb);
 
     // Final command buffer submit
     gs_graphics_command_buffer_submit(&gcb);
 }
 
+void cleanup()
+{
+    // Stop watching and tracking first, then wait for loads still decoding
+    gs_asset_hot_reload_shutdown();
+    gs_asset_residency_shutdown();
+    gs_asset_texture_stream_shutdown();
+    gs_assets_async_shutdown();
+    gs_asset_cache_shutdown();
+    gs_gui_free(&gui);
+}
+
 gs_app_desc_t gs_main(int32_t argc, char** argv)
 {
     return (gs_app_desc_t){
         .init = init,
-        .update = update
+        .update = update,
+        .shutdown = cleanup
     };
 }
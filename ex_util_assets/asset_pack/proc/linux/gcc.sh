@@ -0,0 +1,29 @@
+#!/bin/bash
+
+rm -rf bin
+mkdir bin
+cd bin
+
+proj_name=App
+proj_root_dir=$(pwd)/../
+
+flags=(
+	-std=gnu99 -DNDEBUG -Wl,--no-as-needed -ldl -lGL -lX11 -pthread -lXi
+)
+
+# Include directories
+inc=(
+	-I ../../../third_party/include/
+	-I ../../../ex_core_containers/containers/source/	# Thread/job pool headers for async loading
+	-I ../../asset_manager/source/					# gs_asset_pack.h and gs_asset_async.h
+)
+
+# Source files
+src=(
+	../source/main.c
+)
+
+# Build
+gcc -O3 ${inc[*]} ${src[*]} ${flags[*]} -lm -o ${proj_name}
+
+cd ..
@@ -0,0 +1,264 @@
+/*================================================================
+    * Copyright: 2020 John Jackson
+    * asset_pack
+
+    Command line tool for gs_asset_pack.h (ex_util_assets/asset_manager/source).
+    Packs a directory of assets into a single file, lists a pack, and
+    benchmarks reading every file from a pack against reading loose files.
+
+    Included:
+        * Building a pack from a directory (sub directories included)
+        * Listing a pack's files and sizes
+        * Benchmark: open/read/close per loose file vs. one mapped pack,
+            both copied out through gs_assets_read_file() and zero copy
+            through gs_asset_pack_find()
+
+    Usage: App build <dir> <out.gspk>
+           App list <pack.gspk>
+           App bench [dir] [--files N] [--reps N]
+        bench:      packs dir (or N generated files of 256B-64KB, default 2000, written
+                    to ./bench_assets) into ./bench.gspk and times reading every file.
+                    Best of --reps runs (default 5), so the OS file cache is warm for
+                    both; drop it between runs for cold numbers.
+================================================================*/
+
+// No window or app loop, just main()
+#define GS_NO_HIJACK_MAIN
+#define GS_IMPL
+#include <gs/gs.h>
+
+#define GS_ASSET_IMPL
+#include <gs/util/gs_asset.h>
+
+// Async loading relies on the worker pool (from ex_core_containers/containers/source)
+#define GS_THREAD_IMPL
+#include "gs_thread.h"
+
+#define GS_CONCURRENT_QUEUE_IMPL
+#include "gs_concurrent_queue.h"
+
+#define GS_JOB_IMPL
+#include "gs_job.h"
+
+#define GS_ASSET_ASYNC_IMPL
+#include "gs_asset_async.h"
+
+#define GS_ASSET_PACK_IMPL
+#include "gs_asset_pack.h"
+
+#if (defined _WIN32 || defined _WIN64)
+    #include <windows.h>
+    #include <direct.h>
+    #define pack_mkdir(__PATH) _mkdir(__PATH)
+#else
+    #include <time.h>
+    #include <sys/stat.h>
+    #define pack_mkdir(__PATH) mkdir((__PATH), 0755)
+#endif
+
+#define PACK_BENCH_DIR          "./bench_assets"
+#define PACK_BENCH_OUT          "./bench.gspk"
+#define PACK_BENCH_FILES        2000
+#define PACK_BENCH_REPS         5
+#define PACK_BENCH_DIRS         16          // Generated files are spread over this many sub directories
+
+static double pack_now()
+{
+#if (defined _WIN32 || defined _WIN64)
+    LARGE_INTEGER f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void pack_usage()
+{
+    gs_println("Usage: App build <dir> <out.gspk>");
+    gs_println("       App list <pack.gspk>");
+    gs_println("       App bench [dir] [--files N] [--reps N]");
+}
+
+// Touches every byte, so zero copy reads can't skip the work
+static uint64_t pack_checksum(const uint8_t* data, size_t size)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; ++i) sum = sum * 31 + data[i];
+    return sum;
+}
+
+static int32_t pack_build(const char* dir, const char* out)
+{
+    const double t0 = pack_now();
+    const int32_t ct = gs_asset_pack_build(dir, out);
+    if (ct < 0) return 1;
+    gs_println("packed %d files from %s into %s in %.1f ms", ct, dir, out, (pack_now() - t0) * 1e3);
+    return 0;
+}
+
+static int32_t pack_list(const char* path)
+{
+    gs_asset_pack_t* pack = gs_asset_pack_open(path);
+    if (!pack) {
+        gs_println("can't open %s", path);
+        return 1;
+    }
+    uint64_t total = 0;
+    const uint32_t ct = gs_asset_pack_count(pack);
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        size_t size = 0;
+        const char* name = gs_asset_pack_name(pack, i, &size);
+        gs_println("%12zu  %s", size, name);
+        total += size;
+    }
+    gs_println("%u files, %llu bytes", ct, (unsigned long long)total);
+    gs_asset_pack_close(pack);
+    return 0;
+}
+
+static bool pack_bench_generate(uint32_t n)
+{
+    pack_mkdir(PACK_BENCH_DIR);
+    uint64_t s = 0x9E3779B97F4A7C15ull;
+    uint8_t* buf = gs_malloc(64 * 1024);
+    bool ok = true;
+    for (uint32_t i = 0; i < n && ok; ++i)
+    {
+        char path[256] = gs_default_val();
+        gs_snprintf(path, sizeof(path), "%s/%02u", PACK_BENCH_DIR, i % PACK_BENCH_DIRS);
+        pack_mkdir(path);
+        gs_snprintf(path, sizeof(path), "%s/%02u/file_%05u.bin", PACK_BENCH_DIR, i % PACK_BENCH_DIRS, i);
+
+        s ^= s << 13; s ^= s >> 7; s ^= s << 17;
+        const size_t size = 256 + (size_t)(s % (64 * 1024 - 256));
+        for (size_t b = 0; b < size; ++b) buf[b] = (uint8_t)(s >> (b % 56));
+        ok = gs_platform_write_file_contents(path, "wb", buf, size) == GS_RESULT_SUCCESS;
+    }
+    gs_free(buf);
+    if (!ok) gs_println("can't write generated files to %s", PACK_BENCH_DIR);
+    return ok;
+}
+
+static int32_t pack_bench(const char* dir, uint32_t files, uint32_t reps)
+{
+    if (!dir) {
+        if (!pack_bench_generate(files)) return 1;
+        dir = PACK_BENCH_DIR;
+    }
+    if (pack_build(dir, PACK_BENCH_OUT) != 0) return 1;
+
+    // Names come from the pack, so both sides read the same set of files
+    gs_asset_pack_t* pack = gs_asset_pack_open(PACK_BENCH_OUT);
+    if (!pack) return 1;
+    const uint32_t ct = gs_asset_pack_count(pack);
+    char** loose = gs_malloc(gs_max(ct, 1) * sizeof(char*));
+    char** packed = gs_malloc(gs_max(ct, 1) * sizeof(char*));
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        size_t size = 0;
+        const char* name = gs_asset_pack_name(pack, i, &size);
+        const size_t len = strlen(dir) + strlen(name) + 16;
+        loose[i] = gs_malloc(len);
+        packed[i] = gs_malloc(len);
+        gs_snprintf(loose[i], len, "%s/%s", dir, name);
+        gs_snprintf(packed[i], len, "pack://%s", name);
+        bytes += size;
+    }
+    gs_asset_pack_close(pack);
+
+    double best[3] = {1e9, 1e9, 1e9};
+    uint64_t sums[3] = {0};
+    for (uint32_t r = 0; r < reps; ++r)
+    {
+        // Loose: open, read and close each file
+        double t0 = pack_now();
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < ct; ++i)
+        {
+            size_t size = 0;
+            char* data = gs_platform_read_file_contents(loose[i], "rb", &size);
+            if (data) sum += pack_checksum((uint8_t*)data, size);
+            gs_free(data);
+        }
+        best[0] = gs_min(best[0], pack_now() - t0);
+        sums[0] = sum;
+
+        // Pack, copied out the way async importers read it (mounting counts)
+        t0 = pack_now();
+        sum = 0;
+        pack = gs_asset_pack_mount(PACK_BENCH_OUT, "pack://");
+        for (uint32_t i = 0; pack && i < ct; ++i)
+        {
+            size_t size = 0;
+            char* data = gs_assets_read_file(packed[i], &size);
+            if (data) sum += pack_checksum((uint8_t*)data, size);
+            gs_free(data);
+        }
+        gs_asset_pack_unmount(pack);
+        best[1] = gs_min(best[1], pack_now() - t0);
+        sums[1] = sum;
+
+        // Pack, zero copy (opening counts)
+        t0 = pack_now();
+        sum = 0;
+        pack = gs_asset_pack_open(PACK_BENCH_OUT);
+        for (uint32_t i = 0; pack && i < ct; ++i)
+        {
+            size_t size = 0;
+            const uint8_t* data = gs_asset_pack_find(pack, packed[i] + strlen("pack://"), &size);
+            if (data) sum += pack_checksum(data, size);
+        }
+        gs_asset_pack_close(pack);
+        best[2] = gs_min(best[2], pack_now() - t0);
+        sums[2] = sum;
+    }
+
+    const char* names[3] = {"loose files", "pack, read_file", "pack, zero copy"};
+    gs_println("\n%u files, %.1f MB, best of %u", ct, (double)bytes / (1024.0 * 1024.0), reps);
+    gs_println("%-18s %10s %10s %10s %8s", "", "ms", "us/file", "MB/s", "speedup");
+    for (uint32_t m = 0; m < 3; ++m)
+    {
+        gs_println("%-18s %10.2f %10.2f %10.1f %7.2fx", names[m], best[m] * 1e3, best[m] * 1e6 / gs_max(ct, 1),
+            (double)bytes / (1024.0 * 1024.0) / best[m], best[0] / best[m]);
+    }
+    const bool ok = sums[0] == sums[1] && sums[0] == sums[2];
+    if (!ok) gs_println("checksums differ, pack doesn't match %s", dir);
+
+    for (uint32_t i = 0; i < ct; ++i) {
+        gs_free(loose[i]);
+        gs_free(packed[i]);
+    }
+    gs_free(loose);
+    gs_free(packed);
+    return ok ? 0 : 1;
+}
+
+int32_t main(int32_t argc, char** argv)
+{
+    const char* cmd = argc > 1 ? argv[1] : "";
+    if (strcmp(cmd, "build") == 0 && argc == 4) return pack_build(argv[2], argv[3]);
+    if (strcmp(cmd, "list") == 0 && argc == 3) return pack_list(argv[2]);
+    if (strcmp(cmd, "bench") == 0)
+    {
+        const char* dir = NULL;
+        uint32_t files = PACK_BENCH_FILES;
+        uint32_t reps = PACK_BENCH_REPS;
+        for (int32_t i = 2; i < argc; ++i)
+        {
+            const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+            if (strcmp(argv[i], "--files") == 0 && val) files = (uint32_t)strtoul(argv[++i], NULL, 10);
+            else if (strcmp(argv[i], "--reps") == 0 && val) reps = (uint32_t)strtoul(argv[++i], NULL, 10);
+            else if (argv[i][0] != '-' && !dir) dir = argv[i];
+            else { pack_usage(); return 1; }
+        }
+        return pack_bench(dir, files, gs_max(reps, 1));
+    }
+    pack_usage();
+    return 1;
+}